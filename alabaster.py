@@ -92,7 +92,11 @@ def make_symlink(file_from: str, file_to: str):
 
 
 def generate_cmake(
-    generator: Generator, build_folder: str, build_mode: BuildMode, build_tests: bool
+    generator: Generator,
+    build_folder: str,
+    build_mode: BuildMode,
+    build_tests: bool,
+    build_benchmarks: bool,
 ):
     generator_string: str = (
         generator.value if generator != Generator.VS else "Visual Studio 17 2022"
@@ -113,6 +117,7 @@ def generate_cmake(
         "-D GLFW_BUILD_EXAMPLES=OFF",
         f"-D CMAKE_BUILD_TYPE={build_mode.value}",
         f"-D ALABASTER_BUILD_TESTING={'ON' if build_tests else 'OFF'}",
+        f"-D ALABASTER_BUILD_BENCHMARKS={'ON' if build_benchmarks else 'OFF'}",
         "-D ALABASTER_IS_BUILD_TOOL=OFF",
         "-D ALABASTER_SHOULD_FORMAT=OFF",
         f"-D BUILD_TESTING={'ON' if build_tests else 'OFF'}",
@@ -250,7 +255,13 @@ def main(args: Namespace):
 
     build_folder_exists = Path(build_folder).exists()
     if not build_folder_exists or args.force_configure:
-        generate_cmake(generator, build_folder, build_mode, args.build_tests)
+        generate_cmake(
+            generator,
+            build_folder,
+            build_mode,
+            args.build_tests,
+            args.build_benchmarks,
+        )
 
     build_cmake(build_folder, target, args.parallel)
     should_run_tests = (build_mode == BuildMode.Debug or build_mode ==
@@ -284,6 +295,9 @@ if __name__ == "__main__":
         "-r", "--run", help="Run on completed build", action="store_true"
     )
     parser.add_argument("-b", "--build-tests", help="Build tests", action="store_true")
+    parser.add_argument(
+        "--build-benchmarks", help="Build benchmarks", action="store_true"
+    )
     parser.add_argument(
         "-f", "--force-configure", help="Reconfigure CMake", action="store_true"
     )
@@ -31,9 +31,8 @@ void AlabasterLayer::build_scene(SceneSystem::Scene& scene)
 {
 	using namespace Alabaster;
 
-	auto sphere_model = Alabaster::Mesh::from_file("sphere_subdivided.obj");
-	auto simple_sphere_model = Alabaster::Mesh::from_file("sphere.obj");
-	auto cube_model = Alabaster::Mesh::from_file("cube.obj");
+	const auto sphere_model = AssetManager::the().find_mesh("sphere_subdivided.obj").value_or(AssetManager::MeshHandle {});
+	const auto simple_sphere_model = AssetManager::the().find_mesh("sphere.obj").value_or(AssetManager::MeshHandle {});
 	PipelineSpecification sun_spec { .shader = AssetManager::asset<Alabaster::Shader>("mesh_light"),
 		.debug_name = "Sun Pipeline",
 		.render_pass = scene.get_framebuffer().get_renderpass(),
@@ -42,8 +41,18 @@ void AlabasterLayer::build_scene(SceneSystem::Scene& scene)
 		= VertexBufferLayout { VertexBufferElement(ShaderDataType::Float3, "position"), VertexBufferElement(ShaderDataType::Float4, "colour"),
 			VertexBufferElement(ShaderDataType::Float3, "normal"), VertexBufferElement(ShaderDataType::Float3, "tangent"),
 			VertexBufferElement(ShaderDataType::Float3, "bitangent"), VertexBufferElement(ShaderDataType::Float2, "uvs") },
-		.ranges = PushConstantRanges { PushConstantRange(PushConstantKind::Both, scene.get_renderer().default_push_constant_size()) } };
-	auto sun_pipeline = Alabaster::Pipeline::create(sun_spec);
+		.ranges = PushConstantRanges { PushConstantRange(PushConstantKind::Both, scene.get_renderer().default_push_constant_size()) },
+		.descriptor_set_layouts = { scene.get_renderer().get_descriptor_set_layout() } };
+	auto light_spec = sun_spec;
+	light_spec.shader = AssetManager::the().shader("mesh_light", { "UNLIT" });
+	light_spec.debug_name = "Light Pipeline";
+
+	std::vector<PipelineSpecification> specs;
+	specs.push_back(std::move(sun_spec));
+	specs.push_back(std::move(light_spec));
+	const auto pipelines = Alabaster::Pipeline::create(std::move(specs));
+	const auto& sun_pipeline = pipelines[0];
+	const auto& light_pipeline = pipelines[1];
 
 	Entity sphere_one = scene.create_entity(fmt::format("Sphere-{}", 0));
 	sphere_one.add_component<Component::Mesh>(sphere_model);
@@ -122,6 +131,7 @@ void AlabasterLayer::build_scene(SceneSystem::Scene& scene)
 		ambience.w = 1;
 		point_light.add_component<Component::PointLight>(ambience);
 		point_light.add_component<Component::Mesh>(simple_sphere_model);
+		point_light.add_component<Component::Pipeline>(light_pipeline);
 		const float start_pos = static_cast<float>(index) * division;
 		Alabaster::Log::info("Current pos: {}", start_pos);
 		point_light.add_behaviour<MoveInCircle>("MoveInCircle", radius, height, start_pos);
@@ -132,6 +142,7 @@ void AlabasterLayer::build_scene(SceneSystem::Scene& scene)
 	sun.add_component<Component::Light>(glm::vec4 { 252., 144., 3., 255 });
 	sun.add_component<Component::Mesh>(sphere_model);
 	sun.add_component<Component::Texture>(glm::vec4 { 252., 144., 3., 255 });
+	sun.add_component<Component::Pipeline>(light_pipeline);
 	sun.add_component<Component::ScriptBehaviour>("move");
 	auto& sun_transform = sun.get_transform();
 	sun_transform.position = { -3, -1.5, -1 };
@@ -165,7 +176,7 @@ bool AlabasterLayer::initialise(AssetManager::FileWatcher& file_watcher)
 #ifdef USE_EXPERIMENTAL_FEATURES
 	panels.push_back(std::make_unique<App::DirectoryContentPanel>(FileSystem::resources()));
 #endif
-	panels.push_back(std::make_unique<App::StatisticsPanel>(Application::the().get_statistics()));
+	panels.push_back(std::make_unique<App::StatisticsPanel>(Application::the().get_statistics(), *editor_scene));
 
 	for (const auto& panel : panels) {
 		panel->initialise(file_watcher);
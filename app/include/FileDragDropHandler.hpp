@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Alabaster.hpp>
+#include <AssetManager.hpp>
 #include <SceneSystem.hpp>
 
 namespace App {
@@ -23,7 +24,7 @@ namespace App {
 				return;
 
 			const TextureProperties props;
-			const auto img = Alabaster::Texture::from_filename(path, props);
+			const auto img = AssetManager::the().stream_texture(FileSystem::texture(path), props);
 			auto entity = scene.create_entity("PNG");
 			entity.add_component<Component::Texture>(glm::vec4 { 1.0 }, img);
 		}
@@ -47,7 +48,7 @@ namespace App {
 				return;
 
 			auto entity = scene.create_entity(path.string());
-			entity.add_component<Component::Mesh>(Alabaster::Mesh::from_file(path));
+			entity.add_component<Component::Mesh>(AssetManager::the().find_mesh(path.string()).value_or(AssetManager::MeshHandle {}));
 			entity.add_component<Component::Texture>();
 			entity.add_component<Component::Pipeline>();
 		}
@@ -100,7 +101,7 @@ namespace App {
 				return;
 
 			const TextureProperties props;
-			const auto img = Alabaster::Texture::from_filename(path, props);
+			const auto img = AssetManager::the().stream_texture(FileSystem::texture(path), props);
 			auto entity = scene.create_entity("JPEG");
 			entity.add_component<Component::Texture>(glm::vec4 { 1.0 }, img);
 		}
@@ -113,7 +114,7 @@ namespace App {
 				return;
 
 			const TextureProperties props;
-			const auto img = Alabaster::Texture::from_filename(path, props);
+			const auto img = AssetManager::the().stream_texture(FileSystem::texture(path), props);
 			auto entity = scene.create_entity("JPG");
 			entity.add_component<Component::Texture>(glm::vec4 { 1.0 }, img);
 		}
@@ -3,6 +3,7 @@
 
 #include "core/Application.hpp"
 #include "panels/Panel.hpp"
+#include "scene/Scene.hpp"
 
 namespace App {
 
@@ -42,8 +43,9 @@ namespace App {
 
 	class StatisticsPanel : public Panel {
 	public:
-		explicit StatisticsPanel(const Alabaster::ApplicationStatistics& application_stats)
+		StatisticsPanel(const Alabaster::ApplicationStatistics& application_stats, const SceneSystem::Scene& in_scene)
 			: statistics(application_stats)
+			, scene(in_scene)
 		{
 			descriptives = { Descriptive { "CPU Time", 1.8 }, Descriptive { "FT", 9.3 } };
 		};
@@ -57,6 +59,7 @@ namespace App {
 
 	private:
 		const Alabaster::ApplicationStatistics& statistics;
+		const SceneSystem::Scene& scene;
 		std::array<Descriptive, 2> descriptives {};
 
 		// 144fps, keep for 6 frames, update every 30th frame.
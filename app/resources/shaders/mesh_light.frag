@@ -35,6 +35,9 @@ pc;
 
 void main()
 {
+#ifdef UNLIT
+	out_colour = vec4(vec3(pc.object_colour), 1.0);
+#else
 	vec3 diffuse_light_total = pc.light_ambience.xyz * pc.light_ambience.w;
 	vec3 surface_normal = normal;
 
@@ -50,4 +53,5 @@ void main()
 	}
 
 	out_colour = vec4(diffuse_light_total * vec3(pc.object_colour), 1.0);
+#endif
 }
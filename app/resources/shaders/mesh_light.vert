@@ -1,11 +1,22 @@
 #version 460
 
+#ifdef COMPACT_VERTICES
+// Quantised positions arrive as unorms and are dequantised by pc.object_transform. The frame holds the octahedral normal in xy and
+// tangent in zw.
+layout(location = 0) in vec3 locations;
+layout(location = 1) in vec4 frame;
+layout(location = 2) in vec2 uvs;
+#ifdef VERTEX_COLOUR
+layout(location = 3) in vec4 colour;
+#endif
+#else
 layout(location = 0) in vec3 locations;
 layout(location = 1) in vec4 colour;
 layout(location = 2) in vec3 normal;
 layout(location = 3) in vec3 tangent;
 layout(location = 4) in vec3 bitangent;
 layout(location = 5) in vec2 uvs;
+#endif
 
 struct PointLight {
 	vec4 position;
@@ -38,8 +49,26 @@ layout(location = 1) out vec2 out_uvs;
 layout(location = 2) out vec3 out_normal;
 layout(location = 3) out vec3 out_frag_position;
 
+#ifdef COMPACT_VERTICES
+vec3 decode_octahedral(vec2 encoded)
+{
+	vec3 direction = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+	float fold = max(-direction.z, 0.0);
+	direction.x -= direction.x >= 0.0 ? fold : -fold;
+	direction.y -= direction.y >= 0.0 ? fold : -fold;
+	return normalize(direction);
+}
+#endif
+
 void main()
 {
+#ifdef COMPACT_VERTICES
+	vec3 normal = decode_octahedral(frame.xy);
+#ifndef VERTEX_COLOUR
+	vec4 colour = vec4(1.0);
+#endif
+#endif
+
 	vec4 world_coordinates = pc.object_transform * vec4(locations, 1.0);
 	gl_Position = ubo.view_proj * world_coordinates;
 
@@ -268,8 +268,8 @@ namespace App {
 		draw_component<SceneSystem::Component::Texture>(entity, "Texture", [](SceneSystem::Component::Texture& component) {
 			ImGui::ColorEdit4("Colour", glm::value_ptr(component.colour));
 
-			if (component.texture)
-				Alabaster::UI::image(component.texture->get_descriptor_info(), ImVec2(200, 200));
+			if (const auto* texture = AssetManager::the().get(component.texture))
+				Alabaster::UI::image(texture->get_descriptor_info(), ImVec2(200, 200));
 		});
 
 		draw_component<SceneSystem::Component::Behaviour>(
@@ -284,8 +284,8 @@ namespace App {
 		});
 
 		draw_component<SceneSystem::Component::Mesh>(entity, "Mesh", [](const SceneSystem::Component::Mesh& component) {
-			if (component.mesh) {
-				ImGui::Text("Mesh path: %s", component.mesh->get_asset_path().string().data());
+			if (const auto* mesh = AssetManager::the().get(component.mesh)) {
+				ImGui::Text("Mesh path: %s", mesh->get_asset_path().string().data());
 				return;
 			}
 			ImGui::Button("Component mesh");
@@ -1,5 +1,8 @@
 #include "panels/StatisticsPanel.hpp"
 
+#include "graphics/Pipeline.hpp"
+
+#include <AssetManager.hpp>
 #include <imgui.h>
 #include <tuple>
 
@@ -7,6 +10,8 @@ namespace App {
 
 	static constexpr auto update_interval_ms = 30.0;
 
+	static constexpr double to_mebibytes(std::uint64_t bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); }
+
 	void StatisticsPanel::on_update(float ts)
 	{
 		should_update_counter += ts;
@@ -29,6 +34,26 @@ namespace App {
 			ImGui::TableNextColumn();
 			ImGui::Text("%s: %fms", "FPS", 1000.0 * frame_time_average.inverse());
 			ImGui::TableNextColumn();
+
+			const auto& residency = AssetManager::the().texture_residency();
+			ImGui::Text("%s: %.1f%%", "Texture Hit Rate", 100.0 * residency.hit_rate());
+			ImGui::TableNextColumn();
+			ImGui::Text("%s: %.1f / %.1f MiB", "Resident Textures", to_mebibytes(residency.resident_bytes), to_mebibytes(residency.budget_bytes));
+			ImGui::TableNextColumn();
+			ImGui::Text("%s: %llu", "Texture Evictions", static_cast<unsigned long long>(residency.evictions));
+			ImGui::TableNextColumn();
+
+			const auto& culling = scene.get_culling_statistics();
+			ImGui::Text("%s: %u visible, %u culled", "Entities", culling.visible, culling.culled);
+			ImGui::TableNextColumn();
+			ImGui::Text("%s: %.3fms", "Frustum Culling", culling.milliseconds);
+			ImGui::TableNextColumn();
+
+			const auto pipelines = Alabaster::Pipeline::statistics();
+			ImGui::Text("%s: %u built, %u reused", "Pipelines", pipelines.created, pipelines.reused);
+			ImGui::TableNextColumn();
+			ImGui::Text("%s: %.2fms (total %.2fms)", "Pipeline Build", pipelines.last_build_milliseconds, pipelines.total_build_milliseconds);
+			ImGui::TableNextColumn();
 			ImGui::EndTable();
 		}
 		ImGui::End();
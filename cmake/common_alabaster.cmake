@@ -69,6 +69,11 @@ function(register_for_project PROJECT HAS_TESTS)
   if(ALABASTER_BUILD_TESTING STREQUAL "ON" AND HAS_TESTS STREQUAL "ON")
     add_subdirectory(tests)
   endif()
+
+  if(ALABASTER_BUILD_BENCHMARKS STREQUAL "ON" AND EXISTS
+                                                 "${CMAKE_CURRENT_SOURCE_DIR}/benchmarks")
+    add_subdirectory(benchmarks)
+  endif()
 endfunction()
 
 function(default_register_project PROJECT)
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <fmt/format.h>
+#include <string_view>
+#include <vector>
+
+namespace Benchmark {
+
+	/// @brief Runs func repetitions times and returns the median wall time in milliseconds.
+	/// Timed with std::chrono, the engine clocks need a glfw context.
+	template <typename Func> double median_milliseconds(std::size_t repetitions, Func&& func)
+	{
+		std::vector<double> samples;
+		samples.reserve(repetitions);
+		for (std::size_t i = 0; i < repetitions; i++) {
+			const auto start = std::chrono::steady_clock::now();
+			func();
+			const auto end = std::chrono::steady_clock::now();
+			samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+		}
+
+		std::sort(samples.begin(), samples.end());
+		return samples[samples.size() / 2];
+	}
+
+	inline void report(std::string_view name, std::string_view variant, double milliseconds, std::string_view extra = "")
+	{
+		fmt::print("{:<36} {:<28} {:>10.3f} ms {}\n", name, variant, milliseconds, extra);
+	}
+
+	/// @brief Keeps the optimiser from discarding a computed value.
+	template <typename T> inline void do_not_optimise(const T& value)
+	{
+#if defined(_MSC_VER)
+		static const void* volatile sink;
+		sink = &value;
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+
+} // namespace Benchmark
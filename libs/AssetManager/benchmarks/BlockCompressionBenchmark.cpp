@@ -0,0 +1,45 @@
+#include "Benchmark.hpp"
+#include "compiler/BlockCompression.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+static constexpr std::size_t repetitions = 5;
+
+/// @brief Smooth ramps in every channel, the kind of content that shows block compression's banding.
+static std::vector<std::uint8_t> make_image(std::uint32_t size)
+{
+	std::vector<std::uint8_t> rgba(static_cast<std::size_t>(size) * size * 4);
+	for (std::uint32_t y = 0; y < size; y++) {
+		for (std::uint32_t x = 0; x < size; x++) {
+			auto* texel = &rgba[(static_cast<std::size_t>(y) * size + x) * 4];
+			texel[0] = static_cast<std::uint8_t>(x * 255 / (size - 1));
+			texel[1] = static_cast<std::uint8_t>(y * 255 / (size - 1));
+			texel[2] = static_cast<std::uint8_t>((x + y) * 255 / (2 * size - 2));
+			texel[3] = static_cast<std::uint8_t>(255 - texel[0] / 2);
+		}
+	}
+	return rgba;
+}
+
+int main()
+{
+	using AssetManager::BlockFormat;
+	namespace BlockCompression = AssetManager::BlockCompression;
+
+	for (const auto size : std::array<std::uint32_t, 2> { 512, 2048 }) {
+		const auto rgba = make_image(size);
+		const auto megapixels = static_cast<double>(size) * size / 1e6;
+		for (const auto format : { BlockFormat::BC1, BlockFormat::BC3, BlockFormat::BC5, BlockFormat::BC7 }) {
+			const auto milliseconds = Benchmark::median_milliseconds(repetitions, [&] {
+				const auto blocks = BlockCompression::encode(format, rgba, size, size);
+				Benchmark::do_not_optimise(blocks.back());
+			});
+			Benchmark::report(fmt::format("block compression {}x{}", size, size), fmt::format("bc{}", static_cast<std::uint32_t>(format)),
+				milliseconds, fmt::format("({:.1f} MP/s)", megapixels / (milliseconds / 1000.0)));
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,116 @@
+#include "Benchmark.hpp"
+#include "watcher/FileWatcher.hpp"
+
+#include <ctime>
+#include <fstream>
+#include <random>
+#include <unordered_set>
+
+static constexpr std::size_t directory_count = 1000;
+static constexpr std::size_t files_per_directory = 100;
+static constexpr std::size_t latency_samples = 50;
+static constexpr std::size_t burst_size = 10000;
+
+using Clock = std::chrono::steady_clock;
+
+static std::filesystem::path file_path(const std::filesystem::path& root, std::size_t index)
+{
+	return root / fmt::format("directory_{}", index / files_per_directory) / fmt::format("file_{}.txt", index % files_per_directory);
+}
+
+static void touch(const std::filesystem::path& path, std::size_t revision)
+{
+	std::ofstream stream(path, std::ios::trunc);
+	stream << revision;
+}
+
+/// @return process CPU time in milliseconds, over all threads
+static double cpu_milliseconds() { return 1000.0 * static_cast<double>(std::clock()) / CLOCKS_PER_SEC; }
+
+int main()
+{
+	const auto root = std::filesystem::temp_directory_path() / "alabaster_file_watcher_benchmark";
+	std::filesystem::remove_all(root);
+	for (std::size_t directory = 0; directory < directory_count; directory++) {
+		std::filesystem::create_directories(root / fmt::format("directory_{}", directory));
+	}
+	const auto file_count = directory_count * files_per_directory;
+	for (std::size_t i = 0; i < file_count; i++) {
+		touch(file_path(root, i), 0);
+	}
+
+	const auto setup_start = Clock::now();
+	AssetManager::FileWatcher watcher(root);
+	std::unordered_set<std::string> notified;
+	std::size_t notifications = 0;
+	watcher.on(AssetManager::FileStatuses::All, [&](const AssetManager::FileInformation& information) {
+		notified.insert(information.path);
+		notifications++;
+	});
+
+	// Stands in for the frame loop, which dispatches with a budget every frame.
+	const auto wait_for = [&](const std::function<bool()>& done, std::chrono::seconds timeout) {
+		const auto deadline = Clock::now() + timeout;
+		while (!done() && Clock::now() < deadline) {
+			watcher.dispatch(std::chrono::milliseconds(2));
+			std::this_thread::sleep_for(std::chrono::microseconds(200));
+		}
+		return done();
+	};
+	const auto seen = [&](const std::filesystem::path& path) { return notified.contains(path.string()); };
+
+	// The watcher is ready once it reports a change, so keep touching a file until it does.
+	const auto sentinel = file_path(root, 0);
+	std::size_t revision = 1;
+	while (!seen(sentinel)) {
+		touch(sentinel, revision++);
+		wait_for([&] { return seen(sentinel); }, std::chrono::seconds(1));
+	}
+	const auto setup_milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - setup_start).count();
+	Benchmark::report(fmt::format("watch {} files", file_count), "until first notification", setup_milliseconds);
+
+	// Idle cost: nothing changes, the watcher should sleep.
+	static constexpr auto idle_time = std::chrono::seconds(3);
+	const auto idle_cpu_start = cpu_milliseconds();
+	std::this_thread::sleep_for(idle_time);
+	const auto idle_cpu = cpu_milliseconds() - idle_cpu_start;
+	const auto idle_wall = std::chrono::duration<double, std::milli>(idle_time).count();
+	Benchmark::report("idle", "cpu time", idle_cpu, fmt::format("({:.2f}% of a core)", 100.0 * idle_cpu / idle_wall));
+
+	// Latency of single edits, from the write returning until the callback runs. Includes the debounce window.
+	std::mt19937 generator { 1234 };
+	std::uniform_int_distribution<std::size_t> pick { 1, file_count - 1 };
+	std::vector<double> latencies;
+	for (std::size_t sample = 0; sample < latency_samples; sample++) {
+		const auto path = file_path(root, pick(generator));
+		notified.erase(path.string());
+
+		touch(path, revision++);
+		const auto written = Clock::now();
+		if (!wait_for([&] { return seen(path); }, std::chrono::seconds(10))) {
+			fmt::print("No notification for {}.\n", path.string());
+			return 1;
+		}
+		latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - written).count());
+	}
+	std::ranges::sort(latencies);
+	Benchmark::report("single edit", "median latency", latencies[latencies.size() / 2]);
+	Benchmark::report("single edit", "worst latency", latencies.back());
+
+	// A burst such as a branch switch or an asset import, every change has to arrive exactly once.
+	const auto burst_start_notifications = notifications;
+	const auto burst_cpu_start = cpu_milliseconds();
+	const auto burst_start = Clock::now();
+	for (std::size_t i = 0; i < burst_size; i++) {
+		touch(file_path(root, i * (file_count / burst_size)), revision);
+	}
+	const auto delivered = wait_for([&] { return notifications - burst_start_notifications >= burst_size; }, std::chrono::seconds(30));
+	const auto burst_milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - burst_start).count();
+	wait_for([] { return false; }, std::chrono::seconds(1));
+	Benchmark::report(fmt::format("burst of {} edits", burst_size), "until all delivered", burst_milliseconds,
+		fmt::format("({} notifications{}, {:.0f} ms cpu)", notifications - burst_start_notifications, delivered ? "" : ", timed out",
+			cpu_milliseconds() - burst_cpu_start));
+
+	std::filesystem::remove_all(root);
+	return 0;
+}
@@ -0,0 +1,111 @@
+#include "Benchmark.hpp"
+#include "graphics/FrustumCuller.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <random>
+#include <string_view>
+#include <vector>
+
+static constexpr std::size_t repetitions = 7;
+static constexpr std::size_t bounds_count = 1'000'000;
+// Below the culler's parallel threshold, so every part is culled on the calling thread.
+static constexpr std::size_t single_thread_part = Alabaster::FrustumCuller::parallel_threshold / 2;
+
+/// @brief The editor camera's default projection, a 45 degree field of view at 16:9 looking down -z from the origin, depth from 0 to 1.
+static glm::mat4 view_projection()
+{
+	constexpr float near_plane = 0.1f;
+	constexpr float far_plane = 1000.0f;
+	const auto focal = 1.0f / std::tan(std::numbers::pi_v<float> / 8.0f);
+	return {
+		glm::vec4 { focal * 9.0f / 16.0f, 0.0f, 0.0f, 0.0f },
+		glm::vec4 { 0.0f, focal, 0.0f, 0.0f },
+		glm::vec4 { 0.0f, 0.0f, far_plane / (near_plane - far_plane), -1.0f },
+		glm::vec4 { 0.0f, 0.0f, far_plane * near_plane / (near_plane - far_plane), 0.0f },
+	};
+}
+
+static std::string_view instruction_set()
+{
+#if defined(__SSE__) || defined(_M_X64)
+	return "sse";
+#else
+	return "scalar";
+#endif
+}
+
+int main()
+{
+	// Unit cubes scattered around the camera, moved and scaled the way entity transforms would.
+	const Alabaster::MeshBounds cube { .min = glm::vec3 { -1.0f }, .max = glm::vec3 { 1.0f }, .radius = std::sqrt(3.0f) };
+	std::mt19937 generator { 42 };
+	std::uniform_real_distribution<float> position { -400.0f, 400.0f };
+	std::uniform_real_distribution<float> scale { 0.25f, 4.0f };
+	std::vector<glm::mat4> transforms;
+	transforms.reserve(bounds_count);
+	for (std::size_t i = 0; i < bounds_count; i++) {
+		const auto size = scale(generator);
+		transforms.push_back({ glm::vec4 { size, 0.0f, 0.0f, 0.0f }, glm::vec4 { 0.0f, size, 0.0f, 0.0f }, glm::vec4 { 0.0f, 0.0f, size, 0.0f },
+			glm::vec4 { position(generator), position(generator), position(generator), 1.0f } });
+	}
+
+	const auto name = fmt::format("frustum culling, {} bounds", bounds_count);
+	const auto throughput = [](double milliseconds) { return static_cast<double>(bounds_count) / milliseconds / 1000.0; };
+
+	// What the scene pays for every entity whose transform changed since the last frame.
+	std::vector<Alabaster::WorldBounds> world(bounds_count);
+	const auto update_milliseconds = Benchmark::median_milliseconds(repetitions, [&] {
+		for (std::size_t i = 0; i < bounds_count; i++) {
+			world[i] = Alabaster::WorldBounds::of(cube, transforms[i]);
+		}
+		Benchmark::do_not_optimise(world.back());
+	});
+	Benchmark::report(name, "world bounds update", update_milliseconds, fmt::format("({:.1f} M/s)", throughput(update_milliseconds)));
+
+	const auto frustum = Alabaster::Frustum::of(view_projection());
+	std::size_t scalar_visible { 0 };
+	const auto scalar_milliseconds = Benchmark::median_milliseconds(repetitions, [&] {
+		scalar_visible = 0;
+		for (const auto& bounds : world) {
+			scalar_visible += frustum.intersects(bounds) ? 1 : 0;
+		}
+		Benchmark::do_not_optimise(scalar_visible);
+	});
+	Benchmark::report(name, "scalar, one thread", scalar_milliseconds,
+		fmt::format("({} visible, {:.1f} M/s)", scalar_visible, throughput(scalar_milliseconds)));
+
+	std::vector<Alabaster::FrustumCuller> parts((bounds_count + single_thread_part - 1) / single_thread_part);
+	for (std::size_t i = 0; i < bounds_count; i++) {
+		parts[i / single_thread_part].add(world[i]);
+	}
+	std::vector<std::uint8_t> visible;
+	std::size_t part_visible { 0 };
+	const auto single_milliseconds = Benchmark::median_milliseconds(repetitions, [&] {
+		part_visible = 0;
+		for (const auto& part : parts) {
+			part_visible += part.cull(frustum, visible);
+		}
+		Benchmark::do_not_optimise(part_visible);
+	});
+	Benchmark::report(name, fmt::format("{}, one thread", instruction_set()), single_milliseconds,
+		fmt::format("({} visible, {:.1f} M/s, {:.1f}x scalar)", part_visible, throughput(single_milliseconds),
+			scalar_milliseconds / single_milliseconds));
+
+	Alabaster::FrustumCuller culler;
+	culler.reserve(bounds_count);
+	for (const auto& bounds : world) {
+		culler.add(bounds);
+	}
+	std::size_t parallel_visible { 0 };
+	const auto parallel_milliseconds = Benchmark::median_milliseconds(repetitions, [&] {
+		parallel_visible = culler.cull(frustum, visible);
+		Benchmark::do_not_optimise(visible.back());
+	});
+	Benchmark::report(name, fmt::format("{}, job system", instruction_set()), parallel_milliseconds,
+		fmt::format("({} visible, {:.1f} M/s, {:.1f}x scalar)", parallel_visible, throughput(parallel_milliseconds),
+			scalar_milliseconds / parallel_milliseconds));
+
+	return 0;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "graphics/Vertex.hpp"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+
+namespace Benchmark {
+
+	/// @brief Writes a cube with every face subdivided and pushed out onto the unit sphere, with positions, uvs and normals like an
+	/// exported model. Vertices on the face seams differ in their uvs and survive deduplication, as they do in real models. The
+	/// sphere has 12 * subdivisions^2 triangles.
+	inline void write_sphere_obj(const std::filesystem::path& path, std::uint32_t subdivisions)
+	{
+		static const std::array<std::array<glm::vec3, 3>, 6> faces { {
+			{ glm::vec3 { 1, 0, 0 }, glm::vec3 { 0, 0, -1 }, glm::vec3 { 0, 1, 0 } },
+			{ glm::vec3 { -1, 0, 0 }, glm::vec3 { 0, 0, 1 }, glm::vec3 { 0, 1, 0 } },
+			{ glm::vec3 { 0, 1, 0 }, glm::vec3 { 1, 0, 0 }, glm::vec3 { 0, 0, -1 } },
+			{ glm::vec3 { 0, -1, 0 }, glm::vec3 { 1, 0, 0 }, glm::vec3 { 0, 0, 1 } },
+			{ glm::vec3 { 0, 0, 1 }, glm::vec3 { 1, 0, 0 }, glm::vec3 { 0, 1, 0 } },
+			{ glm::vec3 { 0, 0, -1 }, glm::vec3 { -1, 0, 0 }, glm::vec3 { 0, 1, 0 } },
+		} };
+
+		std::ofstream stream(path, std::ios::trunc);
+		const auto side = subdivisions + 1;
+		for (const auto& [normal, right, up] : faces) {
+			for (std::uint32_t y = 0; y < side; y++) {
+				for (std::uint32_t x = 0; x < side; x++) {
+					const auto u = static_cast<float>(x) / static_cast<float>(subdivisions);
+					const auto v = static_cast<float>(y) / static_cast<float>(subdivisions);
+					const auto position = glm::normalize(normal + (2.0f * u - 1.0f) * right + (2.0f * v - 1.0f) * up);
+					stream << fmt::format("v {} {} {}\nvt {} {}\nvn {} {} {}\n", position.x, position.y, position.z, u, v, position.x,
+						position.y, position.z);
+				}
+			}
+		}
+
+		// Every corner is written per triangle, the way exporters do, so the importer has duplicates to remove.
+		for (std::uint32_t face = 0; face < faces.size(); face++) {
+			const auto base = face * side * side + 1;
+			const auto corner = [&](std::uint32_t x, std::uint32_t y) {
+				const auto index = base + y * side + x;
+				return fmt::format("{0}/{0}/{0}", index);
+			};
+			for (std::uint32_t y = 0; y < subdivisions; y++) {
+				for (std::uint32_t x = 0; x < subdivisions; x++) {
+					stream << fmt::format("f {} {} {}\n", corner(x, y), corner(x + 1, y), corner(x + 1, y + 1));
+					stream << fmt::format("f {} {} {}\n", corner(x, y), corner(x + 1, y + 1), corner(x, y + 1));
+				}
+			}
+		}
+	}
+
+} // namespace Benchmark
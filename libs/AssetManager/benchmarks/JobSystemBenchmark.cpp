@@ -0,0 +1,98 @@
+#include "Benchmark.hpp"
+#include "ThreadPool.hpp"
+#include "utilities/JobSystem.hpp"
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <numeric>
+#include <vector>
+
+static constexpr std::size_t repetitions = 7;
+static constexpr std::size_t tiny_task_count = 100'000;
+static constexpr std::size_t element_count = 1 << 22;
+static constexpr std::size_t chunk_size = 4096;
+
+static float work(std::size_t index) { return std::sqrt(static_cast<float>(index)) * 0.5f; }
+
+static void fan_out(std::size_t thread_count)
+{
+	AssetManager::ThreadPool pool { static_cast<int>(thread_count) };
+	const auto pool_time = Benchmark::median_milliseconds(repetitions, [&pool] {
+		std::vector<std::future<float>> futures;
+		futures.reserve(tiny_task_count);
+		for (std::size_t i = 0; i < tiny_task_count; i++) {
+			futures.push_back(pool.push([i](int) { return work(i); }));
+		}
+
+		auto sum = 0.0f;
+		for (auto& future : futures) {
+			sum += future.get();
+		}
+		Benchmark::do_not_optimise(sum);
+	});
+
+	AssetManager::JobSystem jobs { thread_count };
+	const auto job_time = Benchmark::median_milliseconds(repetitions, [&jobs] {
+		std::atomic<std::uint32_t> sum { 0 };
+		auto* root = jobs.create([] {});
+		for (std::size_t i = 0; i < tiny_task_count; i++) {
+			jobs.run(jobs.create_child(root, [i, &sum] { sum.fetch_add(static_cast<std::uint32_t>(work(i)), std::memory_order_relaxed); }));
+		}
+		jobs.run(root);
+		jobs.wait(root);
+		Benchmark::do_not_optimise(sum.load());
+	});
+
+	const auto variant = fmt::format("{} threads", thread_count);
+	Benchmark::report("fan out 100k tiny tasks / ThreadPool", variant, pool_time);
+	Benchmark::report("fan out 100k tiny tasks / JobSystem", variant, job_time, fmt::format("({:.2f}x)", pool_time / job_time));
+}
+
+static void reduce(std::size_t thread_count)
+{
+	std::vector<float> values(element_count);
+	for (std::size_t i = 0; i < element_count; i++) {
+		values[i] = work(i);
+	}
+
+	AssetManager::ThreadPool pool { static_cast<int>(thread_count) };
+	const auto pool_time = Benchmark::median_milliseconds(repetitions, [&pool, &values] {
+		std::vector<std::future<double>> futures;
+		for (std::size_t first = 0; first < values.size(); first += chunk_size) {
+			futures.push_back(pool.push([first, &values](int) {
+				const auto last = std::min(first + chunk_size, values.size());
+				return std::accumulate(values.begin() + first, values.begin() + last, 0.0);
+			}));
+		}
+
+		auto sum = 0.0;
+		for (auto& future : futures) {
+			sum += future.get();
+		}
+		Benchmark::do_not_optimise(sum);
+	});
+
+	AssetManager::JobSystem jobs { thread_count };
+	const auto job_time = Benchmark::median_milliseconds(repetitions, [&jobs, &values] {
+		const auto sum = jobs.parallel_reduce(
+			0, values.size(), chunk_size, 0.0, [&values](std::size_t index) { return static_cast<double>(values[index]); },
+			[](double lhs, double rhs) { return lhs + rhs; });
+		Benchmark::do_not_optimise(sum);
+	});
+
+	const auto variant = fmt::format("{} threads", thread_count);
+	Benchmark::report("reduce 4M floats / ThreadPool", variant, pool_time);
+	Benchmark::report("reduce 4M floats / JobSystem", variant, job_time, fmt::format("({:.2f}x)", pool_time / job_time));
+}
+
+int main()
+{
+	for (const auto thread_count : std::array<std::size_t, 3> { 1, 4, 16 }) {
+		fan_out(thread_count);
+		reduce(thread_count);
+	}
+
+	return 0;
+}
@@ -0,0 +1,113 @@
+#include "Benchmark.hpp"
+#include "GeneratedMeshes.hpp"
+#include "core/Logger.hpp"
+#include "filesystem/FileSystem.hpp"
+#include "graphics/MeshFile.hpp"
+#include "graphics/ObjParser.hpp"
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <tiny_obj_loader.h>
+
+static constexpr std::size_t repetitions = 3;
+// 12 * 300^2, a little over a million triangles.
+static constexpr std::uint32_t subdivisions = 300;
+
+static std::optional<tinyobj::ObjReader> parse(const std::filesystem::path& source)
+{
+	const auto file = Alabaster::FileSystem::read(source);
+	if (!file) {
+		return {};
+	}
+
+	tinyobj::ObjReader reader;
+	if (!reader.ParseFromString(std::string { file->text() }, "", tinyobj::ObjReaderConfig {})) {
+		return {};
+	}
+	return reader;
+}
+
+/// @brief The deduplication the importer used before, kept here with the tinyobj parse as the baseline: whole vertices hashed into
+/// a node based map, with one lookup to test for the vertex and another to fetch its index.
+static std::size_t deduplicate_vertices(const tinyobj::attrib_t& attrib, const std::vector<tinyobj::shape_t>& shapes)
+{
+	std::unordered_map<Alabaster::Vertex, std::uint32_t> unique_vertices {};
+	std::vector<Alabaster::Vertex> vertices;
+	std::vector<Alabaster::Index> indices;
+
+	for (const auto& shape : shapes) {
+		for (const auto& index : shape.mesh.indices) {
+			Alabaster::Vertex vertex {};
+			vertex.position = { attrib.vertices[3 * index.vertex_index + 0], attrib.vertices[3 * index.vertex_index + 1],
+				attrib.vertices[3 * index.vertex_index + 2] };
+			vertex.uv = { attrib.texcoords[2 * index.texcoord_index + 0], 1.0f - attrib.texcoords[2 * index.texcoord_index + 1] };
+			vertex.normal = { attrib.normals[3 * index.normal_index + 0], attrib.normals[3 * index.normal_index + 1],
+				attrib.normals[3 * index.normal_index + 2] };
+			vertex.colour = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+			if (!unique_vertices.contains(vertex)) {
+				unique_vertices[vertex] = static_cast<std::uint32_t>(vertices.size());
+				vertices.push_back(vertex);
+			}
+			indices.push_back(unique_vertices[vertex]);
+		}
+	}
+	return vertices.size();
+}
+
+int main()
+{
+	Alabaster::Logger::init();
+
+	const auto directory = std::filesystem::temp_directory_path() / "alabaster_mesh_import_benchmark";
+	std::filesystem::remove_all(directory);
+	std::filesystem::create_directories(directory);
+	Alabaster::FileSystem::init_with_cwd(directory);
+
+	const auto source = directory / "sphere.obj";
+	Benchmark::write_sphere_obj(source, subdivisions);
+	std::filesystem::last_write_time(source, std::filesystem::file_time_type::clock::now() - std::chrono::hours(1));
+	const auto name = fmt::format("sphere, {} subdivisions", subdivisions);
+
+	const auto parse_milliseconds = Benchmark::median_milliseconds(repetitions, [&] {
+		const auto reader = parse(source);
+		Benchmark::do_not_optimise(reader->GetShapes().size());
+	});
+	Benchmark::report(name, "tinyobj parse", parse_milliseconds);
+
+	const auto file = Alabaster::FileSystem::read(source);
+	const auto parser_milliseconds = Benchmark::median_milliseconds(repetitions, [&] {
+		const auto model = Alabaster::ObjParser::parse(file->text());
+		Benchmark::do_not_optimise(model->indices.size());
+	});
+	Benchmark::report(name, "ObjParser parse", parser_milliseconds, fmt::format("({:.1f}x faster)", parse_milliseconds / parser_milliseconds));
+
+	std::size_t vertex_count { 0 };
+	const auto previous_milliseconds = Benchmark::median_milliseconds(repetitions, [&] {
+		const auto reader = parse(source);
+		vertex_count = deduplicate_vertices(reader->GetAttrib(), reader->GetShapes());
+		Benchmark::do_not_optimise(vertex_count);
+	});
+	Benchmark::report(name, "tinyobj, vertex map", previous_milliseconds, fmt::format("({} vertices)", vertex_count));
+
+	const auto import_variant = [&](std::string_view variant, const Alabaster::MeshImportOptions& options) {
+		std::size_t triangles { 0 };
+		const auto milliseconds = Benchmark::median_milliseconds(repetitions, [&] {
+			const auto mesh = Alabaster::MeshFile::import_obj(source, options);
+			vertex_count = mesh->vertices.size();
+			triangles = mesh->indices.size() / 3;
+			Benchmark::do_not_optimise(vertex_count);
+		});
+		const auto speedup = previous_milliseconds / milliseconds;
+		Benchmark::report(name, variant, milliseconds, fmt::format("({} vertices, {} triangles, {:.2f}x faster)", vertex_count, triangles, speedup));
+	};
+	import_variant("ObjParser, index triplets", {});
+	import_variant("ObjParser, triplets, welded", { .weld = true });
+
+	std::filesystem::remove_all(directory);
+	return 0;
+}
@@ -0,0 +1,87 @@
+#include "Benchmark.hpp"
+#include "GeneratedMeshes.hpp"
+#include "core/Logger.hpp"
+#include "filesystem/FileSystem.hpp"
+#include "graphics/MeshFile.hpp"
+#include "utilities/FileInputOutput.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+static constexpr std::size_t repetitions = 9;
+
+static void measure(const std::filesystem::path& source, std::string_view name)
+{
+	const auto cache_path = std::filesystem::path { source }.replace_extension(".amesh");
+
+	std::size_t triangles { 0 };
+	const auto import_milliseconds = Benchmark::median_milliseconds(repetitions, [&] {
+		const auto imported = Alabaster::MeshFile::import_obj(source);
+		triangles = imported ? imported->indices.size() / 3 : 0;
+		Benchmark::do_not_optimise(triangles);
+	});
+	Benchmark::report(name, "obj import", import_milliseconds, fmt::format("({} triangles)", triangles));
+
+	const auto imported = Alabaster::MeshFile::import_obj(source);
+	if (!imported || !Alabaster::MeshFile::write(cache_path, *imported)) {
+		Alabaster::Log::error("[MeshLoadBenchmark] Could not write {}.", cache_path.string());
+		return;
+	}
+
+	// Stands in for the mapped staging buffer the mesh is uploaded through.
+	std::vector<std::uint8_t> staging(imported->vertices.size() * sizeof(Alabaster::Vertex) + imported->indices.size() * sizeof(Alabaster::Index));
+	const auto load_milliseconds = Benchmark::median_milliseconds(repetitions, [&] {
+		const auto cached = Alabaster::MeshFile::open(cache_path);
+		if (!cached || !cached->is_current(source)) {
+			return;
+		}
+		const auto vertex_bytes = cached->vertices().size_bytes();
+		std::memcpy(staging.data(), cached->vertices().data(), vertex_bytes);
+		std::memcpy(staging.data() + vertex_bytes, cached->indices().data(), cached->indices().size_bytes());
+		Benchmark::do_not_optimise(staging.front());
+	});
+	const auto speedup = import_milliseconds / load_milliseconds;
+	Benchmark::report(name, ".amesh map and stage", load_milliseconds, fmt::format("({:.0f}x faster)", speedup));
+}
+
+int main()
+{
+	Alabaster::Logger::init();
+
+	const auto directory = std::filesystem::temp_directory_path() / "alabaster_mesh_load_benchmark";
+	std::filesystem::remove_all(directory);
+	std::filesystem::create_directories(directory);
+
+	// The bundled models are used when they are checked out, generated stand-ins of a similar size otherwise.
+	std::vector<std::pair<std::filesystem::path, std::string>> sources;
+	try {
+		if (const auto root = Alabaster::IO::get_resource_root()) {
+			Alabaster::FileSystem::init_with_cwd(*root);
+			for (const auto* model : { "sphere_subdivided.obj", "viking_room.obj" }) {
+				if (const auto path = Alabaster::FileSystem::model(model); std::filesystem::exists(path)) {
+					std::filesystem::copy_file(path, directory / model);
+					sources.emplace_back(directory / model, model);
+				}
+			}
+		}
+	} catch (const std::exception& e) {
+		Alabaster::Log::info("[MeshLoadBenchmark] Not run from the repository root, using generated models. {}", e.what());
+	}
+	if (sources.empty()) {
+		Alabaster::FileSystem::init_with_cwd(directory);
+		Benchmark::write_sphere_obj(directory / "sphere_64.obj", 64);
+		Benchmark::write_sphere_obj(directory / "sphere_18.obj", 18);
+		sources.emplace_back(directory / "sphere_64.obj", "generated sphere, 64 subdivisions");
+		sources.emplace_back(directory / "sphere_18.obj", "generated sphere, 18 subdivisions");
+	}
+
+	for (const auto& [source, name] : sources) {
+		// Sources written moments ago have an untrustworthy modification time, and would be hashed on every load.
+		std::filesystem::last_write_time(source, std::filesystem::file_time_type::clock::now() - std::chrono::hours(1));
+		measure(source, name);
+	}
+
+	std::filesystem::remove_all(directory);
+	return 0;
+}
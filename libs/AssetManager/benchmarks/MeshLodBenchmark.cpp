@@ -0,0 +1,84 @@
+#include "Benchmark.hpp"
+#include "GeneratedMeshes.hpp"
+#include "core/Logger.hpp"
+#include "filesystem/FileSystem.hpp"
+#include "graphics/MeshFile.hpp"
+#include "graphics/MeshOptimiser.hpp"
+#include "graphics/MeshSimplifier.hpp"
+
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+static constexpr std::size_t repetitions = 5;
+// 12 * 92^2, a little over a hundred thousand triangles.
+static constexpr std::uint32_t subdivisions = 92;
+static constexpr std::array ratios { 0.5f, 0.25f, 0.125f };
+// The import default, relative to the radius of the unit sphere.
+static constexpr float max_error = 0.01f;
+
+int main()
+{
+	Alabaster::Logger::init();
+
+	const auto directory = std::filesystem::temp_directory_path() / "alabaster_mesh_lod_benchmark";
+	std::filesystem::remove_all(directory);
+	std::filesystem::create_directories(directory);
+	Alabaster::FileSystem::init_with_cwd(directory);
+
+	const auto source = directory / "sphere.obj";
+	Benchmark::write_sphere_obj(source, subdivisions);
+	auto mesh = Alabaster::MeshFile::import_obj(source, { .lod_ratios = {} });
+	const auto name = fmt::format("sphere, {} triangles", mesh->indices.size() / 3);
+
+	std::vector<Alabaster::MeshLod> lods;
+	std::vector<Alabaster::Index> lod_indices;
+	const auto milliseconds = Benchmark::median_milliseconds(repetitions, [&] {
+		lod_indices.clear();
+		lods = Alabaster::MeshSimplifier::build_lods(mesh->vertices, mesh->indices, ratios, max_error, lod_indices);
+		Benchmark::do_not_optimise(lods.size());
+	});
+	Benchmark::report(name, "build 50/25/12% chain", milliseconds, fmt::format("({} levels)", lods.size()));
+
+	const auto pixels_per_unit = 0.5f * 1080.0f / std::tan(std::numbers::pi_v<float> / 6.0f);
+
+	// Every index streams its vertex through a perspective projection, standing in for the vertex stage the GPU runs per triangle.
+	// Vertex shader invocations after the post-transform cache are what the levels save on the GPU, on the cache optimised order
+	// they are imported in.
+	lods.insert(lods.begin(), { .first_index = 0, .index_count = static_cast<std::uint32_t>(mesh->indices.size()), .error = 0.0f });
+	std::vector<Alabaster::Index> all_indices { mesh->indices };
+	all_indices.insert(all_indices.end(), lod_indices.begin(), lod_indices.end());
+	for (std::size_t level = 0; level < lods.size(); level++) {
+		const auto& lod = lods[level];
+		const auto range = std::span { all_indices }.subspan(lod.first_index, lod.index_count);
+		Alabaster::MeshOptimiser::optimise_vertex_cache(range, mesh->vertices.size());
+		const auto cache = Alabaster::MeshOptimiser::analyse_vertex_cache(range, mesh->vertices.size());
+
+		const auto stage_milliseconds = Benchmark::median_milliseconds(repetitions, [&] {
+			glm::vec2 sum { 0.0f };
+			for (const auto index : range) {
+				const auto& position = mesh->vertices[index].position;
+				sum += glm::vec2 { position.x, position.y } * (pixels_per_unit / (position.z + 4.0f));
+			}
+			Benchmark::do_not_optimise(sum);
+		});
+		const auto triangles = lod.index_count / 3;
+		const auto throughput = static_cast<double>(triangles) / stage_milliseconds / 1000.0;
+		Benchmark::report(name, fmt::format("level {} vertex stage", level), stage_milliseconds,
+			fmt::format("({} triangles, {:.0f} Mtri/s, {:.0f} vertex shader invocations, error {:.5f})", triangles, throughput,
+				cache.acmr * static_cast<float>(triangles), lod.error));
+	}
+
+	// The level a 1080p viewport with a 60 degree field of view picks, by distance from the centre of the sphere.
+	const auto full = static_cast<double>(lods.front().index_count);
+	for (const auto distance : { 2.0f, 4.0f, 8.0f, 16.0f, 32.0f }) {
+		const auto scale = pixels_per_unit / (distance - 1.0f);
+		const auto& lod = lods[Alabaster::MeshSimplifier::select_lod(lods, scale, 1.0f)];
+		fmt::print("{:<36} {:<28} {:>6.0f}% of the triangles, {:.2f} px error\n", name, fmt::format("{} units away", distance),
+			100.0 * lod.index_count / full, lod.error * scale);
+	}
+
+	std::filesystem::remove_all(directory);
+	return 0;
+}
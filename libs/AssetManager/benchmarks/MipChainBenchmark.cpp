@@ -0,0 +1,52 @@
+#include "Benchmark.hpp"
+#include "compiler/MipChain.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+static constexpr std::size_t repetitions = 7;
+
+static std::vector<std::uint8_t> make_image(std::uint32_t size)
+{
+	std::vector<std::uint8_t> rgba(static_cast<std::size_t>(size) * size * 4);
+	for (std::uint32_t y = 0; y < size; y++) {
+		for (std::uint32_t x = 0; x < size; x++) {
+			auto* texel = &rgba[(static_cast<std::size_t>(y) * size + x) * 4];
+			texel[0] = static_cast<std::uint8_t>(x ^ y);
+			texel[1] = static_cast<std::uint8_t>(x * 3 + y);
+			texel[2] = static_cast<std::uint8_t>(y * 5);
+			texel[3] = static_cast<std::uint8_t>((x / 16 + y / 16) % 2 == 0 ? 255 : x);
+		}
+	}
+	return rgba;
+}
+
+static void generate(std::uint32_t size, const AssetManager::MipChainSettings& settings, std::string_view variant)
+{
+	const auto rgba = make_image(size);
+	const auto milliseconds = Benchmark::median_milliseconds(repetitions, [&] {
+		const auto chain = AssetManager::MipChain::generate(rgba, size, size, settings);
+		Benchmark::do_not_optimise(chain.back().texels.front());
+	});
+
+	// Throughput is measured against the base image, which is what an importer has to push through.
+	const auto megabytes = static_cast<double>(rgba.size()) / (1024.0 * 1024.0);
+	const auto throughput = fmt::format("({:.1f} MB/s)", megabytes / (milliseconds / 1000.0));
+	Benchmark::report(fmt::format("mip chain {}x{}", size, size), variant, milliseconds, throughput);
+}
+
+int main()
+{
+	using AssetManager::MipChainSettings;
+	using AssetManager::MipFilter;
+
+	for (const auto size : std::array<std::uint32_t, 3> { 256, 1024, 4096 }) {
+		generate(size, MipChainSettings { .filter = MipFilter::Box, .srgb = false, .premultiply_alpha = false }, "box / linear");
+		generate(size, MipChainSettings { .filter = MipFilter::Box, .srgb = true, .premultiply_alpha = true }, "box / sRGB, alpha");
+		generate(size, MipChainSettings { .filter = MipFilter::Kaiser, .srgb = false, .premultiply_alpha = false }, "kaiser / linear");
+		generate(size, MipChainSettings { .filter = MipFilter::Kaiser, .srgb = true, .premultiply_alpha = true }, "kaiser / sRGB, alpha");
+	}
+
+	return 0;
+}
@@ -0,0 +1,97 @@
+#include "Benchmark.hpp"
+#include "compiler/ShaderCompiler.hpp"
+#include "compiler/SpirvCache.hpp"
+#include "core/Logger.hpp"
+#include "filesystem/FileSystem.hpp"
+#include "utilities/FileInputOutput.hpp"
+#include "utilities/JobSystem.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+static constexpr std::size_t repetitions = 5;
+
+struct ShaderPair {
+	std::string name;
+	std::filesystem::path vertex;
+	std::filesystem::path fragment;
+};
+
+static std::vector<ShaderPair> find_shader_pairs(const std::filesystem::path& directory)
+{
+	std::vector<ShaderPair> pairs;
+	for (const auto& file : std::filesystem::directory_iterator(directory)) {
+		if (file.path().extension() != ".vert") {
+			continue;
+		}
+
+		auto fragment = file.path();
+		fragment.replace_extension(".frag");
+		if (std::filesystem::exists(fragment)) {
+			pairs.push_back({ file.path().stem().string(), file.path(), fragment });
+		}
+	}
+	std::sort(pairs.begin(), pairs.end(), [](const auto& left, const auto& right) { return left.name < right.name; });
+	return pairs;
+}
+
+static void compile_all(const AssetManager::ShaderCompiler& compiler, const std::vector<ShaderPair>& pairs, bool parallel)
+{
+	const auto compile = [&](std::size_t index) {
+		const auto& [name, vertex, fragment] = pairs[index];
+		const auto [vertex_stage, fragment_stage] = compiler.compile_to_spirv(name, vertex, fragment);
+		Benchmark::do_not_optimise(vertex_stage.spirv.size() + fragment_stage.spirv.size());
+	};
+
+	if (parallel) {
+		AssetManager::JobSystem::the().parallel_for(0, pairs.size(), 1, compile);
+		return;
+	}
+	for (std::size_t i = 0; i < pairs.size(); i++) {
+		compile(i);
+	}
+}
+
+static void measure(const AssetManager::ShaderCompiler& compiler, const std::vector<ShaderPair>& pairs, bool parallel, std::string_view variant)
+{
+	const auto milliseconds = Benchmark::median_milliseconds(repetitions, [&] { compile_all(compiler, pairs, parallel); });
+	const auto throughput = fmt::format("({:.1f} shaders/s)", static_cast<double>(pairs.size()) / (milliseconds / 1000.0));
+	Benchmark::report(fmt::format("compile {} shaders", pairs.size()), variant, milliseconds, throughput);
+}
+
+int main()
+{
+	Alabaster::Logger::init();
+
+	const auto root = Alabaster::IO::get_resource_root();
+	if (!root) {
+		Alabaster::Log::error("[ShaderCompileBenchmark] Run from the repository root, the bundled shaders live in app/resources/shaders.");
+		return EXIT_FAILURE;
+	}
+	Alabaster::FileSystem::init_with_cwd(*root);
+
+	const auto pairs = find_shader_pairs(Alabaster::FileSystem::shaders());
+	if (pairs.empty()) {
+		Alabaster::Log::error("[ShaderCompileBenchmark] Found no shaders in {}.", Alabaster::FileSystem::shaders().string());
+		return EXIT_FAILURE;
+	}
+
+	const AssetManager::ShaderCompiler uncached;
+	measure(uncached, pairs, false, "uncached / sequential");
+	measure(uncached, pairs, true, "uncached / job system");
+
+	const auto cache_directory = std::filesystem::temp_directory_path() / "alabaster_shader_compile_benchmark";
+	std::filesystem::remove_all(cache_directory);
+	{
+		AssetManager::SpirvCache cache(cache_directory);
+		const AssetManager::ShaderCompiler cached(&cache);
+		compile_all(cached, pairs, true);
+		measure(cached, pairs, true, "warm spirv cache / job system");
+	}
+	std::filesystem::remove_all(cache_directory);
+
+	return EXIT_SUCCESS;
+}
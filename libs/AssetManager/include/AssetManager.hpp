@@ -2,5 +2,5 @@
 
 #include "cache/ResourceCache.hpp"
 #include "compiler/ShaderCompiler.hpp"
-#include "utilities/ThreadPool.hpp"
+#include "utilities/JobSystem.hpp"
 #include "watcher/FileWatcher.hpp"
@@ -1,7 +1,7 @@
 #pragma once
 
 namespace AssetManager {
-	class ThreadPool;
+	class JobSystem;
 	class ResourceCache;
 	class ShaderCompiler;
 	class FileWatcher;
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "filesystem/FileStamp.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace AssetManager {
+
+	using FileStamp = Alabaster::FileStamp;
+
+	struct AssetDependency {
+		std::string path;
+		FileStamp stamp;
+	};
+
+	struct AssetRecord {
+		std::string source;
+		FileStamp stamp;
+		std::uint32_t importer_version { 0 };
+		std::vector<std::string> artefacts;
+		std::vector<AssetDependency> dependencies;
+		/// @brief Seconds since the epoch.
+		std::int64_t imported_at { 0 };
+	};
+
+	struct AssetDatabaseStatistics {
+		std::uint32_t fresh { 0 };
+		std::uint32_t stale { 0 };
+		/// @brief Files whose size or modification time changed and whose contents had to be hashed.
+		std::uint32_t hashed { 0 };
+	};
+
+	/// @brief Persistent record of what was imported: the source of every asset, its contents, the importer version, the artefacts the
+	/// import produced and the other files it read. Importers consult it before doing any work, so only stale assets are imported again
+	/// and start up is proportional to what changed since the last run instead of to the number of assets.
+	/// Stored as a compact binary file, written by flush() and on destruction. Thread safe.
+	class AssetDatabase {
+	public:
+		explicit AssetDatabase(std::filesystem::path database_path);
+		~AssetDatabase();
+
+		AssetDatabase(const AssetDatabase&) = delete;
+		AssetDatabase& operator=(const AssetDatabase&) = delete;
+
+		/// @brief An asset is stale if it was never imported, was imported by another importer version, if the source or any of its
+		/// dependencies changed since, or if one of its artefacts is gone.
+		/// @param artefact the derived file the caller is about to read, the asset is stale if no import produced it
+		bool is_stale(const std::filesystem::path& source, std::uint32_t importer_version, const std::filesystem::path& artefact = {});
+
+		/// @brief Records a successful import of the source as it is on disk now. Artefacts from earlier imports of the same contents by
+		/// the same importer version are kept, a texture can be compressed into several formats and a shader stage into several variants.
+		/// They are dropped once a dependency both imports read changed, those have to be imported again.
+		void record_import(const std::filesystem::path& source, std::uint32_t importer_version,
+			const std::vector<std::filesystem::path>& artefacts, const std::vector<std::filesystem::path>& dependencies = {});
+
+		/// @brief Whether the contents of a file differ from what the last import of any asset reading it saw. Meant for file watcher
+		/// handlers, editors often write files without changing them. A file no import has read counts as changed.
+		bool changed(const std::filesystem::path& path);
+
+		[[nodiscard]] std::optional<AssetRecord> find(const std::filesystem::path& source) const;
+		void forget(const std::filesystem::path& source);
+
+		/// @brief Writes the database if any record changed.
+		void flush();
+
+		[[nodiscard]] std::size_t size() const;
+		[[nodiscard]] AssetDatabaseStatistics statistics() const;
+		void reset_statistics();
+
+		/// @param previous stamp of the same file, its hash is reused if the size and modification time did not change
+		/// @return nothing if the file cannot be read
+		static std::optional<FileStamp> stamp(const std::filesystem::path& path, const FileStamp* previous = nullptr);
+
+	private:
+		static std::string key(const std::filesystem::path& path);
+		/// @brief Whether the file still has the contents it had when the stamp was taken. Refreshes the stamp if only the size or
+		/// modification time changed.
+		bool matches(const std::string& path, FileStamp& recorded);
+		void read();
+
+		std::filesystem::path path;
+		mutable std::mutex mutex;
+		std::unordered_map<std::string, AssetRecord> records;
+		bool dirty { false };
+
+		std::atomic<std::uint32_t> fresh { 0 };
+		std::atomic<std::uint32_t> stale { 0 };
+		std::atomic<std::uint32_t> hashed { 0 };
+	};
+
+} // namespace AssetManager
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace Alabaster {
+	class Mesh;
+	class Shader;
+	class Texture;
+} // namespace Alabaster
+
+namespace AssetManager {
+
+	/// @brief Refers to an asset in an AssetPool by slot. Copying one never touches a reference count, so components store these.
+	/// The generation tells a handle to a released slot apart from a handle to whichever asset reused it.
+	template <typename T> struct Handle {
+		static constexpr std::uint32_t invalid_index = std::numeric_limits<std::uint32_t>::max();
+
+		std::uint32_t index { invalid_index };
+		std::uint32_t generation { 0 };
+
+		[[nodiscard]] constexpr bool valid() const { return index != invalid_index; }
+		constexpr explicit operator bool() const { return valid(); }
+		constexpr bool operator==(const Handle&) const = default;
+	};
+
+	using MeshHandle = Handle<Alabaster::Mesh>;
+	using ShaderHandle = Handle<Alabaster::Shader>;
+	using TextureHandle = Handle<Alabaster::Texture>;
+
+} // namespace AssetManager
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "cache/AssetHandle.hpp"
+#include "utilities/StringHash.hpp"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace AssetManager {
+
+	/// @brief Named assets of one type in a dense slot array. Lookups by name take a string_view and do not allocate,
+	/// lookups by handle are an index and a generation compare. Not synchronised, owned and used by the main thread.
+	template <typename T> class AssetPool {
+	public:
+		[[nodiscard]] std::optional<Handle<T>> find(std::string_view name) const
+		{
+			if (const auto found = names.find(name); found != names.end()) {
+				return found->second;
+			}
+			return std::nullopt;
+		}
+
+		[[nodiscard]] bool contains(std::string_view name) const { return names.contains(name); }
+
+		/// @return the asset, nullptr if the handle is invalid or its asset has been erased
+		[[nodiscard]] T* get(Handle<T> handle) const
+		{
+			const auto* slot = live_slot(handle);
+			return slot ? slot->asset.get() : nullptr;
+		}
+
+		/// @brief For callers that need to share ownership, e.g. a pipeline keeping its shader alive.
+		/// @return the asset, empty if the handle is invalid or its asset has been erased
+		[[nodiscard]] const std::shared_ptr<T>& shared(Handle<T> handle) const
+		{
+			static const std::shared_ptr<T> empty {};
+			const auto* slot = live_slot(handle);
+			return slot ? slot->asset : empty;
+		}
+
+		/// @return the name the asset was inserted under, empty if the handle is invalid or its asset has been erased
+		[[nodiscard]] std::string_view name(Handle<T> handle) const
+		{
+			const auto* slot = live_slot(handle);
+			return slot ? std::string_view { slot->name } : std::string_view {};
+		}
+
+		/// @return the handle of the new asset, or of the asset already called name (in which case asset is dropped)
+		Handle<T> insert(std::string_view name, std::shared_ptr<T> asset)
+		{
+			if (const auto found = find(name)) {
+				return *found;
+			}
+
+			std::uint32_t index = 0;
+			if (free_slots.empty()) {
+				index = static_cast<std::uint32_t>(slots.size());
+				slots.emplace_back();
+			} else {
+				index = free_slots.back();
+				free_slots.pop_back();
+			}
+
+			auto& slot = slots[index];
+			slot.asset = std::move(asset);
+			slot.name = name;
+			slot.occupied = true;
+			const Handle<T> handle { .index = index, .generation = slot.generation };
+			names.try_emplace(slot.name, handle);
+			return handle;
+		}
+
+		/// @brief Swaps the asset behind a handle. Every holder of the handle sees the new asset, e.g. after a reload.
+		/// @return the previous asset, empty if the handle is stale
+		std::shared_ptr<T> replace(Handle<T> handle, std::shared_ptr<T> asset)
+		{
+			auto* slot = live_slot(handle);
+			return slot ? std::exchange(slot->asset, std::move(asset)) : nullptr;
+		}
+
+		/// @return the handle of the asset called name, which now refers to asset
+		Handle<T> assign(std::string_view name, std::shared_ptr<T> asset)
+		{
+			if (const auto found = find(name)) {
+				replace(*found, std::move(asset));
+				return *found;
+			}
+			return insert(name, std::move(asset));
+		}
+
+		/// @brief Releases the slot, outstanding handles to it resolve to nothing from now on.
+		void erase(Handle<T> handle)
+		{
+			auto* slot = live_slot(handle);
+			if (!slot) {
+				return;
+			}
+
+			names.erase(slot->name);
+			slot->asset.reset();
+			slot->name.clear();
+			slot->occupied = false;
+			slot->generation++;
+			free_slots.push_back(handle.index);
+		}
+
+		void clear()
+		{
+			for (std::uint32_t index = 0; index < slots.size(); index++) {
+				erase({ .index = index, .generation = slots[index].generation });
+			}
+		}
+
+		/// @brief Calls func(T&) for every asset.
+		template <typename Func> void for_each(Func&& func) const
+		{
+			for (const auto& slot : slots) {
+				if (slot.asset) {
+					func(*slot.asset);
+				}
+			}
+		}
+
+		[[nodiscard]] std::size_t size() const { return names.size(); }
+
+	private:
+		struct Slot {
+			std::shared_ptr<T> asset;
+			std::string name;
+			std::uint32_t generation { 0 };
+			bool occupied { false };
+		};
+
+		const Slot* live_slot(Handle<T> handle) const
+		{
+			if (handle.index >= slots.size()) {
+				return nullptr;
+			}
+			const auto& slot = slots[handle.index];
+			return slot.occupied && slot.generation == handle.generation ? &slot : nullptr;
+		}
+
+		Slot* live_slot(Handle<T> handle) { return const_cast<Slot*>(std::as_const(*this).live_slot(handle)); }
+
+		std::vector<Slot> slots;
+		std::vector<std::uint32_t> free_slots;
+		std::unordered_map<std::string, Handle<T>, StringHash, std::equal_to<>> names;
+	};
+
+} // namespace AssetManager
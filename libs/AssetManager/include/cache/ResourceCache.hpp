@@ -1,14 +1,19 @@
 #pragma once
 
+#include "cache/AssetDatabase.hpp"
 #include "cache/ShaderCache.hpp"
 #include "cache/TextureCache.hpp"
 
 #include <filesystem>
+#include <functional>
+#include <optional>
 #include <string_view>
 #include <type_traits>
 
 namespace AssetManager {
 
+	class FileWatcher;
+
 	class ResourceCache {
 	public:
 		ResourceCache(const ResourceCache&) = delete;
@@ -20,31 +25,89 @@ namespace AssetManager {
 
 		static ResourceCache& the();
 
-		const std::shared_ptr<Alabaster::Texture>& texture(const std::string& name);
-		const std::shared_ptr<Alabaster::Shader>& shader(const std::string& name);
+		/// @brief Returns immediately. Textures that have not been used before sample a placeholder until they have streamed in.
+		/// @param name filename of a texture in the textures, fonts or editor directories
+		/// @return nothing if there is no such texture
+		std::optional<TextureHandle> find_texture(std::string_view name);
+		/// @brief Streams an image from anywhere on disk, see find_texture.
+		TextureHandle stream_texture(const std::filesystem::path& full_path, const Alabaster::TextureProperties& props);
+		std::optional<ShaderHandle> find_shader(std::string_view name) const { return shader_cache.find(name); }
+		/// @brief Compiles the variant the first time it is asked for, blocking until it is done.
+		/// @return nothing if there is no such shader or the variant does not compile
+		std::optional<ShaderHandle> find_shader_variant(const ShaderVariantKey& key) { return shader_cache.variant(key); }
+		/// @brief Loads the model the first time it is asked for, blocking until it is uploaded.
+		/// @param name path of a model relative to the models directory
+		/// @return nothing if there is no such model or it could not be loaded
+		std::optional<MeshHandle> find_mesh(std::string_view name);
+
+		/// @return the asset, nullptr if the handle is stale. Looking a texture up counts as using it, see TextureCache::get.
+		Alabaster::Texture* get(TextureHandle handle) { return texture_cache.get(handle); }
+		Alabaster::Shader* get(ShaderHandle handle) const { return shader_cache.get(handle); }
+		Alabaster::Mesh* get(MeshHandle handle) const { return meshes.get(handle); }
+
+		/// @brief Shared ownership for long lived users such as pipelines and editor icons, throws if the asset does not exist.
+		std::shared_ptr<Alabaster::Texture> texture(std::string_view name);
+		std::shared_ptr<Alabaster::Texture> texture(const std::filesystem::path& full_path, const Alabaster::TextureProperties& props);
+		std::shared_ptr<Alabaster::Shader> shader(std::string_view name);
+		/// @param keywords defined as 1 while compiling, so the variant only contains the branches it needs
+		std::shared_ptr<Alabaster::Shader> shader(std::string_view name, std::vector<std::string> keywords);
+
+		/// @brief Recompiles shaders in the background when one of their sources or includes changes on disk. Writes that leave the
+		/// contents as the asset database last imported them are ignored.
+		void register_file_watcher(FileWatcher& watcher);
+
+		/// @brief Swaps in shaders that finished reloading and notifies the listeners. Call between frames.
+		/// @return the applied reloads, whose previous shaders the caller must retire
+		std::vector<ShaderReload> apply_shader_reloads();
+
+		std::uint32_t add_shader_reload_listener(std::function<void(const ShaderReload&)> listener);
+		void remove_shader_reload_listener(std::uint32_t id);
+
+		/// @brief Uploads textures that finished decoding and notifies the listeners, which should rewrite descriptor sets that were
+		/// written with the placeholder. Call between frames.
+		/// @return the textures that became resident
+		std::vector<std::shared_ptr<Alabaster::Texture>> apply_texture_streams();
+
+		std::uint32_t add_texture_stream_listener(std::function<void(const std::shared_ptr<Alabaster::Texture>&)> listener);
+		void remove_texture_stream_listener(std::uint32_t id);
+
+		/// @brief Evicts the least recently used textures that do not fit the texture memory budget and notifies the texture stream
+		/// listeners, whose descriptor sets now have to sample the placeholder. Call once per frame, between frames.
+		/// @return the images the evicted textures gave up. They are not released, the caller retires them once the GPU is done with them.
+		std::vector<std::shared_ptr<Alabaster::Image>> evict_textures();
+
+		void set_texture_memory_budget(VkDeviceSize bytes) { texture_cache.set_memory_budget(bytes); }
+		[[nodiscard]] const TextureResidencyStatistics& texture_residency() const { return texture_cache.statistics(); }
 
 	private:
 		ResourceCache();
 
+		// Declared first, the caches below import through it.
+		AssetDatabase asset_database;
 		TextureCache texture_cache;
 		ShaderCache shader_cache;
+		AssetPool<Alabaster::Mesh> meshes;
+
+		std::unordered_map<std::uint32_t, std::function<void(const ShaderReload&)>> shader_reload_listeners;
+		std::unordered_map<std::uint32_t, std::function<void(const std::shared_ptr<Alabaster::Texture>&)>> texture_stream_listeners;
+		std::uint32_t next_listener_id { 0 };
 	};
 
 	inline auto& the() { return ResourceCache::the(); }
 
 	template <typename T> struct get_asset {
-		const std::shared_ptr<T>& operator()(const std::string& name) const = delete;
+		std::shared_ptr<T> operator()(std::string_view name) const = delete;
 	};
 
 	template <> struct get_asset<Alabaster::Texture> {
-		const std::shared_ptr<Alabaster::Texture>& operator()(const std::string& name) const { return the().texture(name); }
+		std::shared_ptr<Alabaster::Texture> operator()(std::string_view name) const { return the().texture(name); }
 	};
 
 	template <> struct get_asset<Alabaster::Shader> {
-		const std::shared_ptr<Alabaster::Shader>& operator()(const std::string& name) const { return the().shader(name); }
+		std::shared_ptr<Alabaster::Shader> operator()(std::string_view name) const { return the().shader(name); }
 	};
 
-	template <typename T, typename String> const std::shared_ptr<T>& asset(String&& name)
+	template <typename T, typename String> std::shared_ptr<T> asset(String&& name)
 	{
 		try {
 			return get_asset<T>()(name);
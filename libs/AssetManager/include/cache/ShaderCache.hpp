@@ -1,50 +1,79 @@
 #pragma once
 
+#include "cache/AssetPool.hpp"
 #include "cache/BaseCache.hpp"
 #include "compiler/ShaderCompiler.hpp"
+#include "compiler/ShaderDependencyGraph.hpp"
+#include "compiler/ShaderVariant.hpp"
+#include "compiler/SpirvCache.hpp"
+#include "filesystem/FileSystem.hpp"
 #include "graphics/Shader.hpp"
 
+#include <atomic>
+#include <mutex>
 #include <unordered_map>
 
 namespace AssetManager {
 
+	struct ShaderReload {
+		std::string name;
+		std::shared_ptr<Alabaster::Shader> previous;
+		std::shared_ptr<Alabaster::Shader> shader;
+	};
+
 	class ShaderCache {
 	public:
-		ShaderCache() = default;
+		explicit ShaderCache(AssetDatabase* asset_database = nullptr)
+			: spirv_cache(Alabaster::FileSystem::cache("shaders"), asset_database)
+		{
+		}
 		~ShaderCache() = default;
 
+		/// @brief Compiles every shader in the directory, then the variants listed in its variants.txt.
 		void load_from_directory(const std::filesystem::path& shader_directory_path);
 
-		void destroy()
-		{
-			for (auto& [key, shader] : shaders) {
-				shader->destroy();
-			}
-		}
+		/// @brief Compiles the variant the first time it is asked for, blocking until it is done. Call from the main thread.
+		/// @return nothing if there is no such shader or the variant does not compile
+		std::optional<ShaderHandle> variant(const ShaderVariantKey& key);
 
-		[[nodiscard]] const std::shared_ptr<Alabaster::Shader>& get_from_cache(const std::string& name)
-		{
-			if (shaders.contains(name)) {
-				return shaders.at(name);
-			}
+		/// @brief Compiles the variants that have not been asked for yet in parallel. Call from the main thread.
+		void prewarm(const std::vector<ShaderVariantKey>& keys);
 
-			throw Alabaster::AlabasterException("Could not find shader");
-		}
+		void destroy();
 
-		template <typename... Args> [[nodiscard]] bool add_to_cache(const std::string& name, Args&&... args)
-		{
-			if (shaders.contains(name)) {
-				return false;
-			}
-			shaders.try_emplace(name, std::forward<Args>(args)...);
-			return true;
-		}
+		/// @brief Recompiles every shader that reads the file on the job system. Safe to call from the file watcher thread.
+		/// @param changed_file a shader stage or an include
+		void reload_dependants(const std::filesystem::path& changed_file);
+
+		/// @brief Swaps finished reloads into the cache, handles to the shaders stay valid and resolve to the reloaded ones.
+		/// Call from the main thread between frames.
+		/// @return the swapped shaders. The previous versions are not destroyed, the caller retires them once the GPU is done with them.
+		std::vector<ShaderReload> take_finished_reloads();
+
+		[[nodiscard]] std::optional<ShaderHandle> find(std::string_view name) const { return shaders.find(name); }
+		[[nodiscard]] Alabaster::Shader* get(ShaderHandle handle) const { return shaders.get(handle); }
+		[[nodiscard]] const std::shared_ptr<Alabaster::Shader>& shared(ShaderHandle handle) const { return shaders.shared(handle); }
 
 	private:
+		struct ShaderSources {
+			std::filesystem::path vertex;
+			std::filesystem::path fragment;
+			std::vector<std::string> keywords;
+		};
+
 		std::vector<std::pair<std::filesystem::path, std::filesystem::path>> extract_into_pairs_of_shaders(
 			const std::vector<std::string>& sorted_shaders_in_directory) const;
 
-		std::unordered_map<std::string, std::shared_ptr<Alabaster::Shader>> shaders;
+		AssetPool<Alabaster::Shader> shaders;
+		SpirvCache spirv_cache;
+		ShaderDependencyGraph dependency_graph;
+
+		std::mutex reload_mutex;
+		std::unordered_map<std::string, ShaderSources> sources;
+		std::unordered_map<std::string, std::uint64_t> reload_revisions;
+		std::unordered_map<std::string, std::shared_ptr<Alabaster::Shader>> finished_reloads;
+		std::atomic<std::uint32_t> reloads_in_flight { 0 };
+		bool accepting_reloads { true };
 	};
 
 } // namespace AssetManager
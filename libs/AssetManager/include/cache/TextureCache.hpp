@@ -1,48 +1,162 @@
 #pragma once
 
+#include "cache/AssetPool.hpp"
 #include "cache/BaseCache.hpp"
-#include "core/exceptions/AlabasterException.hpp"
+#include "compiler/TextureCompiler.hpp"
+#include "graphics/StagingRing.hpp"
 #include "graphics/Texture.hpp"
 
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace AssetManager {
 
+	struct TextureEviction {
+		std::shared_ptr<Alabaster::Texture> texture;
+		std::shared_ptr<Alabaster::Image> image;
+	};
+
+	struct TextureResidencyStatistics {
+		/// @brief Lookups of resident textures and of textures still sampling the placeholder.
+		std::uint64_t hits { 0 };
+		std::uint64_t misses { 0 };
+		std::uint64_t evictions { 0 };
+		VkDeviceSize resident_bytes { 0 };
+		/// @brief What the textures were allowed to occupy the last time the budget was enforced.
+		VkDeviceSize budget_bytes { 0 };
+
+		[[nodiscard]] double hit_rate() const
+		{
+			const auto lookups = hits + misses;
+			return lookups > 0 ? static_cast<double>(hits) / static_cast<double>(lookups) : 1.0;
+		}
+	};
+
 	class TextureCache {
 	public:
-		TextureCache() = default;
+		struct IndexedImage {
+			std::filesystem::path path;
+			Alabaster::ImageFormat compression { Alabaster::ImageFormat::None };
+		};
+
+		explicit TextureCache(AssetDatabase* asset_database = nullptr);
 		~TextureCache() = default;
 
 		void load_from_directory(const std::filesystem::path& texture_path,
 			const std::unordered_set<std::string, StringHash, std::equal_to<>>& include_extensions = { ".tga", ".png", ".jpeg", ".jpg" });
 
-		void destroy() { textures.clear(); }
+		/// @brief Remembers where the images in a directory live so they can be streamed by filename, without reading any pixels.
+		/// @param compression block format the images are streamed in, see TextureProperties::compression
+		void index_directory(const std::filesystem::path& directory,
+			const std::unordered_set<std::string, StringHash, std::equal_to<>>& include_extensions,
+			Alabaster::ImageFormat compression = Alabaster::ImageFormat::None);
 
-		[[nodiscard]] const std::shared_ptr<Alabaster::Texture>& get_from_cache(const std::string& name)
-		{
-			if (textures.contains(name)) {
-				return textures[name];
-			}
+		/// @brief Loads the texture that streamed handles sample until their own image is resident. Blocks until it is uploaded.
+		void load_placeholder(const std::filesystem::path& full_path);
 
-			throw Alabaster::AlabasterException("Could not find texture.");
-		}
+		/// @brief Returns the cached texture, or a texture showing the placeholder whose image is decoded on the job system.
+		/// Pending decodes are picked most recently used first. 8 bit images are read from (or compressed into) containers in the
+		/// texture cache directory, together with their prebuilt mip chain.
+		/// @param name cache key, the filename
+		/// @param full_path image to stream
+		/// @param props properties the streamed image is created with
+		/// @return the texture, resident or not
+		TextureHandle stream(std::string_view name, const std::filesystem::path& full_path, const Alabaster::TextureProperties& props);
 
-		template <typename... Args> [[nodiscard]] bool add_to_cache(const std::string& name, Args&&... args)
-		{
-			if (textures.contains(name))
-				return false;
-			try {
-				textures.try_emplace(name, std::forward<Args>(args)...);
-			} catch (const std::exception& exc) {
-				throw Alabaster::AlabasterException(exc.what());
-			}
-			return true;
-		}
+		/// @brief Moves a texture to the front of the streaming queues.
+		void touch(std::string_view name);
+
+		/// @brief Uploads decoded images, most recently used first, in one submission and makes their handles resident.
+		/// Call between frames, from the thread that owns the graphics queue.
+		/// @return the handles that became resident
+		std::vector<std::shared_ptr<Alabaster::Texture>> make_streams_resident();
+
+		[[nodiscard]] bool contains(std::string_view name) const { return textures.contains(name); }
+		[[nodiscard]] std::optional<IndexedImage> find_indexed(std::string_view name) const;
+
+		/// @brief Caps the device memory resident textures may occupy. The device local budget reported by VMA, less what everything
+		/// else has allocated, applies on top of it.
+		void set_memory_budget(VkDeviceSize bytes) { memory_budget = bytes; }
+
+		/// @brief Evicts the least recently used textures until the resident ones fit the budget. Evicted textures sample the placeholder
+		/// and stream back in the next time they are looked up. Textures shared outside the cache, by pipelines or editor icons, and
+		/// textures used by a frame that may still be in flight are never evicted. Call once per frame, between frames.
+		/// @return the evicted textures and the images they gave up, which the caller releases once no frame in flight samples them
+		std::vector<TextureEviction> enforce_budget();
+
+		[[nodiscard]] const TextureResidencyStatistics& statistics() const { return residency_statistics; }
+
+		void destroy();
+
+		[[nodiscard]] std::optional<TextureHandle> find(std::string_view name) const { return textures.find(name); }
+		/// @brief Marks the texture as used this frame. An evicted texture starts streaming back in and samples the placeholder meanwhile.
+		/// @return the texture, nullptr if the handle is stale
+		[[nodiscard]] Alabaster::Texture* get(TextureHandle handle);
+		[[nodiscard]] const std::shared_ptr<Alabaster::Texture>& shared(TextureHandle handle) const { return textures.shared(handle); }
 
 	private:
-		std::unordered_map<std::string, std::shared_ptr<Alabaster::Texture>> textures;
+		struct StreamRequest {
+			std::filesystem::path path;
+			std::optional<BlockFormat> container;
+			std::uint64_t last_used { 0 };
+		};
+
+		struct DecodedStream {
+			std::string name;
+			Alabaster::Texture::DecodedImage decoded;
+			std::optional<CompressedTexture> compressed;
+			std::uint64_t last_used { 0 };
+
+			std::size_t size() const { return compressed ? compressed->data.size() : decoded.pixels.size; }
+		};
+
+		struct Residency {
+			TextureHandle handle {};
+			std::uint64_t last_used_frame { 0 };
+			/// @brief Zero while the texture samples the placeholder.
+			VkDeviceSize bytes { 0 };
+			bool evicted { false };
+		};
+
+		/// @brief Queues the image for decoding on the job system, see stream.
+		void request_stream(std::string_view name, const std::filesystem::path& full_path, const Alabaster::TextureProperties& props);
+		void decode_most_recent_stream();
+
+		Residency& residency_of(TextureHandle handle);
+		/// @brief Accounts for the image the texture behind handle now owns.
+		void track_resident(TextureHandle handle);
+
+		AssetPool<Alabaster::Texture> textures;
 		std::filesystem::path texture_path;
+		std::unique_ptr<Alabaster::StagingRing> staging_ring;
+
+		std::unordered_map<std::string, IndexedImage, StringHash, std::equal_to<>> indexed;
+		TextureCompiler texture_compiler;
+		std::shared_ptr<Alabaster::Texture> placeholder;
+		std::uint64_t use_clock { 0 };
+
+		std::mutex stream_mutex;
+		std::unordered_map<std::string, StreamRequest, StringHash, std::equal_to<>> pending_streams;
+		std::vector<DecodedStream> decoded_streams;
+		std::atomic<std::uint32_t> streams_in_flight { 0 };
+		bool accepting_streams { true };
+
+		std::vector<Residency> residency;
+		TextureResidencyStatistics residency_statistics;
+		VkDeviceSize memory_budget { std::numeric_limits<VkDeviceSize>::max() };
+		std::uint64_t frame { 0 };
+
+		static constexpr VkDeviceSize staging_ring_capacity = 64 * 1024 * 1024;
+		// Copying into the ring happens between frames, so only this much is uploaded per frame.
+		static constexpr VkDeviceSize stream_upload_budget = 16 * 1024 * 1024;
+		// Frames in flight may still sample textures used this recently.
+		static constexpr std::uint64_t eviction_grace_frames = 3;
 	};
 
 } // namespace AssetManager
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace AssetManager {
+
+	enum class BlockFormat : std::uint32_t {
+		/// @brief Uncompressed texels in row major order, for images that are only cached for their prebuilt mip chain.
+		RGBA8 = 0,
+		BC1 = 1,
+		BC3 = 3,
+		BC5 = 5,
+		BC7 = 7,
+	};
+
+	/// @brief CPU encoders (and reference decoders) for the BCn block formats. Every block covers 4x4 texels,
+	/// input and output texels are RGBA8 in row major order.
+	/// BC1 and BC3 fit the colour endpoints along the principal axis and refine them with a least squares pass,
+	/// BC5 stores red and green as two BC4 blocks, BC7 uses mode 6 (one subset, RGBA endpoints with p-bits, 4 bit indices).
+	namespace BlockCompression {
+
+		static constexpr std::uint32_t block_dimension = 4;
+		static constexpr std::uint32_t texels_per_block = block_dimension * block_dimension;
+
+		/// @return size of one 4x4 block in bytes, 8 for BC1, 64 for RGBA8 and 16 for the others
+		std::size_t block_size(BlockFormat format);
+
+		/// @return size in bytes of an image of the given size, partial blocks at the edges are rounded up
+		std::size_t compressed_size(BlockFormat format, std::uint32_t width, std::uint32_t height);
+
+		/// @param texels 16 RGBA8 texels
+		/// @param block block_size(format) bytes
+		void encode_block(BlockFormat format, const std::uint8_t* texels, std::uint8_t* block);
+
+		/// @param block block_size(format) bytes
+		/// @param texels receives 16 RGBA8 texels. BC5 decodes to (r, g, 0, 255).
+		void decode_block(BlockFormat format, const std::uint8_t* block, std::uint8_t* texels);
+
+		/// @brief Encodes a whole image, rows of blocks are spread over the job system.
+		/// @param rgba width * height RGBA8 texels
+		/// @return compressed_size(format, width, height) bytes
+		std::vector<std::uint8_t> encode(BlockFormat format, std::span<const std::uint8_t> rgba, std::uint32_t width, std::uint32_t height);
+
+		/// @return width * height RGBA8 texels
+		std::vector<std::uint8_t> decode(BlockFormat format, std::span<const std::uint8_t> blocks, std::uint32_t width, std::uint32_t height);
+
+	} // namespace BlockCompression
+
+} // namespace AssetManager
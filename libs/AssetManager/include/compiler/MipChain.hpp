@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace AssetManager {
+
+	enum class MipFilter : std::uint32_t {
+		Box,
+		Kaiser,
+	};
+
+	struct MipChainSettings {
+		MipFilter filter { MipFilter::Kaiser };
+		/// @brief Colour channels are sRGB encoded and filtered in linear space. Turn off for data such as normal maps.
+		bool srgb { true };
+		/// @brief Colour is weighted by alpha while filtering, so fully transparent texels do not bleed into their neighbours.
+		bool premultiply_alpha { true };
+	};
+
+	struct MipLevel {
+		std::uint32_t width { 0 };
+		std::uint32_t height { 0 };
+		std::vector<std::uint8_t> texels;
+	};
+
+	/// @brief CPU mip chain generation for RGBA8 images, done once at import time so the chain can be persisted with the texture.
+	/// Every level is filtered from the previous one in linear, premultiplied floating point and only converted back to 8 bits on output.
+	/// Rows are spread over the job system and texels are processed four channels at a time, with SSE where it is available.
+	namespace MipChain {
+
+		/// @return levels of a full chain down to the smaller dimension reaching one texel, the same count Texture uses
+		std::uint32_t level_count(std::uint32_t width, std::uint32_t height);
+
+		/// @param rgba width * height RGBA8 texels
+		/// @return every level of the chain, starting with a copy of the base image
+		std::vector<MipLevel> generate(
+			std::span<const std::uint8_t> rgba, std::uint32_t width, std::uint32_t height, const MipChainSettings& settings);
+
+	} // namespace MipChain
+
+} // namespace AssetManager
@@ -2,23 +2,52 @@
 
 #include "graphics/Shader.hpp"
 
+#include <cstdint>
 #include <filesystem>
-#include <future>
 #include <string>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace AssetManager {
 
+	class SpirvCache;
+	struct CompiledStage;
+	class ShaderDependencyGraph;
+
+	struct ShaderCompileOptions {
+		std::vector<std::pair<std::string, std::string>> macro_definitions {};
+		/// @brief Release builds always optimise.
+		bool optimise { false };
+
+		/// @brief Hash of everything that influences the generated SPIR-V apart from the source, including the SPIR-V target version.
+		std::uint64_t hash() const;
+	};
+
 	class ShaderCompiler {
 	public:
-		ShaderCompiler() = default;
+		explicit ShaderCompiler(
+			SpirvCache* spirv_cache = nullptr, ShaderDependencyGraph* dependency_graph = nullptr, ShaderCompileOptions compile_options = {})
+			: cache(spirv_cache)
+			, dependencies(dependency_graph)
+			, options(std::move(compile_options))
+		{
+		}
 
 		Alabaster::Shader compile(
 			const std::string& name, const std::filesystem::path& vertex_path, const std::filesystem::path& fragment_path) const;
 
-	private:
-		std::tuple<std::vector<std::uint32_t>, std::vector<std::uint32_t>> compile_to_spirv(
+		/// @brief Compiles both stages concurrently on the job system without creating a Shader, which needs a device.
+		/// Safe to call from several threads, each worker reuses its own shaderc compiler.
+		std::tuple<CompiledStage, CompiledStage> compile_to_spirv(
 			const std::string& name, const std::filesystem::path& vertex, const std::filesystem::path& fragment) const;
+
+	private:
+		CompiledStage compile_stage(const std::string& name, const std::filesystem::path& path, std::uint32_t stage) const;
+
+		SpirvCache* cache { nullptr };
+		ShaderDependencyGraph* dependencies { nullptr };
+		ShaderCompileOptions options;
 	};
 } // namespace AssetManager
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace AssetManager {
+
+	/// @brief Maps every file a shader stage reads (the stage source and everything it #includes) back to the shader that owns the stage,
+	/// so that editing a shared include only recompiles the shaders that actually depend on it.
+	/// Edges are replaced each time a stage is preprocessed, which keeps the graph correct when includes are added or removed.
+	/// Stages are tracked per shader, so variants compiled from the same file keep their own includes.
+	class ShaderDependencyGraph {
+	public:
+		void record(
+			const std::string& shader_name, const std::filesystem::path& stage_path, const std::vector<std::filesystem::path>& included_files);
+
+		/// @brief All shaders that read the file, directly or through an include.
+		/// @param file changed file
+		/// @return shader names, sorted and without duplicates
+		std::vector<std::string> dependants(const std::filesystem::path& file) const;
+
+	private:
+		static std::string normalise(const std::filesystem::path& path);
+
+		mutable std::mutex mutex;
+		std::unordered_map<std::string, std::string> stage_owners;
+		std::unordered_map<std::string, std::vector<std::string>> stage_files;
+		std::unordered_map<std::string, std::unordered_set<std::string>> file_stages;
+	};
+
+} // namespace AssetManager
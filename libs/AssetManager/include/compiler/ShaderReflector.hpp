@@ -1,34 +1,21 @@
 #pragma once
 
-#include "graphics/PushConstantRange.hpp"
+#include "graphics/ShaderReflection.hpp"
 
-#include <memory>
-#include <spirv-cross/spirv_glsl.hpp>
+#include <cstdint>
 #include <vector>
-#include <vulkan/vulkan.h>
 
 namespace AssetManager {
 
-	struct UniformBufferDefinition {
-		std::string_view name;
-		std::uint32_t size;
-		std::uint32_t member_count;
-		std::uint32_t binding;
-		std::uint32_t descriptor_set;
-	};
-
-	struct ShaderReflectionData {
-		std::vector<Alabaster::PushConstantRange> push_constant_ranges;
-		std::vector<UniformBufferDefinition> uniform_buffers;
-	};
-
+	/// @brief Reads the descriptor bindings and push constant blocks a single stage declares from its SPIR-V.
 	class ShaderReflector {
 	public:
-		explicit ShaderReflector(std::string shader_file_name, const std::vector<std::uint32_t>& spirv);
+		explicit ShaderReflector(const std::vector<std::uint32_t>& spirv);
+
+		const Alabaster::ShaderReflection& reflection() const { return reflection_data; }
 
 	private:
-		std::unique_ptr<spirv_cross::CompilerGLSL> reflector;
-		ShaderReflectionData reflection_data;
+		Alabaster::ShaderReflection reflection_data;
 	};
 
 } // namespace AssetManager
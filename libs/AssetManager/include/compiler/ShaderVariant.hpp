@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace AssetManager {
+
+	/// @brief Names a shader compiled with a set of keywords, each of which is defined as 1 while compiling.
+	/// Keywords are sorted and deduplicated, so any ordering of the same set names the same variant.
+	struct ShaderVariantKey {
+		explicit ShaderVariantKey(std::string shader_name, std::vector<std::string> keyword_defines = {});
+
+		/// @return the name the variant is cached under, e.g. mesh_light[NORMAL_MAP,UNLIT], or the shader name without keywords
+		std::string name() const;
+
+		bool operator==(const ShaderVariantKey&) const = default;
+
+		std::string shader;
+		std::vector<std::string> keywords;
+	};
+
+	/// @brief Every line of a variant manifest names a shader followed by its keywords, separated by whitespace. '#' starts a comment.
+	std::vector<ShaderVariantKey> parse_variant_manifest(std::string_view manifest);
+
+} // namespace AssetManager
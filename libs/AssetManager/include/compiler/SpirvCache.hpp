@@ -0,0 +1,102 @@
+#pragma once
+
+#include "graphics/ShaderReflection.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace AssetManager {
+
+	class AssetDatabase;
+
+	struct SpirvCacheStatistics {
+		std::uint32_t hits { 0 };
+		std::uint32_t misses { 0 };
+		double load_milliseconds { 0.0 };
+		double compile_milliseconds { 0.0 };
+	};
+
+	struct CompiledStage {
+		std::vector<std::uint32_t> spirv;
+		Alabaster::ShaderReflection reflection;
+	};
+
+	/// @brief On-disk, content addressed cache of compiled SPIR-V.
+	/// Blobs are stored as <key>.spv where the key hashes the source, the contents of its includes, the compile options and the SPIR-V target.
+	/// The reflected interface of each blob is stored next to it as <key>.reflection, so a warm start does not reflect again.
+	/// A manifest maps each source file and set of options to its last key together with the hashes of the source and every file it
+	/// includes, which lets a warm start find the blob without running the preprocessor. Shader variants each get their own entry.
+	/// With an asset database, stored blobs are recorded as imports of their stage and includes the database vouches for are not hashed.
+	class SpirvCache {
+	public:
+		struct IncludedFile {
+			std::string path;
+			std::uint64_t hash;
+		};
+
+		struct Entry {
+			std::uint32_t stage { 0 };
+			std::uint64_t options_hash { 0 };
+			std::uint64_t source_hash { 0 };
+			std::uint64_t key { 0 };
+			std::vector<IncludedFile> includes;
+		};
+
+		explicit SpirvCache(std::filesystem::path directory, AssetDatabase* asset_database = nullptr);
+		~SpirvCache();
+
+		/// @brief Warm path lookup. Succeeds if the manifest entry for the source was produced with the same options
+		/// and neither the source nor any of its includes changed since.
+		/// @param included_files receives the files the cached stage included, on success
+		std::optional<CompiledStage> find(const std::filesystem::path& source_path, std::uint32_t stage, std::uint64_t options_hash,
+			std::uint64_t source_hash, std::vector<std::filesystem::path>& included_files);
+
+		/// @brief Content addressed lookup. Blobs stored without a reflection are reflected here and the reflection is written back.
+		std::optional<CompiledStage> load(std::uint64_t key);
+
+		void store(const std::filesystem::path& source_path, Entry entry, const CompiledStage& compiled);
+
+		/// @brief Points the manifest entry at an already stored blob.
+		void update(const std::filesystem::path& source_path, Entry entry);
+
+		/// @brief Writes the manifest if any entry changed.
+		void flush();
+
+		void record_hit(std::chrono::nanoseconds load_time);
+		void record_miss(std::chrono::nanoseconds compile_time);
+		SpirvCacheStatistics statistics() const;
+		void reset_statistics();
+
+		/// @brief Keyed on the raw source and include contents rather than the preprocessed source, so a stage is only run through shaderc once.
+		static std::uint64_t make_key(
+			std::uint64_t source_hash, const std::vector<IncludedFile>& includes, std::uint32_t stage, std::uint64_t options_hash);
+		static std::uint64_t hash_file(const std::filesystem::path& path);
+
+	private:
+		static std::string manifest_key(const std::filesystem::path& source_path, std::uint32_t stage, std::uint64_t options_hash);
+		std::filesystem::path blob_path(std::uint64_t key) const;
+		std::filesystem::path reflection_path(std::uint64_t key) const;
+		std::optional<Alabaster::ShaderReflection> read_reflection(std::uint64_t key) const;
+		void write_reflection(std::uint64_t key, const Alabaster::ShaderReflection& reflection) const;
+		void read_manifest();
+
+		std::filesystem::path directory;
+		AssetDatabase* database { nullptr };
+		mutable std::mutex mutex;
+		std::unordered_map<std::string, Entry> manifest;
+		bool dirty { false };
+
+		std::atomic<std::uint32_t> hits { 0 };
+		std::atomic<std::uint32_t> misses { 0 };
+		std::atomic<std::int64_t> load_nanoseconds { 0 };
+		std::atomic<std::int64_t> compile_nanoseconds { 0 };
+	};
+
+} // namespace AssetManager
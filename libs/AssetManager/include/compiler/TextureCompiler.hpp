@@ -0,0 +1,64 @@
+#pragma once
+
+#include "compiler/BlockCompression.hpp"
+#include "compiler/MipChain.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace AssetManager {
+
+	class AssetDatabase;
+
+	/// @brief Block compressed (or plain RGBA8) image together with its whole mip chain, laid out the way it is uploaded.
+	struct CompressedTexture {
+		struct Mip {
+			std::uint32_t width { 0 };
+			std::uint32_t height { 0 };
+			std::uint64_t offset { 0 };
+			std::uint64_t size { 0 };
+		};
+
+		BlockFormat format { BlockFormat::BC7 };
+		std::uint32_t width { 0 };
+		std::uint32_t height { 0 };
+		std::uint64_t source_hash { 0 };
+		std::vector<Mip> mips;
+		std::vector<std::uint8_t> data;
+	};
+
+	/// @brief Compresses images into .atex containers in the cache directory. A container is keyed by the source path and format,
+	/// and is reused for as long as the hash of the source file matches the one stored inside it. With an asset database, a container
+	/// recorded as up to date is read without reading the source at all.
+	class TextureCompiler {
+	public:
+		explicit TextureCompiler(std::filesystem::path cache_directory, AssetDatabase* asset_database = nullptr);
+
+		/// @brief Reads the container for the source, compressing the source and writing the container first if it is missing or stale.
+		/// Thread safe.
+		/// @return the compressed texture, or nullopt if the source could not be decoded or is not an 8 bit image
+		std::optional<CompressedTexture> load_or_compress(const std::filesystem::path& source, BlockFormat format) const;
+
+		/// @brief Builds the mip chain on the CPU and compresses every level. Colour formats are filtered in linear space with alpha
+		/// premultiplied, BC5 is treated as data.
+		/// @param rgba width * height RGBA8 texels
+		static CompressedTexture compress(BlockFormat format, std::span<const std::uint8_t> rgba, std::uint32_t width, std::uint32_t height,
+			MipFilter filter = MipFilter::Kaiser);
+
+		static bool write(const std::filesystem::path& path, const CompressedTexture& texture);
+		static std::optional<CompressedTexture> read(const std::filesystem::path& path);
+
+		/// @brief Mip levels of a compressed texture, the same chain Texture builds for uncompressed images.
+		static std::uint32_t mip_count(std::uint32_t width, std::uint32_t height);
+
+	private:
+		std::filesystem::path container_path(const std::filesystem::path& source, BlockFormat format) const;
+
+		std::filesystem::path directory;
+		AssetDatabase* database { nullptr };
+	};
+
+} // namespace AssetManager
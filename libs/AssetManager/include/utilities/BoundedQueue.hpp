@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace AssetManager {
+
+	namespace Detail {
+		static constexpr std::size_t cache_line_size = 64;
+	} // namespace Detail
+
+	/// @brief Bounded multi-producer multi-consumer queue (Vyukov), lock-free as long as it is neither full nor empty.
+	/// Used to hand jobs from non-worker threads to the workers, and file notifications from the watcher thread to the main thread.
+	template <typename T, std::size_t Capacity>
+		requires((Capacity & (Capacity - 1)) == 0)
+	class BoundedQueue {
+	public:
+		BoundedQueue()
+		{
+			for (std::size_t i = 0; i < Capacity; i++) {
+				cells[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		/// @return false if the queue is full, item is left untouched.
+		bool push(T& item)
+		{
+			auto position = enqueue_position.load(std::memory_order_relaxed);
+			while (true) {
+				auto& cell = cells[position & mask];
+				const auto sequence = cell.sequence.load(std::memory_order_acquire);
+				const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+				if (difference == 0) {
+					if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+						cell.data = std::move(item);
+						cell.sequence.store(position + 1, std::memory_order_release);
+						return true;
+					}
+				} else if (difference < 0) {
+					return false;
+				} else {
+					position = enqueue_position.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		bool push(T&& item) { return push(item); }
+
+		/// @return false if the queue is empty.
+		bool pop(T& item)
+		{
+			auto position = dequeue_position.load(std::memory_order_relaxed);
+			while (true) {
+				auto& cell = cells[position & mask];
+				const auto sequence = cell.sequence.load(std::memory_order_acquire);
+				const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+				if (difference == 0) {
+					if (dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+						item = std::move(cell.data);
+						cell.sequence.store(position + mask + 1, std::memory_order_release);
+						return true;
+					}
+				} else if (difference < 0) {
+					return false;
+				} else {
+					position = dequeue_position.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		/// @return a snapshot of the number of queued items, only exact while no other thread pushes or pops.
+		[[nodiscard]] std::size_t size_approx() const
+		{
+			const auto enqueued = enqueue_position.load(std::memory_order_relaxed);
+			const auto dequeued = dequeue_position.load(std::memory_order_relaxed);
+			return enqueued > dequeued ? enqueued - dequeued : 0;
+		}
+
+	private:
+		static constexpr std::size_t mask = Capacity - 1;
+
+		struct Cell {
+			std::atomic<std::size_t> sequence;
+			T data;
+		};
+
+		alignas(Detail::cache_line_size) std::array<Cell, Capacity> cells {};
+		alignas(Detail::cache_line_size) std::atomic<std::size_t> enqueue_position { 0 };
+		alignas(Detail::cache_line_size) std::atomic<std::size_t> dequeue_position { 0 };
+	};
+
+} // namespace AssetManager
@@ -0,0 +1,323 @@
+#pragma once
+
+#include "utilities/BoundedQueue.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace AssetManager {
+
+	namespace Detail {
+		/// @brief Fixed capacity Chase-Lev deque (Le, Pop, Cohen & Zappa Nardelli, 2013).
+		/// The owning worker pushes and pops at the bottom, every other worker steals from the top.
+		template <typename T, std::size_t Capacity>
+			requires(std::is_pointer_v<T> && (Capacity & (Capacity - 1)) == 0)
+		class WorkStealingDeque {
+		public:
+			/// @return false if the deque is full, in which case the caller should execute the item inline.
+			bool push(T item)
+			{
+				const auto current_bottom = bottom.load(std::memory_order_relaxed);
+				const auto current_top = top.load(std::memory_order_acquire);
+				if (current_bottom - current_top >= static_cast<std::int64_t>(Capacity)) {
+					return false;
+				}
+
+				buffer[current_bottom & mask].store(item, std::memory_order_relaxed);
+				bottom.store(current_bottom + 1, std::memory_order_release);
+				return true;
+			}
+
+			T pop()
+			{
+				const auto current_bottom = bottom.load(std::memory_order_relaxed) - 1;
+				bottom.store(current_bottom, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				auto current_top = top.load(std::memory_order_relaxed);
+
+				if (current_top > current_bottom) {
+					bottom.store(current_bottom + 1, std::memory_order_relaxed);
+					return nullptr;
+				}
+
+				T item = buffer[current_bottom & mask].load(std::memory_order_relaxed);
+				if (current_top == current_bottom) {
+					if (!top.compare_exchange_strong(current_top, current_top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+						item = nullptr;
+					}
+					bottom.store(current_bottom + 1, std::memory_order_relaxed);
+				}
+				return item;
+			}
+
+			T steal()
+			{
+				auto current_top = top.load(std::memory_order_acquire);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				const auto current_bottom = bottom.load(std::memory_order_acquire);
+
+				if (current_top >= current_bottom) {
+					return nullptr;
+				}
+
+				T item = buffer[current_top & mask].load(std::memory_order_relaxed);
+				if (!top.compare_exchange_strong(current_top, current_top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+					return nullptr;
+				}
+				return item;
+			}
+
+		private:
+			static constexpr std::int64_t mask = static_cast<std::int64_t>(Capacity) - 1;
+
+			alignas(cache_line_size) std::atomic<std::int64_t> top { 0 };
+			alignas(cache_line_size) std::atomic<std::int64_t> bottom { 0 };
+			alignas(cache_line_size) std::array<std::atomic<T>, Capacity> buffer {};
+		};
+	} // namespace Detail
+
+	class JobSystem;
+
+	/// @brief A unit of work. The callable is stored inline, so creating a job never allocates.
+	/// Jobs live in ring arenas owned by the JobSystem, one per worker and one shared by every other thread. A slot is held by the job
+	/// until it finishes and, for jobs that are waited on, by the waiter from creation until wait() returns, so a slot is only reused
+	/// once both let go. A pointer to a job that is not waited on must not be used once it may have finished.
+	struct alignas(Detail::cache_line_size) Job {
+		static constexpr std::size_t inline_storage_size = 64;
+		static constexpr std::size_t max_continuations = 8;
+
+		[[nodiscard]] bool is_finished() const { return unfinished.load(std::memory_order_acquire) == 0; }
+
+	private:
+		alignas(std::max_align_t) std::array<std::byte, inline_storage_size> storage {};
+		void (*invoke)(void*) { nullptr };
+		void (*destroy)(void*) { nullptr };
+		Job* parent { nullptr };
+		std::atomic<std::int32_t> unfinished { 0 };
+		std::atomic<std::uint32_t> continuation_count { 0 };
+		std::array<Job*, max_continuations> continuations {};
+		std::atomic<std::uint32_t> holders { 0 };
+		std::atomic_bool has_error { false };
+		std::exception_ptr error {};
+
+		friend class JobSystem;
+	};
+
+	class JobSystem {
+	public:
+		static constexpr std::size_t arena_size = 2048;
+		static constexpr std::size_t deque_size = 4096;
+		static constexpr std::size_t default_grain_size = 64;
+
+		/// @param worker_count Number of worker threads, defaults to one less than the hardware concurrency.
+		explicit JobSystem(std::size_t worker_count = default_worker_count());
+		~JobSystem();
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem(JobSystem&&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+		JobSystem& operator=(JobSystem&&) = delete;
+
+		/// @brief The engine wide job system.
+		static JobSystem& the();
+
+		static std::size_t default_worker_count();
+
+		[[nodiscard]] std::size_t size() const { return workers.size(); }
+
+		/// @brief Create a job without scheduling it. Call run() to schedule it and wait() exactly once, which releases its slot.
+		template <typename Func> Job* create(Func&& func) { return create_job(nullptr, true, std::forward<Func>(func)); }
+
+		/// @brief Create a job whose completion is required for the parent to be considered finished. It is waited on through the
+		/// parent. Must be called before the parent has finished.
+		template <typename Func> Job* create_child(Job* parent, Func&& func) { return create_job(parent, false, std::forward<Func>(func)); }
+
+		/// @brief Create a job that is scheduled once the antecedent has finished. Must be called before running the antecedent, and
+		/// the continuation must be waited on like any created job.
+		template <typename Func> Job* then(Job* antecedent, Func&& func)
+		{
+			auto* continuation = create(std::forward<Func>(func));
+			add_continuation(antecedent, continuation);
+			return continuation;
+		}
+
+		/// @brief Create and run a job in one go. The job must be waited on.
+		template <typename Func> Job* submit(Func&& func)
+		{
+			auto* job = create(std::forward<Func>(func));
+			run(job);
+			return job;
+		}
+
+		/// @brief Create and run a job nobody waits on, its slot is reused as soon as it finished. An exception it throws is dropped.
+		template <typename Func> void dispatch(Func&& func) { run(create_job(nullptr, false, std::forward<Func>(func))); }
+
+		/// @brief Schedules the job, or runs it right away on the calling thread if the queue is full. Creating a job likewise runs
+		/// other jobs while every slot of the arena is held, so no lock a job takes may be held while creating or running one.
+		void run(Job* job);
+
+		/// @brief Blocks until the job and all its children have finished, executing other jobs while waiting.
+		/// Rethrows the first exception thrown by the job or any of its children.
+		/// @param job created by create(), submit() or then(), each of which is waited on exactly once
+		void wait(Job* job);
+
+		/// @brief Invoke func(index) for every index in [begin, end), recursively splitting the range into
+		/// jobs of at most grain_size indices. Blocks until every index has been visited.
+		template <typename Func> void parallel_for(std::size_t begin, std::size_t end, std::size_t grain_size, Func&& func);
+
+		template <typename Func> void parallel_for(std::size_t count, Func&& func)
+		{
+			parallel_for(0, count, default_grain_size, std::forward<Func>(func));
+		}
+
+		/// @brief Invoke func(element) for every element of a sized range. Random access ranges are split in place,
+		/// other ranges (e.g. multi component entt views) are first gathered into a contiguous vector.
+		template <std::ranges::input_range Range, typename Func>
+		void parallel_for_each(Range&& range, Func&& func, std::size_t grain_size = default_grain_size);
+
+		/// @brief Map every index in [begin, end) with map(index) and fold the results with reduce(lhs, rhs), starting from identity.
+		/// The reduction is applied per grain in index order and then across grains in index order, so it does not need to be commutative.
+		template <typename T, typename Map, typename Reduce>
+		T parallel_reduce(std::size_t begin, std::size_t end, std::size_t grain_size, T identity, Map&& map, Reduce&& reduce);
+
+	private:
+		template <typename Func> Job* create_job(Job* parent, bool waited, Func&& func)
+		{
+			using Callable = std::decay_t<Func>;
+			static_assert(sizeof(Callable) <= Job::inline_storage_size, "Job callable is too large, capture by reference or pointer instead.");
+			static_assert(alignof(Callable) <= alignof(std::max_align_t), "Job callable is over-aligned.");
+			static_assert(std::is_invocable_v<Callable&>, "Job callable must be invocable without arguments.");
+
+			auto* job = allocate(waited ? 2 : 1);
+			new (job->storage.data()) Callable(std::forward<Func>(func));
+			job->invoke = [](void* data) { (*std::launder(static_cast<Callable*>(data)))(); };
+			job->destroy = [](void* data) { std::launder(static_cast<Callable*>(data))->~Callable(); };
+			job->parent = parent;
+			if (parent) {
+				parent->unfinished.fetch_add(1, std::memory_order_relaxed);
+			}
+			return job;
+		}
+
+		struct Worker;
+
+		/// @param holders one for the job, and one more if a waiter holds it until wait() returns
+		Job* allocate(std::uint32_t holders);
+		void add_continuation(Job* antecedent, Job* continuation);
+		void execute(Job* job);
+		void finish(Job* job);
+		Job* next_job(std::size_t worker_index);
+		bool execute_one();
+		void worker_loop(std::size_t worker_index);
+		void notify();
+		static void set_error(Job* job, std::exception_ptr error);
+		static Job* current_job();
+
+		static constexpr std::size_t external_index = static_cast<std::size_t>(-1);
+
+		std::vector<std::unique_ptr<Worker>> workers;
+		std::unique_ptr<Worker> external;
+		std::unique_ptr<BoundedQueue<Job*, deque_size>> injected;
+		alignas(Detail::cache_line_size) std::atomic<std::uint32_t> pending_epoch { 0 };
+		std::atomic<std::uint32_t> sleeping { 0 };
+		std::atomic_bool running { true };
+	};
+
+	template <typename Func> void JobSystem::parallel_for(std::size_t begin, std::size_t end, std::size_t grain_size, Func&& func)
+	{
+		if (begin >= end) {
+			return;
+		}
+
+		grain_size = grain_size == 0 ? 1 : grain_size;
+		if (end - begin <= grain_size) {
+			for (auto i = begin; i < end; i++) {
+				func(i);
+			}
+			return;
+		}
+
+		struct Split {
+			JobSystem* system;
+			std::remove_reference_t<Func>* func;
+			std::size_t grain_size;
+
+			void operator()(std::size_t first, std::size_t last) const
+			{
+				auto* self = current_job();
+				while (last - first > grain_size) {
+					const auto middle = first + (last - first) / 2;
+					system->run(system->create_child(self, [split = *this, middle, last] { split(middle, last); }));
+					last = middle;
+				}
+				for (auto i = first; i < last; i++) {
+					(*func)(i);
+				}
+			}
+		};
+
+		const Split split { this, &func, grain_size };
+		auto* root = create([split, begin, end] { split(begin, end); });
+		run(root);
+		wait(root);
+	}
+
+	template <std::ranges::input_range Range, typename Func>
+	void JobSystem::parallel_for_each(Range&& range, Func&& func, std::size_t grain_size)
+	{
+		if constexpr (std::ranges::random_access_range<Range> && std::ranges::sized_range<Range>) {
+			auto first = std::ranges::begin(range);
+			parallel_for(0, static_cast<std::size_t>(std::ranges::size(range)), grain_size,
+				[&first, &func](std::size_t index) { func(first[static_cast<std::ranges::range_difference_t<Range>>(index)]); });
+		} else {
+			std::vector<std::ranges::range_value_t<Range>> gathered;
+			if constexpr (std::ranges::sized_range<Range>) {
+				gathered.reserve(static_cast<std::size_t>(std::ranges::size(range)));
+			}
+			for (auto&& element : range) {
+				gathered.push_back(element);
+			}
+			parallel_for(0, gathered.size(), grain_size, [&gathered, &func](std::size_t index) { func(gathered[index]); });
+		}
+	}
+
+	template <typename T, typename Map, typename Reduce>
+	T JobSystem::parallel_reduce(std::size_t begin, std::size_t end, std::size_t grain_size, T identity, Map&& map, Reduce&& reduce)
+	{
+		if (begin >= end) {
+			return identity;
+		}
+
+		grain_size = grain_size == 0 ? 1 : grain_size;
+		const auto grains = (end - begin + grain_size - 1) / grain_size;
+		std::vector<T> partials(grains, identity);
+
+		parallel_for(0, grains, 1, [&](std::size_t grain) {
+			const auto first = begin + grain * grain_size;
+			const auto last = first + grain_size < end ? first + grain_size : end;
+			auto accumulated = identity;
+			for (auto i = first; i < last; i++) {
+				accumulated = reduce(std::move(accumulated), map(i));
+			}
+			partials[grain] = std::move(accumulated);
+		});
+
+		auto result = std::move(identity);
+		for (auto& partial : partials) {
+			result = reduce(std::move(result), std::move(partial));
+		}
+		return result;
+	}
+
+} // namespace AssetManager
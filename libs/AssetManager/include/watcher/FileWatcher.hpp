@@ -1,11 +1,18 @@
 #pragma once
 
+#include "utilities/BoundedQueue.hpp"
 #include "utilities/StringHash.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <filesystem>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace AssetManager {
@@ -35,6 +42,34 @@ namespace AssetManager {
 		static constexpr FileStatus All = FileStatus::Created | FileStatus::Deleted | FileStatus::Modified;
 	} // namespace FileStatuses
 
+	constexpr auto to_filetype(const auto& extension) -> FileType
+	{
+		if (extension == ".txt")
+			return FileType::TXT;
+		else if (extension == ".png")
+			return FileType::PNG;
+		else if (extension == ".ttf")
+			return FileType::TTF;
+		else if (extension == ".jpeg")
+			return FileType::JPEG;
+		else if (extension == ".jpg")
+			return FileType::JPG;
+		else if (extension == ".spv")
+			return FileType::SPV;
+		else if (extension == ".vert")
+			return FileType::VERT;
+		else if (extension == ".frag")
+			return FileType::FRAG;
+		else if (extension == ".obj")
+			return FileType::OBJ;
+		else if (extension == ".json")
+			return FileType::JSON;
+		else if (extension == ".scene")
+			return FileType::SCENE;
+		else
+			return FileType::UNKNOWN;
+	}
+
 	struct FileInformation {
 		FileType type;
 		std::string path;
@@ -45,35 +80,81 @@ namespace AssetManager {
 		auto is_valid() const { return std::filesystem::is_regular_file(to_path()); }
 	};
 
+	/// @brief Where a callback runs. Callbacks never run on the watcher thread.
+	enum class Delivery : std::uint8_t {
+		/// From FileWatcher::dispatch, i.e. on the main thread between frames, so handlers can touch engine state without locking.
+		MainThread,
+		/// Handed to the JobSystem by FileWatcher::dispatch, for heavy handlers that synchronise themselves.
+		Worker,
+	};
+
 	class FileWatcher {
 	public:
+		static constexpr std::size_t notification_capacity = 1024;
+
 		explicit FileWatcher(const std::filesystem::path& path, std::chrono::duration<int, std::milli> in_delay = std::chrono::milliseconds(2000));
 
 		void on_created(const std::function<void(const FileInformation&)>& activation_function);
 		void on_modified(const std::function<void(const FileInformation&)>& activation_function);
 		void on_deleted(const std::function<void(const FileInformation&)>& activation_function);
 		void on_created_or_deleted(const std::function<void(const FileInformation&)>& activation_function);
-		void on(FileStatus info, const std::function<void(const FileInformation&)>& activation_function);
+		void on(FileStatus info, const std::function<void(const FileInformation&)>& activation_function, Delivery delivery = Delivery::MainThread);
+
+		/// @brief Runs the callbacks of queued notifications on the calling thread, until the queue is empty or the budget is spent.
+		/// Called by the Application once per frame, at least one notification is dispatched per call.
+		/// @return the number of notifications dispatched
+		std::size_t dispatch(std::chrono::microseconds budget);
 
+		/// @brief Also watch the files directly in a directory (relative to the root, or absolute).
 		void add_watched_paths(const std::filesystem::path& path);
 
 		~FileWatcher() { stop(); }
 
 	private:
-		/// @brief OS specific foreach (Apple-Clang does not support execution::par)
-		/// @param info file information
-		/// @param activations all functions
-		static void for_each(const FileInformation& info, const std::vector<std::function<void(const FileInformation&)>>&);
+		using Clock = std::chrono::steady_clock;
+
+		/// @brief Event driven backends merge the bursts editors produce on save (a temporary file written, renamed over the original,
+		/// attributes touched) into one notification per path, sent once the path has been quiet for debounce_window. A path that keeps
+		/// changing is still reported every max_coalescing.
+		static constexpr std::chrono::milliseconds debounce_window { 50 };
+		static constexpr std::chrono::milliseconds max_coalescing { 1000 };
+
+		struct PendingEvent {
+			FileInformation information;
+			Clock::time_point first_seen;
+			Clock::time_point last_seen;
+		};
 
 		void start(const std::function<void(const FileInformation&)>& activation_function);
 		void stop();
+
+		/// @brief OS specific watcher thread, runs until stop() is called.
 		void loop_until();
+		/// @brief Portable backend, rescans the tree every delay and compares write times.
+		void poll_until();
+
+		/// @brief Hands a notification to the main thread, waits for room while the queue is full.
+		void publish(FileInformation information);
+		/// @brief Merges an event into the pending notification for its path.
+		void queue(FileInformation information, Clock::time_point now);
+		/// @brief Sends every pending notification that has settled.
+		/// @return when the next pending notification settles, if there is one
+		std::optional<Clock::time_point> flush(Clock::time_point now);
+
+		/// @brief Copy of the additional paths, clears additional_paths_changed.
+		std::unordered_set<std::string, StringHash> copy_additional_paths();
 
 		std::vector<std::function<void(const FileInformation&)>> activations;
 		std::filesystem::path root;
 		std::chrono::duration<int, std::milli> delay;
 		std::unordered_map<std::string, FileInformation, StringHash, std::equal_to<>> paths {};
+		std::unordered_map<std::string, PendingEvent, StringHash, std::equal_to<>> pending {};
+		std::unique_ptr<BoundedQueue<FileInformation, notification_capacity>> notifications;
+
+		std::mutex additional_paths_mutex;
 		std::unordered_set<std::string, StringHash> additional_paths {};
+		std::atomic_bool additional_paths_changed { false };
+
 		std::atomic_bool running { true };
 		std::thread thread;
 	};
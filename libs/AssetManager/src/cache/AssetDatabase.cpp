@@ -0,0 +1,402 @@
+#include "am_pch.hpp"
+
+#include "cache/AssetDatabase.hpp"
+
+#include "core/Logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+namespace AssetManager {
+
+	static constexpr std::uint32_t database_magic = 0x42444141; // "AADB"
+	static constexpr std::uint32_t database_version = 1;
+
+	template <typename T> static void write_pod(std::ofstream& stream, const T& value)
+	{
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template <typename T> static bool read_pod(std::ifstream& stream, T& value)
+	{
+		stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+		return static_cast<bool>(stream);
+	}
+
+	static void write_string(std::ofstream& stream, const std::string& value)
+	{
+		write_pod(stream, static_cast<std::uint32_t>(value.size()));
+		stream.write(value.data(), static_cast<std::streamsize>(value.size()));
+	}
+
+	/// @return how many bytes are left before end, the size of the file being read
+	static std::uint64_t remaining(std::ifstream& stream, std::uint64_t end)
+	{
+		const auto position = stream.tellg();
+		return position < 0 || static_cast<std::uint64_t>(position) > end ? 0 : end - static_cast<std::uint64_t>(position);
+	}
+
+	/// @return false if the stream ended, or if the length reaches past the end without the stream failing
+	static bool read_string(std::ifstream& stream, std::uint64_t end, std::string& value)
+	{
+		std::uint32_t size;
+		if (!read_pod(stream, size) || size > remaining(stream, end)) {
+			return false;
+		}
+		value.resize(size);
+		stream.read(value.data(), size);
+		return static_cast<bool>(stream);
+	}
+
+	static void write_stamp(std::ofstream& stream, const FileStamp& stamp)
+	{
+		write_pod(stream, stamp.size);
+		write_pod(stream, stamp.last_write);
+		write_pod(stream, stamp.hash);
+	}
+
+	static bool read_stamp(std::ifstream& stream, FileStamp& stamp)
+	{
+		return read_pod(stream, stamp.size) && read_pod(stream, stamp.last_write) && read_pod(stream, stamp.hash);
+	}
+
+	AssetDatabase::AssetDatabase(std::filesystem::path database_path)
+		: path(std::move(database_path))
+	{
+		std::error_code error;
+		std::filesystem::create_directories(path.parent_path(), error);
+		if (error) {
+			Alabaster::Log::warn("[AssetDatabase] Could not create directory {}. Reason: {}", path.parent_path().string(), error.message());
+		}
+
+		read();
+	}
+
+	AssetDatabase::~AssetDatabase() { flush(); }
+
+	std::string AssetDatabase::key(const std::filesystem::path& file)
+	{
+		// The file watcher reports absolute paths, loaders mostly use paths relative to the working directory.
+		std::error_code error;
+		const auto canonical = std::filesystem::weakly_canonical(file, error);
+		if (error) {
+			return file.lexically_normal().generic_string();
+		}
+		return canonical.generic_string();
+	}
+
+	std::optional<FileStamp> AssetDatabase::stamp(const std::filesystem::path& file, const FileStamp* previous)
+	{
+		return FileStamp::of(file, previous);
+	}
+
+	bool AssetDatabase::matches(const std::string& file, FileStamp& recorded)
+	{
+		const auto current = stamp(file, &recorded);
+		if (!current) {
+			return false;
+		}
+		if (!current->can_reuse_hash(recorded)) {
+			hashed.fetch_add(1, std::memory_order_relaxed);
+		}
+		if (current->hash != recorded.hash) {
+			return false;
+		}
+
+		recorded = *current;
+		return true;
+	}
+
+	bool AssetDatabase::is_stale(const std::filesystem::path& source, std::uint32_t importer_version, const std::filesystem::path& artefact)
+	{
+		const auto source_key = key(source);
+		AssetRecord record;
+		{
+			std::scoped_lock lock { mutex };
+			const auto found = records.find(source_key);
+			if (found == records.end()) {
+				stale.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			}
+			record = found->second;
+		}
+
+		// Hashing happens outside the lock, importers on other workers check their own assets meanwhile.
+		const auto original = record;
+		const auto up_to_date = [&] {
+			if (record.importer_version != importer_version) {
+				return false;
+			}
+			if (!artefact.empty() && std::ranges::find(record.artefacts, key(artefact)) == record.artefacts.end()) {
+				return false;
+			}
+			for (const auto& produced : record.artefacts) {
+				std::error_code error;
+				if (!std::filesystem::exists(produced, error)) {
+					return false;
+				}
+			}
+			if (!matches(record.source, record.stamp)) {
+				return false;
+			}
+			return std::ranges::all_of(record.dependencies, [this](auto& dependency) { return matches(dependency.path, dependency.stamp); });
+		}();
+
+		if (!up_to_date) {
+			stale.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+		fresh.fetch_add(1, std::memory_order_relaxed);
+
+		const auto refreshed
+			= [](const FileStamp& left, const FileStamp& right) { return left.size != right.size || left.last_write != right.last_write; };
+		auto any_refreshed = refreshed(record.stamp, original.stamp);
+		for (std::size_t i = 0; i < record.dependencies.size(); i++) {
+			any_refreshed |= refreshed(record.dependencies[i].stamp, original.dependencies[i].stamp);
+		}
+
+		if (any_refreshed) {
+			// Only the times changed, store them so the next check does not hash the contents again.
+			std::scoped_lock lock { mutex };
+			if (const auto found = records.find(source_key); found != records.end() && found->second.imported_at == original.imported_at
+				&& found->second.stamp.hash == original.stamp.hash) {
+				found->second.stamp = record.stamp;
+				found->second.dependencies = std::move(record.dependencies);
+				dirty = true;
+			}
+		}
+		return false;
+	}
+
+	void AssetDatabase::record_import(const std::filesystem::path& source, std::uint32_t importer_version,
+		const std::vector<std::filesystem::path>& artefacts, const std::vector<std::filesystem::path>& dependencies)
+	{
+		const auto source_stamp = stamp(source);
+		if (!source_stamp) {
+			return;
+		}
+
+		AssetRecord record {
+			.source = key(source),
+			.stamp = *source_stamp,
+			.importer_version = importer_version,
+			.artefacts = {},
+			.dependencies = {},
+			.imported_at = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count(),
+		};
+		for (const auto& artefact : artefacts) {
+			record.artefacts.push_back(key(artefact));
+		}
+		for (const auto& dependency : dependencies) {
+			if (const auto dependency_stamp = stamp(dependency)) {
+				record.dependencies.push_back({ .path = key(dependency), .stamp = *dependency_stamp });
+			}
+		}
+
+		std::scoped_lock lock { mutex };
+		auto& existing = records[record.source];
+		// Earlier artefacts were built from the dependencies as they were then. Once any of those changed, keeping them would vouch for
+		// artefacts that were never rebuilt from the new contents, e.g. a second shader variant reading the same include.
+		const auto dependency_changed = std::ranges::any_of(existing.dependencies, [&record](const AssetDependency& dependency) {
+			const auto found = std::ranges::find(record.dependencies, dependency.path, &AssetDependency::path);
+			return found != record.dependencies.end() && found->stamp.hash != dependency.stamp.hash;
+		});
+		if (existing.importer_version == importer_version && existing.stamp.hash == record.stamp.hash && !dependency_changed) {
+			for (auto& artefact : existing.artefacts) {
+				if (std::ranges::find(record.artefacts, artefact) == record.artefacts.end()) {
+					record.artefacts.push_back(std::move(artefact));
+				}
+			}
+			for (auto& dependency : existing.dependencies) {
+				if (std::ranges::find(record.dependencies, dependency.path, &AssetDependency::path) == record.dependencies.end()) {
+					record.dependencies.push_back(std::move(dependency));
+				}
+			}
+		}
+		existing = std::move(record);
+		dirty = true;
+	}
+
+	bool AssetDatabase::changed(const std::filesystem::path& file)
+	{
+		const auto file_key = key(file);
+		std::vector<std::uint64_t> recorded_hashes;
+		{
+			std::scoped_lock lock { mutex };
+			for (const auto& [source, record] : records) {
+				if (source == file_key) {
+					recorded_hashes.push_back(record.stamp.hash);
+				}
+				for (const auto& dependency : record.dependencies) {
+					if (dependency.path == file_key) {
+						recorded_hashes.push_back(dependency.stamp.hash);
+					}
+				}
+			}
+		}
+
+		if (recorded_hashes.empty()) {
+			return true;
+		}
+
+		// Every asset reading the file must have seen the current contents, one that did not is stale.
+		const auto current = stamp(file);
+		hashed.fetch_add(1, std::memory_order_relaxed);
+		return !current || std::ranges::any_of(recorded_hashes, [&current](std::uint64_t hash) { return hash != current->hash; });
+	}
+
+	std::optional<AssetRecord> AssetDatabase::find(const std::filesystem::path& source) const
+	{
+		std::scoped_lock lock { mutex };
+		if (const auto found = records.find(key(source)); found != records.end()) {
+			return found->second;
+		}
+		return {};
+	}
+
+	void AssetDatabase::forget(const std::filesystem::path& source)
+	{
+		std::scoped_lock lock { mutex };
+		if (records.erase(key(source)) > 0) {
+			dirty = true;
+		}
+	}
+
+	std::size_t AssetDatabase::size() const
+	{
+		std::scoped_lock lock { mutex };
+		return records.size();
+	}
+
+	AssetDatabaseStatistics AssetDatabase::statistics() const
+	{
+		return {
+			.fresh = fresh.load(std::memory_order_relaxed),
+			.stale = stale.load(std::memory_order_relaxed),
+			.hashed = hashed.load(std::memory_order_relaxed),
+		};
+	}
+
+	void AssetDatabase::reset_statistics()
+	{
+		fresh = 0;
+		stale = 0;
+		hashed = 0;
+	}
+
+	void AssetDatabase::read()
+	{
+		std::ifstream stream(path, std::ios::binary);
+		std::error_code error;
+		const auto end = std::filesystem::file_size(path, error);
+		if (!stream || error) {
+			return;
+		}
+
+		std::uint32_t magic;
+		std::uint32_t version;
+		std::uint32_t count;
+		if (!read_pod(stream, magic) || !read_pod(stream, version) || !read_pod(stream, count)) {
+			return;
+		}
+
+		if (magic != database_magic || version != database_version) {
+			Alabaster::Log::info("[AssetDatabase] Ignoring {} with an unknown version, every asset will be imported again.", path.string());
+			return;
+		}
+
+		// A length or count reaching past the end of the file is corruption rather than an interrupted write, so none of the records
+		// read so far can be trusted either.
+		const auto stop = [this, &stream] {
+			if (stream) {
+				Alabaster::Log::warn("[AssetDatabase] {} is corrupt, every asset will be imported again.", path.string());
+				records.clear();
+			} else {
+				Alabaster::Log::warn("[AssetDatabase] {} is truncated, ignoring the remaining records.", path.string());
+			}
+		};
+
+		for (std::uint32_t i = 0; i < count; i++) {
+			AssetRecord record;
+			std::uint32_t artefact_count;
+			std::uint32_t dependency_count;
+			if (!read_string(stream, end, record.source) || !read_stamp(stream, record.stamp) || !read_pod(stream, record.importer_version)
+				|| !read_pod(stream, record.imported_at) || !read_pod(stream, artefact_count)
+				|| artefact_count > remaining(stream, end) / sizeof(std::uint32_t)) {
+				stop();
+				return;
+			}
+
+			record.artefacts.resize(artefact_count);
+			for (auto& artefact : record.artefacts) {
+				if (!read_string(stream, end, artefact)) {
+					stop();
+					return;
+				}
+			}
+
+			// Every dependency takes at least its path's length and a stamp.
+			constexpr auto dependency_size = sizeof(std::uint32_t) + 3 * sizeof(std::uint64_t);
+			if (!read_pod(stream, dependency_count) || dependency_count > remaining(stream, end) / dependency_size) {
+				stop();
+				return;
+			}
+			record.dependencies.resize(dependency_count);
+			for (auto& dependency : record.dependencies) {
+				if (!read_string(stream, end, dependency.path) || !read_stamp(stream, dependency.stamp)) {
+					stop();
+					return;
+				}
+			}
+
+			auto source = record.source;
+			records.try_emplace(std::move(source), std::move(record));
+		}
+	}
+
+	void AssetDatabase::flush()
+	{
+		std::scoped_lock lock { mutex };
+		if (!dirty) {
+			return;
+		}
+
+		const auto temporary_path = std::filesystem::path { path }.concat(".tmp");
+		{
+			std::ofstream stream(temporary_path, std::ios::binary | std::ios::trunc);
+			if (!stream) {
+				Alabaster::Log::warn("[AssetDatabase] Could not write {}.", path.string());
+				return;
+			}
+
+			write_pod(stream, database_magic);
+			write_pod(stream, database_version);
+			write_pod(stream, static_cast<std::uint32_t>(records.size()));
+			for (const auto& [source, record] : records) {
+				write_string(stream, record.source);
+				write_stamp(stream, record.stamp);
+				write_pod(stream, record.importer_version);
+				write_pod(stream, record.imported_at);
+				write_pod(stream, static_cast<std::uint32_t>(record.artefacts.size()));
+				for (const auto& artefact : record.artefacts) {
+					write_string(stream, artefact);
+				}
+				write_pod(stream, static_cast<std::uint32_t>(record.dependencies.size()));
+				for (const auto& dependency : record.dependencies) {
+					write_string(stream, dependency.path);
+					write_stamp(stream, dependency.stamp);
+				}
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temporary_path, path, error);
+		if (error) {
+			Alabaster::Log::warn("[AssetDatabase] Could not replace {}. Reason: {}", path.string(), error.message());
+			return;
+		}
+		dirty = false;
+	}
+
+} // namespace AssetManager
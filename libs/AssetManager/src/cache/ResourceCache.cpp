@@ -5,25 +5,41 @@
 
 #include "core/exceptions/AlabasterException.hpp"
 #include "filesystem/FileSystem.hpp"
+#include "graphics/Mesh.hpp"
+#include "watcher/FileWatcher.hpp"
 
 #include <filesystem>
 
 namespace AssetManager {
 
 	ResourceCache::ResourceCache()
+		: asset_database(Alabaster::FileSystem::cache("assets.adb"))
+		, texture_cache(&asset_database)
+		, shader_cache(&asset_database)
 	{
 		shader_cache.load_from_directory(Alabaster::FileSystem::shaders());
-		texture_cache.load_from_directory(Alabaster::FileSystem::textures(), { ".png", ".tga", ".jpg", ".jpeg", ".bmp" });
-		texture_cache.load_from_directory(Alabaster::FileSystem::fonts(), { ".png", ".tga", ".jpg", ".jpeg", ".bmp" });
-		texture_cache.load_from_directory(Alabaster::FileSystem::editor_resources(), { "*" });
+
+		// Only the placeholder is loaded up front, everything else streams in the first time it is asked for.
+		texture_cache.load_placeholder(Alabaster::FileSystem::editor_resources() / "white_texture.png");
+		// Scene textures are block compressed once and read back from the cache, fonts and editor icons stay uncompressed.
+		texture_cache.index_directory(Alabaster::FileSystem::textures(), { ".png", ".tga", ".jpg", ".jpeg", ".bmp" }, Alabaster::ImageFormat::BC7);
+		texture_cache.index_directory(Alabaster::FileSystem::fonts(), { ".png", ".tga", ".jpg", ".jpeg", ".bmp" });
+		texture_cache.index_directory(Alabaster::FileSystem::editor_resources(), { "*" });
+
+		asset_database.flush();
+		const auto statistics = asset_database.statistics();
+		Alabaster::Log::info("[ResourceCache] Asset database: {} records, {} up to date and {} stale at start up, {} files hashed.",
+			asset_database.size(), statistics.fresh, statistics.stale, statistics.hashed);
 	}
 
 	void ResourceCache::initialise() { the(); }
 
 	void ResourceCache::shutdown()
 	{
+		meshes.clear();
 		texture_cache.destroy();
 		shader_cache.destroy();
+		asset_database.flush();
 	}
 
 	ResourceCache& ResourceCache::the()
@@ -32,29 +48,144 @@ namespace AssetManager {
 		return cache;
 	}
 
-	const std::shared_ptr<Alabaster::Texture>& ResourceCache::texture(const std::string& name)
+	std::optional<TextureHandle> ResourceCache::find_texture(std::string_view name)
+	{
+		if (const auto found = texture_cache.find(name)) {
+			texture_cache.touch(name);
+			return found;
+		}
+
+		if (const auto indexed = texture_cache.find_indexed(name)) {
+			Alabaster::TextureProperties props { std::string { name } };
+			props.compression = indexed->compression;
+			return texture_cache.stream(name, indexed->path, props);
+		}
+
+		if (const auto path = Alabaster::FileSystem::texture(name); Alabaster::FileSystem::exists(path)) {
+			return texture_cache.stream(name, path, Alabaster::TextureProperties { std::string { name } });
+		}
+
+		return std::nullopt;
+	}
+
+	TextureHandle ResourceCache::stream_texture(const std::filesystem::path& full_path, const Alabaster::TextureProperties& props)
+	{
+		return texture_cache.stream(full_path.filename().string(), full_path, props);
+	}
+
+	std::optional<MeshHandle> ResourceCache::find_mesh(std::string_view name)
 	{
-		if (const auto& found = texture_cache.get_from_cache(name)) {
+		if (const auto found = meshes.find(name)) {
 			return found;
 		}
 
+		if (!Alabaster::FileSystem::exists(Alabaster::FileSystem::model(name))) {
+			return std::nullopt;
+		}
+
 		try {
-			if (texture_cache.add_to_cache(name, Alabaster::Texture::from_filename(name)))
-				return texture_cache.get_from_cache(name);
-		} catch (const Alabaster::AlabasterException& e) {
-			throw Alabaster::AlabasterException("Exception: {}", e.what());
+			return meshes.insert(name, Alabaster::Mesh::from_file(name));
+		} catch (const std::exception& e) {
+			Alabaster::Log::warn("[ResourceCache] Could not load mesh {}. Message: {}", name, e.what());
+			return std::nullopt;
 		}
+	}
 
+	std::shared_ptr<Alabaster::Texture> ResourceCache::texture(std::string_view name)
+	{
+		if (const auto handle = find_texture(name)) {
+			return texture_cache.shared(*handle);
+		}
 		throw Alabaster::AlabasterException("Texture [{}] not found.", name);
 	}
 
-	const std::shared_ptr<Alabaster::Shader>& ResourceCache::shader(const std::string& name)
+	std::shared_ptr<Alabaster::Texture> ResourceCache::texture(const std::filesystem::path& full_path, const Alabaster::TextureProperties& props)
 	{
-		const auto& found = shader_cache.get_from_cache(name);
-		if (found) {
-			return found;
+		return texture_cache.shared(stream_texture(full_path, props));
+	}
+
+	std::shared_ptr<Alabaster::Shader> ResourceCache::shader(std::string_view name)
+	{
+		if (const auto handle = shader_cache.find(name)) {
+			return shader_cache.shared(*handle);
 		}
 		throw Alabaster::AlabasterException("Shader [{}] not found.", name);
 	}
 
+	std::shared_ptr<Alabaster::Shader> ResourceCache::shader(std::string_view name, std::vector<std::string> keywords)
+	{
+		const ShaderVariantKey key { std::string { name }, std::move(keywords) };
+		if (const auto handle = shader_cache.variant(key)) {
+			return shader_cache.shared(*handle);
+		}
+		throw Alabaster::AlabasterException("Shader variant [{}] not found.", key.name());
+	}
+
+	void ResourceCache::register_file_watcher(FileWatcher& watcher)
+	{
+		watcher.on(FileStatuses::CM, [this](const FileInformation& info) {
+			if (info.type == FileType::DIRECTORY)
+				return;
+
+			const auto path = info.to_path();
+			if (!asset_database.changed(path)) {
+				return;
+			}
+			shader_cache.reload_dependants(path);
+		});
+	}
+
+	std::vector<ShaderReload> ResourceCache::apply_shader_reloads()
+	{
+		auto reloads = shader_cache.take_finished_reloads();
+		for (const auto& reload : reloads) {
+			Alabaster::Log::info("[ResourceCache] Swapped in reloaded shader {}.", reload.name);
+			for (const auto& [id, listener] : shader_reload_listeners) {
+				listener(reload);
+			}
+		}
+		return reloads;
+	}
+
+	std::uint32_t ResourceCache::add_shader_reload_listener(std::function<void(const ShaderReload&)> listener)
+	{
+		const auto id = next_listener_id++;
+		shader_reload_listeners.try_emplace(id, std::move(listener));
+		return id;
+	}
+
+	void ResourceCache::remove_shader_reload_listener(std::uint32_t id) { shader_reload_listeners.erase(id); }
+
+	std::vector<std::shared_ptr<Alabaster::Texture>> ResourceCache::apply_texture_streams()
+	{
+		auto resident = texture_cache.make_streams_resident();
+		for (const auto& texture : resident) {
+			for (const auto& [id, listener] : texture_stream_listeners) {
+				listener(texture);
+			}
+		}
+		return resident;
+	}
+
+	std::uint32_t ResourceCache::add_texture_stream_listener(std::function<void(const std::shared_ptr<Alabaster::Texture>&)> listener)
+	{
+		const auto id = next_listener_id++;
+		texture_stream_listeners.try_emplace(id, std::move(listener));
+		return id;
+	}
+
+	void ResourceCache::remove_texture_stream_listener(std::uint32_t id) { texture_stream_listeners.erase(id); }
+
+	std::vector<std::shared_ptr<Alabaster::Image>> ResourceCache::evict_textures()
+	{
+		std::vector<std::shared_ptr<Alabaster::Image>> images;
+		for (auto& [texture, image] : texture_cache.enforce_budget()) {
+			for (const auto& [id, listener] : texture_stream_listeners) {
+				listener(texture);
+			}
+			images.push_back(std::move(image));
+		}
+		return images;
+	}
+
 } // namespace AssetManager
@@ -4,22 +4,23 @@
 
 #include "filesystem/FileSystem.hpp"
 #include "utilities/FileInputOutput.hpp"
+#include "utilities/JobSystem.hpp"
 
-#include <future>
 #include <shaderc/shaderc.hpp>
+#include <thread>
 
 namespace AssetManager {
 
-	struct ShaderCodeAndName {
-		std::string name;
-		Alabaster::Shader shader;
+	static constexpr auto variant_manifest_filename = "variants.txt";
 
-		ShaderCodeAndName(const auto& in_name, auto&& in_shader)
-			: name(in_name)
-			, shader(std::move(in_shader))
-		{
+	static ShaderCompileOptions variant_options(const std::vector<std::string>& keywords)
+	{
+		ShaderCompileOptions options;
+		for (const auto& keyword : keywords) {
+			options.macro_definitions.emplace_back(keyword, "1");
 		}
-	};
+		return options;
+	}
 
 	static constexpr auto check_is_sorted = [](auto&& a, auto&& true_if_next_is_after_current_function) -> bool {
 		if (a.size() < 1) {
@@ -42,40 +43,215 @@ namespace AssetManager {
 
 		const auto shader_pairs = extract_into_pairs_of_shaders(all_files_in_shaders);
 
-		std::vector<std::future<ShaderCodeAndName>> results;
 		Alabaster::assert_that(shader_pairs.size() == all_files_in_shaders.size() / 2);
 
-		const ShaderCompiler compiler;
-		for (const auto& [vert, frag] : shader_pairs) {
+		std::vector<std::shared_ptr<Alabaster::Shader>> compiled(shader_pairs.size());
 
-			const auto& shader_name = remove_extension<std::filesystem::path>(vert);
+		// Track the stages up front so that fixing a shader which fails to preprocess still triggers a reload.
+		for (const auto& [vertex_path, fragment_path] : shader_pairs) {
+			const auto& shader_name = remove_extension<std::filesystem::path>(vertex_path);
+			dependency_graph.record(shader_name, vertex_path, {});
+			dependency_graph.record(shader_name, fragment_path, {});
+		}
 
-			const auto& vertex_path = vert;
-			const auto& fragment_path = frag;
+		spirv_cache.reset_statistics();
+		const ShaderCompiler compiler { &spirv_cache, &dependency_graph };
+		JobSystem::the().parallel_for(0, shader_pairs.size(), 1, [&](std::size_t index) {
+			const auto& [vertex_path, fragment_path] = shader_pairs[index];
+			const auto& shader_name = remove_extension<std::filesystem::path>(vertex_path);
 
-			auto task
-				= [=]() -> ShaderCodeAndName { return ShaderCodeAndName(shader_name, compiler.compile(shader_name, vertex_path, fragment_path)); };
+			try {
+				compiled[index] = std::make_shared<Alabaster::Shader>(compiler.compile(shader_name, vertex_path, fragment_path));
+			} catch (const std::exception& e) {
+				Alabaster::Log::info("{}", e.what());
+			}
+		});
 
-			results.push_back(std::async(std::launch::async, std::move(task)));
+		{
+			std::scoped_lock lock { reload_mutex };
+			for (const auto& [vertex_path, fragment_path] : shader_pairs) {
+				const ShaderSources source { .vertex = vertex_path, .fragment = fragment_path, .keywords = {} };
+				sources.insert_or_assign(remove_extension<std::filesystem::path>(vertex_path), source);
+			}
 		}
 
-		for (auto& res : results) {
-			res.wait();
+		for (std::size_t i = 0; i < shader_pairs.size(); i++) {
+			if (!compiled[i]) {
+				continue;
+			}
+
+			shaders.insert(remove_extension<std::filesystem::path>(shader_pairs[i].first), std::move(compiled[i]));
 		}
 
-		for (auto& res : results) {
+		if (const auto manifest = Alabaster::FileSystem::read(shader_directory / variant_manifest_filename)) {
+			prewarm(parse_variant_manifest(manifest->text()));
+		}
 
-			if (!res.valid()) {
-				continue;
+		spirv_cache.flush();
+
+		const auto statistics = spirv_cache.statistics();
+		Alabaster::Log::info("[ShaderCache] SPIR-V cache: {} hits, {} misses. Loaded {} stages in {:.2f} ms, compiled {} stages in {:.2f} ms.",
+			statistics.hits, statistics.misses, statistics.hits, statistics.load_milliseconds, statistics.misses, statistics.compile_milliseconds);
+	}
+
+	std::optional<ShaderHandle> ShaderCache::variant(const ShaderVariantKey& key)
+	{
+		const auto name = key.name();
+		if (const auto handle = shaders.find(name)) {
+			return handle;
+		}
+
+		prewarm({ key });
+		return shaders.find(name);
+	}
+
+	void ShaderCache::prewarm(const std::vector<ShaderVariantKey>& keys)
+	{
+		std::vector<std::pair<std::string, ShaderSources>> pending;
+		{
+			std::scoped_lock lock { reload_mutex };
+			for (const auto& key : keys) {
+				// Variants that failed to compile keep their sources, a fix on disk reloads them like any other shader.
+				auto name = key.name();
+				if (sources.contains(name)) {
+					continue;
+				}
+
+				const auto base = sources.find(key.shader);
+				if (base == sources.end()) {
+					Alabaster::Log::warn("[ShaderCache] Cannot compile variant {}, there is no shader {}.", name, key.shader);
+					continue;
+				}
+
+				ShaderSources variant_sources { .vertex = base->second.vertex, .fragment = base->second.fragment, .keywords = key.keywords };
+				sources.try_emplace(name, variant_sources);
+				pending.emplace_back(std::move(name), std::move(variant_sources));
 			}
+		}
+
+		if (pending.empty()) {
+			return;
+		}
+
+		std::vector<std::shared_ptr<Alabaster::Shader>> compiled(pending.size());
+		JobSystem::the().parallel_for(0, pending.size(), 1, [this, &pending, &compiled](std::size_t index) {
+			const auto& [name, source] = pending[index];
+			dependency_graph.record(name, source.vertex, {});
+			dependency_graph.record(name, source.fragment, {});
+
 			try {
-				auto&& code = res.get();
-				auto shader = std::make_shared<Alabaster::Shader>(std::move(code.shader));
-				shaders.insert(std::make_pair(code.name, shader));
+				const ShaderCompiler compiler { &spirv_cache, &dependency_graph, variant_options(source.keywords) };
+				compiled[index] = std::make_shared<Alabaster::Shader>(compiler.compile(name, source.vertex, source.fragment));
 			} catch (const std::exception& e) {
-				Alabaster::Log::info("{}", e.what());
+				Alabaster::Log::error("[ShaderCache] Could not compile variant {}. Reason: {}", name, e.what());
+			}
+		});
+
+		std::size_t compiled_count { 0 };
+		for (std::size_t i = 0; i < pending.size(); i++) {
+			if (compiled[i]) {
+				shaders.insert(pending[i].first, std::move(compiled[i]));
+				compiled_count++;
+			}
+		}
+		spirv_cache.flush();
+
+		Alabaster::Log::info("[ShaderCache] Compiled {} of {} shader variants.", compiled_count, pending.size());
+	}
+
+	void ShaderCache::destroy()
+	{
+		{
+			std::scoped_lock lock { reload_mutex };
+			accepting_reloads = false;
+		}
+		while (reloads_in_flight.load() > 0) {
+			std::this_thread::yield();
+		}
+
+		for (auto& [key, shader] : finished_reloads) {
+			shader->destroy();
+		}
+		finished_reloads.clear();
+
+		shaders.for_each([](Alabaster::Shader& shader) { shader.destroy(); });
+	}
+
+	void ShaderCache::reload_dependants(const std::filesystem::path& changed_file)
+	{
+		const auto dependants = dependency_graph.dependants(changed_file);
+		if (dependants.empty()) {
+			return;
+		}
+
+		struct Reload {
+			std::string name;
+			ShaderSources source;
+			std::uint64_t revision;
+		};
+
+		// The job system may run a job on the thread dispatching it, and the jobs lock reload_mutex, so it is released before dispatching.
+		std::vector<std::shared_ptr<const Reload>> reloads;
+		{
+			std::scoped_lock lock { reload_mutex };
+			for (const auto& name : dependants) {
+				const auto found = sources.find(name);
+				if (found == sources.end() || !accepting_reloads) {
+					continue;
+				}
+
+				// The paths do not fit in a job, they are shared with it instead.
+				reloads.push_back(std::make_shared<const Reload>(Reload { name, found->second, ++reload_revisions[name] }));
+				reloads_in_flight++;
 			}
 		}
+
+		for (const auto& reload : reloads) {
+			Alabaster::Log::info("[ShaderCache] {} changed, reloading {}.", changed_file.filename().string(), reload->name);
+			JobSystem::the().dispatch([this, reload] {
+				std::shared_ptr<Alabaster::Shader> shader;
+				try {
+					const ShaderCompiler compiler { &spirv_cache, &dependency_graph, variant_options(reload->source.keywords) };
+					shader = std::make_shared<Alabaster::Shader>(compiler.compile(reload->name, reload->source.vertex, reload->source.fragment));
+				} catch (const std::exception& e) {
+					Alabaster::Log::error("[ShaderCache] Could not reload {}, keeping the previous version. Reason: {}", reload->name, e.what());
+				}
+
+				if (shader) {
+					spirv_cache.flush();
+
+					std::scoped_lock reload_lock { reload_mutex };
+					if (reload_revisions[reload->name] == reload->revision) {
+						// A finished reload that was never swapped in has not been used by the GPU and can go right away.
+						if (auto& pending = finished_reloads[reload->name]) {
+							pending->destroy();
+						}
+						finished_reloads[reload->name] = std::move(shader);
+					} else {
+						shader->destroy();
+					}
+				}
+
+				reloads_in_flight--;
+			});
+		}
+	}
+
+	std::vector<ShaderReload> ShaderCache::take_finished_reloads()
+	{
+		std::vector<ShaderReload> reloads;
+
+		std::scoped_lock lock { reload_mutex };
+		reloads.reserve(finished_reloads.size());
+		for (auto& [name, shader] : finished_reloads) {
+			// A shader that did not compile at startup gets its slot with its first successful reload.
+			const auto handle = shaders.insert(name, nullptr);
+			auto previous = shaders.replace(handle, shader);
+			reloads.push_back({ .name = name, .previous = std::move(previous), .shader = std::move(shader) });
+		}
+		finished_reloads.clear();
+
+		return reloads;
 	}
 
 	std::vector<std::pair<std::filesystem::path, std::filesystem::path>> ShaderCache::extract_into_pairs_of_shaders(
@@ -2,15 +2,71 @@
 
 #include "cache/TextureCache.hpp"
 
-#include "core/Utilities.hpp"
+#include "core/Logger.hpp"
 #include "filesystem/FileSystem.hpp"
+#include "graphics/Allocator.hpp"
 #include "graphics/CommandBuffer.hpp"
 #include "graphics/Image.hpp"
-#include "utilities/ThreadPool.hpp"
+#include "utilities/JobSystem.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <thread>
+#include <tuple>
 
 namespace AssetManager {
 
-	static constexpr auto num_batches = 4;
+	static std::optional<BlockFormat> to_block_format(Alabaster::ImageFormat format)
+	{
+		switch (format) {
+		case Alabaster::ImageFormat::BC1:
+			return BlockFormat::BC1;
+		case Alabaster::ImageFormat::BC3:
+			return BlockFormat::BC3;
+		case Alabaster::ImageFormat::BC5:
+			return BlockFormat::BC5;
+		case Alabaster::ImageFormat::BC7:
+			return BlockFormat::BC7;
+		default:
+			return {};
+		}
+	}
+
+	static Alabaster::ImageFormat to_image_format(BlockFormat format)
+	{
+		switch (format) {
+		case BlockFormat::RGBA8:
+			return Alabaster::ImageFormat::RGBA;
+		case BlockFormat::BC1:
+			return Alabaster::ImageFormat::BC1;
+		case BlockFormat::BC3:
+			return Alabaster::ImageFormat::BC3;
+		case BlockFormat::BC5:
+			return Alabaster::ImageFormat::BC5;
+		case BlockFormat::BC7:
+			return Alabaster::ImageFormat::BC7;
+		}
+		return Alabaster::ImageFormat::None;
+	}
+
+	/// @return the container a streamed image is cached in, nullopt to decode it on every run
+	static std::optional<BlockFormat> container_format(const Alabaster::TextureProperties& props)
+	{
+		if (const auto block_format = to_block_format(props.compression)) {
+			return block_format;
+		}
+		// Uncompressed images are still cached for their mip chain, which is expensive to filter.
+		if (props.generate_mips) {
+			return BlockFormat::RGBA8;
+		}
+		return {};
+	}
+
+	TextureCache::TextureCache(AssetDatabase* asset_database)
+		: texture_compiler(Alabaster::FileSystem::cache("textures"), asset_database)
+	{
+	}
 
 	void TextureCache::load_from_directory(
 		const std::filesystem::path& directory, const std::unordered_set<std::string, StringHash, std::equal_to<>>& include_extensions)
@@ -18,18 +74,437 @@ namespace AssetManager {
 		using namespace Alabaster;
 		auto sorted_images_in_directory
 			= FileSystem::in_directory<std::filesystem::path, StringHash, std::equal_to<>>(directory, include_extensions, true);
+		const auto image_count = sorted_images_in_directory.size();
+
+		// Headers are cheap to read and tell us how much staging memory every image needs before anything is decoded.
+		std::vector<Texture::ImageHeader> headers(image_count);
+		JobSystem::the().parallel_for(
+			0, image_count, 1, [&](std::size_t index) { headers[index] = Texture::probe(sorted_images_in_directory[index]); });
+
+		if (!staging_ring) {
+			staging_ring = StagingRing::create(staging_ring_capacity);
+		}
+
+		struct StagedImage {
+			std::size_t index { 0 };
+			StagingRing::Region region {};
+			bool decoded { false };
+		};
+
+		std::size_t next = 0;
+		while (next < image_count) {
+			// Hand out regions until the ring is full, the rest of the directory goes into the next batch.
+			std::vector<StagedImage> batch;
+			for (; next < image_count; next++) {
+				const auto& entry = sorted_images_in_directory[next];
+				const auto& header = headers[next];
+				if (!header) {
+					Log::warn("[TextureCache] Could not decode {}.", entry.string());
+					continue;
+				}
+
+				if (header.size() > staging_ring->capacity()) {
+					auto decoded = Texture::decode(entry);
+					if (!decoded) {
+						Log::warn("[TextureCache] Could not decode {}.", entry.string());
+						continue;
+					}
+					auto texture = Texture::from_decoded(entry, std::move(decoded), TextureProperties(entry.string()));
+					track_resident(textures.insert(entry.filename().string(), std::move(texture)));
+					continue;
+				}
+
+				auto region = staging_ring->allocate(header.size());
+				if (!region) {
+					break;
+				}
+				batch.push_back({ .index = next, .region = *region });
+			}
+
+			// Workers decode straight into the mapped ring, every region is disjoint so no synchronisation is needed.
+			JobSystem::the().parallel_for(0, batch.size(), 1, [&](std::size_t i) {
+				auto& staged = batch[i];
+				staged.decoded = Texture::decode_into(sorted_images_in_directory[staged.index], headers[staged.index], staged.region.data);
+			});
+
+			staging_ring->flush();
+			{
+				// One submission and one fence wait for the whole batch, the textures must outlive it.
+				ImmediateCommandBuffer immediate_command_buffer { "TextureCache Upload" };
+				for (const auto& staged : batch) {
+					const auto& entry = sorted_images_in_directory[staged.index];
+					const auto& image_name = entry.filename().string();
+					if (!staged.decoded) {
+						Log::warn("[TextureCache] Could not decode {}.", entry.string());
+						continue;
+					}
+					if (textures.contains(image_name)) {
+						continue;
+					}
+
+					auto texture = Texture::from_staged(entry, headers[staged.index], TextureProperties(entry.string()));
+					texture->record_upload(*immediate_command_buffer, staged.region.buffer, staged.region.offset);
+					track_resident(textures.insert(image_name, std::move(texture)));
+				}
+			}
+			staging_ring->reset();
+		}
+	}
+
+	void TextureCache::index_directory(const std::filesystem::path& directory,
+		const std::unordered_set<std::string, StringHash, std::equal_to<>>& include_extensions, Alabaster::ImageFormat compression)
+	{
+		using namespace Alabaster;
+		const auto images_in_directory
+			= FileSystem::in_directory<std::filesystem::path, StringHash, std::equal_to<>>(directory, include_extensions, true);
+		for (const auto& entry : images_in_directory) {
+			indexed.try_emplace(entry.filename().string(), IndexedImage { .path = entry, .compression = compression });
+		}
+	}
+
+	void TextureCache::load_placeholder(const std::filesystem::path& full_path)
+	{
+		using namespace Alabaster;
+		auto decoded = Texture::decode(full_path);
+		if (!decoded) {
+			throw AlabasterException("Could not decode the placeholder texture {}.", full_path.string());
+		}
+
+		placeholder = Texture::from_decoded(full_path, std::move(decoded), TextureProperties(full_path.string()));
+		track_resident(textures.assign(full_path.filename().string(), placeholder));
+	}
+
+	std::optional<TextureCache::IndexedImage> TextureCache::find_indexed(std::string_view name) const
+	{
+		if (const auto found = indexed.find(name); found != indexed.end()) {
+			return found->second;
+		}
+		return {};
+	}
+
+	TextureHandle TextureCache::stream(std::string_view name, const std::filesystem::path& full_path, const Alabaster::TextureProperties& props)
+	{
+		if (const auto found = textures.find(name)) {
+			touch(name);
+			return *found;
+		}
+
+		Alabaster::verify(placeholder != nullptr, "Streaming a texture requires a placeholder.");
+		const auto handle = textures.insert(name, Alabaster::Texture::streamed(full_path, placeholder, props));
+		request_stream(name, full_path, props);
+		return handle;
+	}
+
+	void TextureCache::request_stream(std::string_view name, const std::filesystem::path& full_path, const Alabaster::TextureProperties& props)
+	{
+		{
+			std::scoped_lock lock { stream_mutex };
+			if (!accepting_streams) {
+				return;
+			}
+			pending_streams.insert_or_assign(
+				std::string { name }, StreamRequest { .path = full_path, .container = container_format(props), .last_used = ++use_clock });
+			streams_in_flight++;
+		}
+
+		// Every job decodes whichever request was used most recently when it starts, not necessarily the one that submitted it.
+		JobSystem::the().dispatch([this] { decode_most_recent_stream(); });
+	}
+
+	void TextureCache::touch(std::string_view name)
+	{
+		std::scoped_lock lock { stream_mutex };
+		const auto last_used = ++use_clock;
+		if (auto pending = pending_streams.find(name); pending != pending_streams.end()) {
+			pending->second.last_used = last_used;
+			return;
+		}
+
+		for (auto& decoded_stream : decoded_streams) {
+			if (decoded_stream.name == name) {
+				decoded_stream.last_used = last_used;
+				return;
+			}
+		}
+	}
+
+	void TextureCache::decode_most_recent_stream()
+	{
+		std::string name;
+		StreamRequest request;
+		{
+			std::scoped_lock lock { stream_mutex };
+			const auto most_recent = std::ranges::max_element(pending_streams, {}, [](const auto& entry) { return entry.second.last_used; });
+			if (most_recent != pending_streams.end()) {
+				name = most_recent->first;
+				request = std::move(most_recent->second);
+				pending_streams.erase(most_recent);
+			}
+		}
+
+		if (!name.empty()) {
+			DecodedStream decoded_stream;
+			decoded_stream.name = std::move(name);
+			decoded_stream.last_used = request.last_used;
+			if (request.container) {
+				// Images that have no 8 bit container (HDR ones) are streamed as they decode.
+				decoded_stream.compressed = texture_compiler.load_or_compress(request.path, *request.container);
+			}
+			if (!decoded_stream.compressed) {
+				decoded_stream.decoded = Alabaster::Texture::decode(request.path);
+			}
+
+			if (!decoded_stream.compressed && !decoded_stream.decoded) {
+				Alabaster::Log::warn("[TextureCache] Could not decode {}, keeping the placeholder.", request.path.string());
+			} else {
+				std::scoped_lock lock { stream_mutex };
+				decoded_streams.push_back(std::move(decoded_stream));
+			}
+		}
+
+		streams_in_flight--;
+	}
+
+	std::vector<std::shared_ptr<Alabaster::Texture>> TextureCache::make_streams_resident()
+	{
+		using namespace Alabaster;
+
+		struct StagedStream {
+			DecodedStream stream;
+			StagingRing::Region region;
+		};
 
-		const auto batches = Utilities::split_into(sorted_images_in_directory, num_batches);
-		for (const auto& batch : batches) {
-			for (const auto& entry : batch) {
-				const auto& image_name = entry.filename().string();
-				Alabaster::TextureProperties spec;
-				spec.generate_mips = false;
-				spec.debug_name = image_name;
+		std::vector<std::shared_ptr<Texture>> resident;
+		std::vector<StagedStream> staged;
+		std::vector<DecodedStream> oversized;
+		{
+			std::scoped_lock lock { stream_mutex };
+			if (decoded_streams.empty()) {
+				return resident;
+			}
 
-				textures.try_emplace(image_name, Texture::from_full_path(entry));
+			if (!staging_ring) {
+				staging_ring = StagingRing::create(staging_ring_capacity);
 			}
+
+			std::ranges::sort(decoded_streams, std::ranges::greater {}, &DecodedStream::last_used);
+
+			std::vector<DecodedStream> deferred;
+			for (auto& decoded_stream : decoded_streams) {
+				const VkDeviceSize size = decoded_stream.size();
+				if (size > staging_ring->capacity()) {
+					oversized.push_back(std::move(decoded_stream));
+					continue;
+				}
+
+				const auto over_budget = !staged.empty() && staging_ring->used() + size > stream_upload_budget;
+				const auto region = over_budget ? std::nullopt : staging_ring->allocate(size);
+				if (!region) {
+					deferred.push_back(std::move(decoded_stream));
+					continue;
+				}
+				staged.push_back({ .stream = std::move(decoded_stream), .region = *region });
+			}
+			decoded_streams = std::move(deferred);
+		}
+
+		JobSystem::the().parallel_for(0, staged.size(), 1, [&](std::size_t index) {
+			auto& [stream, region] = staged[index];
+			if (stream.compressed) {
+				std::memcpy(region.data, stream.compressed->data.data(), region.size);
+			} else {
+				std::memcpy(region.data, stream.decoded.pixels.data, region.size);
+				stream.decoded.release();
+			}
+		});
+		staging_ring->flush();
+
+		std::vector<std::tuple<TextureHandle, std::shared_ptr<Texture>, std::shared_ptr<Texture>>> uploads;
+		{
+			// The loaded textures must outlive the submission, which happens when the command buffer goes out of scope.
+			ImmediateCommandBuffer immediate_command_buffer { "TextureCache Streaming" };
+			for (const auto& [stream, region] : staged) {
+				const auto handle = textures.find(stream.name).value_or(TextureHandle {});
+				const auto& texture = textures.shared(handle);
+				if (!texture || texture->is_resident()) {
+					continue;
+				}
+
+				if (const auto& compressed = stream.compressed) {
+					const Texture::ImageHeader header { .width = compressed->width,
+						.height = compressed->height,
+						.format = to_image_format(compressed->format),
+						.mips = static_cast<std::uint32_t>(compressed->mips.size()) };
+					std::vector<VkDeviceSize> mip_offsets;
+					std::ranges::transform(compressed->mips, std::back_inserter(mip_offsets), &CompressedTexture::Mip::offset);
+
+					auto loaded = Texture::from_staged(texture->get_path(), header, texture->get_properties());
+					loaded->record_upload(*immediate_command_buffer, region.buffer, region.offset, mip_offsets);
+					uploads.emplace_back(handle, texture, std::move(loaded));
+					continue;
+				}
+
+				const Texture::ImageHeader header { .width = stream.decoded.width, .height = stream.decoded.height, .format = stream.decoded.format };
+				auto loaded = Texture::from_staged(texture->get_path(), header, texture->get_properties());
+				loaded->record_upload(*immediate_command_buffer, region.buffer, region.offset);
+				uploads.emplace_back(handle, texture, std::move(loaded));
+			}
+		}
+		staging_ring->reset();
+
+		for (auto& [handle, texture, loaded] : uploads) {
+			texture->make_resident(*loaded);
+			track_resident(handle);
+			resident.push_back(texture);
+		}
+
+		for (auto& stream : oversized) {
+			const auto handle = textures.find(stream.name).value_or(TextureHandle {});
+			const auto& texture = textures.shared(handle);
+			if (!texture || texture->is_resident()) {
+				stream.decoded.release();
+				continue;
+			}
+
+			if (stream.compressed) {
+				Log::warn(
+					"[TextureCache] Cached {} does not fit the staging ring, uploading it from the source image.", texture->get_path().string());
+				stream.decoded = Texture::decode(texture->get_path());
+				if (!stream.decoded) {
+					continue;
+				}
+			}
+
+			auto loaded = Texture::from_decoded(texture->get_path(), std::move(stream.decoded), texture->get_properties());
+			texture->make_resident(*loaded);
+			track_resident(handle);
+			resident.push_back(texture);
+		}
+
+		return resident;
+	}
+
+	Alabaster::Texture* TextureCache::get(TextureHandle handle)
+	{
+		auto* texture = textures.get(handle);
+		if (!texture) {
+			return nullptr;
+		}
+
+		auto& entry = residency_of(handle);
+		entry.last_used_frame = frame;
+		if (texture->is_resident()) {
+			residency_statistics.hits++;
+			return texture;
+		}
+
+		residency_statistics.misses++;
+		if (entry.evicted) {
+			entry.evicted = false;
+			request_stream(textures.name(handle), texture->get_path(), texture->get_properties());
 		}
+		return texture;
+	}
+
+	TextureCache::Residency& TextureCache::residency_of(TextureHandle handle)
+	{
+		if (handle.index >= residency.size()) {
+			residency.resize(handle.index + 1);
+		}
+
+		auto& entry = residency[handle.index];
+		if (entry.handle != handle) {
+			// The slot was reused by another texture.
+			residency_statistics.resident_bytes -= entry.bytes;
+			entry = Residency { .handle = handle, .last_used_frame = frame };
+		}
+		return entry;
+	}
+
+	void TextureCache::track_resident(TextureHandle handle)
+	{
+		const auto* texture = textures.get(handle);
+		if (!texture) {
+			return;
+		}
+
+		auto& entry = residency_of(handle);
+		residency_statistics.resident_bytes -= entry.bytes;
+		entry.bytes = texture->get_memory_size();
+		entry.evicted = false;
+		residency_statistics.resident_bytes += entry.bytes;
+	}
+
+	std::vector<TextureEviction> TextureCache::enforce_budget()
+	{
+		frame++;
+
+		// Buffers, attachments and everything else on the device are not ours to evict, textures get what is left of the budget.
+		const auto device = Alabaster::Allocator::device_local_budget();
+		const auto resident_bytes = residency_statistics.resident_bytes;
+		const auto other_usage = device.usage > resident_bytes ? device.usage - resident_bytes : 0;
+		const auto device_room = device.budget > other_usage ? device.budget - other_usage : 0;
+		residency_statistics.budget_bytes = std::min(memory_budget, device_room);
+
+		std::vector<TextureEviction> evictions;
+		if (!placeholder || residency_statistics.resident_bytes <= residency_statistics.budget_bytes) {
+			return evictions;
+		}
+
+		std::vector<Residency*> candidates;
+		for (auto& entry : residency) {
+			if (entry.bytes > 0 && entry.last_used_frame + eviction_grace_frames <= frame) {
+				candidates.push_back(&entry);
+			}
+		}
+		std::ranges::sort(candidates, std::ranges::less {}, &Residency::last_used_frame);
+
+		for (auto* entry : candidates) {
+			if (residency_statistics.resident_bytes <= residency_statistics.budget_bytes) {
+				break;
+			}
+
+			const auto& texture = textures.shared(entry->handle);
+			// The pool holds one reference, anything more is a pipeline or an editor icon that expects the texture to stay resident.
+			if (!texture || texture.use_count() > 1 || !texture->is_resident()) {
+				continue;
+			}
+
+			residency_statistics.resident_bytes -= entry->bytes;
+			residency_statistics.evictions++;
+			entry->bytes = 0;
+			entry->evicted = true;
+			evictions.push_back({ .texture = texture, .image = texture->evict(*placeholder) });
+		}
+
+		if (!evictions.empty()) {
+			Alabaster::Log::info("[TextureCache] Evicted {} textures, {} of {} bytes resident.", evictions.size(),
+				residency_statistics.resident_bytes, residency_statistics.budget_bytes);
+		}
+		return evictions;
+	}
+
+	void TextureCache::destroy()
+	{
+		{
+			std::scoped_lock lock { stream_mutex };
+			accepting_streams = false;
+			pending_streams.clear();
+		}
+		while (streams_in_flight.load() > 0) {
+			std::this_thread::yield();
+		}
+
+		for (auto& decoded_stream : decoded_streams) {
+			decoded_stream.decoded.release();
+		}
+		decoded_streams.clear();
+
+		textures.clear();
+		residency.clear();
+		residency_statistics.resident_bytes = 0;
+		placeholder.reset();
+		staging_ring.reset();
 	}
 
 } // namespace AssetManager
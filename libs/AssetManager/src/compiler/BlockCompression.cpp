@@ -0,0 +1,706 @@
+#include "am_pch.hpp"
+
+#include "compiler/BlockCompression.hpp"
+
+#include "utilities/JobSystem.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace AssetManager::BlockCompression {
+
+	template <std::size_t Channels> using Points = std::array<std::array<float, Channels>, texels_per_block>;
+
+	static constexpr std::array<std::uint32_t, 16> bc7_weights = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	class BitWriter {
+	public:
+		explicit BitWriter(std::uint8_t* output)
+			: bytes(output)
+		{
+		}
+
+		void write(std::uint32_t value, std::uint32_t count)
+		{
+			for (std::uint32_t i = 0; i < count; i++, position++) {
+				if ((value >> i) & 1u) {
+					bytes[position >> 3] |= static_cast<std::uint8_t>(1u << (position & 7));
+				}
+			}
+		}
+
+	private:
+		std::uint8_t* bytes;
+		std::uint32_t position { 0 };
+	};
+
+	class BitReader {
+	public:
+		explicit BitReader(const std::uint8_t* input)
+			: bytes(input)
+		{
+		}
+
+		std::uint32_t read(std::uint32_t count)
+		{
+			std::uint32_t value = 0;
+			for (std::uint32_t i = 0; i < count; i++, position++) {
+				value |= static_cast<std::uint32_t>((bytes[position >> 3] >> (position & 7)) & 1u) << i;
+			}
+			return value;
+		}
+
+	private:
+		const std::uint8_t* bytes;
+		std::uint32_t position { 0 };
+	};
+
+	template <std::size_t Channels> static std::array<float, Channels> mean_of(const Points<Channels>& points)
+	{
+		std::array<float, Channels> mean {};
+		for (const auto& point : points) {
+			for (std::size_t c = 0; c < Channels; c++) {
+				mean[c] += point[c];
+			}
+		}
+		for (auto& channel : mean) {
+			channel /= static_cast<float>(texels_per_block);
+		}
+		return mean;
+	}
+
+	/// @brief Direction of largest variance through power iteration on the covariance matrix. Zero for a single coloured block.
+	template <std::size_t Channels>
+	static std::array<float, Channels> principal_axis(const Points<Channels>& points, const std::array<float, Channels>& mean)
+	{
+		std::array<std::array<float, Channels>, Channels> covariance {};
+		std::array<float, Channels> low;
+		std::array<float, Channels> high;
+		low.fill(std::numeric_limits<float>::max());
+		high.fill(std::numeric_limits<float>::lowest());
+
+		for (const auto& point : points) {
+			std::array<float, Channels> delta;
+			for (std::size_t c = 0; c < Channels; c++) {
+				delta[c] = point[c] - mean[c];
+				low[c] = std::min(low[c], point[c]);
+				high[c] = std::max(high[c], point[c]);
+			}
+			for (std::size_t row = 0; row < Channels; row++) {
+				for (std::size_t column = 0; column < Channels; column++) {
+					covariance[row][column] += delta[row] * delta[column];
+				}
+			}
+		}
+
+		// The bounding box diagonal is a good first guess and converges in a few iterations.
+		std::array<float, Channels> axis;
+		for (std::size_t c = 0; c < Channels; c++) {
+			axis[c] = high[c] - low[c];
+		}
+
+		for (std::uint32_t iteration = 0; iteration < 8; iteration++) {
+			std::array<float, Channels> next {};
+			for (std::size_t row = 0; row < Channels; row++) {
+				for (std::size_t column = 0; column < Channels; column++) {
+					next[row] += covariance[row][column] * axis[column];
+				}
+			}
+
+			float largest = 0.0f;
+			for (const auto channel : next) {
+				largest = std::max(largest, std::abs(channel));
+			}
+			if (largest < 1e-6f) {
+				break;
+			}
+			for (std::size_t c = 0; c < Channels; c++) {
+				axis[c] = next[c] / largest;
+			}
+		}
+
+		float length = 0.0f;
+		for (const auto channel : axis) {
+			length += channel * channel;
+		}
+		length = std::sqrt(length);
+		if (length < 1e-6f) {
+			return {};
+		}
+		for (auto& channel : axis) {
+			channel /= length;
+		}
+		return axis;
+	}
+
+	/// @brief Endpoints at the extremes of the projection of the points onto the principal axis.
+	template <std::size_t Channels>
+	static void fit_endpoints(const Points<Channels>& points, std::array<float, Channels>& first, std::array<float, Channels>& second)
+	{
+		const auto mean = mean_of(points);
+		const auto axis = principal_axis(points, mean);
+
+		float low = std::numeric_limits<float>::max();
+		float high = std::numeric_limits<float>::lowest();
+		for (const auto& point : points) {
+			float projection = 0.0f;
+			for (std::size_t c = 0; c < Channels; c++) {
+				projection += (point[c] - mean[c]) * axis[c];
+			}
+			low = std::min(low, projection);
+			high = std::max(high, projection);
+		}
+
+		for (std::size_t c = 0; c < Channels; c++) {
+			first[c] = std::clamp(mean[c] + axis[c] * high, 0.0f, 255.0f);
+			second[c] = std::clamp(mean[c] + axis[c] * low, 0.0f, 255.0f);
+		}
+	}
+
+	static std::uint16_t pack_565(const std::array<float, 3>& colour)
+	{
+		const auto r = static_cast<std::uint32_t>(std::lround(colour[0] * 31.0f / 255.0f));
+		const auto g = static_cast<std::uint32_t>(std::lround(colour[1] * 63.0f / 255.0f));
+		const auto b = static_cast<std::uint32_t>(std::lround(colour[2] * 31.0f / 255.0f));
+		return static_cast<std::uint16_t>((r << 11) | (g << 5) | b);
+	}
+
+	static std::array<std::int32_t, 3> unpack_565(std::uint16_t packed)
+	{
+		const std::int32_t r = (packed >> 11) & 31;
+		const std::int32_t g = (packed >> 5) & 63;
+		const std::int32_t b = packed & 31;
+		return { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) };
+	}
+
+	static std::array<std::array<std::int32_t, 3>, 4> colour_palette(std::uint16_t first, std::uint16_t second, bool always_four_colours)
+	{
+		const auto a = unpack_565(first);
+		const auto b = unpack_565(second);
+
+		std::array<std::array<std::int32_t, 3>, 4> palette { a, b };
+		for (std::size_t c = 0; c < 3; c++) {
+			if (first > second || always_four_colours) {
+				palette[2][c] = (2 * a[c] + b[c]) / 3;
+				palette[3][c] = (a[c] + 2 * b[c]) / 3;
+			} else {
+				palette[2][c] = (a[c] + b[c]) / 2;
+				palette[3][c] = 0;
+			}
+		}
+		return palette;
+	}
+
+	/// @brief Picks the closest palette entry for every texel.
+	/// @return the summed squared error
+	static std::uint32_t select_colour_indices(const Points<3>& points, std::uint16_t first, std::uint16_t second, std::uint32_t& indices)
+	{
+		const auto palette = colour_palette(first, second, true);
+
+		indices = 0;
+		std::uint32_t total_error = 0;
+		for (std::uint32_t i = 0; i < texels_per_block; i++) {
+			std::uint32_t best_error = std::numeric_limits<std::uint32_t>::max();
+			std::uint32_t best_index = 0;
+			for (std::uint32_t entry = 0; entry < 4; entry++) {
+				std::uint32_t error = 0;
+				for (std::size_t c = 0; c < 3; c++) {
+					const auto delta = static_cast<std::int32_t>(points[i][c]) - palette[entry][c];
+					error += static_cast<std::uint32_t>(delta * delta);
+				}
+				if (error < best_error) {
+					best_error = error;
+					best_index = entry;
+				}
+			}
+			indices |= best_index << (2 * i);
+			total_error += best_error;
+		}
+		return total_error;
+	}
+
+	/// @brief Solves for the endpoints that minimise the squared error of the given index assignment.
+	/// @brief Least squares endpoints for fixed indices.
+	/// @param weights how much of the first endpoint goes into the palette entry picked by each texel
+	template <std::size_t Channels>
+	static bool refine_endpoints(const Points<Channels>& points, const std::array<float, texels_per_block>& weights,
+		std::array<float, Channels>& first, std::array<float, Channels>& second)
+	{
+		float aa = 0.0f;
+		float bb = 0.0f;
+		float ab = 0.0f;
+		std::array<float, Channels> ax {};
+		std::array<float, Channels> bx {};
+		for (std::uint32_t i = 0; i < texels_per_block; i++) {
+			const auto a = weights[i];
+			const auto b = 1.0f - a;
+			aa += a * a;
+			bb += b * b;
+			ab += a * b;
+			for (std::size_t c = 0; c < Channels; c++) {
+				ax[c] += a * points[i][c];
+				bx[c] += b * points[i][c];
+			}
+		}
+
+		const auto determinant = aa * bb - ab * ab;
+		if (std::abs(determinant) < 1e-6f) {
+			return false;
+		}
+
+		for (std::size_t c = 0; c < Channels; c++) {
+			first[c] = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+			second[c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+		}
+		return true;
+	}
+
+	static bool refine_colour_endpoints(const Points<3>& points, std::uint32_t indices, std::array<float, 3>& first, std::array<float, 3>& second)
+	{
+		static constexpr std::array<float, 4> first_weights = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+		std::array<float, texels_per_block> weights;
+		for (std::uint32_t i = 0; i < texels_per_block; i++) {
+			weights[i] = first_weights[(indices >> (2 * i)) & 3u];
+		}
+		return refine_endpoints(points, weights, first, second);
+	}
+
+	static void write_colour_block(std::uint16_t first, std::uint16_t second, std::uint32_t indices, std::uint8_t* block)
+	{
+		std::memcpy(block, &first, sizeof(first));
+		std::memcpy(block + 2, &second, sizeof(second));
+		std::memcpy(block + 4, &indices, sizeof(indices));
+	}
+
+	/// @brief Encodes the colour half of a BC1 or BC3 block, always in four colour mode.
+	static void encode_colour(const std::uint8_t* texels, std::uint8_t* block)
+	{
+		Points<3> points;
+		for (std::uint32_t i = 0; i < texels_per_block; i++) {
+			for (std::size_t c = 0; c < 3; c++) {
+				points[i][c] = texels[i * 4 + c];
+			}
+		}
+
+		std::array<float, 3> first;
+		std::array<float, 3> second;
+		fit_endpoints(points, first, second);
+
+		const auto order = [](std::uint16_t& a, std::uint16_t& b) {
+			if (a < b) {
+				std::swap(a, b);
+			}
+		};
+
+		auto best_first = pack_565(first);
+		auto best_second = pack_565(second);
+		order(best_first, best_second);
+		if (best_first == best_second) {
+			write_colour_block(best_first, best_second, 0, block);
+			return;
+		}
+
+		std::uint32_t best_indices;
+		auto best_error = select_colour_indices(points, best_first, best_second, best_indices);
+
+		if (refine_colour_endpoints(points, best_indices, first, second)) {
+			auto refined_first = pack_565(first);
+			auto refined_second = pack_565(second);
+			order(refined_first, refined_second);
+
+			std::uint32_t refined_indices;
+			if (refined_first != refined_second) {
+				const auto refined_error = select_colour_indices(points, refined_first, refined_second, refined_indices);
+				if (refined_error < best_error) {
+					best_error = refined_error;
+					best_first = refined_first;
+					best_second = refined_second;
+					best_indices = refined_indices;
+				}
+			}
+		}
+
+		write_colour_block(best_first, best_second, best_indices, block);
+	}
+
+	static void decode_colour(const std::uint8_t* block, std::uint8_t* texels, bool always_four_colours)
+	{
+		std::uint16_t first;
+		std::uint16_t second;
+		std::uint32_t indices;
+		std::memcpy(&first, block, sizeof(first));
+		std::memcpy(&second, block + 2, sizeof(second));
+		std::memcpy(&indices, block + 4, sizeof(indices));
+
+		const auto palette = colour_palette(first, second, always_four_colours);
+		const auto has_transparent_entry = !always_four_colours && first <= second;
+		for (std::uint32_t i = 0; i < texels_per_block; i++) {
+			const auto index = (indices >> (2 * i)) & 3u;
+			for (std::size_t c = 0; c < 3; c++) {
+				texels[i * 4 + c] = static_cast<std::uint8_t>(palette[index][c]);
+			}
+			texels[i * 4 + 3] = has_transparent_entry && index == 3 ? 0 : 255;
+		}
+	}
+
+	static std::array<std::int32_t, 8> channel_palette(std::int32_t first, std::int32_t second)
+	{
+		std::array<std::int32_t, 8> palette { first, second };
+		if (first > second) {
+			for (std::int32_t i = 2; i < 8; i++) {
+				palette[i] = ((8 - i) * first + (i - 1) * second) / 7;
+			}
+		} else {
+			for (std::int32_t i = 2; i < 6; i++) {
+				palette[i] = ((6 - i) * first + (i - 1) * second) / 5;
+			}
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+		return palette;
+	}
+
+	/// @brief Encodes one channel as a BC4 block, as used for BC3 alpha and both halves of BC5.
+	static void encode_channel(const std::uint8_t* texels, std::size_t channel, std::uint8_t* block)
+	{
+		std::int32_t low = 255;
+		std::int32_t high = 0;
+		for (std::uint32_t i = 0; i < texels_per_block; i++) {
+			low = std::min<std::int32_t>(low, texels[i * 4 + channel]);
+			high = std::max<std::int32_t>(high, texels[i * 4 + channel]);
+		}
+
+		std::memset(block, 0, 8);
+		block[0] = static_cast<std::uint8_t>(high);
+		block[1] = static_cast<std::uint8_t>(low);
+		if (high == low) {
+			return;
+		}
+
+		const auto palette = channel_palette(high, low);
+		std::uint64_t indices = 0;
+		for (std::uint32_t i = 0; i < texels_per_block; i++) {
+			const std::int32_t value = texels[i * 4 + channel];
+			std::uint64_t best_index = 0;
+			std::int32_t best_error = std::numeric_limits<std::int32_t>::max();
+			for (std::uint32_t entry = 0; entry < 8; entry++) {
+				const auto error = std::abs(value - palette[entry]);
+				if (error < best_error) {
+					best_error = error;
+					best_index = entry;
+				}
+			}
+			indices |= best_index << (3 * i);
+		}
+
+		for (std::uint32_t i = 0; i < 6; i++) {
+			block[2 + i] = static_cast<std::uint8_t>(indices >> (8 * i));
+		}
+	}
+
+	static void decode_channel(const std::uint8_t* block, std::size_t channel, std::uint8_t* texels)
+	{
+		const auto palette = channel_palette(block[0], block[1]);
+
+		std::uint64_t indices = 0;
+		for (std::uint32_t i = 0; i < 6; i++) {
+			indices |= static_cast<std::uint64_t>(block[2 + i]) << (8 * i);
+		}
+
+		for (std::uint32_t i = 0; i < texels_per_block; i++) {
+			texels[i * 4 + channel] = static_cast<std::uint8_t>(palette[(indices >> (3 * i)) & 7u]);
+		}
+	}
+
+	/// @brief Quantises an endpoint to 7 bits per channel plus a shared p-bit.
+	static std::array<std::uint32_t, 4> quantise_bc7_endpoint(const std::array<float, 4>& endpoint, std::uint32_t p_bit)
+	{
+		std::array<std::uint32_t, 4> quantised;
+		for (std::size_t c = 0; c < 4; c++) {
+			const auto value = std::lround((endpoint[c] - static_cast<float>(p_bit)) / 2.0f);
+			quantised[c] = static_cast<std::uint32_t>(std::clamp<long>(value, 0, 127));
+		}
+		return quantised;
+	}
+
+	static std::array<std::array<std::int32_t, 4>, 16> bc7_palette(
+		const std::array<std::uint32_t, 4>& first, std::uint32_t first_p_bit, const std::array<std::uint32_t, 4>& second, std::uint32_t second_p_bit)
+	{
+		std::array<std::array<std::int32_t, 4>, 16> palette;
+		for (std::size_t c = 0; c < 4; c++) {
+			const auto a = static_cast<std::int32_t>((first[c] << 1) | first_p_bit);
+			const auto b = static_cast<std::int32_t>((second[c] << 1) | second_p_bit);
+			for (std::size_t entry = 0; entry < 16; entry++) {
+				const auto weight = static_cast<std::int32_t>(bc7_weights[entry]);
+				palette[entry][c] = ((64 - weight) * a + weight * b + 32) >> 6;
+			}
+		}
+		return palette;
+	}
+
+	static std::uint32_t select_bc7_indices(
+		const Points<4>& points, const std::array<std::array<std::int32_t, 4>, 16>& palette, std::array<std::uint32_t, 16>& indices)
+	{
+		std::uint32_t total_error = 0;
+		for (std::uint32_t i = 0; i < texels_per_block; i++) {
+			std::uint32_t best_error = std::numeric_limits<std::uint32_t>::max();
+			for (std::uint32_t entry = 0; entry < 16; entry++) {
+				std::uint32_t error = 0;
+				for (std::size_t c = 0; c < 4; c++) {
+					const auto delta = static_cast<std::int32_t>(points[i][c]) - palette[entry][c];
+					error += static_cast<std::uint32_t>(delta * delta);
+				}
+				if (error < best_error) {
+					best_error = error;
+					indices[i] = entry;
+				}
+			}
+			total_error += best_error;
+		}
+		return total_error;
+	}
+
+	static void encode_bc7(const std::uint8_t* texels, std::uint8_t* block)
+	{
+		Points<4> points;
+		for (std::uint32_t i = 0; i < texels_per_block; i++) {
+			for (std::size_t c = 0; c < 4; c++) {
+				points[i][c] = texels[i * 4 + c];
+			}
+		}
+
+		std::array<float, 4> first;
+		std::array<float, 4> second;
+		fit_endpoints(points, second, first);
+
+		std::array<std::uint32_t, 4> best_first {};
+		std::array<std::uint32_t, 4> best_second {};
+		std::uint32_t best_first_p_bit = 0;
+		std::uint32_t best_second_p_bit = 0;
+		std::array<std::uint32_t, 16> best_indices {};
+		std::uint32_t best_error = std::numeric_limits<std::uint32_t>::max();
+
+		// The p-bits are the lowest bit of every channel, trying all four combinations is cheap and noticeably better than rounding.
+		const auto try_endpoints = [&](const std::array<float, 4>& candidate_first, const std::array<float, 4>& candidate_second) {
+			for (std::uint32_t first_p_bit = 0; first_p_bit < 2; first_p_bit++) {
+				for (std::uint32_t second_p_bit = 0; second_p_bit < 2; second_p_bit++) {
+					const auto quantised_first = quantise_bc7_endpoint(candidate_first, first_p_bit);
+					const auto quantised_second = quantise_bc7_endpoint(candidate_second, second_p_bit);
+					const auto palette = bc7_palette(quantised_first, first_p_bit, quantised_second, second_p_bit);
+
+					std::array<std::uint32_t, 16> indices {};
+					const auto error = select_bc7_indices(points, palette, indices);
+					if (error < best_error) {
+						best_error = error;
+						best_first = quantised_first;
+						best_second = quantised_second;
+						best_first_p_bit = first_p_bit;
+						best_second_p_bit = second_p_bit;
+						best_indices = indices;
+					}
+				}
+			}
+		};
+
+		try_endpoints(first, second);
+
+		std::array<float, texels_per_block> weights;
+		for (std::uint32_t i = 0; i < texels_per_block; i++) {
+			weights[i] = static_cast<float>(64 - bc7_weights[best_indices[i]]) / 64.0f;
+		}
+		if (best_error > 0 && refine_endpoints(points, weights, first, second)) {
+			try_endpoints(first, second);
+		}
+
+		// The anchor index is stored with its top bit implied to be zero.
+		if (best_indices[0] & 8u) {
+			std::swap(best_first, best_second);
+			std::swap(best_first_p_bit, best_second_p_bit);
+			for (auto& index : best_indices) {
+				index = 15 - index;
+			}
+		}
+
+		std::memset(block, 0, 16);
+		BitWriter writer { block };
+		writer.write(1u << 6, 7);
+		for (std::size_t c = 0; c < 4; c++) {
+			writer.write(best_first[c], 7);
+			writer.write(best_second[c], 7);
+		}
+		writer.write(best_first_p_bit, 1);
+		writer.write(best_second_p_bit, 1);
+		writer.write(best_indices[0], 3);
+		for (std::uint32_t i = 1; i < texels_per_block; i++) {
+			writer.write(best_indices[i], 4);
+		}
+	}
+
+	static void decode_bc7(const std::uint8_t* block, std::uint8_t* texels)
+	{
+		BitReader reader { block };
+		if (reader.read(7) != (1u << 6)) {
+			// Only mode 6 is produced by the encoder, other modes decode to transparent black.
+			std::memset(texels, 0, texels_per_block * 4);
+			return;
+		}
+
+		std::array<std::uint32_t, 4> first;
+		std::array<std::uint32_t, 4> second;
+		for (std::size_t c = 0; c < 4; c++) {
+			first[c] = reader.read(7);
+			second[c] = reader.read(7);
+		}
+		const auto first_p_bit = reader.read(1);
+		const auto second_p_bit = reader.read(1);
+		const auto palette = bc7_palette(first, first_p_bit, second, second_p_bit);
+
+		for (std::uint32_t i = 0; i < texels_per_block; i++) {
+			const auto index = reader.read(i == 0 ? 3 : 4);
+			for (std::size_t c = 0; c < 4; c++) {
+				texels[i * 4 + c] = static_cast<std::uint8_t>(palette[index][c]);
+			}
+		}
+	}
+
+	std::size_t block_size(BlockFormat format)
+	{
+		switch (format) {
+		case BlockFormat::RGBA8:
+			return texels_per_block * 4;
+		case BlockFormat::BC1:
+			return 8;
+		case BlockFormat::BC3:
+		case BlockFormat::BC5:
+		case BlockFormat::BC7:
+			return 16;
+		}
+		return 16;
+	}
+
+	std::size_t compressed_size(BlockFormat format, std::uint32_t width, std::uint32_t height)
+	{
+		if (format == BlockFormat::RGBA8) {
+			return static_cast<std::size_t>(width) * height * 4;
+		}
+
+		const std::size_t blocks_x = (width + block_dimension - 1) / block_dimension;
+		const std::size_t blocks_y = (height + block_dimension - 1) / block_dimension;
+		return blocks_x * blocks_y * block_size(format);
+	}
+
+	void encode_block(BlockFormat format, const std::uint8_t* texels, std::uint8_t* block)
+	{
+		switch (format) {
+		case BlockFormat::RGBA8:
+			std::memcpy(block, texels, texels_per_block * 4);
+			break;
+		case BlockFormat::BC1:
+			encode_colour(texels, block);
+			break;
+		case BlockFormat::BC3:
+			encode_channel(texels, 3, block);
+			encode_colour(texels, block + 8);
+			break;
+		case BlockFormat::BC5:
+			encode_channel(texels, 0, block);
+			encode_channel(texels, 1, block + 8);
+			break;
+		case BlockFormat::BC7:
+			encode_bc7(texels, block);
+			break;
+		}
+	}
+
+	void decode_block(BlockFormat format, const std::uint8_t* block, std::uint8_t* texels)
+	{
+		switch (format) {
+		case BlockFormat::RGBA8:
+			std::memcpy(texels, block, texels_per_block * 4);
+			break;
+		case BlockFormat::BC1:
+			decode_colour(block, texels, false);
+			break;
+		case BlockFormat::BC3:
+			decode_colour(block + 8, texels, true);
+			decode_channel(block, 3, texels);
+			break;
+		case BlockFormat::BC5:
+			for (std::uint32_t i = 0; i < texels_per_block; i++) {
+				texels[i * 4 + 2] = 0;
+				texels[i * 4 + 3] = 255;
+			}
+			decode_channel(block, 0, texels);
+			decode_channel(block + 8, 1, texels);
+			break;
+		case BlockFormat::BC7:
+			decode_bc7(block, texels);
+			break;
+		}
+	}
+
+	std::vector<std::uint8_t> encode(BlockFormat format, std::span<const std::uint8_t> rgba, std::uint32_t width, std::uint32_t height)
+	{
+		const auto blocks_x = (width + block_dimension - 1) / block_dimension;
+		const auto blocks_y = (height + block_dimension - 1) / block_dimension;
+		const auto bytes_per_block = block_size(format);
+		if (format == BlockFormat::RGBA8) {
+			return { rgba.begin(), rgba.end() };
+		}
+
+		std::vector<std::uint8_t> output(compressed_size(format, width, height));
+		if (output.empty()) {
+			return output;
+		}
+
+		JobSystem::the().parallel_for(0, blocks_y, 1, [&](std::size_t block_y) {
+			std::array<std::uint8_t, texels_per_block * 4> texels;
+			for (std::uint32_t block_x = 0; block_x < blocks_x; block_x++) {
+				// Partial blocks at the edges repeat the last row and column, which keeps the endpoints tight.
+				for (std::uint32_t y = 0; y < block_dimension; y++) {
+					const auto source_y = std::min<std::size_t>(block_y * block_dimension + y, height - 1);
+					for (std::uint32_t x = 0; x < block_dimension; x++) {
+						const auto source_x = std::min<std::size_t>(block_x * block_dimension + x, width - 1);
+						std::memcpy(&texels[(y * block_dimension + x) * 4], &rgba[(source_y * width + source_x) * 4], 4);
+					}
+				}
+				encode_block(format, texels.data(), &output[(block_y * blocks_x + block_x) * bytes_per_block]);
+			}
+		});
+
+		return output;
+	}
+
+	std::vector<std::uint8_t> decode(BlockFormat format, std::span<const std::uint8_t> blocks, std::uint32_t width, std::uint32_t height)
+	{
+		const auto blocks_x = (width + block_dimension - 1) / block_dimension;
+		const auto blocks_y = (height + block_dimension - 1) / block_dimension;
+		const auto bytes_per_block = block_size(format);
+		if (format == BlockFormat::RGBA8) {
+			return { blocks.begin(), blocks.end() };
+		}
+
+		std::vector<std::uint8_t> output(static_cast<std::size_t>(width) * height * 4);
+		std::array<std::uint8_t, texels_per_block * 4> texels;
+		for (std::size_t block_y = 0; block_y < blocks_y; block_y++) {
+			for (std::size_t block_x = 0; block_x < blocks_x; block_x++) {
+				decode_block(format, &blocks[(block_y * blocks_x + block_x) * bytes_per_block], texels.data());
+				for (std::uint32_t y = 0; y < block_dimension; y++) {
+					const auto target_y = block_y * block_dimension + y;
+					for (std::uint32_t x = 0; x < block_dimension; x++) {
+						const auto target_x = block_x * block_dimension + x;
+						if (target_x < width && target_y < height) {
+							std::memcpy(&output[(target_y * width + target_x) * 4], &texels[(y * block_dimension + x) * 4], 4);
+						}
+					}
+				}
+			}
+		}
+		return output;
+	}
+
+} // namespace AssetManager::BlockCompression
@@ -0,0 +1,263 @@
+#include "am_pch.hpp"
+
+#include "compiler/MipChain.hpp"
+
+#include "utilities/JobSystem.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <numbers>
+
+#if defined(__SSE__) || defined(_M_X64)
+#define ALABASTER_MIP_CHAIN_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace AssetManager::MipChain {
+
+	/// @brief One RGBA texel in linear, premultiplied floating point. Sixteen byte aligned so it maps onto one SSE register.
+	struct alignas(16) Texel {
+		std::array<float, 4> channels {};
+	};
+
+	/// @brief accumulator += texel * weight
+	static inline void multiply_add(Texel& accumulator, const Texel& texel, float weight)
+	{
+#ifdef ALABASTER_MIP_CHAIN_SSE
+		const auto product = _mm_mul_ps(_mm_load_ps(texel.channels.data()), _mm_set1_ps(weight));
+		_mm_store_ps(accumulator.channels.data(), _mm_add_ps(_mm_load_ps(accumulator.channels.data()), product));
+#else
+		for (std::size_t c = 0; c < 4; c++) {
+			accumulator.channels[c] += texel.channels[c] * weight;
+		}
+#endif
+	}
+
+	/// @brief Taps applied to the source texels step * target + first + [0, taps).
+	struct Kernel {
+		std::array<float, 8> weights {};
+		std::int32_t first { 0 };
+		std::uint32_t taps { 1 };
+		std::uint32_t step { 1 };
+	};
+
+	static float bessel_i0(float x)
+	{
+		// Power series, converges quickly for the arguments a Kaiser window needs.
+		float sum = 1.0f;
+		float term = 1.0f;
+		for (std::uint32_t k = 1; k < 16; k++) {
+			term *= (x / (2.0f * static_cast<float>(k))) * (x / (2.0f * static_cast<float>(k)));
+			sum += term;
+		}
+		return sum;
+	}
+
+	static float sinc(float x)
+	{
+		if (std::abs(x) < 1e-6f) {
+			return 1.0f;
+		}
+		const auto angle = std::numbers::pi_v<float> * x;
+		return std::sin(angle) / angle;
+	}
+
+	static Kernel make_kernel(MipFilter filter, std::uint32_t source_size)
+	{
+		// A dimension that is already one texel wide stays as it is while the other one keeps shrinking.
+		if (source_size == 1) {
+			return Kernel { .weights = { 1.0f }, .first = 0, .taps = 1, .step = 1 };
+		}
+
+		if (filter == MipFilter::Box) {
+			return Kernel { .weights = { 0.5f, 0.5f }, .first = 0, .taps = 2, .step = 2 };
+		}
+
+		// Windowed sinc over three target texels (six source texels) centred between the two texels a box filter would average.
+		static constexpr float width = 1.5f;
+		static constexpr float alpha = 4.0f;
+		Kernel kernel { .weights = {}, .first = -2, .taps = 6, .step = 2 };
+		float total = 0.0f;
+		for (std::uint32_t tap = 0; tap < kernel.taps; tap++) {
+			const auto distance = (static_cast<float>(kernel.first + static_cast<std::int32_t>(tap)) - 0.5f) / 2.0f;
+			const auto ratio = distance / width;
+			const auto window = bessel_i0(alpha * std::sqrt(std::max(1.0f - ratio * ratio, 0.0f))) / bessel_i0(alpha);
+			kernel.weights[tap] = sinc(distance) * window;
+			total += kernel.weights[tap];
+		}
+		for (auto& weight : kernel.weights) {
+			weight /= total;
+		}
+		return kernel;
+	}
+
+	static constexpr std::uint32_t encoding_steps = 65535;
+
+	/// @brief sRGB to linear for every 8 bit value, and the way back from linear quantised to 16 bits. The steps are far finer than
+	/// the smallest gap between two 8 bit values, so every value survives a round trip exactly.
+	struct TransferTables {
+		std::array<float, 256> to_linear {};
+		std::array<std::uint8_t, encoding_steps + 1> to_encoded {};
+	};
+
+	static const TransferTables& transfer_tables(bool srgb)
+	{
+		static const auto make = [](bool encoded) {
+			TransferTables tables;
+			for (std::uint32_t value = 0; value < 256; value++) {
+				const auto normalised = static_cast<float>(value) / 255.0f;
+				if (!encoded) {
+					tables.to_linear[value] = normalised;
+				} else {
+					tables.to_linear[value] = normalised <= 0.04045f ? normalised / 12.92f : std::pow((normalised + 0.055f) / 1.055f, 2.4f);
+				}
+			}
+
+			std::array<float, 255> midpoints;
+			for (std::uint32_t value = 0; value < 255; value++) {
+				midpoints[value] = 0.5f * (tables.to_linear[value] + tables.to_linear[value + 1]);
+			}
+			for (std::uint32_t step = 0; step <= encoding_steps; step++) {
+				const auto linear = static_cast<float>(step) / static_cast<float>(encoding_steps);
+				tables.to_encoded[step] = static_cast<std::uint8_t>(std::ranges::upper_bound(midpoints, linear) - midpoints.begin());
+			}
+			return tables;
+		};
+
+		static const auto srgb_tables = make(true);
+		static const auto linear_tables = make(false);
+		return srgb ? srgb_tables : linear_tables;
+	}
+
+	/// @param linear value in [0, 1]
+	static std::uint8_t encode(const TransferTables& tables, float linear)
+	{
+		return tables.to_encoded[static_cast<std::uint32_t>(linear * static_cast<float>(encoding_steps) + 0.5f)];
+	}
+
+	static std::vector<Texel> to_linear(
+		std::span<const std::uint8_t> rgba, std::uint32_t width, std::uint32_t height, const MipChainSettings& settings)
+	{
+		const auto& colour = transfer_tables(settings.srgb);
+		const auto& alpha = transfer_tables(false);
+
+		std::vector<Texel> texels(static_cast<std::size_t>(width) * height);
+		JobSystem::the().parallel_for(0, height, 16, [&](std::size_t y) {
+			for (std::size_t x = 0; x < width; x++) {
+				const auto index = y * width + x;
+				const auto* source = &rgba[index * 4];
+				auto& texel = texels[index].channels;
+				texel[3] = alpha.to_linear[source[3]];
+				const auto weight = settings.premultiply_alpha ? texel[3] : 1.0f;
+				for (std::size_t c = 0; c < 3; c++) {
+					texel[c] = colour.to_linear[source[c]] * weight;
+				}
+			}
+		});
+		return texels;
+	}
+
+	static std::vector<std::uint8_t> to_rgba(const std::vector<Texel>& texels, const MipChainSettings& settings)
+	{
+		const auto& colour = transfer_tables(settings.srgb);
+		const auto& alpha = transfer_tables(false);
+
+		static constexpr std::size_t texels_per_job = 4096;
+
+		std::vector<std::uint8_t> rgba(texels.size() * 4);
+		const auto chunks = (texels.size() + texels_per_job - 1) / texels_per_job;
+		JobSystem::the().parallel_for(0, chunks, 1, [&](std::size_t chunk) {
+			const auto end = std::min((chunk + 1) * texels_per_job, texels.size());
+			for (std::size_t index = chunk * texels_per_job; index < end; index++) {
+				const auto& texel = texels[index].channels;
+				auto* target = &rgba[index * 4];
+
+				// Negative lobes of the Kaiser filter can overshoot, and colour can never exceed its coverage once premultiplied.
+				const auto coverage = std::clamp(texel[3], 0.0f, 1.0f);
+				target[3] = encode(alpha, coverage);
+				for (std::size_t c = 0; c < 3; c++) {
+					auto value = std::max(texel[c], 0.0f);
+					if (settings.premultiply_alpha) {
+						value = coverage > 0.0f ? std::min(value, coverage) / coverage : 0.0f;
+					}
+					target[c] = encode(colour, std::min(value, 1.0f));
+				}
+			}
+		});
+		return rgba;
+	}
+
+	/// @brief Separable downsample: rows are filtered into an intermediate image, which is then filtered column wise one row at a time.
+	static std::vector<Texel> downsample(const std::vector<Texel>& source, std::uint32_t width, std::uint32_t height, std::uint32_t target_width,
+		std::uint32_t target_height, MipFilter filter)
+	{
+		const auto horizontal = make_kernel(filter, width);
+		const auto vertical = make_kernel(filter, height);
+
+		const auto clamp_to = [](std::int64_t coordinate, std::uint32_t size) {
+			return static_cast<std::size_t>(std::clamp<std::int64_t>(coordinate, 0, static_cast<std::int64_t>(size) - 1));
+		};
+
+		std::vector<Texel> rows(static_cast<std::size_t>(target_width) * height);
+		JobSystem::the().parallel_for(0, height, 8, [&](std::size_t y) {
+			const auto* source_row = &source[y * width];
+			auto* target_row = &rows[y * target_width];
+			for (std::size_t x = 0; x < target_width; x++) {
+				Texel accumulator;
+				const auto origin = static_cast<std::int64_t>(x * horizontal.step) + horizontal.first;
+				for (std::uint32_t tap = 0; tap < horizontal.taps; tap++) {
+					multiply_add(accumulator, source_row[clamp_to(origin + tap, width)], horizontal.weights[tap]);
+				}
+				target_row[x] = accumulator;
+			}
+		});
+
+		std::vector<Texel> target(static_cast<std::size_t>(target_width) * target_height);
+		JobSystem::the().parallel_for(0, target_height, 8, [&](std::size_t y) {
+			auto* target_row = &target[y * target_width];
+			const auto origin = static_cast<std::int64_t>(y * vertical.step) + vertical.first;
+			for (std::uint32_t tap = 0; tap < vertical.taps; tap++) {
+				const auto* source_row = &rows[clamp_to(origin + tap, height) * target_width];
+				const auto weight = vertical.weights[tap];
+				for (std::size_t x = 0; x < target_width; x++) {
+					multiply_add(target_row[x], source_row[x], weight);
+				}
+			}
+		});
+		return target;
+	}
+
+	std::uint32_t level_count(std::uint32_t width, std::uint32_t height)
+	{
+		return static_cast<std::uint32_t>(std::bit_width(std::max(std::min(width, height), 1u)));
+	}
+
+	std::vector<MipLevel> generate(std::span<const std::uint8_t> rgba, std::uint32_t width, std::uint32_t height, const MipChainSettings& settings)
+	{
+		const auto levels = level_count(width, height);
+
+		std::vector<MipLevel> chain;
+		chain.reserve(levels);
+		chain.push_back({ .width = width, .height = height, .texels = { rgba.begin(), rgba.end() } });
+		if (levels == 1) {
+			return chain;
+		}
+
+		auto level = to_linear(rgba, width, height, settings);
+		auto level_width = width;
+		auto level_height = height;
+		for (std::uint32_t mip = 1; mip < levels; mip++) {
+			const auto target_width = std::max(level_width / 2, 1u);
+			const auto target_height = std::max(level_height / 2, 1u);
+			level = downsample(level, level_width, level_height, target_width, target_height, settings.filter);
+			level_width = target_width;
+			level_height = target_height;
+
+			chain.push_back({ .width = level_width, .height = level_height, .texels = to_rgba(level, settings) });
+		}
+		return chain;
+	}
+
+} // namespace AssetManager::MipChain
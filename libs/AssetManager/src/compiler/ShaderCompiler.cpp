@@ -2,53 +2,106 @@
 
 #include "compiler/ShaderCompiler.hpp"
 
+#include "compiler/ShaderDependencyGraph.hpp"
 #include "compiler/ShaderReflector.hpp"
+#include "compiler/SpirvCache.hpp"
 #include "core/Common.hpp"
+#include "filesystem/FileSystem.hpp"
 #include "utilities/FileInputOutput.hpp"
+#include "utilities/Hash.hpp"
+#include "utilities/JobSystem.hpp"
 
-#include <future>
+#include <chrono>
+#include <exception>
+#include <optional>
 #include <shaderc/shaderc.hpp>
 
+#ifdef ALABASTER_RELEASE
+static constexpr auto should_optimize = true;
+#else
 static constexpr auto should_optimize = false;
+#endif
+static constexpr auto target_spirv_version = shaderc_spirv_version_1_1;
 
 namespace AssetManager {
 
-	std::string preprocess_shader(const std::string& source_name, const shaderc_shader_kind kind, const std::string& source)
-	{
-		const shaderc::Compiler compiler;
-		shaderc::CompileOptions options;
+	/// @brief Resolves #include "file" relative to the including file and #include <file> relative to the shader directory,
+	/// and records every resolved file so callers can track what a shader depends on.
+	class RecordingIncluder : public shaderc::CompileOptions::IncluderInterface {
+	public:
+		explicit RecordingIncluder(std::vector<std::filesystem::path>& included_files)
+			: included(included_files)
+		{
+		}
 
-		// Like -DMY_DEFINE=1
-		options.AddMacroDefinition("MY_DEFINE", "1");
+		shaderc_include_result* GetInclude(
+			const char* requested_source, shaderc_include_type type, const char* requesting_source, std::size_t) override
+		{
+			auto* result = new IncludeResult;
+			const auto resolved = type == shaderc_include_type_relative
+				? std::filesystem::path { requesting_source }.parent_path() / requested_source
+				: Alabaster::FileSystem::shader(requested_source);
+
+			if (Alabaster::IO::is_file(resolved)) {
+				result->name = resolved.generic_string();
+				result->content = Alabaster::IO::read_file(resolved);
+				included.push_back(resolved);
+			} else {
+				result->content = fmt::format("Could not find include {} requested by {}.", requested_source, requesting_source);
+			}
+
+			result->source_name = result->name.data();
+			result->source_name_length = result->name.size();
+			result->content_data = result->content.data();
+			result->content_length = result->content.size();
+			result->user_data = nullptr;
+			return result;
+		}
 
-		const shaderc::PreprocessedSourceCompilationResult result = compiler.PreprocessGlsl(source, kind, source_name.c_str(), options);
+		void ReleaseInclude(shaderc_include_result* data) override { delete static_cast<IncludeResult*>(data); }
 
-		if (result.GetCompilationStatus() != shaderc_compilation_status_success) {
-			Alabaster::Log::error("[ShaderCompiler] {}", result.GetErrorMessage());
-			Alabaster::stop();
-			return "";
-		}
+	private:
+		struct IncludeResult : shaderc_include_result {
+			std::string name;
+			std::string content;
+		};
 
-		return { result.cbegin(), result.cend() };
-	}
+		std::vector<std::filesystem::path>& included;
+	};
 
-	std::vector<std::uint32_t> compile_file(
-		const std::string& source_name, const shaderc_shader_kind kind, const std::string& source, const bool optimize = false)
+	std::uint64_t ShaderCompileOptions::hash() const
 	{
-		const shaderc::Compiler compiler;
-		shaderc::CompileOptions options;
-
-		if constexpr (should_optimize)
-			options.SetOptimizationLevel(shaderc_optimization_level_performance);
+		auto output = Alabaster::Hash::combine(Alabaster::Hash::default_seed, static_cast<std::uint64_t>(target_spirv_version));
+		output = Alabaster::Hash::combine(output, static_cast<std::uint64_t>(optimise || should_optimize));
+		for (const auto& [name, value] : macro_definitions) {
+			output = Alabaster::Hash::combine(output, Alabaster::Hash::hash_string(name));
+			output = Alabaster::Hash::combine(output, Alabaster::Hash::hash_string(value));
+		}
+		return output;
+	}
 
-		if (optimize)
-			options.SetOptimizationLevel(shaderc_optimization_level_performance);
+	/// @brief shaderc::Compiler is expensive to set up and not safe to share, so every worker keeps its own.
+	static const shaderc::Compiler& thread_compiler()
+	{
+		static thread_local const shaderc::Compiler compiler;
+		return compiler;
+	}
 
-		options.SetTargetSpirv(shaderc_spirv_version_1_1);
+	/// @brief Preprocesses and compiles in a single pass, the includer records every file the stage reads on the way.
+	static std::vector<std::uint32_t> compile_glsl(const std::string& source_name, const shaderc_shader_kind kind, const std::string& source,
+		const ShaderCompileOptions& options, std::vector<std::filesystem::path>& included_files)
+	{
+		shaderc::CompileOptions compile_options;
+		for (const auto& [name, value] : options.macro_definitions) {
+			compile_options.AddMacroDefinition(name, value);
+		}
+		compile_options.SetIncluder(std::make_unique<RecordingIncluder>(included_files));
+		compile_options.SetTargetSpirv(target_spirv_version);
 
-		const auto pre_process = preprocess_shader(source_name, kind, source);
+		if (should_optimize || options.optimise)
+			compile_options.SetOptimizationLevel(shaderc_optimization_level_performance);
 
-		const shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(pre_process, kind, source_name.c_str(), options);
+		const shaderc::SpvCompilationResult module = thread_compiler().CompileGlslToSpv(source, kind, source_name.c_str(), compile_options);
 
 		if (module.GetCompilationStatus() != shaderc_compilation_status_success) {
 			throw Alabaster::AlabasterException(
@@ -61,26 +114,90 @@ namespace AssetManager {
 	Alabaster::Shader ShaderCompiler::compile(
 		const std::string& name, const std::filesystem::path& vertex_path, const std::filesystem::path& fragment_path) const
 	{
-		const auto&& [vert_spv, frag_spv] = compile_to_spirv(name, vertex_path, fragment_path);
+		auto [vertex, fragment] = compile_to_spirv(name, vertex_path, fragment_path);
 
-		const auto shader_name = vertex_path.filename();
+		auto reflection = std::move(vertex.reflection);
+		reflection.merge(fragment.reflection);
+		return { name, std::move(vertex.spirv), std::move(fragment.spirv), std::move(reflection) };
+	}
+
+	CompiledStage ShaderCompiler::compile_stage(const std::string& name, const std::filesystem::path& path, std::uint32_t stage) const
+	{
+		using Clock = std::chrono::steady_clock;
+		const auto kind = static_cast<shaderc_shader_kind>(stage);
+		const auto source_name = path.generic_string();
+		const auto source = Alabaster::IO::read_file(path);
+
+		std::vector<std::filesystem::path> included_files;
+		const auto record_dependencies = [&]() {
+			if (dependencies) {
+				dependencies->record(name, path, included_files);
+			}
+		};
+
+		const auto start = Clock::now();
+		const auto options_hash = options.hash();
+		const auto source_hash = Alabaster::Hash::hash_string(source);
+		if (cache) {
+			if (auto cached = cache->find(path, stage, options_hash, source_hash, included_files)) {
+				cache->record_hit(Clock::now() - start);
+				record_dependencies();
+				return std::move(*cached);
+			}
+		}
 
-		ShaderReflector vert_reflector(shader_name.string(), vert_spv);
-		ShaderReflector frag_reflector(shader_name.string(), frag_spv);
+		std::vector<std::uint32_t> spirv;
+		try {
+			spirv = compile_glsl(source_name, kind, source, options, included_files);
+		} catch (const Alabaster::AlabasterException&) {
+			// Keep watching the includes of a broken stage, fixing any of them should trigger a reload.
+			record_dependencies();
+			throw;
+		}
+		record_dependencies();
 
-		return { name, vert_spv, frag_spv };
+		auto reflection = ShaderReflector(spirv).reflection();
+		CompiledStage compiled { .spirv = std::move(spirv), .reflection = std::move(reflection) };
+		if (!cache) {
+			return compiled;
+		}
+
+		SpirvCache::Entry entry { .stage = stage, .options_hash = options_hash, .source_hash = source_hash, .key = 0, .includes = {} };
+		for (const auto& include : included_files) {
+			entry.includes.push_back({ include.generic_string(), SpirvCache::hash_file(include) });
+		}
+		entry.key = SpirvCache::make_key(source_hash, entry.includes, stage, options_hash);
+
+		cache->store(path, std::move(entry), compiled);
+		cache->record_miss(Clock::now() - start);
+		return compiled;
 	}
 
-	std::tuple<std::vector<std::uint32_t>, std::vector<std::uint32_t>> ShaderCompiler::compile_to_spirv(
+	std::tuple<CompiledStage, CompiledStage> ShaderCompiler::compile_to_spirv(
 		const std::string& name, const std::filesystem::path& vertex, const std::filesystem::path& fragment) const
 	{
-		const auto read_vertex = Alabaster::IO::read_file(vertex);
-		const auto read_fragment = Alabaster::IO::read_file(fragment);
+		// The fragment stage goes to the job system while this thread compiles the vertex stage. Waiting on the job keeps
+		// this thread busy with other work, so nesting inside an outer parallel_for cannot starve the pool.
+		CompiledStage fragment_spv;
+		auto& jobs = JobSystem::the();
+		const auto fragment_job = jobs.submit([this, &name, &fragment, &fragment_spv] {
+			fragment_spv = compile_stage(name, fragment, static_cast<std::uint32_t>(shaderc_fragment_shader));
+		});
+
+		std::optional<CompiledStage> vertex_spv;
+		std::exception_ptr vertex_error;
+		try {
+			vertex_spv = compile_stage(name, vertex, static_cast<std::uint32_t>(shaderc_vertex_shader));
+		} catch (...) {
+			vertex_error = std::current_exception();
+		}
 
-		const auto vertex_spv = compile_file(name, shaderc_vertex_shader, read_vertex);
-		const auto fragment_spv = compile_file(name, shaderc_fragment_shader, read_fragment);
+		jobs.wait(fragment_job);
+		if (vertex_error) {
+			std::rethrow_exception(vertex_error);
+		}
 
-		return { vertex_spv, fragment_spv };
+		return { std::move(*vertex_spv), std::move(fragment_spv) };
 	}
 
 } // namespace AssetManager
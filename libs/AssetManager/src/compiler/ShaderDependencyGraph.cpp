@@ -0,0 +1,72 @@
+#include "am_pch.hpp"
+
+#include "compiler/ShaderDependencyGraph.hpp"
+
+#include <algorithm>
+
+namespace AssetManager {
+
+	std::string ShaderDependencyGraph::normalise(const std::filesystem::path& path)
+	{
+		std::error_code error;
+		const auto canonical = std::filesystem::weakly_canonical(path, error);
+		if (error) {
+			return path.lexically_normal().generic_string();
+		}
+		return canonical.generic_string();
+	}
+
+	void ShaderDependencyGraph::record(
+		const std::string& shader_name, const std::filesystem::path& stage_path, const std::vector<std::filesystem::path>& included_files)
+	{
+		const auto stage_file = normalise(stage_path);
+		// Variants of a shader compile the same stage file, possibly with different includes.
+		const auto stage = shader_name + "|" + stage_file;
+
+		std::vector<std::string> files;
+		files.reserve(included_files.size() + 1);
+		files.push_back(stage_file);
+		for (const auto& include : included_files) {
+			files.push_back(normalise(include));
+		}
+
+		std::scoped_lock lock { mutex };
+		if (const auto previous = stage_files.find(stage); previous != stage_files.end()) {
+			for (const auto& file : previous->second) {
+				if (auto found = file_stages.find(file); found != file_stages.end()) {
+					found->second.erase(stage);
+					if (found->second.empty()) {
+						file_stages.erase(found);
+					}
+				}
+			}
+		}
+
+		for (const auto& file : files) {
+			file_stages[file].insert(stage);
+		}
+		stage_owners[stage] = shader_name;
+		stage_files[stage] = std::move(files);
+	}
+
+	std::vector<std::string> ShaderDependencyGraph::dependants(const std::filesystem::path& file) const
+	{
+		std::vector<std::string> output;
+
+		std::scoped_lock lock { mutex };
+		const auto found = file_stages.find(normalise(file));
+		if (found == file_stages.end()) {
+			return output;
+		}
+
+		for (const auto& stage : found->second) {
+			output.push_back(stage_owners.at(stage));
+		}
+
+		std::ranges::sort(output);
+		const auto [first, last] = std::ranges::unique(output);
+		output.erase(first, last);
+		return output;
+	}
+
+} // namespace AssetManager
@@ -0,0 +1,60 @@
+#include "am_pch.hpp"
+
+#include "compiler/ShaderVariant.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+namespace AssetManager {
+
+	ShaderVariantKey::ShaderVariantKey(std::string shader_name, std::vector<std::string> keyword_defines)
+		: shader(std::move(shader_name))
+		, keywords(std::move(keyword_defines))
+	{
+		std::ranges::sort(keywords);
+		const auto [first, last] = std::ranges::unique(keywords);
+		keywords.erase(first, last);
+	}
+
+	std::string ShaderVariantKey::name() const
+	{
+		if (keywords.empty()) {
+			return shader;
+		}
+
+		auto output = shader + "[";
+		for (std::size_t i = 0; i < keywords.size(); i++) {
+			output += i == 0 ? "" : ",";
+			output += keywords[i];
+		}
+		return output + "]";
+	}
+
+	std::vector<ShaderVariantKey> parse_variant_manifest(std::string_view manifest)
+	{
+		std::vector<ShaderVariantKey> output;
+
+		std::istringstream lines { std::string { manifest } };
+		std::string line;
+		while (std::getline(lines, line)) {
+			if (const auto comment = line.find('#'); comment != std::string::npos) {
+				line.erase(comment);
+			}
+
+			std::istringstream words { line };
+			std::string shader;
+			if (!(words >> shader)) {
+				continue;
+			}
+
+			std::vector<std::string> keywords;
+			for (std::string keyword; words >> keyword;) {
+				keywords.push_back(std::move(keyword));
+			}
+			output.emplace_back(std::move(shader), std::move(keywords));
+		}
+
+		return output;
+	}
+
+} // namespace AssetManager
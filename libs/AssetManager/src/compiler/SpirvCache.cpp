@@ -0,0 +1,429 @@
+#include "am_pch.hpp"
+
+#include "compiler/SpirvCache.hpp"
+
+#include "cache/AssetDatabase.hpp"
+#include "compiler/ShaderReflector.hpp"
+#include "core/Logger.hpp"
+#include "filesystem/FileSystem.hpp"
+#include "utilities/Hash.hpp"
+
+#include <fstream>
+#include <thread>
+
+namespace AssetManager {
+
+	static constexpr std::uint32_t manifest_magic = 0x56505341; // "ASPV"
+	static constexpr std::uint32_t manifest_version = 2;
+	static constexpr auto manifest_filename = "manifest.bin";
+	static constexpr std::uint32_t reflection_magic = 0x4C465241; // "ARFL"
+	static constexpr std::uint32_t reflection_version = 1;
+
+	template <typename T> static void write_pod(std::ofstream& stream, const T& value)
+	{
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template <typename T> static bool read_pod(std::ifstream& stream, T& value)
+	{
+		stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+		return static_cast<bool>(stream);
+	}
+
+	static void write_string(std::ofstream& stream, const std::string& value)
+	{
+		write_pod(stream, static_cast<std::uint32_t>(value.size()));
+		stream.write(value.data(), static_cast<std::streamsize>(value.size()));
+	}
+
+	/// @return how many bytes are left before end, the size of the file being read
+	static std::uint64_t remaining(std::ifstream& stream, std::uint64_t end)
+	{
+		const auto position = stream.tellg();
+		return position < 0 || static_cast<std::uint64_t>(position) > end ? 0 : end - static_cast<std::uint64_t>(position);
+	}
+
+	/// @return false if the stream ended, or if the length reaches past the end
+	static bool read_string(std::ifstream& stream, std::uint64_t end, std::string& value)
+	{
+		std::uint32_t size;
+		if (!read_pod(stream, size) || size > remaining(stream, end)) {
+			return false;
+		}
+		value.resize(size);
+		stream.read(value.data(), size);
+		return static_cast<bool>(stream);
+	}
+
+	SpirvCache::SpirvCache(std::filesystem::path cache_directory, AssetDatabase* asset_database)
+		: directory(std::move(cache_directory))
+		, database(asset_database)
+	{
+		std::error_code error;
+		std::filesystem::create_directories(directory, error);
+		if (error) {
+			Alabaster::Log::warn("[SpirvCache] Could not create cache directory {}. Reason: {}", directory.string(), error.message());
+		}
+
+		read_manifest();
+	}
+
+	SpirvCache::~SpirvCache() { flush(); }
+
+	std::uint64_t SpirvCache::make_key(
+		std::uint64_t source_hash, const std::vector<IncludedFile>& includes, std::uint32_t stage, std::uint64_t options_hash)
+	{
+		auto key = source_hash;
+		for (const auto& include : includes) {
+			key = Alabaster::Hash::combine(key, include.hash);
+		}
+		key = Alabaster::Hash::combine(key, stage);
+		return Alabaster::Hash::combine(key, options_hash);
+	}
+
+	std::uint64_t SpirvCache::hash_file(const std::filesystem::path& path)
+	{
+		const auto file = Alabaster::FileSystem::read(path);
+		if (!file) {
+			return 0;
+		}
+		return Alabaster::Hash::hash_string(file->text());
+	}
+
+	std::string SpirvCache::manifest_key(const std::filesystem::path& source_path, std::uint32_t stage, std::uint64_t options_hash)
+	{
+		return fmt::format("{}:{}:{}", source_path.generic_string(), stage, Alabaster::Hash::to_hex(options_hash));
+	}
+
+	std::filesystem::path SpirvCache::blob_path(std::uint64_t key) const { return directory / (Alabaster::Hash::to_hex(key) + ".spv"); }
+
+	std::filesystem::path SpirvCache::reflection_path(std::uint64_t key) const
+	{
+		return directory / (Alabaster::Hash::to_hex(key) + ".reflection");
+	}
+
+	std::optional<CompiledStage> SpirvCache::find(const std::filesystem::path& source_path, std::uint32_t stage,
+		std::uint64_t options_hash, std::uint64_t source_hash, std::vector<std::filesystem::path>& included_files)
+	{
+		Entry entry;
+		{
+			std::scoped_lock lock { mutex };
+			const auto found = manifest.find(manifest_key(source_path, stage, options_hash));
+			if (found == manifest.end()) {
+				return {};
+			}
+			entry = found->second;
+		}
+
+		if (entry.options_hash != options_hash || entry.source_hash != source_hash) {
+			return {};
+		}
+
+		// The database tracks the includes by size and modification time, so unchanged ones are not hashed again.
+		const auto vouched = database && !database->is_stale(source_path, manifest_version, blob_path(entry.key));
+		if (!vouched) {
+			for (const auto& [include_path, include_hash] : entry.includes) {
+				if (hash_file(include_path) != include_hash) {
+					return {};
+				}
+			}
+		}
+
+		auto compiled = load(entry.key);
+		if (compiled) {
+			for (const auto& include : entry.includes) {
+				included_files.emplace_back(include.path);
+			}
+			if (database && !vouched) {
+				database->record_import(source_path, manifest_version, { blob_path(entry.key) }, included_files);
+			}
+		}
+		return compiled;
+	}
+
+	std::optional<CompiledStage> SpirvCache::load(std::uint64_t key)
+	{
+		std::ifstream stream(blob_path(key), std::ios::binary | std::ios::ate);
+		if (!stream) {
+			return {};
+		}
+
+		const auto size = static_cast<std::size_t>(stream.tellg());
+		if (size == 0 || size % sizeof(std::uint32_t) != 0) {
+			return {};
+		}
+
+		std::vector<std::uint32_t> spirv(size / sizeof(std::uint32_t));
+		stream.seekg(0);
+		stream.read(reinterpret_cast<char*>(spirv.data()), static_cast<std::streamsize>(size));
+		if (!stream) {
+			return {};
+		}
+
+		if (auto reflection = read_reflection(key)) {
+			return CompiledStage { .spirv = std::move(spirv), .reflection = std::move(*reflection) };
+		}
+
+		// Blob written before reflections were cached.
+		auto reflection = ShaderReflector(spirv).reflection();
+		write_reflection(key, reflection);
+		return CompiledStage { .spirv = std::move(spirv), .reflection = std::move(reflection) };
+	}
+
+	std::optional<Alabaster::ShaderReflection> SpirvCache::read_reflection(std::uint64_t key) const
+	{
+		const auto path = reflection_path(key);
+		std::ifstream stream(path, std::ios::binary);
+		std::error_code error;
+		const auto end = std::filesystem::file_size(path, error);
+		if (!stream || error) {
+			return {};
+		}
+
+		// Counts reaching past the end of the file are corruption, the blob is reflected again like one without a reflection.
+		using Binding = Alabaster::DescriptorBinding;
+		using Block = Alabaster::PushConstantBlock;
+		constexpr auto binding_size = sizeof(Binding::set) + sizeof(Binding::binding) + sizeof(Binding::type) + sizeof(Binding::count)
+			+ sizeof(Binding::stages);
+		constexpr auto block_size = sizeof(Block::offset) + sizeof(Block::size) + sizeof(Block::stages);
+
+		std::uint32_t magic;
+		std::uint32_t version;
+		std::uint32_t binding_count;
+		if (!read_pod(stream, magic) || !read_pod(stream, version) || magic != reflection_magic || version != reflection_version
+			|| !read_pod(stream, binding_count) || binding_count > remaining(stream, end) / binding_size) {
+			return {};
+		}
+
+		Alabaster::ShaderReflection reflection;
+		reflection.bindings.resize(binding_count);
+		for (auto& binding : reflection.bindings) {
+			if (!read_pod(stream, binding.set) || !read_pod(stream, binding.binding) || !read_pod(stream, binding.type)
+				|| !read_pod(stream, binding.count) || !read_pod(stream, binding.stages)) {
+				return {};
+			}
+		}
+
+		std::uint32_t push_constant_count;
+		if (!read_pod(stream, push_constant_count) || push_constant_count > remaining(stream, end) / block_size) {
+			return {};
+		}
+		reflection.push_constants.resize(push_constant_count);
+		for (auto& block : reflection.push_constants) {
+			if (!read_pod(stream, block.offset) || !read_pod(stream, block.size) || !read_pod(stream, block.stages)) {
+				return {};
+			}
+		}
+
+		return reflection;
+	}
+
+	void SpirvCache::write_reflection(std::uint64_t key, const Alabaster::ShaderReflection& reflection) const
+	{
+		const auto output_path = reflection_path(key);
+		const auto thread_hash = std::hash<std::thread::id> {}(std::this_thread::get_id());
+		const auto temporary_path = std::filesystem::path { output_path }.concat(fmt::format(".{}.tmp", thread_hash));
+		{
+			std::ofstream stream(temporary_path, std::ios::binary | std::ios::trunc);
+			if (!stream) {
+				Alabaster::Log::warn("[SpirvCache] Could not write {}.", output_path.string());
+				return;
+			}
+
+			write_pod(stream, reflection_magic);
+			write_pod(stream, reflection_version);
+			write_pod(stream, static_cast<std::uint32_t>(reflection.bindings.size()));
+			for (const auto& binding : reflection.bindings) {
+				write_pod(stream, binding.set);
+				write_pod(stream, binding.binding);
+				write_pod(stream, binding.type);
+				write_pod(stream, binding.count);
+				write_pod(stream, binding.stages);
+			}
+			write_pod(stream, static_cast<std::uint32_t>(reflection.push_constants.size()));
+			for (const auto& block : reflection.push_constants) {
+				write_pod(stream, block.offset);
+				write_pod(stream, block.size);
+				write_pod(stream, block.stages);
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temporary_path, output_path, error);
+		if (error) {
+			std::filesystem::remove(temporary_path, error);
+		}
+	}
+
+	void SpirvCache::store(const std::filesystem::path& source_path, Entry entry, const CompiledStage& compiled)
+	{
+		const auto& spirv = compiled.spirv;
+		const auto output_path = blob_path(entry.key);
+		const auto thread_hash = std::hash<std::thread::id> {}(std::this_thread::get_id());
+		const auto temporary_path = std::filesystem::path { output_path }.concat(fmt::format(".{}.tmp", thread_hash));
+		{
+			std::ofstream stream(temporary_path, std::ios::binary | std::ios::trunc);
+			if (!stream) {
+				Alabaster::Log::warn("[SpirvCache] Could not write {}.", output_path.string());
+				return;
+			}
+			stream.write(reinterpret_cast<const char*>(spirv.data()), static_cast<std::streamsize>(spirv.size() * sizeof(std::uint32_t)));
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temporary_path, output_path, error);
+		if (error) {
+			std::filesystem::remove(temporary_path, error);
+			return;
+		}
+
+		write_reflection(entry.key, compiled.reflection);
+		if (database) {
+			std::vector<std::filesystem::path> included_files;
+			for (const auto& include : entry.includes) {
+				included_files.emplace_back(include.path);
+			}
+			database->record_import(source_path, manifest_version, { output_path }, included_files);
+		}
+		update(source_path, std::move(entry));
+	}
+
+	void SpirvCache::update(const std::filesystem::path& source_path, Entry entry)
+	{
+		std::scoped_lock lock { mutex };
+		manifest[manifest_key(source_path, entry.stage, entry.options_hash)] = std::move(entry);
+		dirty = true;
+	}
+
+	void SpirvCache::read_manifest()
+	{
+		const auto manifest_path = directory / manifest_filename;
+		std::ifstream stream(manifest_path, std::ios::binary);
+		std::error_code error;
+		const auto end = std::filesystem::file_size(manifest_path, error);
+		if (!stream || error) {
+			return;
+		}
+
+		std::uint32_t magic;
+		std::uint32_t version;
+		std::uint32_t count;
+		if (!read_pod(stream, magic) || !read_pod(stream, version) || !read_pod(stream, count)) {
+			return;
+		}
+
+		if (magic != manifest_magic || version != manifest_version) {
+			Alabaster::Log::info("[SpirvCache] Ignoring manifest with an unknown version.");
+			return;
+		}
+
+		// A length or count reaching past the end of the file is corruption rather than an interrupted write, so none of the entries
+		// read so far can be trusted either.
+		const auto stop = [this, &stream] {
+			if (stream) {
+				Alabaster::Log::warn("[SpirvCache] Manifest is corrupt, ignoring it.");
+				manifest.clear();
+			} else {
+				Alabaster::Log::warn("[SpirvCache] Manifest is truncated, ignoring the remaining entries.");
+			}
+		};
+
+		// Every include takes at least its path's length and its hash.
+		constexpr auto include_size = sizeof(std::uint32_t) + sizeof(IncludedFile::hash);
+		for (std::uint32_t i = 0; i < count; i++) {
+			std::string key;
+			Entry entry;
+			std::uint32_t include_count;
+			if (!read_string(stream, end, key) || !read_pod(stream, entry.stage) || !read_pod(stream, entry.options_hash)
+				|| !read_pod(stream, entry.source_hash) || !read_pod(stream, entry.key) || !read_pod(stream, include_count)
+				|| include_count > remaining(stream, end) / include_size) {
+				stop();
+				return;
+			}
+
+			entry.includes.resize(include_count);
+			for (auto& include : entry.includes) {
+				if (!read_string(stream, end, include.path) || !read_pod(stream, include.hash)) {
+					stop();
+					return;
+				}
+			}
+
+			manifest.try_emplace(std::move(key), std::move(entry));
+		}
+	}
+
+	void SpirvCache::flush()
+	{
+		std::scoped_lock lock { mutex };
+		if (!dirty) {
+			return;
+		}
+
+		const auto manifest_path = directory / manifest_filename;
+		const auto temporary_path = std::filesystem::path { manifest_path }.concat(".tmp");
+		{
+			std::ofstream stream(temporary_path, std::ios::binary | std::ios::trunc);
+			if (!stream) {
+				Alabaster::Log::warn("[SpirvCache] Could not write manifest to {}.", manifest_path.string());
+				return;
+			}
+
+			write_pod(stream, manifest_magic);
+			write_pod(stream, manifest_version);
+			write_pod(stream, static_cast<std::uint32_t>(manifest.size()));
+			for (const auto& [key, entry] : manifest) {
+				write_string(stream, key);
+				write_pod(stream, entry.stage);
+				write_pod(stream, entry.options_hash);
+				write_pod(stream, entry.source_hash);
+				write_pod(stream, entry.key);
+				write_pod(stream, static_cast<std::uint32_t>(entry.includes.size()));
+				for (const auto& include : entry.includes) {
+					write_string(stream, include.path);
+					write_pod(stream, include.hash);
+				}
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temporary_path, manifest_path, error);
+		if (error) {
+			Alabaster::Log::warn("[SpirvCache] Could not replace manifest. Reason: {}", error.message());
+			return;
+		}
+		dirty = false;
+	}
+
+	void SpirvCache::record_hit(std::chrono::nanoseconds load_time)
+	{
+		hits.fetch_add(1, std::memory_order_relaxed);
+		load_nanoseconds.fetch_add(load_time.count(), std::memory_order_relaxed);
+	}
+
+	void SpirvCache::record_miss(std::chrono::nanoseconds compile_time)
+	{
+		misses.fetch_add(1, std::memory_order_relaxed);
+		compile_nanoseconds.fetch_add(compile_time.count(), std::memory_order_relaxed);
+	}
+
+	SpirvCacheStatistics SpirvCache::statistics() const
+	{
+		static constexpr auto to_milliseconds = [](std::int64_t nanoseconds) { return static_cast<double>(nanoseconds) / 1.0e6; };
+		return {
+			.hits = hits.load(std::memory_order_relaxed),
+			.misses = misses.load(std::memory_order_relaxed),
+			.load_milliseconds = to_milliseconds(load_nanoseconds.load(std::memory_order_relaxed)),
+			.compile_milliseconds = to_milliseconds(compile_nanoseconds.load(std::memory_order_relaxed)),
+		};
+	}
+
+	void SpirvCache::reset_statistics()
+	{
+		hits = 0;
+		misses = 0;
+		load_nanoseconds = 0;
+		compile_nanoseconds = 0;
+	}
+
+} // namespace AssetManager
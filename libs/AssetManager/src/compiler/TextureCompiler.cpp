@@ -0,0 +1,228 @@
+#include "am_pch.hpp"
+
+#include "compiler/TextureCompiler.hpp"
+
+#include "cache/AssetDatabase.hpp"
+#include "core/Logger.hpp"
+#include "filesystem/FileSystem.hpp"
+#include "graphics/Texture.hpp"
+#include "utilities/Hash.hpp"
+
+#include <fstream>
+#include <thread>
+
+namespace AssetManager {
+
+	static constexpr std::uint32_t container_magic = 0x58455441; // "ATEX"
+	static constexpr std::uint32_t container_version = 2;
+	static constexpr std::uint64_t mip_alignment = 16;
+
+	template <typename T> static void write_pod(std::ofstream& stream, const T& value)
+	{
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template <typename T> static bool read_pod(std::ifstream& stream, T& value)
+	{
+		stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+		return static_cast<bool>(stream);
+	}
+
+	static MipChainSettings mip_chain_settings(BlockFormat format, MipFilter filter)
+	{
+		// BC5 holds two channels of data (normal maps), everything else is colour, and only BC1 has nowhere to keep partial coverage.
+		return MipChainSettings {
+			.filter = filter,
+			.srgb = format != BlockFormat::BC5,
+			.premultiply_alpha = format != BlockFormat::BC1 && format != BlockFormat::BC5,
+		};
+	}
+
+	TextureCompiler::TextureCompiler(std::filesystem::path cache_directory, AssetDatabase* asset_database)
+		: directory(std::move(cache_directory))
+		, database(asset_database)
+	{
+		std::error_code error;
+		std::filesystem::create_directories(directory, error);
+		if (error) {
+			Alabaster::Log::warn("[TextureCompiler] Could not create cache directory {}. Reason: {}", directory.string(), error.message());
+		}
+	}
+
+	std::uint32_t TextureCompiler::mip_count(std::uint32_t width, std::uint32_t height)
+	{
+		return MipChain::level_count(width, height);
+	}
+
+	CompressedTexture TextureCompiler::compress(
+		BlockFormat format, std::span<const std::uint8_t> rgba, std::uint32_t width, std::uint32_t height, MipFilter filter)
+	{
+		CompressedTexture texture;
+		texture.format = format;
+		texture.width = width;
+		texture.height = height;
+
+		const auto levels = MipChain::generate(rgba, width, height, mip_chain_settings(format, filter));
+		for (const auto& level : levels) {
+			const auto blocks = BlockCompression::encode(format, level.texels, level.width, level.height);
+			const auto offset = (texture.data.size() + mip_alignment - 1) & ~(mip_alignment - 1);
+			texture.data.resize(offset + blocks.size());
+			std::ranges::copy(blocks, texture.data.begin() + static_cast<std::ptrdiff_t>(offset));
+			texture.mips.push_back({ .width = level.width, .height = level.height, .offset = offset, .size = blocks.size() });
+		}
+
+		return texture;
+	}
+
+	bool TextureCompiler::write(const std::filesystem::path& path, const CompressedTexture& texture)
+	{
+		const auto thread_hash = std::hash<std::thread::id> {}(std::this_thread::get_id());
+		const auto temporary_path = std::filesystem::path { path }.concat(fmt::format(".{}.tmp", thread_hash));
+		{
+			std::ofstream stream(temporary_path, std::ios::binary | std::ios::trunc);
+			if (!stream) {
+				return false;
+			}
+
+			write_pod(stream, container_magic);
+			write_pod(stream, container_version);
+			write_pod(stream, static_cast<std::uint32_t>(texture.format));
+			write_pod(stream, texture.width);
+			write_pod(stream, texture.height);
+			write_pod(stream, texture.source_hash);
+			write_pod(stream, static_cast<std::uint32_t>(texture.mips.size()));
+			for (const auto& mip : texture.mips) {
+				write_pod(stream, mip.width);
+				write_pod(stream, mip.height);
+				write_pod(stream, mip.offset);
+				write_pod(stream, mip.size);
+			}
+			write_pod(stream, static_cast<std::uint64_t>(texture.data.size()));
+			stream.write(reinterpret_cast<const char*>(texture.data.data()), static_cast<std::streamsize>(texture.data.size()));
+			if (!stream) {
+				return false;
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temporary_path, path, error);
+		if (error) {
+			std::filesystem::remove(temporary_path, error);
+			return false;
+		}
+		return true;
+	}
+
+	/// @return how many bytes are left before end, the size of the file being read
+	static std::uint64_t remaining(std::ifstream& stream, std::uint64_t end)
+	{
+		const auto position = stream.tellg();
+		return position < 0 || static_cast<std::uint64_t>(position) > end ? 0 : end - static_cast<std::uint64_t>(position);
+	}
+
+	std::optional<CompressedTexture> TextureCompiler::read(const std::filesystem::path& path)
+	{
+		std::ifstream stream(path, std::ios::binary);
+		std::error_code error;
+		const auto end = std::filesystem::file_size(path, error);
+		if (!stream || error) {
+			return {};
+		}
+
+		std::uint32_t magic;
+		std::uint32_t version;
+		std::uint32_t format;
+		std::uint32_t count;
+		CompressedTexture texture;
+		if (!read_pod(stream, magic) || !read_pod(stream, version) || magic != container_magic || version != container_version) {
+			return {};
+		}
+		if (!read_pod(stream, format) || !read_pod(stream, texture.width) || !read_pod(stream, texture.height)
+			|| !read_pod(stream, texture.source_hash) || !read_pod(stream, count)) {
+			return {};
+		}
+		texture.format = static_cast<BlockFormat>(format);
+
+		// Lengths and counts reaching past the end of the file are corruption, the texture is compressed again.
+		constexpr auto mip_size = 2 * sizeof(std::uint32_t) + 2 * sizeof(std::uint64_t);
+		if (count > MipChain::level_count(texture.width, texture.height) || count > remaining(stream, end) / mip_size) {
+			return {};
+		}
+		texture.mips.resize(count);
+		for (auto& mip : texture.mips) {
+			if (!read_pod(stream, mip.width) || !read_pod(stream, mip.height) || !read_pod(stream, mip.offset) || !read_pod(stream, mip.size)) {
+				return {};
+			}
+		}
+
+		std::uint64_t size;
+		if (!read_pod(stream, size) || size > remaining(stream, end)) {
+			return {};
+		}
+		// Each level is uploaded as a copy region of its size, it has to hold exactly the blocks covering the level and lie in the data.
+		for (std::size_t i = 0; i < texture.mips.size(); i++) {
+			const auto& mip = texture.mips[i];
+			if (mip.width != std::max(texture.width >> i, 1u) || mip.height != std::max(texture.height >> i, 1u)
+				|| mip.size != BlockCompression::compressed_size(texture.format, mip.width, mip.height) || mip.offset > size
+				|| mip.size > size - mip.offset) {
+				return {};
+			}
+		}
+
+		texture.data.resize(size);
+		stream.read(reinterpret_cast<char*>(texture.data.data()), static_cast<std::streamsize>(size));
+		if (!stream) {
+			return {};
+		}
+		return texture;
+	}
+
+	std::filesystem::path TextureCompiler::container_path(const std::filesystem::path& source, BlockFormat format) const
+	{
+		const auto key = Alabaster::Hash::combine(Alabaster::Hash::hash_string(source.generic_string()), static_cast<std::uint64_t>(format));
+		return directory / fmt::format("{}.atex", Alabaster::Hash::to_hex(key));
+	}
+
+	std::optional<CompressedTexture> TextureCompiler::load_or_compress(const std::filesystem::path& source, BlockFormat format) const
+	{
+		const auto output_path = container_path(source, format);
+		// The database vouches for the source without reading it, which is most of the cost of a warm start.
+		if (database && !database->is_stale(source, container_version, output_path)) {
+			if (auto cached = read(output_path); cached && cached->format == format) {
+				return cached;
+			}
+		}
+
+		const auto file = Alabaster::FileSystem::read(source);
+		if (!file) {
+			return {};
+		}
+		const auto source_hash = Alabaster::Hash::hash_bytes(file->bytes.data(), file->bytes.size());
+
+		if (auto cached = read(output_path); cached && cached->source_hash == source_hash && cached->format == format) {
+			if (database) {
+				database->record_import(source, container_version, { output_path });
+			}
+			return cached;
+		}
+
+		auto decoded = Alabaster::Texture::decode(file->bytes);
+		if (!decoded || decoded.format != Alabaster::ImageFormat::RGBA) {
+			decoded.release();
+			return {};
+		}
+
+		const std::span<const std::uint8_t> rgba { static_cast<const std::uint8_t*>(decoded.pixels.data), decoded.pixels.size };
+		auto compressed = compress(format, rgba, decoded.width, decoded.height);
+		compressed.source_hash = source_hash;
+		decoded.release();
+
+		if (!write(output_path, compressed)) {
+			Alabaster::Log::warn("[TextureCompiler] Could not write {}.", output_path.string());
+		} else if (database) {
+			database->record_import(source, container_version, { output_path });
+		}
+		return compressed;
+	}
+
+} // namespace AssetManager
@@ -1,12 +1,231 @@
 #include "watcher/FileWatcher.hpp"
 
+#include "core/Logger.hpp"
+
 #include <algorithm>
+#include <array>
+#include <cerrno>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
 
 namespace AssetManager {
 
-	void FileWatcher::for_each(const FileInformation& info, const std::vector<std::function<void(const FileInformation&)>>& vec)
+	static constexpr std::uint32_t watch_mask
+		= IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR | IN_EXCL_UNLINK;
+
+	// Upper bound on how long stop() waits for the watcher thread.
+	static constexpr std::chrono::milliseconds idle_wakeup { 100 };
+
+	/// @brief inotify watches one directory per descriptor, so the tree is mirrored here: every watched directory, and every file
+	/// below them so that a file written through a rename can be told apart from a new one.
+	class InotifyTree {
+	public:
+		explicit InotifyTree(int in_descriptor)
+			: descriptor(in_descriptor)
+		{
+		}
+
+		/// @brief Watches a directory, and everything below it when recursive.
+		/// @param found called for every file and directory that already exists below it
+		template <typename Found> void watch(const std::filesystem::path& directory, bool recursive, Found&& found)
+		{
+			const auto watch_descriptor = inotify_add_watch(descriptor, directory.c_str(), watch_mask);
+			if (watch_descriptor < 0) {
+				// ENOSPC means fs.inotify.max_user_watches is exhausted, everything else is a directory that vanished under us.
+				if (errno == ENOSPC) {
+					Alabaster::Log::warn("[FileWatcher] Out of inotify watches at {}, raise fs.inotify.max_user_watches.", directory.string());
+				}
+				return;
+			}
+			// Watching the same directory twice hands back the same descriptor, and a recursive watch must stay recursive.
+			const auto [watched, inserted] = directories.try_emplace(watch_descriptor, Directory { .path = directory, .recursive = recursive });
+			if (!inserted) {
+				watched->second.recursive = watched->second.recursive || recursive;
+			}
+
+			std::error_code error;
+			for (const auto& entry : std::filesystem::directory_iterator { directory, error }) {
+				if (entry.is_directory(error)) {
+					found(entry.path(), true);
+					if (recursive) {
+						watch(entry.path(), true, found);
+					}
+				} else {
+					files.insert(entry.path().string());
+					found(entry.path(), false);
+				}
+			}
+		}
+
+		/// @brief Stops watching a directory and everything below it.
+		/// @param removed called for every known file below it
+		template <typename Removed> void forget(const std::filesystem::path& directory, Removed&& removed)
+		{
+			const auto prefix = directory.string() + static_cast<char>(std::filesystem::path::preferred_separator);
+			for (auto it = directories.begin(); it != directories.end();) {
+				if (it->second.path == directory || it->second.path.string().starts_with(prefix)) {
+					inotify_rm_watch(descriptor, it->first);
+					it = directories.erase(it);
+				} else {
+					++it;
+				}
+			}
+			for (auto it = files.begin(); it != files.end();) {
+				if (it->starts_with(prefix)) {
+					removed(std::filesystem::path { *it });
+					it = files.erase(it);
+				} else {
+					++it;
+				}
+			}
+		}
+
+		struct Directory {
+			std::filesystem::path path;
+			bool recursive { true };
+		};
+
+		int descriptor;
+		std::unordered_map<int, Directory> directories;
+		std::unordered_set<std::string, StringHash, std::equal_to<>> files;
+	};
+
+	void FileWatcher::loop_until()
 	{
-		std::for_each(std::begin(vec), std::end(vec), [&info = info](const auto& func) { func(info); });
+		const auto descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (descriptor < 0) {
+			Alabaster::Log::warn("[FileWatcher] inotify is unavailable, falling back to polling every {}ms.", delay.count());
+			poll_until();
+			return;
+		}
+
+		InotifyTree tree { descriptor };
+		const auto information = [](const std::filesystem::path& path, bool directory, FileStatus status) {
+			return FileInformation {
+				.type = directory ? FileType::DIRECTORY : to_filetype(path.extension()),
+				.path = path.string(),
+				.last_modified = std::filesystem::file_time_type::clock::now(),
+				.status = status,
+			};
+		};
+
+		const auto watch_everything = [&](auto&& found) {
+			tree.watch(root, true, found);
+			for (const auto& additional : copy_additional_paths()) {
+				tree.watch(root / additional, false, found);
+			}
+		};
+		watch_everything([](const std::filesystem::path&, bool) { });
+
+		// After the kernel queue overflowed events are lost, so the tree is walked again and compared against what is known.
+		const auto rescan = [&](std::filesystem::file_time_type since) {
+			auto known = std::move(tree.files);
+			tree.files = {};
+			tree.directories.clear();
+
+			const auto now = Clock::now();
+			watch_everything([&](const std::filesystem::path& path, bool directory) {
+				if (directory) {
+					return;
+				}
+				std::error_code error;
+				if (known.erase(path.string()) == 0) {
+					queue(information(path, false, FileStatus::Created), now);
+				} else if (std::filesystem::last_write_time(path, error) >= since && !error) {
+					queue(information(path, false, FileStatus::Modified), now);
+				}
+			});
+			for (const auto& missing : known) {
+				queue(information(missing, false, FileStatus::Deleted), now);
+			}
+		};
+
+		alignas(inotify_event) std::array<char, 64 * 1024> buffer {};
+		auto last_drained = std::filesystem::file_time_type::clock::now();
+		while (running) {
+			if (additional_paths_changed) {
+				for (const auto& additional : copy_additional_paths()) {
+					tree.watch(root / additional, false, [](const std::filesystem::path&, bool) { });
+				}
+			}
+
+			auto timeout = idle_wakeup;
+			if (const auto next = flush(Clock::now())) {
+				const auto until_next = std::chrono::ceil<std::chrono::milliseconds>(*next - Clock::now());
+				timeout = std::clamp(until_next, std::chrono::milliseconds { 0 }, idle_wakeup);
+			}
+
+			pollfd readable { .fd = descriptor, .events = POLLIN, .revents = 0 };
+			if (poll(&readable, 1, static_cast<int>(timeout.count())) <= 0) {
+				continue;
+			}
+
+			const auto drained_at = std::filesystem::file_time_type::clock::now();
+			while (true) {
+				const auto size = read(descriptor, buffer.data(), buffer.size());
+				if (size <= 0) {
+					break;
+				}
+
+				const auto now = Clock::now();
+				for (std::size_t offset = 0; offset < static_cast<std::size_t>(size);) {
+					const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+					offset += sizeof(inotify_event) + event->len;
+
+					if (event->mask & IN_Q_OVERFLOW) {
+						Alabaster::Log::warn("[FileWatcher] inotify queue overflowed, rescanning {}.", root.string());
+						rescan(last_drained);
+						continue;
+					}
+
+					const auto found = tree.directories.find(event->wd);
+					if (found == tree.directories.end()) {
+						continue;
+					}
+					if (event->mask & IN_IGNORED) {
+						tree.directories.erase(found);
+						continue;
+					}
+					if (event->len == 0) {
+						continue;
+					}
+
+					const auto path = found->second.path / event->name;
+					const auto recursive = found->second.recursive;
+					if (event->mask & IN_ISDIR) {
+						if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+							queue(information(path, true, FileStatus::Created), now);
+							if (recursive) {
+								// Anything created before the watch was in place has to be picked up by hand.
+								tree.watch(path, true, [&](const std::filesystem::path& child, bool directory) {
+									queue(information(child, directory, FileStatus::Created), now);
+								});
+							}
+						} else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+							tree.forget(path, [&](const std::filesystem::path& file) { queue(information(file, false, FileStatus::Deleted), now); });
+							queue(information(path, true, FileStatus::Deleted), now);
+						}
+						continue;
+					}
+
+					const auto key = path.string();
+					if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+						tree.files.erase(key);
+						queue(information(path, false, FileStatus::Deleted), now);
+					} else if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+						const auto created = tree.files.insert(key).second;
+						queue(information(path, false, created ? FileStatus::Created : FileStatus::Modified), now);
+					} else if (event->mask & (IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB)) {
+						tree.files.insert(key);
+						queue(information(path, false, FileStatus::Modified), now);
+					}
+				}
+			}
+			last_drained = drained_at;
+		}
+
+		close(descriptor);
 	}
 
 } // namespace AssetManager
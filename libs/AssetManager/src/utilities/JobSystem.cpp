@@ -0,0 +1,272 @@
+#include "am_pch.hpp"
+
+#include "utilities/JobSystem.hpp"
+
+#include "core/exceptions/AlabasterException.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace AssetManager {
+
+	struct JobSystem::Worker {
+		Detail::WorkStealingDeque<Job*, JobSystem::deque_size> deque;
+		std::unique_ptr<std::array<Job, JobSystem::arena_size>> arena { std::make_unique<std::array<Job, JobSystem::arena_size>>() };
+		std::atomic<std::size_t> cursor { 0 };
+		std::thread thread;
+	};
+
+	struct ThreadState {
+		JobSystem* system { nullptr };
+		std::size_t worker_index { 0 };
+		Job* current { nullptr };
+	};
+
+	static thread_local ThreadState thread_state;
+
+	static constexpr auto spins_before_sleeping = 32;
+
+	JobSystem::JobSystem(std::size_t worker_count)
+		: external(std::make_unique<Worker>())
+		, injected(std::make_unique<BoundedQueue<Job*, deque_size>>())
+	{
+		worker_count = std::max<std::size_t>(worker_count, 1);
+		workers.reserve(worker_count);
+		for (std::size_t i = 0; i < worker_count; i++) {
+			workers.push_back(std::make_unique<Worker>());
+		}
+
+		for (std::size_t i = 0; i < worker_count; i++) {
+			workers[i]->thread = std::thread(&JobSystem::worker_loop, this, i);
+		}
+	}
+
+	JobSystem::~JobSystem()
+	{
+		running.store(false, std::memory_order_release);
+		pending_epoch.fetch_add(1, std::memory_order_seq_cst);
+		pending_epoch.notify_all();
+
+		for (auto& worker : workers) {
+			if (worker->thread.joinable()) {
+				worker->thread.join();
+			}
+		}
+
+		while (execute_one()) { }
+	}
+
+	JobSystem& JobSystem::the()
+	{
+		static JobSystem system;
+		return system;
+	}
+
+	std::size_t JobSystem::default_worker_count()
+	{
+		const auto hardware_threads = static_cast<std::size_t>(std::thread::hardware_concurrency());
+		return hardware_threads > 1 ? hardware_threads - 1 : 1;
+	}
+
+	Job* JobSystem::current_job() { return thread_state.current; }
+
+	Job* JobSystem::allocate(std::uint32_t holders)
+	{
+		auto& owner = thread_state.system == this ? *workers[thread_state.worker_index] : *external;
+
+		while (true) {
+			for (std::size_t probe = 0; probe < arena_size; probe++) {
+				auto& job = (*owner.arena)[owner.cursor.fetch_add(1, std::memory_order_relaxed) & (arena_size - 1)];
+
+				std::uint32_t expected = 0;
+				if (!job.holders.compare_exchange_strong(expected, holders, std::memory_order_acquire, std::memory_order_relaxed)) {
+					continue;
+				}
+
+				job.parent = nullptr;
+				job.unfinished.store(1, std::memory_order_relaxed);
+				job.continuation_count.store(0, std::memory_order_relaxed);
+				job.has_error.store(false, std::memory_order_relaxed);
+				job.error = nullptr;
+				return &job;
+			}
+
+			// Every slot is held by an unfinished job, help out until one is released.
+			if (!execute_one()) {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void JobSystem::add_continuation(Job* antecedent, Job* continuation)
+	{
+		const auto index = antecedent->continuation_count.fetch_add(1, std::memory_order_acq_rel);
+		if (index >= Job::max_continuations) {
+			throw Alabaster::AlabasterException("A job can have at most {} continuations.", Job::max_continuations);
+		}
+		antecedent->continuations[index] = continuation;
+	}
+
+	void JobSystem::run(Job* job)
+	{
+		const auto is_worker = thread_state.system == this;
+		const auto pushed = is_worker ? workers[thread_state.worker_index]->deque.push(job) : injected->push(job);
+
+		if (!pushed) {
+			execute(job);
+			return;
+		}
+
+		notify();
+	}
+
+	void JobSystem::wait(Job* job)
+	{
+		// The slot was held for the waiter since the job was created, so it cannot have been reused, even if the job finished long ago.
+		while (!job->is_finished()) {
+			if (!execute_one()) {
+				std::this_thread::yield();
+			}
+		}
+
+		const auto error = job->has_error.load(std::memory_order_acquire) ? job->error : nullptr;
+		job->holders.fetch_sub(1, std::memory_order_release);
+
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+
+	void JobSystem::set_error(Job* job, std::exception_ptr error)
+	{
+		if (!job->has_error.exchange(true, std::memory_order_acq_rel)) {
+			job->error = std::move(error);
+		}
+	}
+
+	void JobSystem::execute(Job* job)
+	{
+		auto* previous = thread_state.current;
+		thread_state.current = job;
+
+		try {
+			job->invoke(job->storage.data());
+		} catch (...) {
+			set_error(job, std::current_exception());
+		}
+		job->destroy(job->storage.data());
+
+		thread_state.current = previous;
+		finish(job);
+	}
+
+	void JobSystem::finish(Job* job)
+	{
+		if (job->unfinished.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+			return;
+		}
+
+		auto* parent = job->parent;
+		if (parent && job->has_error.load(std::memory_order_acquire)) {
+			set_error(parent, job->error);
+		}
+
+		const auto continuation_count = std::min<std::size_t>(job->continuation_count.load(std::memory_order_acquire), Job::max_continuations);
+		for (std::size_t i = 0; i < continuation_count; i++) {
+			run(job->continuations[i]);
+		}
+
+		job->holders.fetch_sub(1, std::memory_order_release);
+
+		if (parent) {
+			finish(parent);
+		}
+	}
+
+	Job* JobSystem::next_job(std::size_t worker_index)
+	{
+		if (worker_index != external_index) {
+			if (auto* job = workers[worker_index]->deque.pop()) {
+				return job;
+			}
+		}
+
+		if (Job* job = nullptr; injected->pop(job)) {
+			return job;
+		}
+
+		const auto count = workers.size();
+		const auto start = worker_index == external_index ? 0 : worker_index + 1;
+		for (std::size_t i = 0; i < count; i++) {
+			const auto victim = (start + i) % count;
+			if (victim == worker_index) {
+				continue;
+			}
+
+			if (auto* job = workers[victim]->deque.steal()) {
+				return job;
+			}
+		}
+
+		return nullptr;
+	}
+
+	bool JobSystem::execute_one()
+	{
+		const auto worker_index = thread_state.system == this ? thread_state.worker_index : external_index;
+		if (auto* job = next_job(worker_index)) {
+			execute(job);
+			return true;
+		}
+		return false;
+	}
+
+	void JobSystem::notify()
+	{
+		pending_epoch.fetch_add(1, std::memory_order_seq_cst);
+		if (sleeping.load(std::memory_order_seq_cst) > 0) {
+			pending_epoch.notify_one();
+		}
+	}
+
+	void JobSystem::worker_loop(std::size_t worker_index)
+	{
+		thread_state = ThreadState { this, worker_index, nullptr };
+
+		auto idle_spins = 0;
+		while (true) {
+			if (auto* job = next_job(worker_index)) {
+				execute(job);
+				idle_spins = 0;
+				continue;
+			}
+
+			if (!running.load(std::memory_order_acquire)) {
+				break;
+			}
+
+			if (idle_spins++ < spins_before_sleeping) {
+				std::this_thread::yield();
+				continue;
+			}
+
+			sleeping.fetch_add(1, std::memory_order_seq_cst);
+			const auto epoch = pending_epoch.load(std::memory_order_seq_cst);
+			if (auto* job = next_job(worker_index)) {
+				sleeping.fetch_sub(1, std::memory_order_relaxed);
+				execute(job);
+				idle_spins = 0;
+				continue;
+			}
+
+			if (running.load(std::memory_order_acquire)) {
+				pending_epoch.wait(epoch, std::memory_order_seq_cst);
+			}
+			sleeping.fetch_sub(1, std::memory_order_relaxed);
+			idle_spins = 0;
+		}
+
+		thread_state = ThreadState {};
+	}
+
+} // namespace AssetManager
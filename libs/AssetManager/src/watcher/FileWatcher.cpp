@@ -2,45 +2,23 @@
 
 #include "core/Common.hpp"
 #include "core/exceptions/AlabasterException.hpp"
+#include "utilities/JobSystem.hpp"
 
 #include <algorithm>
 
 namespace AssetManager {
 
-	constexpr auto to_filetype(const auto& extension) -> FileType
-	{
-		using namespace Alabaster;
-		if (extension == ".txt")
-			return FileType::TXT;
-		else if (extension == ".png")
-			return FileType::PNG;
-		else if (extension == ".ttf")
-			return FileType::TTF;
-		else if (extension == ".jpeg")
-			return FileType::JPEG;
-		else if (extension == ".jpg")
-			return FileType::JPG;
-		else if (extension == ".spv")
-			return FileType::SPV;
-		else if (extension == ".vert")
-			return FileType::VERT;
-		else if (extension == ".frag")
-			return FileType::FRAG;
-		else if (extension == ".obj")
-			return FileType::OBJ;
-		else if (extension == ".json")
-			return FileType::JSON;
-		else if (extension == ".scene")
-			return FileType::SCENE;
-		else
-			return FileType::UNKNOWN;
-	}
-
 	FileWatcher::FileWatcher(const std::filesystem::path& in_path, std::chrono::duration<int, std::milli> in_delay)
 		: root(in_path)
 		, delay(in_delay)
+		, notifications(std::make_unique<BoundedQueue<FileInformation, notification_capacity>>())
 	{
 		Alabaster::assert_that(std::filesystem::is_directory(root), "File watcher API currently only supports directories.");
+		thread = std::thread(&FileWatcher::loop_until, this);
+	}
+
+	void FileWatcher::poll_until()
+	{
 		for (const auto& file : std::filesystem::recursive_directory_iterator { root }) {
 			const auto path = file.path().string();
 			const auto type_if_not_directory = std::filesystem::is_directory(file) ? FileType::DIRECTORY : to_filetype(file.path().extension());
@@ -52,11 +30,6 @@ namespace AssetManager {
 			};
 		}
 
-		thread = std::thread(&FileWatcher::loop_until, this);
-	}
-
-	void FileWatcher::loop_until()
-	{
 		while (running) {
 			std::this_thread::sleep_for(delay);
 
@@ -65,7 +38,7 @@ namespace AssetManager {
 				if (!std::filesystem::exists(path_iterator->first)) {
 					path_iterator->second.status = FileStatus::Deleted;
 					const auto& current = path_iterator->second;
-					for_each(current, activations);
+					publish(current);
 					path_iterator = paths.erase(path_iterator);
 				} else {
 					path_iterator++;
@@ -85,19 +58,19 @@ namespace AssetManager {
 					};
 
 					const auto& current = paths[file.path().string()];
-					for_each(current, activations);
+					publish(current);
 				} else {
 					auto& current = paths[file.path().string()];
 
 					if (current.last_modified != current_file_last_write_time) {
 						current.last_modified = current_file_last_write_time;
 						current.status = FileStatus::Modified;
-						for_each(current, activations);
+						publish(current);
 					}
 				}
 			}
 
-			for (auto& additional : additional_paths) {
+			for (auto& additional : copy_additional_paths()) {
 				for (auto& file : std::filesystem::directory_iterator { root / additional }) {
 					auto current_file_last_write_time = std::filesystem::last_write_time(file);
 					const auto view = file.path().string();
@@ -111,14 +84,14 @@ namespace AssetManager {
 						};
 
 						const auto& current = paths[file.path().string()];
-						for_each(current, activations);
+						publish(current);
 					} else {
 						auto& current = paths[file.path().string()];
 
 						if (current.last_modified != current_file_last_write_time) {
 							current.last_modified = current_file_last_write_time;
 							current.status = FileStatus::Modified;
-							for_each(current, activations);
+							publish(current);
 						}
 					}
 				}
@@ -126,11 +99,112 @@ namespace AssetManager {
 		}
 	}
 
+	/// @return the status a burst of two events on one path amounts to, nothing if they cancel out
+	static std::optional<FileStatus> coalesce(FileStatus previous, FileStatus next)
+	{
+		if (previous == FileStatus::Created) {
+			// A file that only lived for the length of a burst (an editor's temporary file) never needs to be seen.
+			return next == FileStatus::Deleted ? std::nullopt : std::optional { FileStatus::Created };
+		}
+		if (previous == FileStatus::Deleted && next != FileStatus::Deleted) {
+			// Deleted and written again, typically a save through rename.
+			return FileStatus::Modified;
+		}
+		return next;
+	}
+
+	void FileWatcher::queue(FileInformation information, Clock::time_point now)
+	{
+		const auto found = pending.find(information.path);
+		if (found == pending.end()) {
+			auto key = information.path;
+			pending.try_emplace(std::move(key), PendingEvent { .information = std::move(information), .first_seen = now, .last_seen = now });
+			return;
+		}
+
+		auto& event = found->second;
+		const auto status = coalesce(event.information.status, information.status);
+		if (!status) {
+			pending.erase(found);
+			return;
+		}
+
+		event.information = std::move(information);
+		event.information.status = *status;
+		event.last_seen = now;
+	}
+
+	std::optional<FileWatcher::Clock::time_point> FileWatcher::flush(Clock::time_point now)
+	{
+		std::optional<Clock::time_point> next;
+		for (auto it = pending.begin(); it != pending.end();) {
+			const auto settles = std::min(it->second.last_seen + debounce_window, it->second.first_seen + max_coalescing);
+			if (settles <= now) {
+				publish(std::move(it->second.information));
+				it = pending.erase(it);
+				continue;
+			}
+
+			next = next ? std::min(*next, settles) : settles;
+			++it;
+		}
+		return next;
+	}
+
+	void FileWatcher::publish(FileInformation information)
+	{
+		// A full queue means the main thread is not getting to it (a long load, a breakpoint), wait for it rather than lose events.
+		while (!notifications->push(information)) {
+			if (!running) {
+				return;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	std::size_t FileWatcher::dispatch(std::chrono::microseconds budget)
+	{
+		const auto deadline = Clock::now() + budget;
+		std::size_t dispatched = 0;
+		FileInformation information {};
+		while (notifications->pop(information)) {
+			for (const auto& activation : activations) {
+				activation(information);
+			}
+			dispatched++;
+			if (Clock::now() >= deadline) {
+				break;
+			}
+		}
+		return dispatched;
+	}
+
+	std::unordered_set<std::string, StringHash> FileWatcher::copy_additional_paths()
+	{
+		std::scoped_lock lock { additional_paths_mutex };
+		additional_paths_changed = false;
+		return additional_paths;
+	}
+
 	void FileWatcher::start(const std::function<void(const FileInformation&)>& in) { activations.push_back(in); }
 
-	static constexpr auto register_callback(FileStatus status, auto& activations, auto&& function)
+	static auto register_callback(FileStatus status, auto& activations, auto&& function, Delivery delivery = Delivery::MainThread)
 	{
-		auto func = [activation = function, status = status](const auto& file) {
+		std::function<void(const FileInformation&)> handler = function;
+		if (delivery == Delivery::Worker) {
+			// Two shared pointers keep the job within its inline storage.
+			handler = [shared = std::make_shared<std::function<void(const FileInformation&)>>(std::move(handler))](const FileInformation& file) {
+				JobSystem::the().dispatch([shared, information = std::make_shared<const FileInformation>(file)] {
+					try {
+						(*shared)(*information);
+					} catch (const std::exception& e) {
+						Alabaster::Log::error("[FileWatcher] Callback for {} failed. Message: {}", information->path, e.what());
+					}
+				});
+			};
+		}
+
+		auto func = [activation = std::move(handler), status = status](const auto& file) {
 			const auto is_given_status = static_cast<bool>(file.status & status);
 			if (is_given_status)
 				activation(file);
@@ -149,9 +223,17 @@ namespace AssetManager {
 		register_callback(FileStatus::Deleted | FileStatus::Created, activations, in);
 	}
 
-	void FileWatcher::on(FileStatus status, const std::function<void(const FileInformation&)>& in) { register_callback(status, activations, in); }
+	void FileWatcher::on(FileStatus status, const std::function<void(const FileInformation&)>& in, Delivery delivery)
+	{
+		register_callback(status, activations, in, delivery);
+	}
 
-	void FileWatcher::add_watched_paths(const std::filesystem::path& path) { additional_paths.insert(path.string()); }
+	void FileWatcher::add_watched_paths(const std::filesystem::path& path)
+	{
+		std::scoped_lock lock { additional_paths_mutex };
+		additional_paths.insert(path.string());
+		additional_paths_changed = true;
+	}
 
 	void FileWatcher::stop()
 	{
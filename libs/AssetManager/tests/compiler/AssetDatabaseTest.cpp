@@ -0,0 +1,172 @@
+#include "cache/AssetDatabase.hpp"
+#include "utils/TestFiles.hpp"
+
+#include <fstream>
+#include <gtest/gtest.h>
+#include <limits>
+
+using AssetManager::AssetDatabase;
+
+static constexpr std::uint32_t importer_version = 3;
+
+class AssetDatabaseTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		std::filesystem::remove_all(directory);
+		std::filesystem::create_directories(directory);
+		write(source, "texture");
+		write(artefact, "compressed");
+	}
+
+	void TearDown() override { std::filesystem::remove_all(directory); }
+
+	static void write(const std::filesystem::path& path, std::string_view contents)
+	{
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		stream << contents;
+	}
+
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "alabaster_asset_database";
+	const std::filesystem::path database_path = directory / "assets.adb";
+	const std::filesystem::path source = directory / "image.png";
+	const std::filesystem::path artefact = directory / "image.atex";
+	const std::filesystem::path include = directory / "common.glsl";
+};
+
+TEST_F(AssetDatabaseTest, UnknownAssetsAreStale)
+{
+	AssetDatabase database(database_path);
+	EXPECT_TRUE(database.is_stale(source, importer_version));
+	EXPECT_TRUE(database.changed(source));
+}
+
+TEST_F(AssetDatabaseTest, ImportedAssetIsUpToDate)
+{
+	AssetDatabase database(database_path);
+	database.record_import(source, importer_version, { artefact });
+
+	EXPECT_FALSE(database.is_stale(source, importer_version, artefact));
+	EXPECT_FALSE(database.changed(source));
+
+	const auto record = database.find(source);
+	ASSERT_TRUE(record.has_value());
+	EXPECT_EQ(record->importer_version, importer_version);
+	EXPECT_EQ(record->artefacts.size(), 1);
+	EXPECT_GT(record->imported_at, 0);
+}
+
+TEST_F(AssetDatabaseTest, ChangesMakeTheAssetStale)
+{
+	AssetDatabase database(database_path);
+	write(include, "float shade();");
+	database.record_import(source, importer_version, { artefact }, { include });
+
+	EXPECT_TRUE(database.is_stale(source, importer_version + 1));
+	EXPECT_TRUE(database.is_stale(source, importer_version, directory / "image.bc5.atex"));
+
+	write(include, "float shade(vec3 normal);");
+	EXPECT_TRUE(database.changed(include));
+	EXPECT_TRUE(database.is_stale(source, importer_version));
+
+	database.record_import(source, importer_version, { artefact }, { include });
+	EXPECT_FALSE(database.is_stale(source, importer_version));
+
+	std::filesystem::remove(artefact);
+	EXPECT_TRUE(database.is_stale(source, importer_version));
+}
+
+TEST_F(AssetDatabaseTest, RewritingTheSameContentsIsNotAChange)
+{
+	AssetDatabase database(database_path);
+	TestFiles::age(source);
+	database.record_import(source, importer_version, { artefact });
+
+	write(source, "texture");
+	EXPECT_FALSE(database.changed(source));
+	EXPECT_FALSE(database.is_stale(source, importer_version));
+
+	// The refreshed modification time is stored, so the next check is a stat.
+	TestFiles::age(source);
+	database.is_stale(source, importer_version);
+	database.reset_statistics();
+	EXPECT_FALSE(database.is_stale(source, importer_version));
+	EXPECT_EQ(database.statistics().hashed, 0);
+}
+
+TEST_F(AssetDatabaseTest, ArtefactsOfTheSameContentsAccumulate)
+{
+	AssetDatabase database(database_path);
+	const auto other_artefact = directory / "image.bc5.atex";
+	write(other_artefact, "compressed");
+
+	database.record_import(source, importer_version, { artefact });
+	database.record_import(source, importer_version, { other_artefact });
+	EXPECT_FALSE(database.is_stale(source, importer_version, artefact));
+	EXPECT_FALSE(database.is_stale(source, importer_version, other_artefact));
+
+	write(source, "another texture");
+	database.record_import(source, importer_version, { other_artefact });
+	EXPECT_TRUE(database.is_stale(source, importer_version, artefact));
+}
+
+TEST_F(AssetDatabaseTest, ChangedDependenciesDropEarlierArtefacts)
+{
+	AssetDatabase database(database_path);
+	const auto other_variant = directory / "image.skinned.atex";
+	write(other_variant, "compressed");
+	write(include, "float shade();");
+
+	database.record_import(source, importer_version, { artefact }, { include });
+	database.record_import(source, importer_version, { other_variant }, { include });
+	EXPECT_FALSE(database.is_stale(source, importer_version, artefact));
+
+	// Only the variant that was rebuilt saw the new include.
+	write(include, "float shade(vec3 normal);");
+	database.record_import(source, importer_version, { other_variant }, { include });
+	EXPECT_FALSE(database.is_stale(source, importer_version, other_variant));
+	EXPECT_TRUE(database.is_stale(source, importer_version, artefact));
+}
+
+TEST_F(AssetDatabaseTest, RecordsArePersisted)
+{
+	TestFiles::age(source);
+	write(include, "float shade();");
+	TestFiles::age(include);
+	{
+		AssetDatabase database(database_path);
+		database.record_import(source, importer_version, { artefact }, { include });
+	}
+
+	AssetDatabase database(database_path);
+	EXPECT_EQ(database.size(), 1);
+	EXPECT_FALSE(database.is_stale(source, importer_version, artefact));
+	EXPECT_EQ(database.statistics().hashed, 0);
+
+	const auto record = database.find(source);
+	ASSERT_TRUE(record.has_value());
+	ASSERT_EQ(record->dependencies.size(), 1);
+
+	database.forget(source);
+	EXPECT_TRUE(database.is_stale(source, importer_version));
+}
+
+TEST_F(AssetDatabaseTest, CorruptLengthsInvalidateTheDatabase)
+{
+	{
+		AssetDatabase database(database_path);
+		database.record_import(source, importer_version, { artefact });
+	}
+
+	// The first record's source path starts after the magic, version and record count, its length is now far past the end.
+	{
+		std::fstream stream(database_path, std::ios::binary | std::ios::in | std::ios::out);
+		const auto length = std::numeric_limits<std::uint32_t>::max();
+		stream.seekp(3 * sizeof(std::uint32_t));
+		stream.write(reinterpret_cast<const char*>(&length), sizeof(length));
+	}
+
+	AssetDatabase database(database_path);
+	EXPECT_EQ(database.size(), 0);
+	EXPECT_TRUE(database.is_stale(source, importer_version));
+}
@@ -0,0 +1,56 @@
+#include "cache/AssetPool.hpp"
+
+#include <gtest/gtest.h>
+
+using AssetManager::AssetPool;
+using AssetManager::Handle;
+
+struct Asset {
+	int value { 0 };
+};
+
+TEST(AssetPoolTest, FindsAssetsByName)
+{
+	AssetPool<Asset> pool;
+	const auto first = pool.insert("first", std::make_shared<Asset>(1));
+	const auto second = pool.insert("second", std::make_shared<Asset>(2));
+
+	EXPECT_NE(first, second);
+	EXPECT_EQ(pool.find(std::string_view { "first" }), first);
+	EXPECT_EQ(pool.get(second)->value, 2);
+	EXPECT_FALSE(pool.find("missing").has_value());
+	EXPECT_EQ(pool.get(Handle<Asset> {}), nullptr);
+	EXPECT_EQ(pool.name(second), "second");
+
+	// Inserting a name twice keeps the first asset.
+	EXPECT_EQ(pool.insert("first", std::make_shared<Asset>(3)), first);
+	EXPECT_EQ(pool.get(first)->value, 1);
+}
+
+TEST(AssetPoolTest, ErasedHandlesGoStaleWhenTheirSlotIsReused)
+{
+	AssetPool<Asset> pool;
+	const auto erased = pool.insert("erased", std::make_shared<Asset>(1));
+	pool.erase(erased);
+	EXPECT_EQ(pool.get(erased), nullptr);
+	EXPECT_FALSE(pool.contains("erased"));
+	EXPECT_TRUE(pool.name(erased).empty());
+
+	const auto reused = pool.insert("reused", std::make_shared<Asset>(2));
+	EXPECT_EQ(reused.index, erased.index);
+	EXPECT_EQ(pool.get(erased), nullptr);
+	EXPECT_EQ(pool.get(reused)->value, 2);
+	EXPECT_EQ(pool.size(), 1);
+}
+
+TEST(AssetPoolTest, ReplacingKeepsHandlesValid)
+{
+	AssetPool<Asset> pool;
+	const auto handle = pool.insert("shader", std::make_shared<Asset>(1));
+	const auto previous = pool.replace(handle, std::make_shared<Asset>(2));
+
+	EXPECT_EQ(previous->value, 1);
+	EXPECT_EQ(pool.get(handle)->value, 2);
+	EXPECT_EQ(pool.assign("shader", std::make_shared<Asset>(3)), handle);
+	EXPECT_EQ(pool.shared(handle)->value, 3);
+}
@@ -0,0 +1,213 @@
+#include "compiler/BlockCompression.hpp"
+#include "compiler/TextureCompiler.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <gtest/gtest.h>
+
+using AssetManager::BlockFormat;
+using AssetManager::TextureCompiler;
+namespace BlockCompression = AssetManager::BlockCompression;
+
+static std::vector<std::uint8_t> gradient_image(std::uint32_t width, std::uint32_t height)
+{
+	std::vector<std::uint8_t> rgba(static_cast<std::size_t>(width) * height * 4);
+	for (std::uint32_t y = 0; y < height; y++) {
+		for (std::uint32_t x = 0; x < width; x++) {
+			auto* texel = &rgba[(y * width + x) * 4];
+			texel[0] = static_cast<std::uint8_t>(x * 255 / std::max(width - 1, 1u));
+			texel[1] = static_cast<std::uint8_t>(y * 255 / std::max(height - 1, 1u));
+			texel[2] = static_cast<std::uint8_t>((x + y) * 255 / std::max(width + height - 2, 1u));
+			texel[3] = static_cast<std::uint8_t>(255 - texel[0] / 2);
+		}
+	}
+	return rgba;
+}
+
+/// @brief Every channel follows the same diagonal ramp, so each block lies on a line in RGBA space.
+static std::vector<std::uint8_t> ramp_image(std::uint32_t width, std::uint32_t height)
+{
+	std::vector<std::uint8_t> rgba(static_cast<std::size_t>(width) * height * 4);
+	for (std::uint32_t y = 0; y < height; y++) {
+		for (std::uint32_t x = 0; x < width; x++) {
+			auto* texel = &rgba[(y * width + x) * 4];
+			texel[0] = static_cast<std::uint8_t>((x + y) * 255 / (width + height - 2));
+			texel[1] = static_cast<std::uint8_t>(255 - texel[0] / 3);
+			texel[2] = static_cast<std::uint8_t>(texel[0] / 2 + 20);
+			texel[3] = static_cast<std::uint8_t>(200 - texel[0] / 2);
+		}
+	}
+	return rgba;
+}
+
+/// @brief Peak signal to noise ratio over the selected channels, in dB.
+static double psnr(const std::vector<std::uint8_t>& reference, const std::vector<std::uint8_t>& decoded, std::uint32_t channel_count)
+{
+	double squared_error = 0.0;
+	std::size_t samples = 0;
+	for (std::size_t i = 0; i < reference.size(); i += 4) {
+		for (std::uint32_t c = 0; c < channel_count; c++) {
+			const double delta = static_cast<double>(reference[i + c]) - static_cast<double>(decoded[i + c]);
+			squared_error += delta * delta;
+			samples++;
+		}
+	}
+
+	const auto mean_squared_error = squared_error / static_cast<double>(samples);
+	if (mean_squared_error == 0.0) {
+		return 100.0;
+	}
+	return 10.0 * std::log10(255.0 * 255.0 / mean_squared_error);
+}
+
+static double round_trip_psnr(
+	BlockFormat format, const std::vector<std::uint8_t>& rgba, std::uint32_t width, std::uint32_t height, std::uint32_t channels)
+{
+	const auto blocks = BlockCompression::encode(format, rgba, width, height);
+	EXPECT_EQ(blocks.size(), BlockCompression::compressed_size(format, width, height));
+	return psnr(rgba, BlockCompression::decode(format, blocks, width, height), channels);
+}
+
+TEST(BlockCompressionTest, SizesRoundPartialBlocksUp)
+{
+	EXPECT_EQ(BlockCompression::compressed_size(BlockFormat::BC1, 4, 4), 8);
+	EXPECT_EQ(BlockCompression::compressed_size(BlockFormat::BC3, 4, 4), 16);
+	EXPECT_EQ(BlockCompression::compressed_size(BlockFormat::BC1, 5, 3), 16);
+	EXPECT_EQ(BlockCompression::compressed_size(BlockFormat::BC7, 1, 1), 16);
+	EXPECT_EQ(BlockCompression::compressed_size(BlockFormat::BC5, 256, 128), 64 * 32 * 16);
+	EXPECT_EQ(BlockCompression::compressed_size(BlockFormat::RGBA8, 5, 3), 5 * 3 * 4);
+}
+
+TEST(BlockCompressionTest, SolidBlocksSurviveEveryFormat)
+{
+	const std::array<std::uint8_t, 4> colour = { 200, 100, 50, 128 };
+	std::array<std::uint8_t, 64> texels;
+	for (std::size_t i = 0; i < texels.size(); i++) {
+		texels[i] = colour[i % 4];
+	}
+
+	const auto check = [&](BlockFormat format, std::array<int, 4> tolerance) {
+		std::array<std::uint8_t, 16> block {};
+		std::array<std::uint8_t, 64> decoded {};
+		BlockCompression::encode_block(format, texels.data(), block.data());
+		BlockCompression::decode_block(format, block.data(), decoded.data());
+		for (std::size_t i = 0; i < decoded.size(); i++) {
+			EXPECT_NEAR(decoded[i], texels[i], tolerance[i % 4]) << "format BC" << static_cast<std::uint32_t>(format) << ", channel " << i % 4;
+		}
+	};
+
+	check(BlockFormat::BC1, { 4, 2, 4, 127 });
+	check(BlockFormat::BC3, { 4, 2, 4, 0 });
+	check(BlockFormat::BC7, { 1, 1, 1, 1 });
+
+	std::array<std::uint8_t, 16> block {};
+	std::array<std::uint8_t, 64> decoded {};
+	BlockCompression::encode_block(BlockFormat::BC5, texels.data(), block.data());
+	BlockCompression::decode_block(BlockFormat::BC5, block.data(), decoded.data());
+	EXPECT_EQ(decoded[0], colour[0]);
+	EXPECT_EQ(decoded[1], colour[1]);
+}
+
+TEST(BlockCompressionTest, GradientsKeepTheirQuality)
+{
+	static constexpr std::uint32_t width = 64;
+	static constexpr std::uint32_t height = 48;
+	const auto rgba = gradient_image(width, height);
+
+	EXPECT_GT(round_trip_psnr(BlockFormat::BC1, rgba, width, height, 3), 36.0);
+	EXPECT_GT(round_trip_psnr(BlockFormat::BC3, rgba, width, height, 4), 37.0);
+	EXPECT_GT(round_trip_psnr(BlockFormat::BC5, rgba, width, height, 2), 50.0);
+	EXPECT_GT(round_trip_psnr(BlockFormat::BC7, rgba, width, height, 4), 38.0);
+}
+
+TEST(BlockCompressionTest, BC7KeepsMorePrecisionThanBC3)
+{
+	static constexpr std::uint32_t width = 64;
+	static constexpr std::uint32_t height = 48;
+	const auto rgba = ramp_image(width, height);
+
+	const auto bc3 = round_trip_psnr(BlockFormat::BC3, rgba, width, height, 4);
+	const auto bc7 = round_trip_psnr(BlockFormat::BC7, rgba, width, height, 4);
+	EXPECT_GT(bc7, bc3 + 6.0);
+	EXPECT_GT(bc7, 50.0);
+}
+
+TEST(BlockCompressionTest, PartialEdgeBlocksDecodeToTheImageSize)
+{
+	static constexpr std::uint32_t width = 70;
+	static constexpr std::uint32_t height = 37;
+	const auto rgba = gradient_image(width, height);
+
+	const auto blocks = BlockCompression::encode(BlockFormat::BC7, rgba, width, height);
+	const auto decoded = BlockCompression::decode(BlockFormat::BC7, blocks, width, height);
+	ASSERT_EQ(decoded.size(), rgba.size());
+	EXPECT_GT(psnr(rgba, decoded, 4), 35.0);
+}
+
+TEST(BlockCompressionTest, ContainerHoldsEveryMipLevel)
+{
+	static constexpr std::uint32_t width = 64;
+	static constexpr std::uint32_t height = 32;
+	const auto rgba = gradient_image(width, height);
+
+	auto compressed = TextureCompiler::compress(BlockFormat::BC1, rgba, width, height);
+	compressed.source_hash = 42;
+	ASSERT_EQ(compressed.mips.size(), TextureCompiler::mip_count(width, height));
+	ASSERT_EQ(compressed.mips.size(), 6);
+	EXPECT_EQ(compressed.mips.back().width, 2);
+	EXPECT_EQ(compressed.mips.back().height, 1);
+	for (const auto& mip : compressed.mips) {
+		EXPECT_EQ(mip.offset % 16, 0);
+		EXPECT_EQ(mip.size, BlockCompression::compressed_size(BlockFormat::BC1, mip.width, mip.height));
+	}
+
+	const auto path = std::filesystem::temp_directory_path() / "alabaster_block_compression_test.atex";
+	ASSERT_TRUE(TextureCompiler::write(path, compressed));
+	const auto read = TextureCompiler::read(path);
+	std::filesystem::remove(path);
+
+	ASSERT_TRUE(read.has_value());
+	EXPECT_EQ(read->format, BlockFormat::BC1);
+	EXPECT_EQ(read->width, width);
+	EXPECT_EQ(read->height, height);
+	EXPECT_EQ(read->source_hash, 42);
+	EXPECT_EQ(read->mips.size(), compressed.mips.size());
+	EXPECT_EQ(read->data, compressed.data);
+}
+
+TEST(BlockCompressionTest, ContainersWithBadLengthsAreRejected)
+{
+	static constexpr std::uint32_t width = 16;
+	static constexpr std::uint32_t height = 16;
+	const auto compressed = TextureCompiler::compress(BlockFormat::BC7, gradient_image(width, height), width, height);
+	const auto path = std::filesystem::temp_directory_path() / "alabaster_block_compression_corrupt.atex";
+
+	const auto written_with = [&path, &compressed](auto&& change) {
+		auto copy = compressed;
+		change(copy);
+		EXPECT_TRUE(TextureCompiler::write(path, copy));
+		auto read = TextureCompiler::read(path);
+		std::filesystem::remove(path);
+		return read;
+	};
+	EXPECT_TRUE(written_with([](auto&) {}).has_value());
+	// A level larger than its blocks would be uploaded as a copy region reaching past them.
+	EXPECT_FALSE(written_with([](auto& texture) { texture.mips[1].size += 16; }).has_value());
+	EXPECT_FALSE(written_with([](auto& texture) { texture.mips[2].width = 8; }).has_value());
+	EXPECT_FALSE(written_with([](auto& texture) { texture.mips.push_back(texture.mips.back()); }).has_value());
+
+	// The mip count and the data size sit behind the magic, version, format, size and source hash.
+	const auto patched = [&path, &compressed](std::streamoff offset, auto value) {
+		EXPECT_TRUE(TextureCompiler::write(path, compressed));
+		{
+			std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+			stream.seekp(offset);
+			stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+		}
+		auto read = TextureCompiler::read(path);
+		std::filesystem::remove(path);
+		return read;
+	};
+	EXPECT_FALSE(patched(28, std::uint32_t { 0xFFFFFFFF }).has_value());
+	EXPECT_FALSE(patched(32 + static_cast<std::streamoff>(compressed.mips.size()) * 24, std::uint64_t { 1 } << 40).has_value());
+}
@@ -0,0 +1,138 @@
+#include "watcher/FileWatcher.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <gtest/gtest.h>
+
+using AssetManager::Delivery;
+using AssetManager::FileInformation;
+using AssetManager::FileStatus;
+using AssetManager::FileWatcher;
+
+class FileWatcherTest : public ::testing::Test {
+protected:
+	static constexpr auto poll_delay = std::chrono::milliseconds(100);
+	static constexpr auto timeout = std::chrono::seconds(5);
+	static constexpr auto budget = std::chrono::milliseconds(2);
+
+	void SetUp() override
+	{
+		directory = std::filesystem::temp_directory_path() / "alabaster_file_watcher_test";
+		std::filesystem::remove_all(directory);
+		std::filesystem::create_directories(directory / "shaders");
+		write("shaders/existing.vert", "void main() {}");
+	}
+
+	void TearDown() override
+	{
+		watcher.reset();
+		std::filesystem::remove_all(directory);
+	}
+
+	void write(const std::string& relative, const std::string& contents) const
+	{
+		std::ofstream stream(directory / relative, std::ios::binary | std::ios::trunc);
+		stream << contents;
+	}
+
+	void watch()
+	{
+		watcher = std::make_unique<FileWatcher>(directory, poll_delay);
+		watcher->on(AssetManager::FileStatuses::All, [this](const FileInformation& information) {
+			// Delivered by dispatch() on this thread, nothing to lock.
+			seen.emplace_back(std::filesystem::path { information.path }.filename().string(), information.status);
+		});
+		// Give the backend time to set up its watches (or take its first snapshot) before anything changes.
+		std::this_thread::sleep_for(poll_delay * 3);
+	}
+
+	std::size_t count(const std::string& filename, FileStatus status)
+	{
+		return static_cast<std::size_t>(std::ranges::count(seen, std::pair { filename, status }));
+	}
+
+	/// @brief Dispatches like the Application does every frame, until predicate holds or the timeout passes.
+	template <typename Predicate> bool pump_until(Predicate&& predicate, std::chrono::milliseconds until = timeout)
+	{
+		const auto deadline = std::chrono::steady_clock::now() + until;
+		while (std::chrono::steady_clock::now() < deadline) {
+			watcher->dispatch(budget);
+			if (predicate()) {
+				return true;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+		return false;
+	}
+
+	bool wait_for(const std::string& filename, FileStatus status)
+	{
+		return pump_until([&] { return count(filename, status) > 0; });
+	}
+
+	std::filesystem::path directory;
+	std::unique_ptr<FileWatcher> watcher;
+	std::vector<std::pair<std::string, FileStatus>> seen;
+};
+
+TEST_F(FileWatcherTest, ReportsCreatedModifiedAndDeletedFiles)
+{
+	watch();
+
+	write("shaders/new.frag", "void main() {}");
+	EXPECT_TRUE(wait_for("new.frag", FileStatus::Created));
+
+	write("shaders/existing.vert", "void main() { gl_Position = vec4(0); }");
+	EXPECT_TRUE(wait_for("existing.vert", FileStatus::Modified));
+
+	std::filesystem::remove(directory / "shaders" / "new.frag");
+	EXPECT_TRUE(wait_for("new.frag", FileStatus::Deleted));
+}
+
+TEST_F(FileWatcherTest, WatchesDirectoriesCreatedAfterStart)
+{
+	watch();
+
+	std::filesystem::create_directories(directory / "textures" / "nested");
+	write("textures/nested/wood.png", "png");
+	EXPECT_TRUE(wait_for("wood.png", FileStatus::Created));
+
+	write("textures/nested/wood.png", "a different png");
+	EXPECT_TRUE(wait_for("wood.png", FileStatus::Modified));
+}
+
+TEST_F(FileWatcherTest, CallbacksOnlyRunWhenDispatched)
+{
+	watch();
+	std::atomic<std::thread::id> worker_thread {};
+	watcher->on(FileStatus::Created, [&](const FileInformation&) { worker_thread = std::this_thread::get_id(); }, Delivery::Worker);
+
+	write("shaders/new.frag", "void main() {}");
+	std::this_thread::sleep_for(poll_delay * 5);
+	EXPECT_EQ(count("new.frag", FileStatus::Created), 0);
+
+	EXPECT_TRUE(wait_for("new.frag", FileStatus::Created));
+	EXPECT_TRUE(pump_until([&] { return worker_thread.load() != std::thread::id {}; }));
+	EXPECT_NE(worker_thread.load(), std::this_thread::get_id());
+}
+
+#ifdef __linux__
+TEST_F(FileWatcherTest, SaveBurstsAreCoalesced)
+{
+	watch();
+
+	// What an editor does on save: write a temporary file, rename it over the original, then touch it a few more times.
+	write("shaders/.existing.vert.swp", "void main() { }");
+	std::filesystem::rename(directory / "shaders" / ".existing.vert.swp", directory / "shaders" / "existing.vert");
+	for (int i = 0; i < 5; i++) {
+		write("shaders/existing.vert", "void main() { } // " + std::to_string(i));
+	}
+
+	ASSERT_TRUE(wait_for("existing.vert", FileStatus::Modified));
+	pump_until([] { return false; }, poll_delay * 3);
+	EXPECT_EQ(count("existing.vert", FileStatus::Modified), 1);
+	EXPECT_EQ(count("existing.vert", FileStatus::Created), 0);
+	EXPECT_EQ(count(".existing.vert.swp", FileStatus::Created), 0);
+	EXPECT_EQ(count(".existing.vert.swp", FileStatus::Deleted), 0);
+}
+#endif
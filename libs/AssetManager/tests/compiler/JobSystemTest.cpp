@@ -0,0 +1,146 @@
+#include "utilities/JobSystem.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <list>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using AssetManager::JobSystem;
+
+static constexpr std::size_t worker_count = 4;
+
+TEST(JobSystemTest, ParallelForVisitsEveryIndexOnce)
+{
+	JobSystem jobs { worker_count };
+	std::vector<std::atomic<std::uint32_t>> visits(10000);
+	jobs.parallel_for(0, visits.size(), 7, [&visits](std::size_t index) { visits[index].fetch_add(1, std::memory_order_relaxed); });
+	for (std::size_t i = 0; i < visits.size(); i++) {
+		ASSERT_EQ(visits[i].load(), 1) << i;
+	}
+
+	std::atomic<std::uint32_t> count { 0 };
+	jobs.parallel_for(5, 5, 1, [&count](std::size_t) { count++; });
+	jobs.parallel_for(3, 5, 64, [&count](std::size_t) { count++; });
+	EXPECT_EQ(count.load(), 2);
+}
+
+TEST(JobSystemTest, ParallelForEachGathersOtherRanges)
+{
+	JobSystem jobs { worker_count };
+	const std::list<std::uint32_t> values(1000, 3);
+	std::atomic<std::uint32_t> sum { 0 };
+	jobs.parallel_for_each(values, [&sum](std::uint32_t value) { sum.fetch_add(value, std::memory_order_relaxed); }, 16);
+	EXPECT_EQ(sum.load(), 3000);
+}
+
+TEST(JobSystemTest, ParallelReduceFoldsInIndexOrder)
+{
+	JobSystem jobs { worker_count };
+	static constexpr std::size_t count = 5000;
+
+	const auto sum = jobs.parallel_reduce(
+		std::size_t { 0 }, count, 10, std::uint64_t { 0 }, [](std::size_t index) { return std::uint64_t { index }; }, std::plus<> {});
+	EXPECT_EQ(sum, count * (count - 1) / 2);
+
+	// Appending is not commutative, the indices only come out sorted if every grain and every partial is folded in order.
+	const auto sequence = jobs.parallel_reduce(
+		std::size_t { 0 }, count, 10, std::vector<std::size_t> {}, [](std::size_t index) { return std::vector<std::size_t> { index }; },
+		[](std::vector<std::size_t> left, const std::vector<std::size_t>& right) {
+			left.insert(left.end(), right.begin(), right.end());
+			return left;
+		});
+	std::vector<std::size_t> expected(count);
+	std::iota(expected.begin(), expected.end(), 0);
+	EXPECT_EQ(sequence, expected);
+}
+
+TEST(JobSystemTest, ExceptionsReachTheWaiter)
+{
+	JobSystem jobs { worker_count };
+	auto* job = jobs.submit([] { throw std::runtime_error("job"); });
+	EXPECT_THROW(jobs.wait(job), std::runtime_error);
+
+	auto* parent = jobs.create([] { });
+	jobs.run(jobs.create_child(parent, [] { throw std::runtime_error("child"); }));
+	jobs.run(parent);
+	EXPECT_THROW(jobs.wait(parent), std::runtime_error);
+
+	const auto throw_at_one_index = [](std::size_t index) {
+		if (index == 777) {
+			throw std::runtime_error("index");
+		}
+	};
+	EXPECT_THROW(jobs.parallel_for(0, 1000, 10, throw_at_one_index), std::runtime_error);
+}
+
+TEST(JobSystemTest, ResultsOutliveTheArenaWrappingAround)
+{
+	JobSystem jobs { worker_count };
+	auto* job = jobs.submit([] { throw std::runtime_error("kept"); });
+	while (!job->is_finished()) {
+		std::this_thread::yield();
+	}
+
+	// Every other slot of this thread's arena is taken and released again, the finished job's slot stays with its waiter.
+	for (std::size_t i = 0; i < 3 * JobSystem::arena_size; i++) {
+		jobs.wait(jobs.submit([] { }));
+	}
+	EXPECT_THROW(jobs.wait(job), std::runtime_error);
+}
+
+TEST(JobSystemTest, ContinuationsRunAfterTheirAntecedent)
+{
+	JobSystem jobs { worker_count };
+	std::atomic<std::uint32_t> step { 0 };
+	std::uint32_t seen_by_continuation { 0 };
+
+	auto* antecedent = jobs.create([&step] {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		step.store(1);
+	});
+	auto* continuation = jobs.then(antecedent, [&step, &seen_by_continuation] { seen_by_continuation = step.exchange(2); });
+	jobs.run(antecedent);
+
+	jobs.wait(continuation);
+	jobs.wait(antecedent);
+	EXPECT_EQ(seen_by_continuation, 1);
+	EXPECT_EQ(step.load(), 2);
+}
+
+TEST(JobSystemTest, SaturatedSystemRunsJobsOnTheCallingThread)
+{
+	JobSystem jobs { 1 };
+	std::atomic_bool started { false };
+	std::atomic_bool release { false };
+	auto* blocker = jobs.submit([&started, &release] {
+		started.store(true);
+		while (!release.load()) {
+			std::this_thread::yield();
+		}
+	});
+	while (!started.load()) {
+		std::this_thread::yield();
+	}
+
+	// With the only worker busy, the arena of this thread runs out and creating a job has to run queued ones right here.
+	const auto caller = std::this_thread::get_id();
+	std::atomic<std::uint32_t> finished { 0 };
+	std::atomic<std::uint32_t> on_caller { 0 };
+	for (std::size_t i = 0; i < 2 * JobSystem::arena_size; i++) {
+		jobs.dispatch([&finished, &on_caller, caller] {
+			on_caller.fetch_add(std::this_thread::get_id() == caller ? 1 : 0);
+			finished.fetch_add(1);
+		});
+	}
+	EXPECT_GT(on_caller.load(), 0);
+
+	release.store(true);
+	jobs.wait(blocker);
+	while (finished.load() < 2 * JobSystem::arena_size) {
+		std::this_thread::yield();
+	}
+}
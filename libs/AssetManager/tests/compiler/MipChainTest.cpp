@@ -0,0 +1,121 @@
+#include "compiler/MipChain.hpp"
+#include "compiler/TextureCompiler.hpp"
+
+#include <gtest/gtest.h>
+
+using AssetManager::MipChainSettings;
+using AssetManager::MipFilter;
+namespace MipChain = AssetManager::MipChain;
+
+static std::vector<std::uint8_t> solid_image(std::uint32_t width, std::uint32_t height, std::array<std::uint8_t, 4> colour)
+{
+	std::vector<std::uint8_t> rgba(static_cast<std::size_t>(width) * height * 4);
+	for (std::size_t i = 0; i < rgba.size(); i++) {
+		rgba[i] = colour[i % 4];
+	}
+	return rgba;
+}
+
+TEST(MipChainTest, LevelCountMatchesTexture)
+{
+	EXPECT_EQ(MipChain::level_count(256, 128), 8);
+	EXPECT_EQ(MipChain::level_count(5, 3), 2);
+	EXPECT_EQ(MipChain::level_count(1, 1), 1);
+}
+
+TEST(MipChainTest, LevelsHalveUntilTheSmallerSideIsOneTexel)
+{
+	const auto rgba = solid_image(64, 16, { 10, 20, 30, 255 });
+	const auto chain = MipChain::generate(rgba, 64, 16, {});
+
+	ASSERT_EQ(chain.size(), 5);
+	EXPECT_EQ(chain.front().texels, rgba);
+	EXPECT_EQ(chain.back().width, 4);
+	EXPECT_EQ(chain.back().height, 1);
+	for (const auto& level : chain) {
+		EXPECT_EQ(level.texels.size(), static_cast<std::size_t>(level.width) * level.height * 4);
+	}
+}
+
+TEST(MipChainTest, SolidColoursSurviveEveryFilter)
+{
+	const std::array<std::uint8_t, 4> colour = { 200, 100, 50, 128 };
+	const auto rgba = solid_image(32, 32, colour);
+
+	for (const auto filter : { MipFilter::Box, MipFilter::Kaiser }) {
+		const auto chain = MipChain::generate(rgba, 32, 32, MipChainSettings { .filter = filter, .srgb = true, .premultiply_alpha = true });
+		for (const auto& level : chain) {
+			for (std::size_t i = 0; i < level.texels.size(); i++) {
+				ASSERT_EQ(level.texels[i], colour[i % 4]) << "filter " << static_cast<std::uint32_t>(filter) << ", level " << level.width;
+			}
+		}
+	}
+}
+
+TEST(MipChainTest, SrgbTexelsAreAveragedInLinearSpace)
+{
+	// A black and white checkerboard averages to half the light, which is far brighter than half the encoded value.
+	std::vector<std::uint8_t> rgba = { 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 255 };
+
+	const auto srgb = MipChain::generate(rgba, 2, 2, MipChainSettings { .filter = MipFilter::Box, .srgb = true, .premultiply_alpha = false });
+	ASSERT_EQ(srgb.size(), 2);
+	EXPECT_NEAR(srgb[1].texels[0], 188, 1);
+
+	const auto linear = MipChain::generate(rgba, 2, 2, MipChainSettings { .filter = MipFilter::Box, .srgb = false, .premultiply_alpha = false });
+	EXPECT_NEAR(linear[1].texels[0], 128, 1);
+}
+
+TEST(MipChainTest, TransparentTexelsDoNotBleed)
+{
+	// One opaque red texel next to three fully transparent green ones.
+	std::vector<std::uint8_t> rgba = { 255, 0, 0, 255, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0 };
+
+	const auto premultiplied = MipChain::generate(rgba, 2, 2, MipChainSettings { .filter = MipFilter::Box, .srgb = true, .premultiply_alpha = true });
+	const auto& texel = premultiplied[1].texels;
+	EXPECT_EQ(texel[0], 255);
+	EXPECT_EQ(texel[1], 0);
+	EXPECT_NEAR(texel[3], 64, 1);
+
+	const auto straight = MipChain::generate(rgba, 2, 2, MipChainSettings { .filter = MipFilter::Box, .srgb = true, .premultiply_alpha = false });
+	EXPECT_GT(straight[1].texels[1], 200);
+}
+
+TEST(MipChainTest, KaiserAliasesLessThanBox)
+{
+	// Stripes repeating every three texels are too fine for the next level, whatever is left of them is aliasing.
+	static constexpr std::uint32_t size = 32;
+	std::vector<std::uint8_t> rgba(size * size * 4);
+	for (std::uint32_t y = 0; y < size; y++) {
+		for (std::uint32_t x = 0; x < size; x++) {
+			const std::uint8_t value = x % 3 == 0 ? 220 : 40;
+			std::fill_n(&rgba[(y * size + x) * 4], 3, value);
+			rgba[(y * size + x) * 4 + 3] = 255;
+		}
+	}
+
+	const auto contrast = [&](MipFilter filter) {
+		const auto chain = MipChain::generate(rgba, size, size, MipChainSettings { .filter = filter, .srgb = false, .premultiply_alpha = false });
+		std::uint8_t low = 255;
+		std::uint8_t high = 0;
+		for (std::size_t i = 0; i < chain[1].texels.size(); i += 4) {
+			low = std::min(low, chain[1].texels[i]);
+			high = std::max(high, chain[1].texels[i]);
+		}
+		return high - low;
+	};
+
+	EXPECT_LT(contrast(MipFilter::Kaiser), contrast(MipFilter::Box));
+}
+
+TEST(MipChainTest, UncompressedContainersKeepEveryLevel)
+{
+	const auto rgba = solid_image(16, 8, { 1, 2, 3, 4 });
+	const auto texture = AssetManager::TextureCompiler::compress(AssetManager::BlockFormat::RGBA8, rgba, 16, 8);
+
+	ASSERT_EQ(texture.mips.size(), 4);
+	for (const auto& mip : texture.mips) {
+		EXPECT_EQ(mip.size, static_cast<std::uint64_t>(mip.width) * mip.height * 4);
+		EXPECT_EQ(mip.offset % 16, 0);
+	}
+	EXPECT_TRUE(std::equal(rgba.begin(), rgba.end(), texture.data.begin()));
+}
@@ -0,0 +1,59 @@
+#include "compiler/ShaderDependencyGraph.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using AssetManager::ShaderDependencyGraph;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+static const auto shader_directory = std::filesystem::temp_directory_path() / "alabaster_dependency_graph";
+
+TEST(ShaderDependencyGraphTest, SharedIncludeAffectsEveryDependant)
+{
+	ShaderDependencyGraph graph;
+	graph.record("mesh", shader_directory / "mesh.frag", { shader_directory / "lighting.glsl" });
+	graph.record("quad", shader_directory / "quad.frag", { shader_directory / "lighting.glsl" });
+	graph.record("line", shader_directory / "line.frag", {});
+
+	EXPECT_THAT(graph.dependants(shader_directory / "lighting.glsl"), ElementsAre("mesh", "quad"));
+	EXPECT_THAT(graph.dependants(shader_directory / "line.frag"), ElementsAre("line"));
+	EXPECT_THAT(graph.dependants(shader_directory / "unrelated.glsl"), IsEmpty());
+}
+
+TEST(ShaderDependencyGraphTest, BothStagesReportTheShaderOnce)
+{
+	ShaderDependencyGraph graph;
+	graph.record("mesh", shader_directory / "mesh.vert", { shader_directory / "common.glsl" });
+	graph.record("mesh", shader_directory / "mesh.frag", { shader_directory / "common.glsl" });
+
+	EXPECT_THAT(graph.dependants(shader_directory / "common.glsl"), ElementsAre("mesh"));
+}
+
+TEST(ShaderDependencyGraphTest, RecordingAgainReplacesStaleIncludes)
+{
+	ShaderDependencyGraph graph;
+	graph.record("mesh", shader_directory / "mesh.frag", { shader_directory / "old.glsl" });
+	graph.record("mesh", shader_directory / "mesh.frag", { shader_directory / "new.glsl" });
+
+	EXPECT_THAT(graph.dependants(shader_directory / "old.glsl"), IsEmpty());
+	EXPECT_THAT(graph.dependants(shader_directory / "new.glsl"), ElementsAre("mesh"));
+}
+
+TEST(ShaderDependencyGraphTest, EquivalentPathsMatch)
+{
+	ShaderDependencyGraph graph;
+	graph.record("mesh", shader_directory / "mesh.frag", { shader_directory / "include" / ".." / "common.glsl" });
+
+	EXPECT_THAT(graph.dependants(shader_directory / "common.glsl"), ElementsAre("mesh"));
+}
+
+TEST(ShaderDependencyGraphTest, VariantsOfAStageAreTrackedSeparately)
+{
+	ShaderDependencyGraph graph;
+	graph.record("mesh", shader_directory / "mesh.frag", { shader_directory / "lighting.glsl" });
+	graph.record("mesh[UNLIT]", shader_directory / "mesh.frag", {});
+
+	EXPECT_THAT(graph.dependants(shader_directory / "mesh.frag"), ElementsAre("mesh", "mesh[UNLIT]"));
+	EXPECT_THAT(graph.dependants(shader_directory / "lighting.glsl"), ElementsAre("mesh"));
+}
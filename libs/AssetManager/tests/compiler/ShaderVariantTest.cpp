@@ -0,0 +1,34 @@
+#include "compiler/ShaderVariant.hpp"
+
+#include <gtest/gtest.h>
+
+using AssetManager::ShaderVariantKey;
+
+TEST(ShaderVariantTest, KeywordOrderDoesNotMatter)
+{
+	const ShaderVariantKey first { "mesh_light", { "UNLIT", "NORMAL_MAP", "UNLIT" } };
+	const ShaderVariantKey second { "mesh_light", { "NORMAL_MAP", "UNLIT" } };
+
+	EXPECT_EQ(first, second);
+	EXPECT_EQ(first.name(), "mesh_light[NORMAL_MAP,UNLIT]");
+}
+
+TEST(ShaderVariantTest, NoKeywordsNamesTheShader)
+{
+	EXPECT_EQ(ShaderVariantKey { "line" }.name(), "line");
+	EXPECT_NE(ShaderVariantKey { "line" }, ShaderVariantKey("line", { "UNLIT" }));
+}
+
+TEST(ShaderVariantTest, ManifestSkipsCommentsAndBlankLines)
+{
+	const auto variants = AssetManager::parse_variant_manifest("# Variants to compile at startup\n"
+																"mesh_light UNLIT\n"
+																"\n"
+																"  quad_light\tSHADOWS NORMAL_MAP # trailing comment\n"
+																"line\n");
+
+	ASSERT_EQ(variants.size(), 3);
+	EXPECT_EQ(variants[0].name(), "mesh_light[UNLIT]");
+	EXPECT_EQ(variants[1].name(), "quad_light[NORMAL_MAP,SHADOWS]");
+	EXPECT_EQ(variants[2].name(), "line");
+}
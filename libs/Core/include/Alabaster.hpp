@@ -9,6 +9,7 @@
 #include "core/events/Event.hpp"
 #include "core/events/KeyEvent.hpp"
 #include "core/events/MouseEvent.hpp"
+#include "filesystem/AssetPack.hpp"
 #include "filesystem/FileSystem.hpp"
 #include "glm/geometric.hpp"
 #include "graphics/Camera.hpp"
@@ -102,6 +102,8 @@ namespace Alabaster {
 		bool on_window_change(WindowCloseEvent& event);
 		void render_imgui();
 		void render_layers();
+		void apply_shader_reloads();
+		void evict_textures();
 		void update_layers(float ts);
 		void update_layers(double ts);
 
@@ -2,6 +2,8 @@
 
 #include "Alabaster.hpp"
 #include "AssetManager.hpp"
+#include "graphics/DescriptorLayoutCache.hpp"
+#include "graphics/PipelineCache.hpp"
 #include "graphics/Renderer.hpp"
 #include "graphics/Renderer3D.hpp"
 
@@ -45,6 +47,10 @@ int main(int argc, char** argv)
 		.type(po::string)
 		.fallback(std::string { "vsync" })
 		.bind(sync_mode);
+	std::string pack;
+	std::string write_pack;
+	parser["pack"].description("Asset pack to mount over the resource directory.").type(po::string).bind(pack);
+	parser["write-pack"].description("Pack the resource directory into this file and exit.").type(po::string).bind(write_pack);
 
 	if (!parser(argc, argv)) {
 		Alabaster::Log::critical("Could not parse argument options.");
@@ -66,6 +72,15 @@ int main(int argc, char** argv)
 
 	Alabaster::FileSystem::init_with_cwd(*root);
 
+	if (!write_pack.empty()) {
+		const auto written = Alabaster::AssetPack::write(write_pack, *root);
+		Alabaster::Log::info("[EntryPoint] {} {}.", written ? "Wrote" : "Could not write", write_pack);
+		return written ? 0 : 1;
+	}
+	if (!pack.empty() && !Alabaster::FileSystem::mount(pack)) {
+		return 1;
+	}
+
 	try {
 		app = Alabaster::create(props);
 	} catch (const std::system_error& e) {
@@ -82,6 +97,8 @@ int main(int argc, char** argv)
 
 	Alabaster::Renderer::shutdown();
 	AssetManager::ResourceCache::the().shutdown();
+	Alabaster::PipelineCache::the().destroy();
+	Alabaster::DescriptorLayoutCache::the().destroy();
 	Alabaster::Allocator::shutdown();
 	Alabaster::GraphicsContext::the().destroy();
 
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "filesystem/MappedFile.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace Alabaster {
+
+	/// @brief Read only archive of resources, mapped into memory as a whole. The layout is a header, a table of contents sorted by
+	/// path, the path strings and finally the file contents, each starting on a blob_alignment boundary. Every entry carries a hash of
+	/// its contents so a pack can be checked against corruption without unpacking it.
+	class AssetPack {
+	public:
+		static constexpr std::uint64_t blob_alignment = 64;
+
+		struct Entry {
+			/// @brief Generic path relative to the packed directory, e.g. "textures/wood.png".
+			std::string_view path;
+			std::span<const std::uint8_t> bytes;
+			std::uint64_t hash { 0 };
+		};
+
+		/// @brief Only checks the structure, the contents are left to the page cache until they are first read.
+		/// @return the pack, or nothing if the file is missing, truncated, corrupt or not a pack of this version
+		static std::optional<AssetPack> open(const std::filesystem::path& path);
+
+		/// @brief Packs every regular file below a directory, keyed by its path relative to that directory.
+		/// @return false if a file could not be read or the pack could not be written
+		static bool write(const std::filesystem::path& output, const std::filesystem::path& directory);
+
+		/// @brief The first read of an entry checks it against its hash.
+		/// @param path generic path relative to the packed directory
+		/// @return the contents of the file, straight from the mapping, or nothing if it is missing or corrupt
+		std::optional<std::span<const std::uint8_t>> find(std::string_view path) const;
+		bool contains(std::string_view path) const { return lookup(path) != nullptr; }
+
+		/// @param directory generic path relative to the packed directory, empty for the top level
+		/// @return entries in the directory, and in all directories below it when recursive
+		std::vector<const Entry*> list(std::string_view directory, bool recursive) const;
+
+		/// @return false if the contents of the entry no longer match the hash it was packed with
+		static bool verify(const Entry& entry);
+		/// @brief Reads every entry, for tools checking a whole pack up front.
+		/// @return false if any entry is corrupt
+		bool verify_all() const;
+
+		std::span<const Entry> entries() const { return table; }
+
+	private:
+		enum class Check : std::uint8_t { Pending, Intact, Corrupt };
+
+		const Entry* lookup(std::string_view path) const;
+
+		MappedFile file;
+		std::vector<Entry> table;
+		mutable std::vector<std::atomic<Check>> checked;
+	};
+
+} // namespace Alabaster
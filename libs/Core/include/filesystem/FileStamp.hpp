@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+
+namespace Alabaster {
+
+	/// @brief Size and modification time of a file together with the hash of its contents. The contents are only hashed again once the
+	/// size or modification time changed, so checking an unchanged file costs a stat.
+	struct FileStamp {
+		/// @brief A file written this recently can be written again within the same tick of its modification time, without changing its
+		/// size.
+		static constexpr auto racy_window = std::chrono::seconds(2);
+
+		std::uint64_t size { 0 };
+		/// @brief Zero if the time cannot be trusted, which forces the contents to be hashed.
+		std::int64_t last_write { 0 };
+		std::uint64_t hash { 0 };
+
+		/// @return whether the hash of the previous stamp still holds, i.e. both have the same trusted time and size
+		bool can_reuse_hash(const FileStamp& previous) const;
+
+		/// @brief Stats a file without reading it. The time is left at zero if it lies within the racy window, and the size as well if
+		/// the file is not a loose one (e.g. it lives in a mounted pack).
+		static FileStamp stat(const std::filesystem::path& path);
+
+		/// @brief Completes a stat with the contents read after it. The time is dropped if the size no longer agrees, the file changed
+		/// in between.
+		FileStamp hashed(std::span<const std::uint8_t> contents) const;
+
+		/// @param previous stamp of the same file, its hash is reused if the size and modification time did not change
+		/// @return nothing if the file cannot be read
+		static std::optional<FileStamp> of(const std::filesystem::path& path, const FileStamp* previous = nullptr);
+	};
+
+} // namespace Alabaster
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <filesystem>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string_view>
 #include <unordered_set>
 #include <vector>
@@ -15,6 +19,7 @@ namespace Alabaster::FileSystem {
 	std::filesystem::path scenes();
 	std::filesystem::path scripts();
 	std::filesystem::path textures();
+	std::filesystem::path cache();
 
 	std::filesystem::path resources();
 	std::filesystem::path executable();
@@ -36,6 +41,32 @@ namespace Alabaster::FileSystem {
 	std::optional<std::filesystem::path> find_file(
 		const std::string& name, const std::string& directory, const std::unordered_set<std::string>& extensions);
 
+	/// @brief Contents of a file without any copies, either a slice of a mounted pack or a mapping of a loose file. The view stays valid
+	/// for as long as it is alive, even if the pack it came from is unmounted.
+	struct FileView {
+		std::span<const std::uint8_t> bytes;
+		std::shared_ptr<const void> owner;
+
+		std::string_view text() const { return { reinterpret_cast<const char*>(bytes.data()), bytes.size() }; }
+	};
+
+	/// @brief Mounts a directory or an asset pack over the resource root. Paths below the root (everything the helpers below return) are
+	/// looked up in the most recent mount first and fall back to the loose files under the root.
+	/// @param source directory laid out like the resource root, or a pack written by AssetPack::write from one
+	/// @return false if the source is neither a directory nor a valid pack
+	bool mount(const std::filesystem::path& source);
+	void unmount_all();
+
+	/// @return the contents of a file, resolved through the mounts
+	std::optional<FileView> read(const std::filesystem::path& path);
+	/// @return true if the path is a directory or a file, resolved through the mounts
+	bool exists(const std::filesystem::path& path);
+	/// @return true if the path is a regular file, resolved through the mounts
+	bool is_file(const std::filesystem::path& path);
+
+	/// @brief Files a directory below the resource root holds in the mounts, as paths below the root.
+	std::vector<std::filesystem::path> mounted_files(const std::filesystem::path& directory, bool recursive);
+
 	template <typename Path = std::filesystem::path> std::filesystem::path shader(const Path& path)
 	{
 		return FileSystem::shaders() / std::filesystem::path { path };
@@ -60,38 +91,48 @@ namespace Alabaster::FileSystem {
 	{
 		return FileSystem::scripts() / std::filesystem::path { path };
 	}
+	template <typename Path = std::filesystem::path> std::filesystem::path cache(const Path& path)
+	{
+		return FileSystem::cache() / std::filesystem::path { path };
+	}
 
 	template <typename Output = std::string, typename Hasher = std::hash<std::string>, typename Equality = std::equal_to<std::string>,
 		bool Recursive = false>
 	std::vector<Output> in_directory(const std::filesystem::path& path, std::unordered_set<std::string, Hasher, Equality> extensions, bool sorted)
 	{
-		static constexpr auto entry_to_string = [](const auto& input) { return input.path().extension().string(); };
-		static auto should_include = [&extensions](const auto& input) {
+		const auto should_include = [&extensions](const std::filesystem::path& input) {
 			if (extensions.contains("*")) {
 				return true;
 			}
 
-			return extensions.contains(entry_to_string(input));
-		};
-		static auto add_to_output = [](const auto& fd, auto& output) mutable {
-			if constexpr (std::is_same_v<Output, std::filesystem::path>) {
-				output.push_back(static_cast<Output>(fd.path().string()));
-			} else {
-				output.push_back(static_cast<Output>(fd.path().string()));
-			};
+			return extensions.contains(input.extension().string());
 		};
+		const auto add_to_output = [](const std::filesystem::path& input, auto& output) { output.push_back(static_cast<Output>(input.string())); };
 
+		// Mounted files come first, a loose file only shows up if no mount already provides it.
 		std::vector<Output> output;
-		if constexpr (Recursive) {
-			for (const auto& fd : std::filesystem::recursive_directory_iterator { path }) {
-				if (should_include(fd)) {
-					add_to_output(fd, output);
-				}
+		std::unordered_set<std::string> mounted;
+		for (const auto& file : FileSystem::mounted_files(path, Recursive)) {
+			if (should_include(file)) {
+				mounted.insert(file.string());
+				add_to_output(file, output);
+			}
+		}
+
+		const auto add_loose = [&](const auto& fd) {
+			if (should_include(fd.path()) && !mounted.contains(fd.path().string())) {
+				add_to_output(fd.path(), output);
 			}
-		} else {
-			for (const auto& fd : std::filesystem::directory_iterator { path }) {
-				if (should_include(fd)) {
-					add_to_output(fd, output);
+		};
+		std::error_code error;
+		if (mounted.empty() || std::filesystem::is_directory(path, error)) {
+			if constexpr (Recursive) {
+				for (const auto& fd : std::filesystem::recursive_directory_iterator { path }) {
+					add_loose(fd);
+				}
+			} else {
+				for (const auto& fd : std::filesystem::directory_iterator { path }) {
+					add_loose(fd);
 				}
 			}
 		}
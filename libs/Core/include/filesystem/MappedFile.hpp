@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+
+namespace Alabaster {
+
+	/// @brief Read only mapping of a whole file. Opening costs one open and one map call regardless of the size of the file, and pages
+	/// are only read from disk once they are touched.
+	class MappedFile {
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		/// @return the mapped file, empty files map to an empty span. Nothing if the file could not be opened or mapped.
+		static std::optional<MappedFile> open(const std::filesystem::path& path);
+
+		std::span<const std::uint8_t> bytes() const { return { data, size }; }
+
+	private:
+		void unmap();
+
+		const std::uint8_t* data { nullptr };
+		std::size_t size { 0 };
+		/// @brief File mapping object, only used on Windows.
+		void* handle { nullptr };
+	};
+
+} // namespace Alabaster
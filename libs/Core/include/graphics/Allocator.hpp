@@ -46,6 +46,11 @@ namespace Alabaster {
 			STRATEGY_MASK = STRATEGY_MIN_MEMORY_BIT | STRATEGY_MIN_TIME_BIT | STRATEGY_MIN_OFFSET_BIT,
 		};
 
+		struct MemoryBudget {
+			VkDeviceSize usage { 0 };
+			VkDeviceSize budget { 0 };
+		};
+
 		Allocator() = default;
 		explicit Allocator(const std::string& tag);
 		~Allocator();
@@ -68,6 +73,10 @@ namespace Alabaster {
 
 		static VmaAllocator& get_vma_allocator();
 
+		/// @brief Usage and budget of the device local heaps as reported by vmaGetHeapBudgets. Without VK_EXT_memory_budget VMA estimates
+		/// both from its own allocations and the heap sizes.
+		static MemoryBudget device_local_budget();
+
 	private:
 		std::string tag;
 	};
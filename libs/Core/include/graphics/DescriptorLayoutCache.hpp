@@ -0,0 +1,42 @@
+#pragma once
+
+#include "graphics/ShaderReflection.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+using VkDescriptorSetLayout = struct VkDescriptorSetLayout_T*;
+using VkPipelineLayout = struct VkPipelineLayout_T*;
+struct VkPushConstantRange;
+
+namespace Alabaster {
+
+	/// @brief Owns every descriptor set layout and pipeline layout, deduplicated by what they describe. Pipelines whose shaders have the
+	/// same interface get the same layouts, so a descriptor set allocated for one of them can be bound with any of them. Thread safe.
+	class DescriptorLayoutCache {
+	public:
+		static DescriptorLayoutCache& the();
+
+		/// @param bindings bindings of one set, sorted by binding. No bindings gives an empty layout, for sets a shader skips.
+		VkDescriptorSetLayout descriptor_set_layout(std::span<const DescriptorBinding> bindings);
+
+		/// @return a layout for every set up to the highest one the reflection uses
+		std::vector<VkDescriptorSetLayout> descriptor_set_layouts(const ShaderReflection& reflection);
+
+		VkPipelineLayout pipeline_layout(std::span<const VkDescriptorSetLayout> set_layouts, std::span<const VkPushConstantRange> push_constants);
+
+		/// @brief Destroys every layout, once nothing that uses them is left.
+		void destroy();
+
+	private:
+		DescriptorLayoutCache() = default;
+
+		std::mutex mutex;
+		std::unordered_map<std::uint64_t, VkDescriptorSetLayout> set_layouts;
+		std::unordered_map<std::uint64_t, VkPipelineLayout> pipeline_layouts;
+	};
+
+} // namespace Alabaster
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "graphics/MeshFile.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Alabaster {
+
+	/// @brief A mesh's bounds in world space, the box around its transformed box and its transformed sphere, both around one centre.
+	struct WorldBounds {
+		glm::vec3 centre { 0.0f };
+		/// @brief Half the size of the box along each axis.
+		glm::vec3 extent { 0.0f };
+		float radius { 0.0f };
+
+		/// @brief The box is fitted around the transformed one (Arvo, 1990), the sphere grows with the largest scale of the transform.
+		static WorldBounds of(const MeshBounds& bounds, const glm::mat4& transform);
+	};
+
+	/// @brief The six planes bounding a view volume, with unit normals facing into it.
+	struct Frustum {
+		std::array<glm::vec4, 6> planes {};
+
+		/// @brief Takes the planes from a clip transform (Gribb & Hartmann), with depth running from 0 to 1 as in Vulkan. The clip transform
+		/// of a model gives them in its model space.
+		static Frustum of(const glm::mat4& clip);
+
+		bool intersects(const glm::vec3& centre, float radius) const;
+		/// @brief A plane culls the bounds once either the box or the sphere is behind it, they only count as visible where both reach in.
+		bool intersects(const WorldBounds& bounds) const;
+	};
+
+	struct CullingStatistics {
+		std::uint32_t visible { 0 };
+		std::uint32_t culled { 0 };
+		double milliseconds { 0.0 };
+	};
+
+	/// @brief Culls many bounds against one frustum. The bounds are kept as structures of arrays and tested four at a time with SSE,
+	/// or one at a time where it is not available. Large sets are split across the job system.
+	class FrustumCuller {
+	public:
+		/// @brief Fewer bounds are culled on the calling thread, handing them to workers would cost more than it saves.
+		static constexpr std::size_t parallel_threshold = 32768;
+		/// @brief A multiple of the vector width, so only the last job has a remainder to test one by one.
+		static constexpr std::size_t bounds_per_job = 8192;
+
+		void clear();
+		void reserve(std::size_t count);
+		void add(const WorldBounds& bounds);
+
+		[[nodiscard]] std::size_t size() const { return centre_x.size(); }
+
+		/// @param visible resized to one flag for every bounds, in the order they were added
+		/// @return how many are visible
+		std::size_t cull(const Frustum& frustum, std::vector<std::uint8_t>& visible) const;
+
+	private:
+		std::vector<float> centre_x;
+		std::vector<float> centre_y;
+		std::vector<float> centre_z;
+		std::vector<float> extent_x;
+		std::vector<float> extent_y;
+		std::vector<float> extent_z;
+		std::vector<float> radius;
+	};
+
+} // namespace Alabaster
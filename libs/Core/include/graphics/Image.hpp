@@ -46,6 +46,12 @@ namespace Alabaster {
 
 		SRGB,
 
+		// 4x4 texel blocks, see Utilities::is_block_compressed
+		BC1,
+		BC3,
+		BC5,
+		BC7,
+
 		DEPTH32FSTENCIL8UINT,
 		DEPTH32F,
 		DEPTH24STENCIL8,
@@ -72,6 +78,8 @@ namespace Alabaster {
 		bool generate_mips { true };
 		bool srgb { false };
 		bool storage { false };
+		/// @brief Block format streamed images are compressed into ahead of time (BC1, BC3, BC5 or BC7), None uploads them as decoded.
+		ImageFormat compression { ImageFormat::None };
 	};
 
 	struct ImageSpecification {
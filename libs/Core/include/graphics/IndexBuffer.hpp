@@ -3,6 +3,7 @@
 #include "core/Buffer.hpp"
 
 #include <array>
+#include <span>
 #include <vector>
 
 using VmaAllocation = struct VmaAllocation_T*;
@@ -12,6 +13,11 @@ namespace Alabaster {
 
 	using Index = std::uint32_t;
 
+	enum class IndexType : std::uint8_t { UInt16, UInt32 };
+
+	/// @brief Meshes with fewer vertices than this are drawn with 16-bit indices.
+	static constexpr std::size_t max_uint16_vertices = 65536;
+
 	class IndexBuffer {
 	public:
 		~IndexBuffer();
@@ -19,6 +25,8 @@ namespace Alabaster {
 		void set_data(const void* buffer, std::uint32_t size, std::uint32_t offset);
 
 		std::uint32_t count() const { return buffer_count; };
+		std::uint32_t size() const { return buffer_size; };
+		IndexType index_type() const { return type; };
 
 		VkBuffer get_vulkan_buffer() const;
 
@@ -35,6 +43,14 @@ namespace Alabaster {
 			return std::shared_ptr<IndexBuffer>(new IndexBuffer { indices.data(), static_cast<std::uint32_t>(indices.size()) });
 		}
 
+		inline static std::shared_ptr<IndexBuffer> create(std::span<const Index> indices)
+		{
+			return std::shared_ptr<IndexBuffer>(new IndexBuffer { indices.data(), static_cast<std::uint32_t>(indices.size()) });
+		}
+
+		/// @brief Uploads 16-bit indices when there are fewer than max_uint16_vertices vertices, halving the buffer.
+		static std::shared_ptr<IndexBuffer> create(std::span<const Index> indices, std::size_t vertex_count);
+
 		inline static std::shared_ptr<IndexBuffer> create(std::size_t count)
 		{
 			return std::shared_ptr<IndexBuffer>(new IndexBuffer { static_cast<std::uint32_t>(count) });
@@ -46,11 +62,12 @@ namespace Alabaster {
 
 		std::uint32_t buffer_size { 0 };
 		std::uint32_t buffer_count { 0 };
+		IndexType type { IndexType::UInt32 };
 
 		VkBuffer vulkan_buffer { nullptr };
 
 		explicit IndexBuffer(std::uint32_t count);
-		IndexBuffer(const void* data, std::uint32_t count);
+		IndexBuffer(const void* data, std::uint32_t count, IndexType index_type = IndexType::UInt32);
 
 		void offline_set_data(const void* buffer, std::uint32_t size, std::uint32_t offset);
 	};
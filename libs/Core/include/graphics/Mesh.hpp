@@ -3,11 +3,14 @@
 #include "filesystem/FileSystem.hpp"
 #include "glm/fwd.hpp"
 #include "graphics/IndexBuffer.hpp"
+#include "graphics/MeshFile.hpp"
 #include "graphics/Vertex.hpp"
 #include "graphics/VertexBuffer.hpp"
+#include "graphics/VertexPacker.hpp"
 
 #include <filesystem>
 #include <memory>
+#include <span>
 #include <unordered_map>
 
 namespace Alabaster {
@@ -15,10 +18,18 @@ namespace Alabaster {
 	class VertexBuffer;
 	class IndexBuffer;
 
-	class Mesh {
-		using Indices = std::vector<Index>;
-		using Vertices = std::vector<Vertex>;
+	/// @brief Bytes the mesh occupies on the GPU, next to what full vertices and 32-bit indices would take.
+	struct MeshMemoryUsage {
+		std::size_t vertex_bytes { 0 };
+		std::size_t index_bytes { 0 };
+		std::size_t full_vertex_bytes { 0 };
+		std::size_t full_index_bytes { 0 };
+
+		std::size_t bytes() const { return vertex_bytes + index_bytes; }
+		std::size_t saved_bytes() const { return full_vertex_bytes + full_index_bytes - bytes(); }
+	};
 
+	class Mesh {
 	public:
 		~Mesh();
 
@@ -26,12 +37,29 @@ namespace Alabaster {
 		const IndexBuffer& get_index_buffer() const { return *index_buffer; }
 
 		std::size_t get_index_count() const { return index_count; }
+		const MeshBounds& get_bounds() const { return bounds; }
+		/// @brief Empty for meshes created from data, imported meshes are split into meshlets the renderer can cull one by one.
+		std::span<const Meshlet> get_meshlets() const { return meshlets; }
+		/// @brief The levels of detail from the full mesh to the coarsest, all ranges of the one index buffer. Meshes created from data
+		/// only have the full mesh.
+		std::span<const MeshLod> get_lods() const { return lods; }
+
+		/// @brief Meshes drawn with the renderer's own pipeline get the variant for their format, pipelines passed in must match it.
+		const VertexFormat& get_vertex_format() const { return vertex_format; }
+		/// @brief Maps the vertex buffer's positions into model space, applied in front of the object transform.
+		const glm::mat4& get_vertex_transform() const { return vertex_transform; }
+		/// @brief The colour of every vertex when the format dropped it, shaders reading a format without colour use white.
+		const glm::vec4& get_constant_colour() const { return constant_colour; }
+		const MeshMemoryUsage& get_memory_usage() const { return memory_usage; }
 
 		const auto& get_asset_path() const { return path; }
 
 	private:
-		explicit Mesh(const std::filesystem::path& input_path);
-		Mesh(const std::vector<Vertex>& vertices, const std::vector<Index>& indices);
+		Mesh(const std::filesystem::path& input_path, VertexEncoding encoding);
+		Mesh(const std::vector<Vertex>& vertices, const std::vector<Index>& indices, VertexEncoding encoding);
+
+		/// @param indices the full mesh's indices, followed by those of the levels of detail set before uploading
+		void upload(std::span<const Vertex> vertices, std::span<const Index> indices, VertexEncoding encoding);
 
 		std::filesystem::path path;
 
@@ -43,17 +71,24 @@ namespace Alabaster {
 		std::optional<glm::mat4> scale { std::nullopt };
 
 		std::size_t index_count { 0 };
-
-		std::tuple<Vertices, Indices> load_model();
+		MeshBounds bounds {};
+		std::vector<Meshlet> meshlets;
+		std::vector<MeshLod> lods;
+		VertexFormat vertex_format {};
+		glm::mat4 vertex_transform { 1.0f };
+		glm::vec4 constant_colour { 1.0f };
+		MeshMemoryUsage memory_usage {};
 
 	public:
-		static std::shared_ptr<Mesh> from_file(const std::filesystem::path& args)
+		/// @brief Imports an OBJ model the first time, later loads map the .amesh container written to the mesh cache.
+		static std::shared_ptr<Mesh> from_file(const std::filesystem::path& args, VertexEncoding encoding = VertexEncoding::Full)
 		{
-			return std::shared_ptr<Mesh>(new Mesh { FileSystem::model(args) });
+			return std::shared_ptr<Mesh>(new Mesh { FileSystem::model(args), encoding });
 		};
-		static std::shared_ptr<Mesh> from_data(const std::vector<Vertex>& vertices, const std::vector<Index>& indices)
+		static std::shared_ptr<Mesh> from_data(
+			const std::vector<Vertex>& vertices, const std::vector<Index>& indices, VertexEncoding encoding = VertexEncoding::Full)
 		{
-			return std::shared_ptr<Mesh>(new Mesh { vertices, indices });
+			return std::shared_ptr<Mesh>(new Mesh { vertices, indices, encoding });
 		};
 	};
 
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "filesystem/FileStamp.hpp"
+#include "filesystem/MappedFile.hpp"
+#include "graphics/MeshSimplifier.hpp"
+#include "graphics/MeshletBuilder.hpp"
+#include "graphics/Vertex.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace Alabaster {
+
+	struct MeshBounds {
+		glm::vec3 min { 0.0f };
+		glm::vec3 max { 0.0f };
+		/// @brief The sphere around the centre of the box reaching the farthest vertex, tighter than the half diagonal on rounded meshes.
+		float radius { 0.0f };
+
+		glm::vec3 centre() const { return 0.5f * (min + max); }
+
+		static MeshBounds of(std::span<const Vertex> vertices);
+	};
+
+	struct MeshData {
+		std::vector<Vertex> vertices;
+		std::vector<Index> indices;
+		/// @brief Empty unless the mesh was split, the indices are then ordered meshlet by meshlet.
+		std::vector<Meshlet> meshlets;
+		/// @brief The coarser levels of detail, drawn from the same vertices. Their ranges count on from the end of indices, as if
+		/// lod_indices followed them in one buffer.
+		std::vector<MeshLod> lods;
+		std::vector<Index> lod_indices;
+		MeshBounds bounds;
+		/// @brief What the mesh was imported from.
+		FileStamp source;
+	};
+
+	struct MeshImportOptions {
+		/// @brief Merges vertices whose attributes are within weld_tolerance of each other, for models that repeat positions instead
+		/// of sharing them (e.g. exporters writing every face with its own corners). Triangles that collapse are dropped.
+		bool weld { false };
+		float weld_tolerance { 0.00001f };
+		/// @brief Reorders triangles and vertices for the vertex cache, overdraw and vertex fetch, see MeshOptimiser.
+		bool optimise { true };
+		/// @brief Splits the mesh into meshlets after optimising it, see MeshletBuilder.
+		bool meshlets { true };
+		/// @brief Share of the triangles every level of detail keeps, see MeshSimplifier. Empty imports the full mesh only.
+		std::vector<float> lod_ratios { 0.5f, 0.25f, 0.125f };
+		/// @brief Largest error a level of detail may have, relative to the radius of the mesh's bounds.
+		float lod_error { 0.01f };
+	};
+
+	/// @brief Memory mapped .amesh container. The layout is a header followed by the deduplicated vertices, the indices of every
+	/// level of detail, the meshlets and the levels, each starting on a data_alignment boundary so they can be copied into a staging
+	/// buffer straight from the mapping. The header carries the bounds and the source the mesh was imported from.
+	class MeshFile {
+	public:
+		static constexpr std::uint64_t data_alignment = 64;
+
+		/// @return the container, or nothing if the file is missing, truncated, of another version or written with another vertex layout
+		static std::optional<MeshFile> open(const std::filesystem::path& path);
+
+		static bool write(const std::filesystem::path& path, const MeshData& mesh);
+
+		/// @brief Parses an OBJ file and deduplicates its vertices. Corners referencing the same position, normal and texture
+		/// coordinate become one vertex, welding near duplicates is optional.
+		/// @return nothing if the file could not be read or parsed
+		static std::optional<MeshData> import_obj(const std::filesystem::path& source, const MeshImportOptions& options = {});
+
+		/// @return the container for a source in the mesh cache directory
+		static std::filesystem::path cache_path(const std::filesystem::path& source);
+
+		/// @brief Whether the source still has the contents this container was imported from.
+		bool is_current(const std::filesystem::path& source) const;
+
+		std::span<const Vertex> vertices() const { return vertex_data; }
+		/// @return the indices of the full mesh
+		std::span<const Index> indices() const { return index_data.first(lod_data.empty() ? index_data.size() : lod_data.front().first_index); }
+		/// @return the indices of the full mesh followed by those of the coarser levels
+		std::span<const Index> all_indices() const { return index_data; }
+		std::span<const Meshlet> meshlets() const { return meshlet_data; }
+		std::span<const MeshLod> lods() const { return lod_data; }
+		const MeshBounds& bounds() const { return mesh_bounds; }
+		const FileStamp& source() const { return mesh_source; }
+
+	private:
+		MappedFile file;
+		std::span<const Vertex> vertex_data;
+		std::span<const Index> index_data;
+		std::span<const Meshlet> meshlet_data;
+		std::span<const MeshLod> lod_data;
+		MeshBounds mesh_bounds;
+		FileStamp mesh_source;
+	};
+
+} // namespace Alabaster
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "graphics/MeshFile.hpp"
+#include "graphics/Vertex.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Alabaster {
+
+	/// @brief Post-transform vertex cache behaviour of an index buffer, simulated with a FIFO cache.
+	struct VertexCacheStatistics {
+		/// @brief Average cache miss ratio, vertex shader invocations per triangle. Three means no reuse, a regular grid approaches 0.5.
+		float acmr { 0.0f };
+		/// @brief Average transformed vertex ratio, vertex shader invocations per referenced vertex. One means every vertex is
+		/// transformed once.
+		float atvr { 0.0f };
+	};
+
+	struct MeshOptimisationReport {
+		VertexCacheStatistics before;
+		VertexCacheStatistics after;
+	};
+
+	/// @brief Reorders imported meshes for the GPU, on the CPU. Triangles are ordered for vertex cache reuse with Tipsify (Sander,
+	/// Nehab & Barczak, 2007), the resulting clusters are ordered so outward facing ones are drawn first and occlude the rest, and
+	/// vertices are finally laid out in the order they are first used so vertex fetch reads memory linearly.
+	class MeshOptimiser {
+	public:
+		/// @brief Small enough to stay below the reuse window of every GPU we run on.
+		static constexpr std::uint32_t cache_size = 16;
+		/// @brief How much worse than the Tipsify order the overdraw order may use the vertex cache.
+		static constexpr float overdraw_threshold = 1.05f;
+
+		/// @brief Runs every step on the mesh and measures the vertex cache before and after.
+		static MeshOptimisationReport optimise(MeshData& mesh);
+
+		/// @brief Reorders triangles for vertex cache reuse.
+		/// @return the first triangle of every cluster, the points at which Tipsify had to restart away from the cached vertices
+		static std::vector<std::uint32_t> optimise_vertex_cache(std::span<Index> indices, std::size_t vertex_count);
+
+		/// @brief Splits the clusters where that costs little cache efficiency, then sorts them front to back by how far they face
+		/// away from the centre of the mesh. Triangles within a cluster keep their order, and the order is only kept if the ACMR
+		/// stays within threshold of what it was.
+		/// @param clusters the first triangle of every cluster, as returned by optimise_vertex_cache
+		static void optimise_overdraw(std::span<Index> indices, std::span<const Vertex> vertices, std::span<const std::uint32_t> clusters,
+			float threshold = overdraw_threshold);
+
+		/// @brief Reorders the triangles within every meshlet for vertex cache reuse. Meshlets keep their index ranges, splitting a mesh
+		/// into them regroups its triangles and undoes the order optimise_vertex_cache found for the whole mesh.
+		static void optimise_meshlets(std::span<Index> indices, std::span<const Meshlet> meshlets, std::size_t vertex_count);
+
+		/// @brief Lays vertices out in the order the indices first reference them and drops vertices no triangle uses.
+		static void optimise_vertex_fetch(std::vector<Vertex>& vertices, std::span<Index> indices);
+
+		static VertexCacheStatistics analyse_vertex_cache(std::span<const Index> indices, std::size_t vertex_count, std::uint32_t size = cache_size);
+	};
+
+} // namespace Alabaster
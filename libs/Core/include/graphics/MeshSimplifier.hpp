@@ -0,0 +1,53 @@
+#pragma once
+
+#include "graphics/Vertex.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Alabaster {
+
+	/// @brief A level of detail, a range of the mesh's index buffer drawing a subset of the same vertices.
+	struct MeshLod {
+		std::uint32_t first_index { 0 };
+		std::uint32_t index_count { 0 };
+		/// @brief How far the level strays from the full mesh, the root mean square distance in model space from the surface it
+		/// replaces.
+		float error { 0.0f };
+	};
+
+	struct SimplifiedMesh {
+		std::vector<Index> indices;
+		float error { 0.0f };
+	};
+
+	/// @brief Simplifies meshes with quadric error metrics (Garland & Heckbert, 1997). Edges are collapsed onto one of their own
+	/// vertices, never onto a new position, so every level draws from the vertex buffer of the full mesh. Vertices on open borders,
+	/// on attribute seams (e.g. uv or hard normal edges) and on non-manifold edges are never moved, which keeps the outline and the
+	/// texturing of the mesh intact at the cost of how far it can be simplified.
+	class MeshSimplifier {
+	public:
+		/// @brief A level has to drop at least this share of the triangles of the one before it to be worth keeping.
+		static constexpr float min_reduction = 0.2f;
+
+		/// @param target_index_count stops once the mesh has no more indices than this
+		/// @param max_error stops before a collapse would make the error exceed this, in model space
+		static SimplifiedMesh simplify(
+			std::span<const Vertex> vertices, std::span<const Index> indices, std::size_t target_index_count, float max_error);
+
+		/// @brief Simplifies to every ratio of the triangles in turn, each level continuing from the one before it. The chain ends early at
+		/// a ratio the error bound does not allow.
+		/// @param lod_indices the levels' indices are appended to it
+		/// @return the levels, whose first indices count on from the end of indices, as if lod_indices followed them in one buffer
+		static std::vector<MeshLod> build_lods(std::span<const Vertex> vertices, std::span<const Index> indices, std::span<const float> ratios,
+			float max_error, std::vector<Index>& lod_indices);
+
+		/// @brief Picks the coarsest level whose error covers no more than max_screen_error pixels.
+		/// @param lods the levels from full detail to coarsest
+		/// @param pixels_per_unit how many pixels one unit of model space covers where the mesh is drawn
+		static std::size_t select_lod(std::span<const MeshLod> lods, float pixels_per_unit, float max_screen_error);
+	};
+
+} // namespace Alabaster
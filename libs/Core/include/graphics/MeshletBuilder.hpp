@@ -0,0 +1,53 @@
+#pragma once
+
+#include "graphics/Vertex.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Alabaster {
+
+	/// @brief A cluster of triangles. Its indices are one contiguous range of the mesh's index buffer, so it can be drawn on its own.
+	struct Meshlet {
+		std::uint32_t first_index { 0 };
+		std::uint32_t triangle_count { 0 };
+		std::uint32_t vertex_count { 0 };
+		/// @brief Bounding sphere in model space.
+		glm::vec3 centre { 0.0f };
+		float radius { 0.0f };
+		/// @brief Normal cone, the average direction the triangles face.
+		glm::vec3 cone_axis { 0.0f, 0.0f, 1.0f };
+		/// @brief Sine of the largest angle between a triangle normal and the axis, one if the triangles face too many ways to ever be
+		/// culled together.
+		float cone_cutoff { 1.0f };
+
+		/// @return whether every triangle faces away from the viewer, tested conservatively against the whole bounding sphere
+		bool is_backfacing(const glm::vec3& viewer) const;
+	};
+
+	struct MeshletStatistics {
+		float triangles_per_meshlet { 0.0f };
+		float vertices_per_meshlet { 0.0f };
+		float average_cone_cutoff { 0.0f };
+		/// @brief Share of the meshlets whose cone is narrow enough to be culled from some direction.
+		float cullable_ratio { 0.0f };
+	};
+
+	/// @brief Splits meshes into meshlets small enough for a mesh shader workgroup, or for the CPU to cull clusters of a large mesh.
+	/// Meshlets are grown greedily from triangles adjacent to those already in them, preferring the ones adding the fewest vertices
+	/// and facing the way the meshlet does.
+	class MeshletBuilder {
+	public:
+		static constexpr std::uint32_t max_vertices = 64;
+		static constexpr std::uint32_t max_triangles = 124;
+		/// @brief How much a triangle facing away from the meshlet counts against it, in vertices it would add.
+		static constexpr float cone_weight = 0.5f;
+
+		/// @brief Reorders the triangles so every meshlet is a contiguous range of the indices.
+		static std::vector<Meshlet> build(std::span<const Vertex> vertices, std::span<Index> indices);
+
+		static MeshletStatistics analyse(std::span<const Meshlet> meshlets);
+	};
+
+} // namespace Alabaster
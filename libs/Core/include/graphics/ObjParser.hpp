@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace Alabaster {
+
+	/// @brief One corner of a face. The indices are zero based into the attributes of the model, -1 if the corner has no normal or
+	/// texture coordinate.
+	struct ObjIndex {
+		std::int32_t position { -1 };
+		std::int32_t normal { -1 };
+		std::int32_t texcoord { -1 };
+
+		bool operator==(const ObjIndex&) const = default;
+	};
+
+	/// @brief The geometry of an OBJ file. Groups, objects and materials are not kept, faces are triangulated in the order they
+	/// appear in the file.
+	struct ObjModel {
+		/// @brief Three components per position.
+		std::vector<float> positions;
+		/// @brief Three components per normal.
+		std::vector<float> normals;
+		/// @brief Two components per texture coordinate, as written in the file.
+		std::vector<float> texcoords;
+		/// @brief Three corners per triangle.
+		std::vector<ObjIndex> indices;
+	};
+
+	/// @brief Parses OBJ geometry on the engine job system. The text is split into chunks on line boundaries, every chunk is parsed
+	/// into its own attribute arrays, and the chunks are then copied into place at offsets from a prefix sum of their sizes.
+	/// Triangulation matches tinyobjloader for triangles and quads, larger polygons are triangulated as fans.
+	class ObjParser {
+	public:
+		static constexpr std::size_t default_chunk_size = 1 << 20;
+
+		/// @param text the contents of an OBJ file, e.g. a memory mapped view of it
+		/// @param chunk_size the least number of bytes parsed by one job
+		/// @return nothing if a line could not be parsed or a face references an attribute that does not exist
+		static std::optional<ObjModel> parse(std::string_view text, std::size_t chunk_size = default_chunk_size);
+
+		/// @brief Maps the file through the FileSystem and parses it in place.
+		static std::optional<ObjModel> read(const std::filesystem::path& path);
+	};
+
+} // namespace Alabaster
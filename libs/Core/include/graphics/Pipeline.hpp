@@ -4,6 +4,7 @@
 #include "graphics/Shader.hpp"
 #include "graphics/VertexBufferLayout.hpp"
 
+#include <cstdint>
 #include <initializer_list>
 #include <memory>
 #include <optional>
@@ -13,7 +14,6 @@
 using VkPipelineLayout = struct VkPipelineLayout_T*;
 using VkPipeline = struct VkPipeline_T*;
 using VkRenderPass = struct VkRenderPass_T*;
-using VkPipelineCache = struct VkPipelineCache_T*;
 using VkDescriptorSetLayout = struct VkDescriptorSetLayout_T*;
 
 namespace Alabaster {
@@ -49,6 +49,16 @@ namespace Alabaster {
 		float line_width { 1.0f };
 	};
 
+	/// @brief Hash of everything that ends up in the VkPipeline, the debug name is left out.
+	std::uint64_t hash_specification(const PipelineSpecification& spec);
+
+	struct PipelineStatistics {
+		std::uint32_t created { 0 };
+		std::uint32_t reused { 0 };
+		double last_build_milliseconds { 0.0 };
+		double total_build_milliseconds { 0.0 };
+	};
+
 	class Pipeline {
 	public:
 		~Pipeline();
@@ -58,24 +68,31 @@ namespace Alabaster {
 		PipelineSpecification& get_specification();
 		const PipelineSpecification& get_specification() const;
 
+		/// @brief Whether the rasteriser discards back faces, culling them on the CPU is only invisible when it does.
+		bool culls_back_faces() const;
+
 		VkPipelineLayout get_vulkan_pipeline_layout() const;
 		VkPipeline get_vulkan_pipeline() const;
 
 		bool operator!=(const Pipeline& other) const;
 		bool operator()(const Pipeline* other) const;
 
-		inline static std::shared_ptr<Pipeline> create(PipelineSpecification spec)
-		{
-			auto pipeline = std::shared_ptr<Pipeline>(new Pipeline { spec });
-			pipeline->invalidate();
-			return pipeline;
-		}
+		/// @brief Returns the live pipeline built from an identical specification if there is one.
+		static std::shared_ptr<Pipeline> create(PipelineSpecification spec);
+
+		/// @brief Creates the pipelines of a batch on the job system, each specification is only built once.
+		/// @return the pipelines in the order of the specifications
+		static std::vector<std::shared_ptr<Pipeline>> create(std::vector<PipelineSpecification> specs);
+
+		static PipelineStatistics statistics();
 
 	private:
+		void build();
+
 		PipelineSpecification spec;
+		std::uint64_t key { 0 };
 		VkPipelineLayout pipeline_layout {};
 		VkPipeline pipeline {};
-		VkPipelineCache pipeline_cache = nullptr;
 		std::vector<VkDescriptorSetLayout> descriptor_set_layouts;
 
 		explicit Pipeline(PipelineSpecification pipe_spec)
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <filesystem>
+
+using VkPipelineCache = struct VkPipelineCache_T*;
+
+namespace Alabaster {
+
+	/// @brief The VkPipelineCache every pipeline is created with. It is read from the cache directory on first use and
+	/// written back on destroy. A file written by another driver or device is ignored, its header carries the device UUID.
+	class PipelineCache {
+	public:
+		static PipelineCache& the();
+
+		VkPipelineCache get() const { return cache; }
+
+		/// @brief Writes the cache to disk and destroys it.
+		void destroy();
+
+	private:
+		PipelineCache();
+
+		std::filesystem::path path;
+		VkPipelineCache cache { nullptr };
+	};
+
+} // namespace Alabaster
@@ -2,6 +2,8 @@
 
 #include "graphics/RenderQueue.hpp"
 
+#include <functional>
+
 using VkPipeline = struct VkPipeline_T*;
 using VkRenderPass = struct VkRenderPass_T*;
 using VkPipelineLayout = struct VkPipelineLayout_T*;
@@ -30,6 +32,13 @@ namespace Alabaster {
 
 		static RenderQueue& resource_release_queue(std::uint32_t index);
 
+		/// @brief Defers freeing a GPU resource until every frame that may still reference it has finished executing.
+		/// @param func frees the resource, typically by dropping the last reference to it
+		static void submit_resource_free(std::function<void()>&& func);
+
+		/// @brief Runs the deferred frees queued while the frame was current. Call once its fence has been waited on.
+		static void release_resources(std::uint32_t frame);
+
 	private:
 		static RenderQueue& render_queue();
 	};
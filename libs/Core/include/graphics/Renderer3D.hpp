@@ -11,6 +11,11 @@
 #include <vector>
 
 using VkRenderPass = struct VkRenderPass_T*;
+using VkDescriptorSetLayout = struct VkDescriptorSetLayout_T*;
+
+namespace AssetManager {
+	struct ShaderReload;
+} // namespace AssetManager
 
 namespace Alabaster {
 
@@ -47,6 +52,8 @@ namespace Alabaster {
 		void mesh(const std::shared_ptr<Mesh>& mesh, const glm::mat4& transform, const std::shared_ptr<Pipeline>& pipeline = nullptr,
 			const glm::vec4& colour = { 1, 1, 1, 1 });
 		void mesh(const std::shared_ptr<Mesh>& mesh, const glm::mat4& transform, const glm::vec4& colour = { 1, 1, 1, 1 });
+		/// @param pipeline nullptr for the default mesh pipeline
+		void mesh(const Mesh& mesh, const glm::mat4& transform, Pipeline* pipeline, const glm::vec4& colour);
 
 		void line(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color);
 		void line(float size, const glm::vec3& from, const glm::vec3& to, const glm::vec4& color);
@@ -65,8 +72,13 @@ namespace Alabaster {
 		void reset_stats();
 
 		void set_camera(const Camera& cam);
+		/// @brief Levels of detail are picked by how many pixels their error covers, zero draws every mesh at full detail.
+		/// @param pixels_per_unit how many pixels one unit covers at a distance of one unit from the camera
+		void set_lod_scale(float pixels_per_unit);
 
 		const VkRenderPass& get_render_pass() const;
+		/// @brief Layout of the set the renderer binds for every pipeline it draws with, pipelines submitted to it have to use it.
+		VkDescriptorSetLayout get_descriptor_set_layout() const;
 
 	private:
 		void draw_quads(const CommandBuffer& command_buffer);
@@ -78,12 +90,15 @@ namespace Alabaster {
 		void create_descriptor_set_layout();
 		void create_descriptor_pool();
 		void create_descriptor_sets();
+		void write_descriptor_set(std::uint32_t frame);
 
-		void invalidate_pipelines();
+		void rebuild_pipelines(const AssetManager::ShaderReload& reload);
 
 		Camera* camera;
 		RendererData* data;
 		bool scene_has_begun { false };
+		std::uint32_t shader_reload_listener { 0 };
+		std::uint32_t texture_stream_listener { 0 };
 	};
 
 } // namespace Alabaster
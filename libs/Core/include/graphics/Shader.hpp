@@ -1,5 +1,7 @@
 #pragma once
 
+#include "graphics/ShaderReflection.hpp"
+
 #include <array>
 #include <filesystem>
 #include <memory>
@@ -19,7 +21,9 @@ namespace Alabaster {
 		///     or <path_and_filename>-vert.spv and <path_and_filename>-frag.spv
 		/// @param path_and_filename
 		explicit Shader(std::tuple<std::string_view, std::string_view> vertex_fragment_paths);
-		Shader(const std::string& path_or_name, std::vector<std::uint32_t> vertex_shader_spirv, std::vector<std::uint32_t> fragment_shader_spirv);
+		/// @param reflection interface of both stages, the descriptor set layouts are generated from it
+		Shader(const std::string& path_or_name, std::vector<std::uint32_t> vertex_shader_spirv, std::vector<std::uint32_t> fragment_shader_spirv,
+			ShaderReflection reflection = {});
 
 		template <typename Str = std::string_view>
 		Shader(Str&& vertex, Str&& fragment)
@@ -37,6 +41,8 @@ namespace Alabaster {
 
 		void destroy();
 		const auto& get_path() const { return shader_path; }
+		const ShaderReflection& get_reflection() const { return reflection; }
+		/// @brief Layouts of the reflected sets, owned by the DescriptorLayoutCache. Empty for shaders loaded without reflection.
 		const std::vector<VkDescriptorSetLayout>& descriptor_set_layouts() const;
 
 	private:
@@ -46,6 +52,7 @@ namespace Alabaster {
 		std::unique_ptr<VkPipelineShaderStageCreateInfo> vertex_stage;
 		std::unique_ptr<VkPipelineShaderStageCreateInfo> fragment_stage;
 		std::filesystem::path shader_path;
+		ShaderReflection reflection;
 		std::vector<VkDescriptorSetLayout> layouts;
 	};
 
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+using VkFlags = uint32_t;
+using VkShaderStageFlags = VkFlags;
+
+namespace Alabaster {
+
+	/// @brief Mirrors VkDescriptorType for the descriptor kinds shaders declare.
+	enum class DescriptorType : std::uint32_t {
+		Sampler = 0,
+		CombinedImageSampler = 1,
+		SampledImage = 2,
+		StorageImage = 3,
+		UniformBuffer = 6,
+		StorageBuffer = 7,
+	};
+
+	struct DescriptorBinding {
+		std::uint32_t set { 0 };
+		std::uint32_t binding { 0 };
+		DescriptorType type { DescriptorType::UniformBuffer };
+		std::uint32_t count { 1 };
+		VkShaderStageFlags stages { 0 };
+
+		bool operator==(const DescriptorBinding&) const = default;
+	};
+
+	struct PushConstantBlock {
+		std::uint32_t offset { 0 };
+		std::uint32_t size { 0 };
+		VkShaderStageFlags stages { 0 };
+
+		bool operator==(const PushConstantBlock&) const = default;
+	};
+
+	/// @brief Resource interface of a shader, reflected from its SPIR-V when it is compiled and cached next to it.
+	struct ShaderReflection {
+		/// @brief Sorted by set, then binding.
+		std::vector<DescriptorBinding> bindings;
+		std::vector<PushConstantBlock> push_constants;
+
+		/// @brief Adds the interface of another stage or shader. A binding both declare is visible to the stages of both.
+		void merge(const ShaderReflection& other);
+
+		/// @return one more than the highest set any binding is in
+		std::uint32_t set_count() const;
+
+		/// @return the bindings of one descriptor set, sorted by binding
+		std::span<const DescriptorBinding> set(std::uint32_t index) const;
+
+		bool operator==(const ShaderReflection&) const = default;
+	};
+
+	/// @brief Hash of a set's bindings, equal for sets that can share a VkDescriptorSetLayout.
+	std::uint64_t hash_bindings(std::span<const DescriptorBinding> bindings);
+
+} // namespace Alabaster
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+using VkDeviceSize = std::uint64_t;
+using VmaAllocation = struct VmaAllocation_T*;
+using VkBuffer = struct VkBuffer_T*;
+
+namespace Alabaster {
+
+	/// @brief Host visible upload buffer that stays mapped for its whole lifetime.
+	/// Regions are handed out front to back, and the ring wraps around once the submission that consumed them has completed.
+	/// Writing into distinct regions from several threads is safe, handing the regions out is not.
+	class StagingRing {
+	public:
+		struct Region {
+			VkBuffer buffer { nullptr };
+			VkDeviceSize offset { 0 };
+			VkDeviceSize size { 0 };
+			std::byte* data { nullptr };
+		};
+
+		~StagingRing();
+
+		/// @brief Reserve a region. Fails instead of overwriting regions handed out since the last reset.
+		/// @param region_size size in bytes
+		/// @param alignment alignment of the offset, 16 covers texel block sizes and optimalBufferCopyOffsetAlignment in practice
+		/// @return the region, or nullopt if the ring is full
+		std::optional<Region> allocate(VkDeviceSize region_size, VkDeviceSize alignment = default_alignment);
+
+		/// @brief Make host writes to the handed out regions visible to the device. A no-op on host coherent memory.
+		void flush() const;
+
+		/// @brief Wrap around to the start. Call once the GPU has consumed every region handed out.
+		void reset() { head = 0; }
+
+		VkDeviceSize capacity() const { return size; }
+		VkDeviceSize used() const { return head; }
+		VkBuffer get_buffer() const { return buffer; }
+
+		static std::unique_ptr<StagingRing> create(VkDeviceSize capacity) { return std::unique_ptr<StagingRing>(new StagingRing { capacity }); }
+
+		static constexpr VkDeviceSize default_alignment = 16;
+
+	private:
+		explicit StagingRing(VkDeviceSize capacity);
+
+		VmaAllocation allocation { nullptr };
+		VkBuffer buffer { nullptr };
+		std::byte* mapped { nullptr };
+		VkDeviceSize size { 0 };
+		VkDeviceSize head { 0 };
+	};
+
+} // namespace Alabaster
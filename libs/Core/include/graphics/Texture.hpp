@@ -9,12 +9,43 @@
 #include "graphics/Image.hpp"
 
 #include <filesystem>
+#include <span>
 #include <string>
 
+using VkBuffer = struct VkBuffer_T*;
+using VkCommandBuffer = struct VkCommandBuffer_T*;
+using VkDeviceSize = std::uint64_t;
+
 namespace Alabaster {
 
 	class Texture {
 	public:
+		/// @brief CPU side result of decoding an image file. Producing one never touches the GPU.
+		struct DecodedImage {
+			Buffer pixels;
+			std::uint32_t width { 0 };
+			std::uint32_t height { 0 };
+			ImageFormat format { ImageFormat::None };
+
+			explicit operator bool() const { return pixels.data != nullptr; }
+
+			/// @brief Frees the pixels of an image that is not going to be handed to a Texture.
+			void release();
+		};
+
+		/// @brief Dimensions and format of an image file as read from its header, enough to reserve staging memory before decoding.
+		struct ImageHeader {
+			std::uint32_t width { 0 };
+			std::uint32_t height { 0 };
+			ImageFormat format { ImageFormat::None };
+			/// @brief Mip levels already present in the staged data, zero lets the texture generate its own chain from mip 0.
+			std::uint32_t mips { 0 };
+
+			/// @brief Size of the decoded pixels in bytes.
+			std::size_t size() const;
+			explicit operator bool() const { return width > 0 && height > 0; }
+		};
+
 		~Texture();
 		void resize(const glm::uvec2& size);
 		void resize(std::uint32_t width, uint32_t height);
@@ -37,10 +68,40 @@ namespace Alabaster {
 
 		void generate_mips();
 
+		/// @brief Records the upload of pixels already written to a staging buffer: the copy into mip 0, mip generation and the
+		/// transition for sampling. Lets loaders put many textures into one command buffer and one submission.
+		/// @param command_buffer recording command buffer
+		/// @param staging_buffer buffer holding the pixels in the layout produced by Texture::decode_into
+		/// @param offset offset of the pixels in the staging buffer
+		void record_upload(VkCommandBuffer command_buffer, VkBuffer staging_buffer, VkDeviceSize offset) const;
+
+		/// @brief Records the upload of a prebuilt mip chain, as produced by the offline texture compiler. Block compressed images cannot be
+		/// blitted, so they must provide every level of the chain they were created with.
+		/// @param mip_offsets offset of every provided mip, relative to offset
+		void record_upload(
+			VkCommandBuffer command_buffer, VkBuffer staging_buffer, VkDeviceSize offset, std::span<const VkDeviceSize> mip_offsets) const;
+
+		/// @brief Takes over the image of a fully uploaded texture. The handle keeps its identity, so everyone holding it samples the new
+		/// image from now on. Descriptor sets that were written with the placeholder image have to be rewritten by their owners.
+		/// @param loaded texture whose upload has completed, it is left holding the placeholder
+		void make_resident(Texture& loaded);
+
+		/// @brief Gives the image up and samples the placeholder's again, the opposite of make_resident. The texture can be made resident
+		/// again later, through make_resident.
+		/// @param placeholder resident texture to sample from now on
+		/// @return the image, which frames in flight may still sample, so the caller decides when it is released
+		std::shared_ptr<Image> evict(const Texture& placeholder);
+
+		/// @brief False while the handle is still sampling the placeholder it was streamed with.
+		bool is_resident() const { return owns_image; }
+		/// @brief Device memory held by the image, zero while sampling a placeholder.
+		VkDeviceSize get_memory_size() const;
+		const TextureProperties& get_properties() const { return properties; }
+
 		uint64_t get_hash() const;
 
 	private:
-		/// @brief Loads the image data from disk, sets up width, height and format.
+		/// @brief Loads the image data through FileSystem::read, sets up width, height and format.
 		/// @param path path of the texture
 		/// @return false if could not load the data
 		bool load_image(const std::string& path);
@@ -50,6 +111,9 @@ namespace Alabaster {
 		/// @return false if could not load the data
 		bool load_image(const void* data, std::uint32_t size);
 
+		void create_image_resources();
+		void record_mips(VkCommandBuffer command_buffer) const;
+
 		std::filesystem::path path;
 		std::uint32_t width;
 		std::uint32_t height;
@@ -58,25 +122,31 @@ namespace Alabaster {
 		Buffer image_data;
 
 		std::shared_ptr<Image> image;
+		bool owns_image { true };
+		std::uint32_t provided_mips { 0 };
 
 		ImageFormat format = ImageFormat::None;
 
 		Texture(const std::filesystem::path& path, TextureProperties properties);
+		Texture(const std::filesystem::path& path, DecodedImage&& decoded, TextureProperties properties);
+		Texture(const std::filesystem::path& path, const ImageHeader& header, TextureProperties properties);
+		Texture(const std::filesystem::path& path, const Texture& placeholder, TextureProperties properties);
 		Texture(ImageFormat format, std::uint32_t width, uint32_t height, const void* data, TextureProperties properties);
 		explicit Texture(const void* data, std::size_t size);
 
 	public:
 		/// @brief Creates a Texture from a texture filename. This assumes that the filename is found in %root%/textures/{filename}.
+		/// The image is streamed in the background, see Texture::from_filename(const std::filesystem::path&, const TextureProperties&).
 		/// @tparam T std::string or std::filesystem::path
 		/// @param filename name and extension (image.jpg, image.png etc)
-		/// @return constructed and available Texture
+		/// @return handle to the Texture, available immediately
 		template <typename T> static std::shared_ptr<Texture> from_filename(const T& filename)
 		{
 			static_assert(std::is_same_v<T, std::string> || std::is_same_v<T, std::filesystem::path>);
 			if constexpr (std::is_same_v<T, std::filesystem::path>)
-				return std::shared_ptr<Texture>(new Texture { FileSystem::texture(filename), TextureProperties(filename.string()) });
+				return from_filename(filename, TextureProperties(filename.string()));
 			else
-				return std::shared_ptr<Texture>(new Texture { FileSystem::texture(filename), TextureProperties(filename) });
+				return from_filename(std::filesystem::path { filename }, TextureProperties(filename));
 		}
 
 		/// @brief Creates a Texture from full path like %root%/editor/some_icon.png
@@ -92,8 +162,60 @@ namespace Alabaster {
 				return std::shared_ptr<Texture>(new Texture { filename, TextureProperties(filename) });
 		}
 
+		/// @brief Returns a handle right away. It samples a placeholder until the ResourceCache has decoded and uploaded the image in the
+		/// background and made it resident at a frame boundary.
+		/// @param filename name and extension, resolved against %root%/textures/, or a full path
+		/// @param props texture properties
+		/// @return handle to the Texture, shared with every other request for the same filename
 		static std::shared_ptr<Texture> from_filename(const std::filesystem::path& filename, const TextureProperties& props);
 
+		/// @brief Creates a handle that samples the placeholder's image until Texture::make_resident is called on it.
+		/// @param full_path full path of the image that is being streamed
+		/// @param placeholder resident texture to sample in the meantime, it must outlive the handle's use of its image
+		/// @param props texture properties the streamed image is created with
+		/// @return handle that is not yet resident
+		static std::shared_ptr<Texture> streamed(
+			const std::filesystem::path& full_path, const std::shared_ptr<Texture>& placeholder, const TextureProperties& props);
+
+		/// @brief Decodes an image from disk into RGBA8 (or RGBA32F for HDR images). Thread safe, so loaders can decode in parallel
+		/// and hand the result to from_decoded on the thread that owns the graphics queue.
+		/// @param full_path full path like <root>/textures/image.png
+		/// @return the decoded image, which evaluates to false if the image could not be decoded
+		static DecodedImage decode(const std::filesystem::path& full_path);
+
+		/// @brief Decodes an encoded image (png, jpg, hdr, ...) that is already in memory, for example a view from FileSystem::read.
+		/// @param encoded contents of the image file
+		/// @return the decoded image, which evaluates to false if the image could not be decoded
+		static DecodedImage decode(std::span<const std::uint8_t> encoded);
+
+		/// @brief Creates a Texture from an image decoded by Texture::decode. Takes ownership of the decoded pixels.
+		/// @param full_path full path the image was decoded from
+		/// @param decoded result of Texture::decode
+		/// @param props texture properties
+		/// @return constructed and available Texture
+		static std::shared_ptr<Texture> from_decoded(const std::filesystem::path& full_path, DecodedImage&& decoded, const TextureProperties& props);
+
+		/// @brief Reads the dimensions and format of an image without decoding it. Thread safe.
+		/// @param full_path full path like <root>/textures/image.png
+		/// @return the header, which evaluates to false if the file is not a supported image
+		static ImageHeader probe(const std::filesystem::path& full_path);
+
+		/// @brief Decodes an image straight into caller provided memory, typically a region of a mapped staging buffer. Thread safe.
+		/// @param full_path full path the header was probed from
+		/// @param header result of Texture::probe
+		/// @param destination at least header.size() writable bytes
+		/// @return false if the image could not be decoded or no longer matches the header
+		static bool decode_into(const std::filesystem::path& full_path, const ImageHeader& header, void* destination);
+
+		/// @brief Creates the image, view and sampler for a texture whose pixels are uploaded later through record_upload.
+		/// The image contents are undefined until that upload has executed.
+		/// @param full_path full path the header was probed from
+		/// @param header result of Texture::probe
+		/// @param props texture properties
+		/// @return constructed Texture
+		static std::shared_ptr<Texture> from_staged(
+			const std::filesystem::path& full_path, const ImageHeader& header, const TextureProperties& props);
+
 		template <std::size_t Size> static std::shared_ptr<Texture> from_data(const void* data)
 		{
 			return std::shared_ptr<Texture>(new Texture { data, Size });
@@ -7,6 +7,8 @@
 #include "core/Buffer.hpp"
 #include "graphics/Vertex.hpp"
 
+#include <span>
+
 using VkBuffer = struct VkBuffer_T*;
 using VmaAllocation = struct VmaAllocation_T*;
 
@@ -34,6 +36,17 @@ namespace Alabaster {
 			return std::shared_ptr<VertexBuffer>(new VertexBuffer { vertices.data(), vertices.size() * sizeof(Vertex) });
 		}
 
+		inline static std::shared_ptr<VertexBuffer> create(std::span<const Vertex> vertices)
+		{
+			return std::shared_ptr<VertexBuffer>(new VertexBuffer { vertices.data(), vertices.size_bytes() });
+		}
+
+		/// @brief Uploads vertices already packed into another layout, see VertexPacker.
+		inline static std::shared_ptr<VertexBuffer> create(std::span<const std::uint8_t> packed)
+		{
+			return std::shared_ptr<VertexBuffer>(new VertexBuffer { packed.data(), packed.size_bytes() });
+		}
+
 		inline static std::shared_ptr<VertexBuffer> create(std::size_t size)
 		{
 			return std::shared_ptr<VertexBuffer>(new VertexBuffer { static_cast<std::uint32_t>(size) });
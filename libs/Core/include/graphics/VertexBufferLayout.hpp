@@ -7,7 +7,9 @@
 
 namespace Alabaster {
 
-	enum class ShaderDataType { None = 0, Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, Bool };
+	/// @brief Half2, Short4, UShort4 and UByte4 are packed attributes. Elements marked normalised are read as floats in [0, 1], or in
+	/// [-1, 1] for the signed Short4.
+	enum class ShaderDataType { None = 0, Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, Bool, Half2, Short4, UShort4, UByte4 };
 
 	static std::uint32_t shader_data_type_size(ShaderDataType type)
 	{
@@ -36,6 +38,14 @@ namespace Alabaster {
 			return 4 * 4;
 		case Bool:
 			return 1;
+		case Half2:
+			return 2 * 2;
+		case Short4:
+			return 2 * 4;
+		case UShort4:
+			return 2 * 4;
+		case UByte4:
+			return 4;
 		default: {
 			Log::error("Unknown ShaderDataType!");
 			stop();
@@ -89,6 +99,14 @@ namespace Alabaster {
 				return 4;
 			case Bool:
 				return 1;
+			case Half2:
+				return 2;
+			case Short4:
+				return 4;
+			case UShort4:
+				return 4;
+			case UByte4:
+				return 4;
 			default: {
 				Log::error("Never reach here in VertexBuffer.");
 				stop();
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "graphics/MeshFile.hpp"
+#include "graphics/Vertex.hpp"
+#include "graphics/VertexBufferLayout.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Alabaster {
+
+	enum class VertexEncoding : std::uint8_t {
+		/// @brief Vertex as it is, 72 bytes of floats.
+		Full,
+		/// @brief Float positions, the normal and tangent octahedral encoded into four 16-bit snorms with the bitangent sign in the
+		/// lowest bit of the last one, and half float texture coordinates.
+		Compact,
+		/// @brief Compact with the positions quantised to 16-bit unorms against the bounds of the mesh.
+		Quantised,
+	};
+
+	/// @brief What a vertex buffer holds per vertex, which decides its VertexBufferLayout and the shader variant that reads it.
+	struct VertexFormat {
+		VertexEncoding encoding { VertexEncoding::Full };
+		/// @brief Compact encodings drop the colour when every vertex has the same one.
+		bool colour { true };
+
+		VertexBufferLayout layout() const;
+		std::uint32_t stride() const { return layout().get_stride(); }
+
+		/// @return the keywords of the shader variant reading this layout, none for the full vertex
+		std::vector<std::string> keywords() const;
+
+		bool operator==(const VertexFormat&) const = default;
+	};
+
+	struct PackedVertices {
+		VertexFormat format;
+		std::vector<std::uint8_t> data;
+		/// @brief Quantised positions are position_origin + position / 65535 * position_scale in model space. The scale is the same
+		/// on every axis so the dequantisation can be folded into the object transform without skewing normals.
+		glm::vec3 position_origin { 0.0f };
+		float position_scale { 1.0f };
+		/// @brief The colour of every vertex, if the format dropped it.
+		glm::vec4 constant_colour { 1.0f, 1.0f, 1.0f, 1.0f };
+
+		std::size_t vertex_count() const { return data.size() / format.stride(); }
+	};
+
+	class VertexPacker {
+	public:
+		/// @param bounds of the vertices, used to quantise positions
+		static PackedVertices pack(std::span<const Vertex> vertices, const MeshBounds& bounds, VertexEncoding encoding);
+
+		/// @brief Decodes a packed vertex, the bitangent is rebuilt from the normal, tangent and sign.
+		static Vertex unpack(const PackedVertices& packed, std::size_t index);
+
+		/// @brief Maps a direction onto the octahedron, unfolded into [-1, 1]^2. The zero vector maps to the origin.
+		static glm::vec2 encode_octahedral(const glm::vec3& direction);
+		static glm::vec3 decode_octahedral(const glm::vec2& encoded);
+	};
+
+} // namespace Alabaster
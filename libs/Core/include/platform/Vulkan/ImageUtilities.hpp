@@ -24,6 +24,7 @@ namespace Alabaster::Utilities {
 
 	bool is_integer_based(ImageFormat format);
 
+	/// @return bytes per texel, or bytes per 4x4 block for block compressed formats
 	uint32_t get_image_format_bpp(ImageFormat format);
 
 	bool is_integer_based(const ImageFormat format);
@@ -32,6 +33,9 @@ namespace Alabaster::Utilities {
 
 	uint32_t get_image_memory_size(ImageFormat format, uint32_t width, uint32_t height);
 
+	/// @brief BCn formats store 4x4 texel blocks, cannot be blitted and round partial blocks at the edges up.
+	bool is_block_compressed(ImageFormat format);
+
 	bool is_depth_format(ImageFormat format);
 
 	VkFormat vulkan_image_format(ImageFormat in);
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fmt/format.h>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace Alabaster::Hash {
+
+	static constexpr std::uint64_t default_seed = 0x9E3779B97F4A7C15ull;
+
+	/// @brief MurmurHash64A over a byte range. Stable across platforms with the same endianness, so it is
+	/// safe to persist as a content hash for on-disk caches.
+	/// @param data start of the range
+	/// @param size size of the range in bytes
+	/// @param seed seed, defaults to default_seed
+	/// @return 64 bit hash
+	inline std::uint64_t hash_bytes(const void* data, std::size_t size, std::uint64_t seed = default_seed)
+	{
+		static constexpr std::uint64_t multiplier = 0xC6A4A7935BD1E995ull;
+		static constexpr int shift = 47;
+
+		const auto* bytes = static_cast<const unsigned char*>(data);
+		std::uint64_t hash = seed ^ (size * multiplier);
+
+		const auto blocks = size / sizeof(std::uint64_t);
+		for (std::size_t i = 0; i < blocks; i++) {
+			std::uint64_t block;
+			std::memcpy(&block, bytes + i * sizeof(std::uint64_t), sizeof(std::uint64_t));
+
+			block *= multiplier;
+			block ^= block >> shift;
+			block *= multiplier;
+
+			hash ^= block;
+			hash *= multiplier;
+		}
+
+		const auto* tail = bytes + blocks * sizeof(std::uint64_t);
+		switch (size & 7) {
+		case 7:
+			hash ^= static_cast<std::uint64_t>(tail[6]) << 48;
+			[[fallthrough]];
+		case 6:
+			hash ^= static_cast<std::uint64_t>(tail[5]) << 40;
+			[[fallthrough]];
+		case 5:
+			hash ^= static_cast<std::uint64_t>(tail[4]) << 32;
+			[[fallthrough]];
+		case 4:
+			hash ^= static_cast<std::uint64_t>(tail[3]) << 24;
+			[[fallthrough]];
+		case 3:
+			hash ^= static_cast<std::uint64_t>(tail[2]) << 16;
+			[[fallthrough]];
+		case 2:
+			hash ^= static_cast<std::uint64_t>(tail[1]) << 8;
+			[[fallthrough]];
+		case 1:
+			hash ^= static_cast<std::uint64_t>(tail[0]);
+			hash *= multiplier;
+			break;
+		default:
+			break;
+		}
+
+		hash ^= hash >> shift;
+		hash *= multiplier;
+		hash ^= hash >> shift;
+		return hash;
+	}
+
+	inline std::uint64_t hash_string(std::string_view view, std::uint64_t seed = default_seed) { return hash_bytes(view.data(), view.size(), seed); }
+
+	template <typename T> inline std::uint64_t hash_span(std::span<const T> span, std::uint64_t seed = default_seed)
+	{
+		return hash_bytes(span.data(), span.size_bytes(), seed);
+	}
+
+	/// @brief Order dependent combination of two hashes.
+	constexpr std::uint64_t combine(std::uint64_t seed, std::uint64_t value)
+	{
+		seed ^= value + 0x9E3779B97F4A7C15ull + (seed << 12) + (seed >> 4);
+		return seed;
+	}
+
+	/// @brief MurmurHash3 finaliser. Spreads every bit of an integer key into the low bits, which open addressing tables index with.
+	constexpr std::uint64_t mix(std::uint64_t value)
+	{
+		value ^= value >> 33;
+		value *= 0xFF51AFD7ED558CCDull;
+		value ^= value >> 33;
+		value *= 0xC4CEB9FE1A85EC53ull;
+		value ^= value >> 33;
+		return value;
+	}
+
+	inline std::string to_hex(std::uint64_t hash) { return fmt::format("{:016x}", hash); }
+
+} // namespace Alabaster::Hash
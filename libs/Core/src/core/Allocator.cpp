@@ -130,4 +130,22 @@ namespace Alabaster {
 
 	VmaAllocator& Allocator::get_vma_allocator() { return vma_data().allocator; }
 
+	Allocator::MemoryBudget Allocator::device_local_budget()
+	{
+		const VkPhysicalDeviceMemoryProperties* memory_properties = nullptr;
+		vmaGetMemoryProperties(vma_data().allocator, &memory_properties);
+
+		std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets {};
+		vmaGetHeapBudgets(vma_data().allocator, budgets.data());
+
+		MemoryBudget device_local;
+		for (std::uint32_t heap = 0; heap < memory_properties->memoryHeapCount; heap++) {
+			if (memory_properties->memoryHeaps[heap].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+				device_local.usage += budgets[heap].usage;
+				device_local.budget += budgets[heap].budget;
+			}
+		}
+		return device_local;
+	}
+
 } // namespace Alabaster
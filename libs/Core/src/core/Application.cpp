@@ -20,6 +20,9 @@ namespace Alabaster {
 
 	static Application* global_app;
 
+	// File notifications left over when the budget runs out wait for the next frame.
+	static constexpr std::chrono::microseconds file_watcher_budget { 2000 };
+
 	Application& Application::the() { return *global_app; }
 
 	Application::Application(const ApplicationArguments& args)
@@ -76,6 +79,8 @@ namespace Alabaster {
 
 		on_init();
 
+		AssetManager::ResourceCache::the().register_file_watcher(*file_watcher);
+
 		last_frametime_ms = Clock::get_ms();
 		while (!window->should_close() && is_running) {
 			double new_time = Clock::get_ms();
@@ -96,6 +101,11 @@ namespace Alabaster {
 			const auto updated_timer = layer_update.elapsed();
 			statistics.cpu_time = updated_timer;
 
+			file_watcher->dispatch(file_watcher_budget);
+			apply_shader_reloads();
+			AssetManager::ResourceCache::the().apply_texture_streams();
+			evict_textures();
+
 			swapchain().begin_frame();
 			Renderer::begin();
 			{
@@ -137,6 +147,22 @@ namespace Alabaster {
 		}
 	}
 
+	void Application::apply_shader_reloads()
+	{
+		for (auto&& reload : AssetManager::ResourceCache::the().apply_shader_reloads()) {
+			if (reload.previous) {
+				Renderer::submit_resource_free([previous = std::move(reload.previous)] { previous->destroy(); });
+			}
+		}
+	}
+
+	void Application::evict_textures()
+	{
+		for (auto&& image : AssetManager::ResourceCache::the().evict_textures()) {
+			Renderer::submit_resource_free([evicted = std::move(image)] { evicted->release(); });
+		}
+	}
+
 	void Application::render_layers()
 	{
 		for (const auto& [key, layer] : layers) {
@@ -0,0 +1,165 @@
+#include "av_pch.hpp"
+
+#include "graphics/FrustumCuller.hpp"
+
+#include "utilities/JobSystem.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <functional>
+
+#if defined(__SSE__) || defined(_M_X64)
+#define ALABASTER_FRUSTUM_CULLER_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace Alabaster {
+
+	static_assert(FrustumCuller::bounds_per_job % 4 == 0, "Jobs have to start on a vector boundary.");
+
+	WorldBounds WorldBounds::of(const MeshBounds& bounds, const glm::mat4& transform)
+	{
+		const auto half = 0.5f * (bounds.max - bounds.min);
+		const glm::vec3 x { transform[0] };
+		const glm::vec3 y { transform[1] };
+		const glm::vec3 z { transform[2] };
+		const auto scale = std::max({ glm::length(x), glm::length(y), glm::length(z) });
+
+		return {
+			.centre = glm::vec3 { transform * glm::vec4 { bounds.centre(), 1.0f } },
+			.extent = glm::abs(x) * half.x + glm::abs(y) * half.y + glm::abs(z) * half.z,
+			.radius = bounds.radius * scale,
+		};
+	}
+
+	Frustum Frustum::of(const glm::mat4& clip)
+	{
+		const auto rows = glm::transpose(clip);
+		Frustum frustum { { rows[3] + rows[0], rows[3] - rows[0], rows[3] + rows[1], rows[3] - rows[1], rows[2], rows[3] - rows[2] } };
+		for (auto& plane : frustum.planes) {
+			plane /= glm::length(glm::vec3 { plane });
+		}
+		return frustum;
+	}
+
+	bool Frustum::intersects(const glm::vec3& centre, float radius) const
+	{
+		return std::ranges::none_of(planes, [&](const glm::vec4& plane) { return glm::dot(glm::vec3 { plane }, centre) + plane.w < -radius; });
+	}
+
+	bool Frustum::intersects(const WorldBounds& bounds) const
+	{
+		return std::ranges::none_of(planes, [&bounds](const glm::vec4& plane) {
+			const glm::vec3 normal { plane };
+			const auto reach = std::min(glm::dot(glm::abs(normal), bounds.extent), bounds.radius);
+			return glm::dot(normal, bounds.centre) + plane.w < -reach;
+		});
+	}
+
+	void FrustumCuller::clear()
+	{
+		for (auto* lane : { &centre_x, &centre_y, &centre_z, &extent_x, &extent_y, &extent_z, &radius }) {
+			lane->clear();
+		}
+	}
+
+	void FrustumCuller::reserve(std::size_t count)
+	{
+		for (auto* lane : { &centre_x, &centre_y, &centre_z, &extent_x, &extent_y, &extent_z, &radius }) {
+			lane->reserve(count);
+		}
+	}
+
+	void FrustumCuller::add(const WorldBounds& bounds)
+	{
+		centre_x.push_back(bounds.centre.x);
+		centre_y.push_back(bounds.centre.y);
+		centre_z.push_back(bounds.centre.z);
+		extent_x.push_back(bounds.extent.x);
+		extent_y.push_back(bounds.extent.y);
+		extent_z.push_back(bounds.extent.z);
+		radius.push_back(bounds.radius);
+	}
+
+	/// @brief A plane split into the scalars every lane is tested against, with the absolute normal the box's reach is projected on.
+	struct PlaneLanes {
+		float x;
+		float y;
+		float z;
+		float w;
+		float abs_x;
+		float abs_y;
+		float abs_z;
+	};
+
+	std::size_t FrustumCuller::cull(const Frustum& frustum, std::vector<std::uint8_t>& visible) const
+	{
+		std::array<PlaneLanes, 6> planes {};
+		for (std::size_t i = 0; i < planes.size(); i++) {
+			const auto& plane = frustum.planes[i];
+			planes[i] = { plane.x, plane.y, plane.z, plane.w, std::abs(plane.x), std::abs(plane.y), std::abs(plane.z) };
+		}
+
+		const auto count = size();
+		visible.resize(count);
+
+		// Tests [first, last), the bounds past the last full vector are tested one at a time.
+		const auto cull_range = [this, &planes, &frustum, &visible](std::size_t first, std::size_t last) {
+			std::size_t visible_count { 0 };
+			auto i = first;
+#if defined(ALABASTER_FRUSTUM_CULLER_SSE)
+			const auto zero = _mm_setzero_ps();
+			for (; i + 4 <= last; i += 4) {
+				const auto x = _mm_loadu_ps(&centre_x[i]);
+				const auto y = _mm_loadu_ps(&centre_y[i]);
+				const auto z = _mm_loadu_ps(&centre_z[i]);
+				const auto extent_along_x = _mm_loadu_ps(&extent_x[i]);
+				const auto extent_along_y = _mm_loadu_ps(&extent_y[i]);
+				const auto extent_along_z = _mm_loadu_ps(&extent_z[i]);
+				const auto sphere = _mm_loadu_ps(&radius[i]);
+
+				auto inside = _mm_cmpeq_ps(zero, zero);
+				for (const auto& plane : planes) {
+					auto distance = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)), _mm_set1_ps(plane.w));
+					distance = _mm_add_ps(distance, _mm_mul_ps(y, _mm_set1_ps(plane.y)));
+					distance = _mm_add_ps(distance, _mm_mul_ps(z, _mm_set1_ps(plane.z)));
+					auto box = _mm_mul_ps(extent_along_x, _mm_set1_ps(plane.abs_x));
+					box = _mm_add_ps(box, _mm_mul_ps(extent_along_y, _mm_set1_ps(plane.abs_y)));
+					box = _mm_add_ps(box, _mm_mul_ps(extent_along_z, _mm_set1_ps(plane.abs_z)));
+					const auto reach = _mm_min_ps(box, sphere);
+					inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, reach), zero));
+				}
+
+				const auto mask = static_cast<unsigned>(_mm_movemask_ps(inside));
+				for (std::size_t lane = 0; lane < 4; lane++) {
+					visible[i + lane] = static_cast<std::uint8_t>((mask >> lane) & 1u);
+				}
+				visible_count += static_cast<std::size_t>(std::popcount(mask));
+			}
+#else
+			(void)planes;
+#endif
+			for (; i < last; i++) {
+				const WorldBounds bounds { { centre_x[i], centre_y[i], centre_z[i] }, { extent_x[i], extent_y[i], extent_z[i] }, radius[i] };
+				visible[i] = frustum.intersects(bounds) ? 1 : 0;
+				visible_count += visible[i];
+			}
+			return visible_count;
+		};
+
+		if (count < parallel_threshold) {
+			return cull_range(0, count);
+		}
+
+		const auto jobs = (count + bounds_per_job - 1) / bounds_per_job;
+		return AssetManager::JobSystem::the().parallel_reduce(
+			0, jobs, 1, std::size_t { 0 },
+			[&cull_range, count](std::size_t job) {
+				const auto first = job * bounds_per_job;
+				return cull_range(first, std::min(first + bounds_per_job, count));
+			},
+			std::plus<> {});
+	}
+
+} // namespace Alabaster
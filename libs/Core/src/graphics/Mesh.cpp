@@ -4,104 +4,84 @@
 
 #include "core/Clock.hpp"
 #include "core/Common.hpp"
+#include "core/Utilities.hpp"
 #include "filesystem/FileSystem.hpp"
 #include "graphics/IndexBuffer.hpp"
+#include "graphics/MeshFile.hpp"
 #include "graphics/Vertex.hpp"
 #include "graphics/VertexBuffer.hpp"
+#include "graphics/VertexPacker.hpp"
 #include "utilities/FileInputOutput.hpp"
 
-#define TINYOBJLOADER_USE_MAPBOX_EARCUT
-#include <tiny_obj_loader.h>
-
 namespace Alabaster {
 
-	auto handle_vertices(const auto& attrib, const auto& shapes)
-	{
-		std::unordered_map<Vertex, std::uint32_t> unique_vertices {};
-		std::vector<Vertex> vertices;
-		vertices.reserve(attrib.vertices.size());
-
-		// Decent metric
-		std::vector<Index> indices;
-		indices.reserve(shapes.size() * shapes[0].mesh.indices.size());
-
-		for (const auto& shape : shapes) {
-			for (const auto& index : shape.mesh.indices) {
-				Vertex vertex {};
-
-				vertex.position = { attrib.vertices[3 * index.vertex_index + 0], attrib.vertices[3 * index.vertex_index + 1],
-					attrib.vertices[3 * index.vertex_index + 2] };
-
-				const auto u = attrib.texcoords[2 * index.texcoord_index + 0];
-				const auto v = 1.0f - attrib.texcoords[2 * index.texcoord_index + 1];
-				vertex.uv = { u, v };
-
-				vertex.normal = { attrib.normals[3 * index.normal_index + 0], attrib.normals[3 * index.normal_index + 1],
-					attrib.normals[3 * index.normal_index + 2] };
-
-				vertex.colour = { 1.0f, 1.0f, 1.0f, 1.0f };
-
-				if (!unique_vertices.contains(vertex)) {
-					unique_vertices[vertex] = static_cast<std::uint32_t>(vertices.size());
-					vertices.push_back(vertex);
-				}
-
-				indices.push_back(unique_vertices[vertex]);
-			}
-		}
-
-		vertices.shrink_to_fit();
-		indices.shrink_to_fit();
-
-		return std::make_tuple(vertices, indices);
-	}
-
-	Mesh::Mesh(const std::filesystem::path& input_path)
+	Mesh::Mesh(const std::filesystem::path& input_path, VertexEncoding encoding)
 		: path(input_path)
 	{
 		const auto t0 = Clock::get_ms<float>();
 		verify(IO::exists(input_path), fmt::format("{} did not exist.", input_path.string()));
 		verify(IO::is_file(input_path), fmt::format("{} is not a file.", input_path.string()));
 
-		auto&& [vertices, indices] = load_model();
-
-		index_count = indices.size();
+		// The mapped vertices and indices are copied into the staging buffers as they are, there is nothing left to parse.
+		const auto cache_path = MeshFile::cache_path(input_path);
+		if (const auto cached = MeshFile::open(cache_path); cached && cached->is_current(input_path)) {
+			bounds = cached->bounds();
+			meshlets.assign(cached->meshlets().begin(), cached->meshlets().end());
+			lods.assign(cached->lods().begin(), cached->lods().end());
+			upload(cached->vertices(), cached->all_indices(), encoding);
+			Log::info("[Mesh] Model with name [{}] load took: {}ms (cached)", input_path.string(), Clock::get_ms<float>() - t0);
+			return;
+		}
 
-		vertex_buffer = VertexBuffer::create(std::move(vertices));
-		index_buffer = IndexBuffer::create(std::move(indices));
-		auto t1 = Clock::get_ms<float>() - t0;
+		const auto imported = MeshFile::import_obj(input_path);
+		if (!imported) {
+			throw AlabasterException("Could not import {}.", input_path.string());
+		}
+		if (!MeshFile::write(cache_path, *imported)) {
+			Log::warn("[Mesh] Could not write {}.", cache_path.string());
+		}
 
-		Log::info("[Mesh] Model with name [{}] load took: {}ms", input_path.string(), t1);
+		bounds = imported->bounds;
+		meshlets = imported->meshlets;
+		lods = imported->lods;
+		std::vector<Index> indices { imported->indices };
+		indices.insert(indices.end(), imported->lod_indices.begin(), imported->lod_indices.end());
+		upload(imported->vertices, indices, encoding);
+		Log::info("[Mesh] Model with name [{}] load took: {}ms", input_path.string(), Clock::get_ms<float>() - t0);
 	}
 
-	Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<Index>& indices)
+	Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<Index>& indices, VertexEncoding encoding)
+		: bounds(MeshBounds::of(vertices))
 	{
-		vertex_buffer = VertexBuffer::create(vertices);
-		index_buffer = IndexBuffer::create(indices);
+		upload(vertices, indices, encoding);
 	}
 
-	std::tuple<Mesh::Vertices, Mesh::Indices> Mesh::load_model()
+	void Mesh::upload(std::span<const Vertex> vertices, std::span<const Index> indices, VertexEncoding encoding)
 	{
-		tinyobj::ObjReaderConfig reader_config;
-		reader_config.mtl_search_path = FileSystem::textures().string();
-
-		tinyobj::ObjReader reader;
-
-		if (!reader.ParseFromFile(path.string(), reader_config)) {
-			if (!reader.Error().empty()) {
-
-				Log::error("{}", reader.Error());
-			}
+		index_count = lods.empty() ? indices.size() : lods.front().first_index;
+		lods.insert(lods.begin(), MeshLod { .first_index = 0, .index_count = static_cast<std::uint32_t>(index_count), .error = 0.0f });
+		index_buffer = IndexBuffer::create(indices, vertices.size());
+
+		if (encoding == VertexEncoding::Full) {
+			vertex_buffer = VertexBuffer::create(vertices);
+			memory_usage.vertex_bytes = vertices.size_bytes();
+		} else {
+			// Positions are quantised against the bounds, which are set before uploading.
+			const auto packed = VertexPacker::pack(vertices, bounds, encoding);
+			vertex_buffer = VertexBuffer::create(std::span<const std::uint8_t> { packed.data });
+			vertex_format = packed.format;
+			constant_colour = packed.constant_colour;
+			vertex_transform = glm::scale(glm::translate(glm::mat4 { 1.0f }, packed.position_origin), glm::vec3 { packed.position_scale });
+			memory_usage.vertex_bytes = packed.data.size();
 		}
 
-		if (!reader.Warning().empty()) {
-			Log::warn("{}", reader.Warning());
-		}
-
-		const auto& attrib = reader.GetAttrib();
-		const auto& shapes = reader.GetShapes();
-
-		return handle_vertices(attrib, shapes);
+		memory_usage.index_bytes = index_buffer->size();
+		memory_usage.full_vertex_bytes = vertices.size_bytes();
+		memory_usage.full_index_bytes = indices.size_bytes();
+		const auto name = path.empty() ? std::string { "Mesh from data" } : path.filename().string();
+		Log::info("[Mesh] {} takes {} of vertices and {} of indices, saving {}.", name,
+			Utilities::human_readable_size(memory_usage.vertex_bytes), Utilities::human_readable_size(memory_usage.index_bytes),
+			Utilities::human_readable_size(memory_usage.saved_bytes()));
 	}
 
 	Mesh::~Mesh() { }
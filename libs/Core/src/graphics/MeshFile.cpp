@@ -0,0 +1,455 @@
+#include "av_pch.hpp"
+
+#include "graphics/MeshFile.hpp"
+
+#include "core/Logger.hpp"
+#include "filesystem/FileSystem.hpp"
+#include "graphics/MeshOptimiser.hpp"
+#include "graphics/ObjParser.hpp"
+#include "utilities/Hash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <thread>
+
+namespace Alabaster {
+
+	static constexpr std::uint32_t mesh_magic = 0x48534D41; // "AMSH"
+	static constexpr std::uint32_t mesh_version = 6;
+
+	struct MeshHeader {
+		std::uint32_t magic;
+		std::uint32_t version;
+		std::uint32_t vertex_stride;
+		std::uint32_t index_stride;
+		std::uint64_t vertex_count;
+		std::uint64_t index_count;
+		std::uint64_t vertex_offset;
+		std::uint64_t index_offset;
+		float bounds_min[3];
+		float bounds_max[3];
+		std::uint64_t source_size;
+		std::int64_t source_last_write;
+		std::uint64_t source_hash;
+		std::uint64_t meshlet_count;
+		std::uint64_t meshlet_offset;
+		std::uint32_t meshlet_stride;
+		std::uint32_t lod_stride;
+		std::uint64_t lod_count;
+		std::uint64_t lod_offset;
+		float bounds_radius;
+		std::uint32_t reserved;
+	};
+
+	static_assert(sizeof(MeshHeader) == 144, "The mesh layout is persisted, its header must not change size.");
+
+	static std::uint64_t align_up(std::uint64_t value, std::uint64_t alignment) { return (value + alignment - 1) & ~(alignment - 1); }
+
+	MeshBounds MeshBounds::of(std::span<const Vertex> vertices)
+	{
+		if (vertices.empty()) {
+			return {};
+		}
+
+		MeshBounds bounds { .min = vertices.front().position, .max = vertices.front().position };
+		for (const auto& vertex : vertices) {
+			bounds.min = glm::min(bounds.min, vertex.position);
+			bounds.max = glm::max(bounds.max, vertex.position);
+		}
+
+		const auto centre = bounds.centre();
+		float radius_squared { 0.0f };
+		for (const auto& vertex : vertices) {
+			const auto offset = vertex.position - centre;
+			radius_squared = std::max(radius_squared, glm::dot(offset, offset));
+		}
+		bounds.radius = std::sqrt(radius_squared);
+		return bounds;
+	}
+
+	struct GridCell {
+		std::int64_t x;
+		std::int64_t y;
+		std::int64_t z;
+
+		bool operator==(const GridCell&) const = default;
+	};
+
+	/// @brief Corners naming the same position, normal and texture coordinate are the same vertex, so their indices are an exact
+	/// key where comparing the floating point contents is not.
+	static std::uint64_t hash_key(const ObjIndex& key)
+	{
+		const auto position_normal = Hash::combine(static_cast<std::uint32_t>(key.position), static_cast<std::uint32_t>(key.normal));
+		return Hash::mix(Hash::combine(position_normal, static_cast<std::uint32_t>(key.texcoord)));
+	}
+
+	static std::uint64_t hash_key(const GridCell& key)
+	{
+		const auto xy = Hash::combine(static_cast<std::uint64_t>(key.x), static_cast<std::uint64_t>(key.y));
+		return Hash::mix(Hash::combine(xy, static_cast<std::uint64_t>(key.z)));
+	}
+
+	/// @brief Open addressing map from a key to a 32 bit index, probing linearly through one flat allocation. It never grows, so it
+	/// is sized up front for the most keys it can be given.
+	template <typename Key> class FlatIndexMap {
+	public:
+		static constexpr std::uint32_t empty = std::numeric_limits<std::uint32_t>::max();
+
+		explicit FlatIndexMap(std::size_t max_size)
+			: slots(std::bit_ceil(std::max<std::size_t>(max_size + max_size / 4, 16)))
+			, mask(slots.size() - 1)
+		{
+		}
+
+		/// @return the index stored for the key, which is the given index if the key was not present before
+		std::uint32_t insert(const Key& key, std::uint32_t index)
+		{
+			for (auto slot = hash_key(key) & mask;; slot = (slot + 1) & mask) {
+				auto& entry = slots[slot];
+				if (entry.index == empty) {
+					entry = { key, index };
+					return index;
+				}
+				if (entry.key == key) {
+					return entry.index;
+				}
+			}
+		}
+
+		std::uint32_t* find(const Key& key)
+		{
+			for (auto slot = hash_key(key) & mask;; slot = (slot + 1) & mask) {
+				auto& entry = slots[slot];
+				if (entry.index == empty) {
+					return nullptr;
+				}
+				if (entry.key == key) {
+					return &entry.index;
+				}
+			}
+		}
+
+	private:
+		struct Slot {
+			Key key {};
+			std::uint32_t index { empty };
+		};
+
+		std::vector<Slot> slots;
+		std::size_t mask;
+	};
+
+	static Vertex make_vertex(const ObjModel& model, const ObjIndex& index)
+	{
+		Vertex vertex {};
+
+		vertex.position = { model.positions[3 * index.position + 0], model.positions[3 * index.position + 1],
+			model.positions[3 * index.position + 2] };
+
+		if (index.texcoord >= 0) {
+			const auto u = model.texcoords[2 * index.texcoord + 0];
+			const auto v = 1.0f - model.texcoords[2 * index.texcoord + 1];
+			vertex.uv = { u, v };
+		}
+
+		if (index.normal >= 0) {
+			vertex.normal = { model.normals[3 * index.normal + 0], model.normals[3 * index.normal + 1], model.normals[3 * index.normal + 2] };
+		}
+
+		vertex.colour = { 1.0f, 1.0f, 1.0f, 1.0f };
+		return vertex;
+	}
+
+	static std::tuple<std::vector<Vertex>, std::vector<Index>> handle_vertices(const ObjModel& model)
+	{
+		// Every corner could be a new vertex, so the table is sized for all of them and never rehashes.
+		FlatIndexMap<ObjIndex> unique_vertices { model.indices.size() };
+		std::vector<Vertex> vertices;
+		vertices.reserve(model.positions.size() / 3);
+
+		std::vector<Index> indices;
+		indices.reserve(model.indices.size());
+
+		for (const auto& index : model.indices) {
+			const auto next_vertex = static_cast<std::uint32_t>(vertices.size());
+			const auto vertex = unique_vertices.insert(index, next_vertex);
+			if (vertex == next_vertex) {
+				vertices.push_back(make_vertex(model, index));
+			}
+			indices.push_back(vertex);
+		}
+
+		vertices.shrink_to_fit();
+		return std::make_tuple(std::move(vertices), std::move(indices));
+	}
+
+	/// @brief Merges vertices within the tolerance of each other. Positions are bucketed in a grid of cells twice the tolerance wide,
+	/// so a vertex only has to be compared with those in its own cell and the neighbouring cells on the side it is closest to.
+	static void weld_vertices(MeshData& mesh, float tolerance)
+	{
+		static constexpr auto empty = FlatIndexMap<GridCell>::empty;
+
+		const auto near = [tolerance](const auto& a, const auto& b) { return glm::all(glm::epsilonEqual(a, b, tolerance)); };
+		const auto cell_size = 2.0f * tolerance;
+
+		FlatIndexMap<GridCell> cells { mesh.vertices.size() };
+		// Vertices sharing a cell are chained through next, the cell stores the most recently kept one.
+		std::vector<std::uint32_t> next;
+		std::vector<std::uint32_t> remap(mesh.vertices.size());
+		std::vector<Vertex> welded;
+		welded.reserve(mesh.vertices.size());
+
+		for (std::size_t i = 0; i < mesh.vertices.size(); i++) {
+			const auto& vertex = mesh.vertices[i];
+			const auto scaled = vertex.position / cell_size;
+			const auto floored = glm::floor(scaled);
+			const GridCell cell { static_cast<std::int64_t>(floored.x), static_cast<std::int64_t>(floored.y),
+				static_cast<std::int64_t>(floored.z) };
+			const auto toward = glm::lessThan(scaled - floored, glm::vec3 { 0.5f });
+
+			auto match = empty;
+			for (std::uint32_t corner = 0; corner < 8 && match == empty; corner++) {
+				const auto step = [&toward, corner](std::uint32_t axis) -> std::int64_t {
+					return (corner >> axis & 1) == 0 ? 0 : (toward[static_cast<glm::length_t>(axis)] ? -1 : 1);
+				};
+				const auto* head = cells.find({ cell.x + step(0), cell.y + step(1), cell.z + step(2) });
+				for (auto candidate = head ? *head : empty; candidate != empty; candidate = next[candidate]) {
+					const auto& other = welded[candidate];
+					if (near(vertex.position, other.position) && near(vertex.normal, other.normal) && near(vertex.uv, other.uv)
+						&& vertex.colour == other.colour) {
+						match = candidate;
+						break;
+					}
+				}
+			}
+
+			if (match == empty) {
+				match = static_cast<std::uint32_t>(welded.size());
+				welded.push_back(vertex);
+				if (auto* head = cells.find(cell)) {
+					next.push_back(std::exchange(*head, match));
+				} else {
+					cells.insert(cell, match);
+					next.push_back(empty);
+				}
+			}
+			remap[i] = match;
+		}
+
+		std::vector<Index> indices;
+		indices.reserve(mesh.indices.size());
+		for (std::size_t triangle = 0; triangle + 2 < mesh.indices.size(); triangle += 3) {
+			const auto a = remap[mesh.indices[triangle + 0]];
+			const auto b = remap[mesh.indices[triangle + 1]];
+			const auto c = remap[mesh.indices[triangle + 2]];
+			if (a != b && b != c && a != c) {
+				indices.insert(indices.end(), { a, b, c });
+			}
+		}
+
+		welded.shrink_to_fit();
+		mesh.vertices = std::move(welded);
+		mesh.indices = std::move(indices);
+	}
+
+	std::optional<MeshData> MeshFile::import_obj(const std::filesystem::path& source, const MeshImportOptions& options)
+	{
+		const auto source_stamp = FileStamp::stat(source);
+		const auto file = FileSystem::read(source);
+		if (!file) {
+			Log::error("[MeshFile] Could not read {}.", source.string());
+			return {};
+		}
+
+		// Parsed straight from the mapping, only geometry is read so the material library is not needed.
+		const auto model = ObjParser::parse(file->text());
+		if (!model) {
+			Log::error("[MeshFile] Could not parse {}.", source.string());
+			return {};
+		}
+
+		MeshData mesh;
+		std::tie(mesh.vertices, mesh.indices) = handle_vertices(*model);
+		if (options.weld && options.weld_tolerance > 0.0f) {
+			weld_vertices(mesh, options.weld_tolerance);
+		}
+		MeshOptimisationReport report;
+		if (options.optimise && !mesh.indices.empty()) {
+			report = MeshOptimiser::optimise(mesh);
+		}
+		if (options.meshlets && !mesh.indices.empty()) {
+			mesh.meshlets = MeshletBuilder::build(mesh.vertices, mesh.indices);
+			// Splitting regroups the triangles, so they are ordered for the cache again within every meshlet and the vertices are laid
+			// out again for the order they are now drawn in.
+			if (options.optimise) {
+				MeshOptimiser::optimise_meshlets(mesh.indices, mesh.meshlets, mesh.vertices.size());
+				MeshOptimiser::optimise_vertex_fetch(mesh.vertices, mesh.indices);
+				report.after = MeshOptimiser::analyse_vertex_cache(mesh.indices, mesh.vertices.size());
+			}
+			const auto statistics = MeshletBuilder::analyse(mesh.meshlets);
+			Log::info("[MeshFile] Split {} into {} meshlets, {:.1f} triangles and {:.1f} vertices each, {:.0f}% cullable.",
+				source.filename().string(), mesh.meshlets.size(), statistics.triangles_per_meshlet, statistics.vertices_per_meshlet,
+				100.0f * statistics.cullable_ratio);
+		}
+		if (options.optimise && !mesh.indices.empty()) {
+			Log::info("[MeshFile] Optimised {}, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}.", source.filename().string(), report.before.acmr,
+				report.after.acmr, report.before.atvr, report.after.atvr);
+		}
+		mesh.bounds = MeshBounds::of(mesh.vertices);
+
+		if (!options.lod_ratios.empty() && !mesh.indices.empty()) {
+			mesh.lods = MeshSimplifier::build_lods(
+				mesh.vertices, mesh.indices, options.lod_ratios, options.lod_error * mesh.bounds.radius, mesh.lod_indices);
+			for (const auto& lod : mesh.lods) {
+				const auto level = std::span { mesh.lod_indices }.subspan(lod.first_index - mesh.indices.size(), lod.index_count);
+				if (options.optimise) {
+					MeshOptimiser::optimise_vertex_cache(level, mesh.vertices.size());
+				}
+				Log::info("[MeshFile] Level of detail for {} with {} triangles, error {:.5f}.", source.filename().string(), lod.index_count / 3,
+					lod.error);
+			}
+		}
+
+		mesh.source = source_stamp.hashed(file->bytes);
+		return mesh;
+	}
+
+	std::filesystem::path MeshFile::cache_path(const std::filesystem::path& source)
+	{
+		return FileSystem::cache("meshes") / fmt::format("{}.amesh", Hash::to_hex(Hash::hash_string(source.generic_string())));
+	}
+
+	bool MeshFile::write(const std::filesystem::path& path, const MeshData& mesh)
+	{
+		MeshHeader header {};
+		header.magic = mesh_magic;
+		header.version = mesh_version;
+		header.vertex_stride = sizeof(Vertex);
+		header.index_stride = sizeof(Index);
+		header.vertex_count = mesh.vertices.size();
+		header.index_count = mesh.indices.size() + mesh.lod_indices.size();
+		header.vertex_offset = align_up(sizeof(MeshHeader), data_alignment);
+		header.index_offset = align_up(header.vertex_offset + header.vertex_count * sizeof(Vertex), data_alignment);
+		header.meshlet_stride = sizeof(Meshlet);
+		header.meshlet_count = mesh.meshlets.size();
+		header.meshlet_offset = align_up(header.index_offset + header.index_count * sizeof(Index), data_alignment);
+		header.lod_stride = sizeof(MeshLod);
+		header.lod_count = mesh.lods.size();
+		header.lod_offset = align_up(header.meshlet_offset + header.meshlet_count * sizeof(Meshlet), data_alignment);
+		std::memcpy(header.bounds_min, &mesh.bounds.min, sizeof(header.bounds_min));
+		std::memcpy(header.bounds_max, &mesh.bounds.max, sizeof(header.bounds_max));
+		header.bounds_radius = mesh.bounds.radius;
+		header.source_size = mesh.source.size;
+		header.source_last_write = mesh.source.last_write;
+		header.source_hash = mesh.source.hash;
+
+		std::error_code error;
+		std::filesystem::create_directories(path.parent_path(), error);
+
+		const auto thread_hash = std::hash<std::thread::id> {}(std::this_thread::get_id());
+		const auto temporary_path = std::filesystem::path { path }.concat(fmt::format(".{}.tmp", thread_hash));
+		{
+			std::ofstream stream(temporary_path, std::ios::binary | std::ios::trunc);
+			if (!stream) {
+				return false;
+			}
+
+			static constexpr std::array<char, data_alignment> padding {};
+			const auto pad_to = [&stream](std::uint64_t offset) {
+				const auto position = static_cast<std::uint64_t>(stream.tellp());
+				stream.write(padding.data(), static_cast<std::streamsize>(offset - position));
+			};
+
+			stream.write(reinterpret_cast<const char*>(&header), sizeof(MeshHeader));
+			pad_to(header.vertex_offset);
+			stream.write(reinterpret_cast<const char*>(mesh.vertices.data()), static_cast<std::streamsize>(mesh.vertices.size() * sizeof(Vertex)));
+			pad_to(header.index_offset);
+			stream.write(reinterpret_cast<const char*>(mesh.indices.data()), static_cast<std::streamsize>(mesh.indices.size() * sizeof(Index)));
+			stream.write(
+				reinterpret_cast<const char*>(mesh.lod_indices.data()), static_cast<std::streamsize>(mesh.lod_indices.size() * sizeof(Index)));
+			pad_to(header.meshlet_offset);
+			stream.write(
+				reinterpret_cast<const char*>(mesh.meshlets.data()), static_cast<std::streamsize>(mesh.meshlets.size() * sizeof(Meshlet)));
+			pad_to(header.lod_offset);
+			stream.write(reinterpret_cast<const char*>(mesh.lods.data()), static_cast<std::streamsize>(mesh.lods.size() * sizeof(MeshLod)));
+			if (!stream) {
+				return false;
+			}
+		}
+
+		std::filesystem::rename(temporary_path, path, error);
+		if (error) {
+			std::filesystem::remove(temporary_path, error);
+			return false;
+		}
+		return true;
+	}
+
+	std::optional<MeshFile> MeshFile::open(const std::filesystem::path& path)
+	{
+		auto mapped = MappedFile::open(path);
+		if (!mapped) {
+			return {};
+		}
+
+		const auto bytes = mapped->bytes();
+		if (bytes.size() < sizeof(MeshHeader)) {
+			return {};
+		}
+
+		MeshHeader header;
+		std::memcpy(&header, bytes.data(), sizeof(MeshHeader));
+		if (header.magic != mesh_magic || header.version != mesh_version || header.vertex_stride != sizeof(Vertex)
+			|| header.index_stride != sizeof(Index) || header.meshlet_stride != sizeof(Meshlet) || header.lod_stride != sizeof(MeshLod)) {
+			return {};
+		}
+
+		// Counts are checked against the file size before they are multiplied, so a corrupt header cannot overflow the bounds checks.
+		const auto fits = [&bytes](std::uint64_t offset, std::uint64_t count, std::uint64_t stride) {
+			return offset % data_alignment == 0 && offset <= bytes.size() && count <= (bytes.size() - offset) / stride;
+		};
+		if (!fits(header.vertex_offset, header.vertex_count, sizeof(Vertex)) || !fits(header.index_offset, header.index_count, sizeof(Index))
+			|| !fits(header.meshlet_offset, header.meshlet_count, sizeof(Meshlet)) || !fits(header.lod_offset, header.lod_count, sizeof(MeshLod))) {
+			return {};
+		}
+
+		MeshFile mesh;
+		mesh.vertex_data = { reinterpret_cast<const Vertex*>(bytes.data() + header.vertex_offset), header.vertex_count };
+		mesh.index_data = { reinterpret_cast<const Index*>(bytes.data() + header.index_offset), header.index_count };
+		mesh.meshlet_data = { reinterpret_cast<const Meshlet*>(bytes.data() + header.meshlet_offset), header.meshlet_count };
+		mesh.lod_data = { reinterpret_cast<const MeshLod*>(bytes.data() + header.lod_offset), header.lod_count };
+		const auto outside = [&header](const MeshLod& lod) {
+			return lod.first_index > header.index_count || lod.index_count > header.index_count - lod.first_index;
+		};
+		const auto meshlet_outside = [&header](const Meshlet& meshlet) {
+			return meshlet.first_index > header.index_count || 3ull * meshlet.triangle_count > header.index_count - meshlet.first_index
+				|| meshlet.vertex_count > header.vertex_count;
+		};
+		if (std::ranges::any_of(mesh.lod_data, outside) || std::ranges::any_of(mesh.meshlet_data, meshlet_outside)) {
+			return {};
+		}
+		// An index past the vertices would have the GPU read out of bounds. A branchless maximum over the whole buffer is cheaper than
+		// stopping at the first bad index, which a valid container never has.
+		if (!mesh.index_data.empty() && std::ranges::max(mesh.index_data) >= header.vertex_count) {
+			return {};
+		}
+		std::memcpy(&mesh.mesh_bounds.min, header.bounds_min, sizeof(header.bounds_min));
+		std::memcpy(&mesh.mesh_bounds.max, header.bounds_max, sizeof(header.bounds_max));
+		mesh.mesh_bounds.radius = header.bounds_radius;
+		mesh.mesh_source = { .size = header.source_size, .last_write = header.source_last_write, .hash = header.source_hash };
+		mesh.file = std::move(*mapped);
+		return mesh;
+	}
+
+	bool MeshFile::is_current(const std::filesystem::path& source) const
+	{
+		const auto current = FileStamp::of(source, &mesh_source);
+		return current && current->hash == mesh_source.hash;
+	}
+
+} // namespace Alabaster
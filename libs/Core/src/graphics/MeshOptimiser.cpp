@@ -0,0 +1,351 @@
+#include "av_pch.hpp"
+
+#include "graphics/MeshOptimiser.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace Alabaster {
+
+	/// @brief The triangles around every vertex, as ranges of one flat list.
+	struct TriangleAdjacency {
+		std::vector<std::uint32_t> offsets;
+		std::vector<std::uint32_t> triangles;
+
+		std::span<const std::uint32_t> around(Index vertex) const
+		{
+			return std::span { triangles }.subspan(offsets[vertex], offsets[vertex + 1] - offsets[vertex]);
+		}
+	};
+
+	static TriangleAdjacency build_adjacency(std::span<const Index> indices, std::size_t vertex_count)
+	{
+		TriangleAdjacency adjacency;
+		adjacency.offsets.assign(vertex_count + 1, 0);
+		for (const auto index : indices) {
+			adjacency.offsets[index + 1]++;
+		}
+		std::partial_sum(adjacency.offsets.begin(), adjacency.offsets.end(), adjacency.offsets.begin());
+
+		adjacency.triangles.resize(indices.size());
+		auto cursors = adjacency.offsets;
+		for (std::size_t i = 0; i < indices.size(); i++) {
+			adjacency.triangles[cursors[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+		}
+		return adjacency;
+	}
+
+	/// @brief FIFO post-transform cache. A vertex is cached while fewer than size vertices were transformed after it.
+	class FifoCache {
+	public:
+		FifoCache(std::size_t vertex_count, std::uint32_t cache_size)
+			: timestamps(vertex_count, 0)
+			, size(cache_size)
+			, time(cache_size + 1)
+		{
+		}
+
+		/// @return whether the vertex missed the cache and had to be transformed
+		bool touch(Index vertex)
+		{
+			if (time - timestamps[vertex] <= size) {
+				return false;
+			}
+			timestamps[vertex] = time++;
+			return true;
+		}
+
+		void flush() { time += size + 1; }
+
+	private:
+		std::vector<std::uint32_t> timestamps;
+		std::uint32_t size;
+		std::uint32_t time;
+	};
+
+	VertexCacheStatistics MeshOptimiser::analyse_vertex_cache(std::span<const Index> indices, std::size_t vertex_count, std::uint32_t size)
+	{
+		if (indices.empty()) {
+			return {};
+		}
+
+		FifoCache cache { vertex_count, size };
+		std::vector<bool> referenced(vertex_count, false);
+		std::size_t misses { 0 };
+		std::size_t unique { 0 };
+		for (const auto index : indices) {
+			misses += cache.touch(index) ? 1 : 0;
+			if (!referenced[index]) {
+				referenced[index] = true;
+				unique++;
+			}
+		}
+
+		return {
+			.acmr = static_cast<float>(misses) / static_cast<float>(indices.size() / 3),
+			.atvr = static_cast<float>(misses) / static_cast<float>(unique),
+		};
+	}
+
+	std::vector<std::uint32_t> MeshOptimiser::optimise_vertex_cache(std::span<Index> indices, std::size_t vertex_count)
+	{
+		static constexpr auto none = std::numeric_limits<std::uint32_t>::max();
+
+		std::vector<std::uint32_t> clusters;
+		if (indices.empty()) {
+			return clusters;
+		}
+
+		const auto adjacency = build_adjacency(indices, vertex_count);
+		std::vector<std::uint32_t> live_triangles(vertex_count);
+		for (std::size_t vertex = 0; vertex < vertex_count; vertex++) {
+			live_triangles[vertex] = adjacency.offsets[vertex + 1] - adjacency.offsets[vertex];
+		}
+
+		std::vector<std::uint32_t> cache_time(vertex_count, 0);
+		std::vector<bool> emitted(indices.size() / 3, false);
+		std::vector<Index> dead_ends;
+		std::vector<Index> candidates;
+		std::vector<Index> output;
+		output.reserve(indices.size());
+		std::uint32_t time = cache_size + 1;
+		std::size_t cursor { 0 };
+
+		// Vertices of emitted triangles that still have live ones are likely cached, the input order is the fallback.
+		const auto next_dead_end = [&]() -> std::uint32_t {
+			while (!dead_ends.empty()) {
+				const auto vertex = dead_ends.back();
+				dead_ends.pop_back();
+				if (live_triangles[vertex] > 0) {
+					return vertex;
+				}
+			}
+			for (; cursor < vertex_count; cursor++) {
+				if (live_triangles[cursor] > 0) {
+					return static_cast<std::uint32_t>(cursor);
+				}
+			}
+			return none;
+		};
+
+		clusters.push_back(0);
+		for (auto fanning = next_dead_end(); fanning != none;) {
+			candidates.clear();
+			for (const auto triangle : adjacency.around(fanning)) {
+				if (emitted[triangle]) {
+					continue;
+				}
+				emitted[triangle] = true;
+
+				for (std::size_t corner = 0; corner < 3; corner++) {
+					const auto vertex = indices[3 * triangle + corner];
+					output.push_back(vertex);
+					dead_ends.push_back(vertex);
+					candidates.push_back(vertex);
+					live_triangles[vertex]--;
+					if (time - cache_time[vertex] > cache_size) {
+						cache_time[vertex] = time++;
+					}
+				}
+			}
+
+			// Fan around the vertex that will still be cached after its remaining triangles are emitted, preferring the oldest.
+			auto next = none;
+			std::int64_t best_priority { -1 };
+			for (const auto vertex : candidates) {
+				if (live_triangles[vertex] == 0) {
+					continue;
+				}
+				std::int64_t priority { 0 };
+				if (time - cache_time[vertex] + 2 * live_triangles[vertex] <= cache_size) {
+					priority = time - cache_time[vertex];
+				}
+				if (priority > best_priority) {
+					best_priority = priority;
+					next = vertex;
+				}
+			}
+
+			if (next == none) {
+				next = next_dead_end();
+				if (next != none) {
+					clusters.push_back(static_cast<std::uint32_t>(output.size() / 3));
+				}
+			}
+			fanning = next;
+		}
+
+		std::copy(output.begin(), output.end(), indices.begin());
+		return clusters;
+	}
+
+	/// @brief Splits every cluster wherever the triangles so far already reuse the cache almost as well as the whole cluster does.
+	static std::vector<std::uint32_t> split_clusters(
+		std::span<const Index> indices, std::size_t vertex_count, std::span<const std::uint32_t> clusters, float threshold)
+	{
+		const auto triangle_count = static_cast<std::uint32_t>(indices.size() / 3);
+		FifoCache cache { vertex_count, MeshOptimiser::cache_size };
+		const auto misses = [&cache, &indices](std::uint32_t triangle) {
+			std::uint32_t count { 0 };
+			for (std::size_t corner = 0; corner < 3; corner++) {
+				count += cache.touch(indices[3 * triangle + corner]) ? 1 : 0;
+			}
+			return count;
+		};
+
+		std::vector<std::uint32_t> boundaries;
+		for (std::size_t cluster = 0; cluster < clusters.size(); cluster++) {
+			const auto start = clusters[cluster];
+			const auto end = cluster + 1 < clusters.size() ? clusters[cluster + 1] : triangle_count;
+
+			cache.flush();
+			std::uint32_t cluster_misses { 0 };
+			for (auto triangle = start; triangle < end; triangle++) {
+				cluster_misses += misses(triangle);
+			}
+			const auto target = threshold * static_cast<float>(cluster_misses) / static_cast<float>(end - start);
+
+			cache.flush();
+			boundaries.push_back(start);
+			auto soft_start = start;
+			std::uint32_t soft_misses { 0 };
+			for (auto triangle = start; triangle < end; triangle++) {
+				soft_misses += misses(triangle);
+				if (triangle + 1 < end && static_cast<float>(soft_misses) <= target * static_cast<float>(triangle + 1 - soft_start)) {
+					boundaries.push_back(triangle + 1);
+					soft_start = triangle + 1;
+					soft_misses = 0;
+					cache.flush();
+				}
+			}
+		}
+		return boundaries;
+	}
+
+	/// @brief Sorts clusters by how far they face away from the centre of the mesh. Those facing away the most are the most likely to
+	/// occlude the others, so they are drawn first.
+	static std::vector<Index> sort_clusters(std::span<const Index> indices, std::span<const Vertex> vertices, std::span<const std::uint32_t> clusters)
+	{
+		const auto triangle_count = static_cast<std::uint32_t>(indices.size() / 3);
+
+		glm::vec3 mesh_centroid { 0.0f };
+		for (const auto index : indices) {
+			mesh_centroid += vertices[index].position;
+		}
+		mesh_centroid /= static_cast<float>(indices.size());
+
+		struct ClusterOrder {
+			float facing;
+			std::uint32_t start;
+			std::uint32_t end;
+		};
+		std::vector<ClusterOrder> order;
+		order.reserve(clusters.size());
+		for (std::size_t cluster = 0; cluster < clusters.size(); cluster++) {
+			const auto start = clusters[cluster];
+			const auto end = cluster + 1 < clusters.size() ? clusters[cluster + 1] : triangle_count;
+
+			glm::vec3 centroid { 0.0f };
+			glm::vec3 normal { 0.0f };
+			for (auto triangle = start; triangle < end; triangle++) {
+				const auto& a = vertices[indices[3 * triangle + 0]].position;
+				const auto& b = vertices[indices[3 * triangle + 1]].position;
+				const auto& c = vertices[indices[3 * triangle + 2]].position;
+				centroid += a + b + c;
+				normal += glm::cross(b - a, c - a);
+			}
+			centroid /= static_cast<float>(3 * (end - start));
+			const auto length = glm::length(normal);
+			const auto facing = length > 0.0f ? glm::dot(centroid - mesh_centroid, normal / length) : 0.0f;
+			order.push_back({ facing, start, end });
+		}
+		std::stable_sort(order.begin(), order.end(), [](const ClusterOrder& lhs, const ClusterOrder& rhs) { return lhs.facing > rhs.facing; });
+
+		std::vector<Index> sorted;
+		sorted.reserve(indices.size());
+		for (const auto& cluster : order) {
+			sorted.insert(sorted.end(), indices.begin() + 3 * cluster.start, indices.begin() + 3 * cluster.end);
+		}
+		return sorted;
+	}
+
+	void MeshOptimiser::optimise_overdraw(
+		std::span<Index> indices, std::span<const Vertex> vertices, std::span<const std::uint32_t> clusters, float threshold)
+	{
+		if (indices.empty() || clusters.empty()) {
+			return;
+		}
+
+		// Reordering loses the cache contents at every cluster boundary, on top of what the split clusters give up. The finer order
+		// is tried first, then the Tipsify clusters alone, and the triangles are left alone if both cost more than the threshold.
+		const auto budget = threshold * analyse_vertex_cache(indices, vertices.size()).acmr;
+		for (const auto& boundaries : { split_clusters(indices, vertices.size(), clusters, threshold),
+				 std::vector<std::uint32_t> { clusters.begin(), clusters.end() } }) {
+			const auto sorted = sort_clusters(indices, vertices, boundaries);
+			if (analyse_vertex_cache(sorted, vertices.size()).acmr <= budget) {
+				std::copy(sorted.begin(), sorted.end(), indices.begin());
+				return;
+			}
+		}
+	}
+
+	void MeshOptimiser::optimise_vertex_fetch(std::vector<Vertex>& vertices, std::span<Index> indices)
+	{
+		static constexpr auto unused = std::numeric_limits<Index>::max();
+
+		std::vector<Index> remap(vertices.size(), unused);
+		std::vector<Vertex> ordered;
+		ordered.reserve(vertices.size());
+		for (auto& index : indices) {
+			if (remap[index] == unused) {
+				remap[index] = static_cast<Index>(ordered.size());
+				ordered.push_back(vertices[index]);
+			}
+			index = remap[index];
+		}
+		vertices = std::move(ordered);
+	}
+
+	void MeshOptimiser::optimise_meshlets(std::span<Index> indices, std::span<const Meshlet> meshlets, std::size_t vertex_count)
+	{
+		static constexpr auto none = std::numeric_limits<Index>::max();
+
+		// Every meshlet is ordered on its own vertices only, so the cost follows the meshlet rather than the whole mesh.
+		std::vector<Index> local(vertex_count, none);
+		std::vector<Index> global;
+		std::vector<Index> triangles;
+		for (const auto& meshlet : meshlets) {
+			const auto range = indices.subspan(meshlet.first_index, 3 * static_cast<std::size_t>(meshlet.triangle_count));
+			triangles.clear();
+			for (const auto index : range) {
+				if (local[index] == none) {
+					local[index] = static_cast<Index>(global.size());
+					global.push_back(index);
+				}
+				triangles.push_back(local[index]);
+			}
+
+			optimise_vertex_cache(triangles, global.size());
+			std::ranges::transform(triangles, range.begin(), [&global](Index index) { return global[index]; });
+			for (const auto vertex : global) {
+				local[vertex] = none;
+			}
+			global.clear();
+		}
+	}
+
+	MeshOptimisationReport MeshOptimiser::optimise(MeshData& mesh)
+	{
+		MeshOptimisationReport report;
+		report.before = analyse_vertex_cache(mesh.indices, mesh.vertices.size());
+
+		const auto clusters = optimise_vertex_cache(mesh.indices, mesh.vertices.size());
+		optimise_overdraw(mesh.indices, mesh.vertices, clusters);
+		optimise_vertex_fetch(mesh.vertices, mesh.indices);
+
+		report.after = analyse_vertex_cache(mesh.indices, mesh.vertices.size());
+		return report;
+	}
+
+} // namespace Alabaster
@@ -0,0 +1,367 @@
+#include "av_pch.hpp"
+
+#include "graphics/MeshSimplifier.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <tuple>
+
+namespace Alabaster {
+
+	static constexpr auto none = std::numeric_limits<Index>::max();
+	/// @brief Cosine of the largest angle a collapse may turn a triangle by.
+	static constexpr float max_turn = 0.25f;
+
+	/// @brief Sum of the squared distances to a set of planes, weighted by the area of the triangles they came from. Evaluated it is
+	/// divided by the total weight, so the error is a mean squared distance no matter how many triangles were merged.
+	struct Quadric {
+		double xx { 0 }, xy { 0 }, xz { 0 }, yy { 0 }, yz { 0 }, zz { 0 };
+		double x { 0 }, y { 0 }, z { 0 };
+		double c { 0 };
+		double weight { 0 };
+
+		static Quadric of_triangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+		{
+			const auto cross = glm::cross(b - a, c - a);
+			const auto length = static_cast<double>(glm::length(cross));
+			if (length == 0.0) {
+				return {};
+			}
+
+			const double nx = cross.x / length, ny = cross.y / length, nz = cross.z / length;
+			const auto d = -(nx * a.x + ny * a.y + nz * a.z);
+			const auto area = 0.5 * length;
+			return { area * nx * nx, area * nx * ny, area * nx * nz, area * ny * ny, area * ny * nz, area * nz * nz, area * nx * d, area * ny * d,
+				area * nz * d, area * d * d, area };
+		}
+
+		Quadric& operator+=(const Quadric& other)
+		{
+			xx += other.xx;
+			xy += other.xy;
+			xz += other.xz;
+			yy += other.yy;
+			yz += other.yz;
+			zz += other.zz;
+			x += other.x;
+			y += other.y;
+			z += other.z;
+			c += other.c;
+			weight += other.weight;
+			return *this;
+		}
+
+		double error(const glm::vec3& point) const
+		{
+			if (weight == 0.0) {
+				return 0.0;
+			}
+
+			const double px = point.x, py = point.y, pz = point.z;
+			const auto squared = px * px * xx + py * py * yy + pz * pz * zz + 2.0 * (px * py * xy + px * pz * xz + py * pz * yz)
+				+ 2.0 * (px * x + py * y + pz * z) + c;
+			return std::max(squared, 0.0) / weight;
+		}
+	};
+
+	struct Collapse {
+		/// @brief The vertex that is removed, it is its own and only wedge.
+		Index from;
+		/// @brief The wedge of the vertex it is moved onto, as the triangles around the edge reference it.
+		Index to;
+		double cost;
+	};
+
+	/// @brief Collapses edges in passes. Every pass sorts the collapses the current triangles allow by cost and applies the cheapest
+	/// ones whose neighbourhoods do not overlap, so one collapse never invalidates the cost or the flip test of another.
+	class Simplification {
+	public:
+		Simplification(std::span<const Vertex> mesh_vertices, std::span<const Index> indices)
+			: vertices(mesh_vertices)
+			, current(indices.begin(), indices.end())
+			, position_of(mesh_vertices.size(), none)
+			, locked(mesh_vertices.size(), false)
+			, quadrics(mesh_vertices.size())
+		{
+			weld_positions();
+			lock_borders();
+			for (std::size_t i = 0; i + 2 < current.size(); i += 3) {
+				const auto quadric = Quadric::of_triangle(position(current[i]), position(current[i + 1]), position(current[i + 2]));
+				for (std::size_t corner = 0; corner < 3; corner++) {
+					quadrics[position_of[current[i + corner]]] += quadric;
+				}
+			}
+		}
+
+		void collapse_until(std::size_t target_index_count, float max_error)
+		{
+			const auto max_cost = static_cast<double>(max_error) * static_cast<double>(max_error);
+			while (current.size() > target_index_count && collapse_pass((current.size() - target_index_count) / 3, max_cost)) { }
+		}
+
+		const std::vector<Index>& indices() const { return current; }
+		float error() const { return static_cast<float>(std::sqrt(max_cost_reached)); }
+
+	private:
+		const glm::vec3& position(Index vertex) const { return vertices[vertex].position; }
+
+		/// @brief Vertices at the same position are wedges of one position vertex, which carries the quadric. Only a position with a
+		/// single wedge can move, moving a seam would tear the attributes apart.
+		void weld_positions()
+		{
+			std::vector<Index> referenced { current };
+			std::sort(referenced.begin(), referenced.end());
+			referenced.erase(std::unique(referenced.begin(), referenced.end()), referenced.end());
+
+			const auto before = [this](Index a, Index b) {
+				const auto& left = position(a);
+				const auto& right = position(b);
+				return std::tie(left.x, left.y, left.z) < std::tie(right.x, right.y, right.z);
+			};
+			std::stable_sort(referenced.begin(), referenced.end(), before);
+
+			for (std::size_t first = 0; first < referenced.size();) {
+				auto last = first + 1;
+				while (last < referenced.size() && position(referenced[last]) == position(referenced[first])) {
+					last++;
+				}
+				for (auto wedge = first; wedge < last; wedge++) {
+					position_of[referenced[wedge]] = referenced[first];
+				}
+				locked[referenced[first]] = last - first > 1;
+				first = last;
+			}
+		}
+
+		/// @brief Edges used by one triangle lie on an open border, edges used by more than two are non-manifold. Moving their
+		/// vertices would pull the outline of the mesh in.
+		void lock_borders()
+		{
+			std::vector<std::uint64_t> edges;
+			edges.reserve(current.size());
+			for (std::size_t i = 0; i < current.size(); i++) {
+				const auto a = position_of[current[i]];
+				const auto b = position_of[current[i % 3 == 2 ? i - 2 : i + 1]];
+				edges.push_back(static_cast<std::uint64_t>(std::min(a, b)) << 32 | std::max(a, b));
+			}
+			std::sort(edges.begin(), edges.end());
+
+			for (std::size_t first = 0; first < edges.size();) {
+				auto last = first + 1;
+				while (last < edges.size() && edges[last] == edges[first]) {
+					last++;
+				}
+				if (last - first != 2) {
+					locked[static_cast<Index>(edges[first] >> 32)] = true;
+					locked[static_cast<Index>(edges[first] & 0xFFFFFFFF)] = true;
+				}
+				first = last;
+			}
+		}
+
+		/// @return whether moving from onto the position of to turns any of the remaining triangles around from over, either against
+		/// where it faced or against the surface around from
+		bool flips(Index from, Index to, std::span<const std::uint32_t> around) const
+		{
+			const auto corners_of = [this, from](std::uint32_t triangle) {
+				const auto* corners = &current[3 * triangle];
+				const auto corner = position_of[corners[0]] == from ? 0 : (position_of[corners[1]] == from ? 1 : 2);
+				return std::array { corners[corner], corners[(corner + 1) % 3], corners[(corner + 2) % 3] };
+			};
+
+			// Area weighted, so slivers standing on edge do not decide which way the surface faces.
+			glm::vec3 surface { 0.0f };
+			for (const auto triangle : around) {
+				const auto [a, b, c] = corners_of(triangle);
+				surface += glm::cross(position(b) - position(a), position(c) - position(a));
+			}
+
+			const auto& moved = position(to);
+			for (const auto triangle : around) {
+				const auto [a, b, c] = corners_of(triangle);
+				if (position_of[b] == to || position_of[c] == to) {
+					continue;
+				}
+
+				// Triangles turned far from where they faced are rejected too, those close to flipping end up as slivers.
+				const auto before = glm::cross(position(b) - position(a), position(c) - position(a));
+				const auto after = glm::cross(position(b) - moved, position(c) - moved);
+				if (glm::dot(before, after) <= max_turn * glm::length(before) * glm::length(after) || glm::dot(surface, after) <= 0.0f) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/// @brief The link condition (Dey et al., 1999). The vertices both ends of the edge share must be exactly the far corners of the
+		/// triangles on the edge, otherwise the collapse folds the surface onto itself.
+		bool keeps_link(Index from, Index to, std::span<const std::uint32_t> around_from, std::span<const std::uint32_t> around_to) const
+		{
+			std::vector<Index> neighbours_from;
+			std::vector<Index> neighbours_to;
+			std::size_t on_edge { 0 };
+			for (const auto triangle : around_from) {
+				bool has_to { false };
+				for (std::size_t corner = 0; corner < 3; corner++) {
+					const auto vertex = position_of[current[3 * triangle + corner]];
+					has_to = has_to || vertex == to;
+					neighbours_from.push_back(vertex);
+				}
+				on_edge += has_to ? 1 : 0;
+			}
+			for (const auto triangle : around_to) {
+				for (std::size_t corner = 0; corner < 3; corner++) {
+					neighbours_to.push_back(position_of[current[3 * triangle + corner]]);
+				}
+			}
+
+			for (auto* neighbours : { &neighbours_from, &neighbours_to }) {
+				std::erase_if(*neighbours, [from, to](Index vertex) { return vertex == from || vertex == to; });
+				std::sort(neighbours->begin(), neighbours->end());
+				neighbours->erase(std::unique(neighbours->begin(), neighbours->end()), neighbours->end());
+			}
+			std::vector<Index> shared;
+			std::set_intersection(
+				neighbours_from.begin(), neighbours_from.end(), neighbours_to.begin(), neighbours_to.end(), std::back_inserter(shared));
+			return shared.size() == on_edge;
+		}
+
+		/// @return whether any edge was collapsed
+		bool collapse_pass(std::size_t triangles_to_remove, double max_cost)
+		{
+			const auto triangle_count = current.size() / 3;
+
+			// Triangles around every position vertex, as ranges of one flat list.
+			std::vector<std::uint32_t> offsets(vertices.size() + 1, 0);
+			for (const auto index : current) {
+				offsets[position_of[index] + 1]++;
+			}
+			std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+			std::vector<std::uint32_t> triangles(current.size());
+			auto cursors = offsets;
+			for (std::size_t i = 0; i < current.size(); i++) {
+				triangles[cursors[position_of[current[i]]]++] = static_cast<std::uint32_t>(i / 3);
+			}
+			const auto around = [&](Index vertex) {
+				return std::span<const std::uint32_t> { triangles }.subspan(offsets[vertex], offsets[vertex + 1] - offsets[vertex]);
+			};
+
+			// Every interior edge is seen once from each of its triangles, each adds the collapse onto the far end, as its own triangle
+			// references it.
+			std::vector<Collapse> collapses;
+			collapses.reserve(current.size());
+			for (std::size_t i = 0; i < current.size(); i++) {
+				const auto from = position_of[current[i]];
+				const auto to = current[i % 3 == 2 ? i - 2 : i + 1];
+				if (locked[from] || from == position_of[to]) {
+					continue;
+				}
+				auto quadric = quadrics[from];
+				quadric += quadrics[position_of[to]];
+				if (const auto cost = quadric.error(position(to)); cost <= max_cost) {
+					collapses.push_back({ from, to, cost });
+				}
+			}
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse& left, const Collapse& right) { return left.cost < right.cost; });
+
+			std::vector<Index> collapse_to(vertices.size(), none);
+			std::vector<bool> touched(vertices.size(), false);
+			std::size_t removed { 0 };
+			for (const auto& [from, to, cost] : collapses) {
+				const auto target = position_of[to];
+				if (removed >= triangles_to_remove) {
+					break;
+				}
+				if (touched[from] || touched[target] || flips(from, target, around(from))
+					|| !keeps_link(from, target, around(from), around(target))) {
+					continue;
+				}
+
+				// The whole ring around the vertex is claimed, the next collapse in it has to see the triangles this one leaves.
+				for (const auto triangle : around(from)) {
+					const auto* corners = &current[3 * triangle];
+					const auto shared = position_of[corners[0]] == target || position_of[corners[1]] == target || position_of[corners[2]] == target;
+					removed += shared ? 1 : 0;
+					for (std::size_t corner = 0; corner < 3; corner++) {
+						touched[position_of[corners[corner]]] = true;
+					}
+				}
+				collapse_to[from] = to;
+				quadrics[target] += quadrics[from];
+				max_cost_reached = std::max(max_cost_reached, cost);
+			}
+			if (removed == 0) {
+				return false;
+			}
+
+			std::size_t output { 0 };
+			for (std::size_t triangle = 0; triangle < triangle_count; triangle++) {
+				std::array<Index, 3> corners {};
+				for (std::size_t corner = 0; corner < 3; corner++) {
+					const auto index = current[3 * triangle + corner];
+					corners[corner] = collapse_to[index] == none ? index : collapse_to[index];
+				}
+				const auto a = position_of[corners[0]], b = position_of[corners[1]], c = position_of[corners[2]];
+				if (a == b || b == c || a == c) {
+					continue;
+				}
+				std::copy(corners.begin(), corners.end(), current.begin() + static_cast<std::ptrdiff_t>(output));
+				output += 3;
+			}
+			current.resize(output);
+			return true;
+		}
+
+		std::span<const Vertex> vertices;
+		std::vector<Index> current;
+		std::vector<Index> position_of;
+		std::vector<bool> locked;
+		std::vector<Quadric> quadrics;
+		double max_cost_reached { 0.0 };
+	};
+
+	SimplifiedMesh MeshSimplifier::simplify(
+		std::span<const Vertex> vertices, std::span<const Index> indices, std::size_t target_index_count, float max_error)
+	{
+		Simplification simplification { vertices, indices };
+		simplification.collapse_until(target_index_count, max_error);
+		return { simplification.indices(), simplification.error() };
+	}
+
+	std::vector<MeshLod> MeshSimplifier::build_lods(std::span<const Vertex> vertices, std::span<const Index> indices, std::span<const float> ratios,
+		float max_error, std::vector<Index>& lod_indices)
+	{
+		std::vector<MeshLod> lods;
+		Simplification simplification { vertices, indices };
+		auto previous = indices.size();
+		for (const auto ratio : ratios) {
+			const auto target = static_cast<std::size_t>(ratio * static_cast<float>(indices.size() / 3)) * 3;
+			simplification.collapse_until(target, max_error);
+
+			const auto& level = simplification.indices();
+			if (static_cast<float>(level.size()) > (1.0f - min_reduction) * static_cast<float>(previous)) {
+				break;
+			}
+			lods.push_back({ .first_index = static_cast<std::uint32_t>(indices.size() + lod_indices.size()),
+				.index_count = static_cast<std::uint32_t>(level.size()),
+				.error = simplification.error() });
+			lod_indices.insert(lod_indices.end(), level.begin(), level.end());
+			previous = level.size();
+		}
+		return lods;
+	}
+
+	std::size_t MeshSimplifier::select_lod(std::span<const MeshLod> lods, float pixels_per_unit, float max_screen_error)
+	{
+		for (auto level = lods.size(); level > 1; level--) {
+			if (lods[level - 1].error * pixels_per_unit <= max_screen_error) {
+				return level - 1;
+			}
+		}
+		return 0;
+	}
+
+} // namespace Alabaster
@@ -0,0 +1,227 @@
+#include "av_pch.hpp"
+
+#include "graphics/MeshletBuilder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace Alabaster {
+
+	static constexpr auto none = std::numeric_limits<std::uint32_t>::max();
+
+	bool Meshlet::is_backfacing(const glm::vec3& viewer) const
+	{
+		const auto to_centre = centre - viewer;
+		return glm::dot(to_centre, cone_axis) >= cone_cutoff * glm::length(to_centre) + radius;
+	}
+
+	/// @brief The triangles around every vertex, as ranges of one flat list.
+	struct VertexTriangles {
+		std::vector<std::uint32_t> offsets;
+		std::vector<std::uint32_t> triangles;
+
+		VertexTriangles(std::span<const Index> indices, std::size_t vertex_count)
+			: offsets(vertex_count + 1, 0)
+			, triangles(indices.size())
+		{
+			for (const auto index : indices) {
+				offsets[index + 1]++;
+			}
+			std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+			auto cursors = offsets;
+			for (std::size_t i = 0; i < indices.size(); i++) {
+				triangles[cursors[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+			}
+		}
+
+		std::span<const std::uint32_t> around(Index vertex) const
+		{
+			return std::span { triangles }.subspan(offsets[vertex], offsets[vertex + 1] - offsets[vertex]);
+		}
+	};
+
+	static glm::vec3 triangle_normal(std::span<const Vertex> vertices, std::span<const Index> indices, std::uint32_t triangle)
+	{
+		const auto& a = vertices[indices[3 * triangle + 0]].position;
+		const auto& b = vertices[indices[3 * triangle + 1]].position;
+		const auto& c = vertices[indices[3 * triangle + 2]].position;
+		const auto normal = glm::cross(b - a, c - a);
+		const auto length = glm::length(normal);
+		return length > 0.0f ? normal / length : glm::vec3 { 0.0f };
+	}
+
+	/// @brief Fits the bounding sphere and normal cone to the triangles of a finished meshlet.
+	static void fit_bounds(Meshlet& meshlet, std::span<const Vertex> vertices, std::span<const Index> indices)
+	{
+		const auto meshlet_indices = indices.subspan(meshlet.first_index, 3 * meshlet.triangle_count);
+
+		auto min = vertices[meshlet_indices.front()].position;
+		auto max = min;
+		for (const auto index : meshlet_indices) {
+			min = glm::min(min, vertices[index].position);
+			max = glm::max(max, vertices[index].position);
+		}
+		meshlet.centre = 0.5f * (min + max);
+		for (const auto index : meshlet_indices) {
+			meshlet.radius = std::max(meshlet.radius, glm::length(vertices[index].position - meshlet.centre));
+		}
+
+		std::vector<glm::vec3> normals(meshlet.triangle_count);
+		glm::vec3 axis { 0.0f };
+		for (std::uint32_t triangle = 0; triangle < meshlet.triangle_count; triangle++) {
+			normals[triangle] = triangle_normal(vertices, meshlet_indices, triangle);
+			axis += normals[triangle];
+		}
+		const auto length = glm::length(axis);
+		if (length == 0.0f) {
+			return;
+		}
+
+		// Degenerate triangles have no normal and cover no pixels, they do not widen the cone.
+		meshlet.cone_axis = axis / length;
+		auto min_dot = 1.0f;
+		for (const auto& normal : normals) {
+			if (normal != glm::vec3 { 0.0f }) {
+				min_dot = std::min(min_dot, glm::dot(normal, meshlet.cone_axis));
+			}
+		}
+		meshlet.cone_cutoff = min_dot <= 0.0f ? 1.0f : std::sqrt(1.0f - min_dot * min_dot);
+	}
+
+	std::vector<Meshlet> MeshletBuilder::build(std::span<const Vertex> vertices, std::span<Index> indices)
+	{
+		std::vector<Meshlet> meshlets;
+		const auto triangle_count = static_cast<std::uint32_t>(indices.size() / 3);
+		if (triangle_count == 0) {
+			return meshlets;
+		}
+
+		const VertexTriangles adjacency { indices, vertices.size() };
+		std::vector<glm::vec3> normals(triangle_count);
+		for (std::uint32_t triangle = 0; triangle < triangle_count; triangle++) {
+			normals[triangle] = triangle_normal(vertices, indices, triangle);
+		}
+
+		// Both are stamped with the meshlet being built, which saves clearing them for every meshlet.
+		std::vector<std::uint32_t> vertex_meshlet(vertices.size(), none);
+		std::vector<std::uint32_t> candidate_meshlet(triangle_count, none);
+		std::vector<bool> emitted(triangle_count, false);
+		std::vector<std::uint32_t> candidates;
+		std::vector<Index> output;
+		output.reserve(indices.size());
+		std::uint32_t cursor { 0 };
+
+		Meshlet meshlet;
+		glm::vec3 normal_sum { 0.0f };
+		const auto current = [&meshlets]() { return static_cast<std::uint32_t>(meshlets.size()); };
+
+		const auto new_vertices = [&](std::uint32_t triangle) {
+			std::uint32_t count { 0 };
+			for (std::size_t corner = 0; corner < 3; corner++) {
+				count += vertex_meshlet[indices[3 * triangle + corner]] != current() ? 1 : 0;
+			}
+			return count;
+		};
+
+		const auto add = [&](std::uint32_t triangle) {
+			emitted[triangle] = true;
+			normal_sum += normals[triangle];
+			meshlet.triangle_count++;
+			for (std::size_t corner = 0; corner < 3; corner++) {
+				const auto vertex = indices[3 * triangle + corner];
+				output.push_back(vertex);
+				if (vertex_meshlet[vertex] == current()) {
+					continue;
+				}
+				vertex_meshlet[vertex] = current();
+				meshlet.vertex_count++;
+				for (const auto neighbour : adjacency.around(vertex)) {
+					if (!emitted[neighbour] && candidate_meshlet[neighbour] != current()) {
+						candidate_meshlet[neighbour] = current();
+						candidates.push_back(neighbour);
+					}
+				}
+			}
+		};
+
+		const auto finish = [&]() {
+			fit_bounds(meshlet, vertices, output);
+			meshlets.push_back(meshlet);
+			meshlet = Meshlet { .first_index = static_cast<std::uint32_t>(output.size()) };
+			normal_sum = glm::vec3 { 0.0f };
+			candidates.clear();
+		};
+
+		while (true) {
+			auto best = none;
+			auto best_cost = std::numeric_limits<float>::max();
+			const auto length = glm::length(normal_sum);
+			const auto axis = length > 0.0f ? normal_sum / length : glm::vec3 { 0.0f };
+			std::erase_if(candidates, [&emitted](std::uint32_t triangle) { return emitted[triangle]; });
+			for (const auto triangle : candidates) {
+				const auto added = new_vertices(triangle);
+				if (meshlet.vertex_count + added > max_vertices) {
+					continue;
+				}
+				const auto cost = static_cast<float>(added) + cone_weight * (1.0f - glm::dot(normals[triangle], axis));
+				if (cost < best_cost) {
+					best_cost = cost;
+					best = triangle;
+				}
+			}
+
+			// Without a neighbour that fits, the next triangle in index order is taken, which the vertex cache order keeps close by.
+			if (best == none) {
+				while (cursor < triangle_count && emitted[cursor]) {
+					cursor++;
+				}
+				if (cursor == triangle_count) {
+					break;
+				}
+				if (meshlet.vertex_count + new_vertices(cursor) > max_vertices) {
+					finish();
+					continue;
+				}
+				best = cursor;
+			}
+
+			add(best);
+			if (meshlet.triangle_count == max_triangles) {
+				finish();
+			}
+		}
+		if (meshlet.triangle_count > 0) {
+			finish();
+		}
+
+		std::copy(output.begin(), output.end(), indices.begin());
+		return meshlets;
+	}
+
+	MeshletStatistics MeshletBuilder::analyse(std::span<const Meshlet> meshlets)
+	{
+		if (meshlets.empty()) {
+			return {};
+		}
+
+		MeshletStatistics statistics;
+		std::size_t cullable { 0 };
+		for (const auto& meshlet : meshlets) {
+			statistics.triangles_per_meshlet += static_cast<float>(meshlet.triangle_count);
+			statistics.vertices_per_meshlet += static_cast<float>(meshlet.vertex_count);
+			statistics.average_cone_cutoff += meshlet.cone_cutoff;
+			cullable += meshlet.cone_cutoff < 1.0f ? 1 : 0;
+		}
+
+		const auto count = static_cast<float>(meshlets.size());
+		statistics.triangles_per_meshlet /= count;
+		statistics.vertices_per_meshlet /= count;
+		statistics.average_cone_cutoff /= count;
+		statistics.cullable_ratio = static_cast<float>(cullable) / count;
+		return statistics;
+	}
+
+} // namespace Alabaster
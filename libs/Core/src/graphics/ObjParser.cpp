@@ -0,0 +1,358 @@
+#include "av_pch.hpp"
+
+#include "graphics/ObjParser.hpp"
+
+#include "core/Logger.hpp"
+#include "filesystem/FileSystem.hpp"
+#include "utilities/JobSystem.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace Alabaster {
+
+	/// @brief A corner with negative indices, which count back from the attributes defined before its line. Other chunks may define
+	/// some of those, so they are resolved once the chunk offsets are known.
+	struct RelativeCorner {
+		std::uint32_t corner;
+		std::uint8_t components;
+	};
+
+	static constexpr std::uint8_t relative_position = 1;
+	static constexpr std::uint8_t relative_normal = 2;
+	static constexpr std::uint8_t relative_texcoord = 4;
+
+	struct ObjChunk {
+		std::string_view text;
+
+		std::vector<float> positions;
+		std::vector<float> normals;
+		std::vector<float> texcoords;
+		std::vector<ObjIndex> corners;
+		std::vector<std::uint32_t> face_sizes;
+		std::vector<RelativeCorner> relative_corners;
+
+		std::size_t line_count { 0 };
+		std::size_t triangle_count { 0 };
+		/// @brief Line within the chunk that could not be parsed, one based.
+		std::size_t error_line { 0 };
+		bool invalid_index { false };
+
+		std::size_t first_line { 0 };
+		std::size_t position_offset { 0 };
+		std::size_t normal_offset { 0 };
+		std::size_t texcoord_offset { 0 };
+		std::size_t triangle_offset { 0 };
+	};
+
+	static const char* skip_spaces(const char* at, const char* end)
+	{
+		while (at != end && (*at == ' ' || *at == '\t')) {
+			at++;
+		}
+		return at;
+	}
+
+	static bool parse_float(const char*& at, const char* end, float& value)
+	{
+		at = skip_spaces(at, end);
+		if (at != end && *at == '+') {
+			at++;
+		}
+
+		// Values too small for a float come back as out of range, they are read as zero like denormals would be.
+		value = 0.0f;
+		const auto [next, error] = std::from_chars(at, end, value);
+		if (error == std::errc::invalid_argument) {
+			return false;
+		}
+		at = next;
+		return true;
+	}
+
+	static bool parse_floats(const char* at, const char* end, std::vector<float>& output, std::size_t required, std::size_t count)
+	{
+		for (std::size_t i = 0; i < count; i++) {
+			float value;
+			if (!parse_float(at, end, value)) {
+				if (i < required) {
+					return false;
+				}
+				value = 0.0f;
+			}
+			output.push_back(value);
+		}
+		return true;
+	}
+
+	/// @brief Reads a one based index, negative ones relative to the attribute count so far, and stores it zero based.
+	/// @return false if the index is missing or zero
+	static bool parse_index(const char*& at, const char* end, std::size_t count, std::int32_t& index, bool& relative)
+	{
+		std::int32_t value { 0 };
+		const auto [next, error] = std::from_chars(at, end, value);
+		if (error != std::errc {} || value == 0) {
+			return false;
+		}
+
+		at = next;
+		relative = value < 0;
+		index = relative ? static_cast<std::int32_t>(count) + value : value - 1;
+		return true;
+	}
+
+	static bool parse_face(const char* at, const char* end, ObjChunk& chunk)
+	{
+		const auto first_corner = chunk.corners.size();
+		while (true) {
+			at = skip_spaces(at, end);
+			if (at == end) {
+				break;
+			}
+
+			ObjIndex corner;
+			std::uint8_t relative_components { 0 };
+			bool relative { false };
+			if (!parse_index(at, end, chunk.positions.size() / 3, corner.position, relative)) {
+				return false;
+			}
+			relative_components |= relative ? relative_position : 0;
+
+			if (at != end && *at == '/') {
+				at++;
+				if (at != end && *at != '/') {
+					if (!parse_index(at, end, chunk.texcoords.size() / 2, corner.texcoord, relative)) {
+						return false;
+					}
+					relative_components |= relative ? relative_texcoord : 0;
+				}
+				if (at != end && *at == '/') {
+					at++;
+					if (!parse_index(at, end, chunk.normals.size() / 3, corner.normal, relative)) {
+						return false;
+					}
+					relative_components |= relative ? relative_normal : 0;
+				}
+			}
+
+			if (at != end && *at != ' ' && *at != '\t') {
+				return false;
+			}
+			if (relative_components != 0) {
+				chunk.relative_corners.push_back({ static_cast<std::uint32_t>(chunk.corners.size()), relative_components });
+			}
+			chunk.corners.push_back(corner);
+		}
+
+		const auto corner_count = chunk.corners.size() - first_corner;
+		if (corner_count < 3) {
+			// Points and lines written as faces have nothing to draw.
+			while (!chunk.relative_corners.empty() && chunk.relative_corners.back().corner >= first_corner) {
+				chunk.relative_corners.pop_back();
+			}
+			chunk.corners.resize(first_corner);
+			return true;
+		}
+
+		chunk.face_sizes.push_back(static_cast<std::uint32_t>(corner_count));
+		chunk.triangle_count += corner_count - 2;
+		return true;
+	}
+
+	static bool parse_line(std::string_view line, ObjChunk& chunk)
+	{
+		const auto* end = line.data() + line.size();
+		const auto* at = skip_spaces(line.data(), end);
+		if (at == end || *at == '#') {
+			return true;
+		}
+
+		const auto* keyword_end = at;
+		while (keyword_end != end && *keyword_end != ' ' && *keyword_end != '\t') {
+			keyword_end++;
+		}
+
+		// Groups, objects, smoothing groups and materials do not change the geometry.
+		const std::string_view keyword { at, static_cast<std::size_t>(keyword_end - at) };
+		if (keyword == "v") {
+			return parse_floats(keyword_end, end, chunk.positions, 3, 3);
+		}
+		if (keyword == "vn") {
+			return parse_floats(keyword_end, end, chunk.normals, 3, 3);
+		}
+		if (keyword == "vt") {
+			return parse_floats(keyword_end, end, chunk.texcoords, 1, 2);
+		}
+		if (keyword == "f") {
+			return parse_face(keyword_end, end, chunk);
+		}
+		return true;
+	}
+
+	static void parse_chunk(ObjChunk& chunk)
+	{
+		auto remaining = chunk.text;
+		while (!remaining.empty()) {
+			const auto newline = remaining.find('\n');
+			auto line = remaining.substr(0, newline);
+			remaining.remove_prefix(newline == std::string_view::npos ? remaining.size() : newline + 1);
+			if (!line.empty() && line.back() == '\r') {
+				line.remove_suffix(1);
+			}
+
+			chunk.line_count++;
+			if (!parse_line(line, chunk)) {
+				chunk.error_line = chunk.line_count;
+				return;
+			}
+		}
+	}
+
+	/// @brief Moves a chunk into place, resolving its relative indices against the attributes of the chunks before it.
+	static void place_chunk(ObjChunk& chunk, ObjModel& model)
+	{
+		std::copy(chunk.positions.begin(), chunk.positions.end(), model.positions.begin() + static_cast<std::ptrdiff_t>(3 * chunk.position_offset));
+		std::copy(chunk.normals.begin(), chunk.normals.end(), model.normals.begin() + static_cast<std::ptrdiff_t>(3 * chunk.normal_offset));
+		std::copy(chunk.texcoords.begin(), chunk.texcoords.end(), model.texcoords.begin() + static_cast<std::ptrdiff_t>(2 * chunk.texcoord_offset));
+
+		for (const auto& [corner_index, components] : chunk.relative_corners) {
+			auto& corner = chunk.corners[corner_index];
+			const auto resolve = [&chunk](std::int32_t& index, std::size_t offset) {
+				index += static_cast<std::int32_t>(offset);
+				chunk.invalid_index |= index < 0;
+			};
+			if (components & relative_position) {
+				resolve(corner.position, chunk.position_offset);
+			}
+			if (components & relative_normal) {
+				resolve(corner.normal, chunk.normal_offset);
+			}
+			if (components & relative_texcoord) {
+				resolve(corner.texcoord, chunk.texcoord_offset);
+			}
+		}
+	}
+
+	/// @brief Writes the triangles of a chunk. Quads are split along their shorter diagonal like tinyobjloader does, which needs the
+	/// positions of every chunk in place.
+	static void triangulate_chunk(ObjChunk& chunk, ObjModel& model)
+	{
+		const auto position_count = static_cast<std::int32_t>(model.positions.size() / 3);
+		const auto normal_count = static_cast<std::int32_t>(model.normals.size() / 3);
+		const auto texcoord_count = static_cast<std::int32_t>(model.texcoords.size() / 2);
+		for (const auto& corner : chunk.corners) {
+			chunk.invalid_index |= corner.position < 0 || corner.position >= position_count || corner.normal >= normal_count
+				|| corner.texcoord >= texcoord_count;
+		}
+		if (chunk.invalid_index) {
+			return;
+		}
+
+		const auto squared_distance = [&model](const ObjIndex& a, const ObjIndex& b) {
+			const auto* from = model.positions.data() + 3 * a.position;
+			const auto* to = model.positions.data() + 3 * b.position;
+			const auto x = to[0] - from[0];
+			const auto y = to[1] - from[1];
+			const auto z = to[2] - from[2];
+			return x * x + y * y + z * z;
+		};
+
+		auto output = model.indices.begin() + static_cast<std::ptrdiff_t>(3 * chunk.triangle_offset);
+		const auto emit = [&output](const ObjIndex& a, const ObjIndex& b, const ObjIndex& c) {
+			*output++ = a;
+			*output++ = b;
+			*output++ = c;
+		};
+
+		const auto* corner = chunk.corners.data();
+		for (const auto face_size : chunk.face_sizes) {
+			if (face_size == 4) {
+				if (squared_distance(corner[0], corner[2]) < squared_distance(corner[1], corner[3])) {
+					emit(corner[0], corner[1], corner[2]);
+					emit(corner[0], corner[2], corner[3]);
+				} else {
+					emit(corner[0], corner[1], corner[3]);
+					emit(corner[1], corner[2], corner[3]);
+				}
+			} else {
+				for (std::uint32_t i = 1; i + 1 < face_size; i++) {
+					emit(corner[0], corner[i], corner[i + 1]);
+				}
+			}
+			corner += face_size;
+		}
+	}
+
+	std::optional<ObjModel> ObjParser::parse(std::string_view text, std::size_t chunk_size)
+	{
+		std::vector<ObjChunk> chunks;
+		chunk_size = std::max<std::size_t>(chunk_size, 1);
+		for (std::size_t begin = 0; begin < text.size();) {
+			auto end = begin + chunk_size;
+			if (end >= text.size()) {
+				end = text.size();
+			} else {
+				const auto newline = text.find('\n', end - 1);
+				end = newline == std::string_view::npos ? text.size() : newline + 1;
+			}
+			chunks.emplace_back().text = text.substr(begin, end - begin);
+			begin = end;
+		}
+
+		auto& jobs = AssetManager::JobSystem::the();
+		jobs.parallel_for(0, chunks.size(), 1, [&chunks](std::size_t index) { parse_chunk(chunks[index]); });
+
+		ObjModel model;
+		std::size_t position_count { 0 };
+		std::size_t normal_count { 0 };
+		std::size_t texcoord_count { 0 };
+		std::size_t triangle_count { 0 };
+		std::size_t line_count { 0 };
+		for (auto& chunk : chunks) {
+			if (chunk.error_line != 0) {
+				Log::error("[ObjParser] Could not parse line {}.", line_count + chunk.error_line);
+				return {};
+			}
+
+			chunk.first_line = line_count;
+			chunk.position_offset = position_count;
+			chunk.normal_offset = normal_count;
+			chunk.texcoord_offset = texcoord_count;
+			chunk.triangle_offset = triangle_count;
+			line_count += chunk.line_count;
+			position_count += chunk.positions.size() / 3;
+			normal_count += chunk.normals.size() / 3;
+			texcoord_count += chunk.texcoords.size() / 2;
+			triangle_count += chunk.triangle_count;
+		}
+
+		model.positions.resize(3 * position_count);
+		model.normals.resize(3 * normal_count);
+		model.texcoords.resize(2 * texcoord_count);
+		model.indices.resize(3 * triangle_count);
+
+		jobs.parallel_for(0, chunks.size(), 1, [&chunks, &model](std::size_t index) { place_chunk(chunks[index], model); });
+		jobs.parallel_for(0, chunks.size(), 1, [&chunks, &model](std::size_t index) { triangulate_chunk(chunks[index], model); });
+
+		for (const auto& chunk : chunks) {
+			if (chunk.invalid_index) {
+				Log::error("[ObjParser] A face between lines {} and {} references an attribute that does not exist.", chunk.first_line + 1,
+					chunk.first_line + chunk.line_count);
+				return {};
+			}
+		}
+		return model;
+	}
+
+	std::optional<ObjModel> ObjParser::read(const std::filesystem::path& path)
+	{
+		const auto file = FileSystem::read(path);
+		if (!file) {
+			Log::error("[ObjParser] Could not read {}.", path.string());
+			return {};
+		}
+		return parse(file->text());
+	}
+
+} // namespace Alabaster
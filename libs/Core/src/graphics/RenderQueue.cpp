@@ -3,13 +3,26 @@
 #include "graphics/RenderQueue.hpp"
 
 #include "core/CPUProfiler.hpp"
+#include "core/Common.hpp"
 #include "core/Logger.hpp"
 
+#include <cstddef>
+#include <new>
+
 namespace Alabaster {
 
 	static constexpr auto buffer_size = 10 * 1024 * 1024;
 	using byte = unsigned char;
 
+	static constexpr std::uint32_t align_up(std::size_t size)
+	{
+		constexpr auto alignment = alignof(std::max_align_t);
+		return static_cast<std::uint32_t>((size + alignment - 1) & ~(alignment - 1));
+	}
+
+	// Each command is [function | payload size | padding] followed by the payload, so the function object and payload stay aligned.
+	static constexpr auto header_size = align_up(sizeof(RenderQueue::RenderFunction) + sizeof(std::uint32_t));
+
 	RenderQueue::RenderQueue()
 	{
 		command_buffer = new uint8_t[buffer_size];
@@ -21,14 +34,14 @@ namespace Alabaster {
 
 	void* RenderQueue::allocate(RenderFunction func, BufferCount size)
 	{
-		*(RenderFunction*)command_buffer_ptr = func;
-		command_buffer_ptr += sizeof(RenderFunction);
+		const auto command_size = header_size + align_up(size);
+		verify(command_buffer_ptr + command_size <= command_buffer + buffer_size, "[RenderQueue] Out of command memory.");
 
-		*(BufferCount*)command_buffer_ptr = size;
-		command_buffer_ptr += sizeof(BufferCount);
+		new (command_buffer_ptr) RenderFunction(std::move(func));
+		*reinterpret_cast<BufferCount*>(command_buffer_ptr + sizeof(RenderFunction)) = size;
 
-		void* memory = command_buffer_ptr;
-		command_buffer_ptr += size;
+		void* memory = command_buffer_ptr + header_size;
+		command_buffer_ptr += command_size;
 
 		command_count++;
 		return memory;
@@ -36,19 +49,22 @@ namespace Alabaster {
 
 	void RenderQueue::execute()
 	{
+		if (command_count == 0) {
+			return;
+		}
+
 		Log::debug("[RenderQueue] -- [{0} command(s): {1} bytes]", command_count, (command_buffer_ptr - command_buffer));
 
 		CPUProfiler profiler("RenderQueue-execute");
 		byte* buffer = command_buffer;
 
 		for (std::uint32_t i = 0; i < command_count; i++) {
-			RenderFunction function = *(RenderFunction*)buffer;
-			buffer += sizeof(RenderFunction);
+			auto* function = std::launder(reinterpret_cast<RenderFunction*>(buffer));
+			const auto size = *reinterpret_cast<BufferCount*>(buffer + sizeof(RenderFunction));
 
-			BufferCount size = *(BufferCount*)buffer;
-			buffer += sizeof(BufferCount);
-			function(buffer);
-			buffer += size;
+			(*function)(buffer + header_size);
+			function->~RenderFunction();
+			buffer += header_size + align_up(size);
 		}
 
 		command_buffer_ptr = command_buffer;
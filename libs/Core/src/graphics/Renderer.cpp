@@ -14,7 +14,7 @@ namespace Alabaster {
 	};
 	template <class... Fs> Overload(Fs...) -> Overload<Fs...>;
 
-	static RenderQueue global_release_queues[3];
+	static std::vector<std::unique_ptr<RenderQueue>> global_release_queues;
 
 	static bool frame_started { false };
 
@@ -24,7 +24,30 @@ namespace Alabaster {
 		return render_queue;
 	}
 
-	RenderQueue& Renderer::resource_release_queue(std::uint32_t index) { return global_release_queues[index]; }
+	RenderQueue& Renderer::resource_release_queue(std::uint32_t index)
+	{
+		if (index >= global_release_queues.size()) {
+			global_release_queues.resize(index + 1);
+		}
+
+		auto& queue = global_release_queues[index];
+		if (!queue) {
+			queue = std::make_unique<RenderQueue>();
+		}
+		return *queue;
+	}
+
+	void Renderer::submit_resource_free(std::function<void()>&& func)
+	{
+		resource_release_queue(current_frame()).allocate([free = std::move(func)](void*) { free(); }, 0);
+	}
+
+	void Renderer::release_resources(std::uint32_t frame)
+	{
+		if (frame < global_release_queues.size() && global_release_queues[frame]) {
+			global_release_queues[frame]->execute();
+		}
+	}
 
 	void Renderer::begin()
 	{
@@ -170,6 +193,16 @@ namespace Alabaster {
 
 	void Renderer::init() { Log::info("[Renderer] Initialisation of renderer."); }
 
-	void Renderer::shutdown() { Log::info("[Renderer] Destruction of renderer."); }
+	void Renderer::shutdown()
+	{
+		for (const auto& queue : global_release_queues) {
+			if (queue) {
+				queue->execute();
+			}
+		}
+		global_release_queues.clear();
+
+		Log::info("[Renderer] Destruction of renderer.");
+	}
 
 } // namespace Alabaster
@@ -0,0 +1,59 @@
+#include "av_pch.hpp"
+
+#include "graphics/ShaderReflection.hpp"
+
+#include "utilities/Hash.hpp"
+
+#include <algorithm>
+
+namespace Alabaster {
+
+	void ShaderReflection::merge(const ShaderReflection& other)
+	{
+		for (const auto& incoming : other.bindings) {
+			const auto existing = std::ranges::find_if(bindings,
+				[&incoming](const DescriptorBinding& binding) { return binding.set == incoming.set && binding.binding == incoming.binding; });
+			if (existing == bindings.end()) {
+				bindings.push_back(incoming);
+				continue;
+			}
+
+			existing->stages |= incoming.stages;
+			existing->count = std::max(existing->count, incoming.count);
+		}
+		std::ranges::sort(bindings, [](const DescriptorBinding& left, const DescriptorBinding& right) {
+			return left.set != right.set ? left.set < right.set : left.binding < right.binding;
+		});
+
+		for (const auto& incoming : other.push_constants) {
+			const auto existing = std::ranges::find_if(push_constants,
+				[&incoming](const PushConstantBlock& block) { return block.offset == incoming.offset && block.size == incoming.size; });
+			if (existing == push_constants.end()) {
+				push_constants.push_back(incoming);
+			} else {
+				existing->stages |= incoming.stages;
+			}
+		}
+	}
+
+	std::uint32_t ShaderReflection::set_count() const { return bindings.empty() ? 0 : bindings.back().set + 1; }
+
+	std::span<const DescriptorBinding> ShaderReflection::set(std::uint32_t index) const
+	{
+		const auto [first, last] = std::ranges::equal_range(bindings, index, {}, &DescriptorBinding::set);
+		return { first, last };
+	}
+
+	std::uint64_t hash_bindings(std::span<const DescriptorBinding> bindings)
+	{
+		auto output = Hash::default_seed;
+		for (const auto& binding : bindings) {
+			output = Hash::combine(output, binding.binding);
+			output = Hash::combine(output, static_cast<std::uint64_t>(binding.type));
+			output = Hash::combine(output, binding.count);
+			output = Hash::combine(output, binding.stages);
+		}
+		return output;
+	}
+
+} // namespace Alabaster
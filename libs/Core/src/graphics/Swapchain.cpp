@@ -4,6 +4,7 @@
 
 #include "core/Common.hpp"
 #include "graphics/GraphicsContext.hpp"
+#include "graphics/Renderer.hpp"
 #include "platform/Vulkan/ImageUtilities.hpp"
 
 #include <GLFW/glfw3.h>
@@ -422,6 +423,9 @@ namespace Alabaster {
 			current_buffer_index = (current_buffer_index + 1) % image_count;
 			vk_check(vkWaitForFences(device, 1, &wait_fences[current_buffer_index], VK_TRUE, UINT64_MAX));
 		}
+
+		// The fence covers every earlier submission, so resources retired while this frame was current are no longer in use.
+		Renderer::release_resources(current_buffer_index);
 	}
 
 	uint32_t Swapchain::acquire_next_image()
@@ -0,0 +1,176 @@
+#include "av_pch.hpp"
+
+#include "graphics/VertexPacker.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace Alabaster {
+
+	static constexpr float snorm_max = 32767.0f;
+	static constexpr float unorm_max = 65535.0f;
+	/// @brief The tangent's last component gives up its lowest bit to the bitangent sign, so it is quantised to even values.
+	static constexpr float sign_carrier_max = 16383.0f;
+
+	VertexBufferLayout VertexFormat::layout() const
+	{
+		using enum ShaderDataType;
+
+		if (encoding == VertexEncoding::Full) {
+			return VertexBufferLayout { VertexBufferElement(Float3, "position"), VertexBufferElement(Float4, "colour"),
+				VertexBufferElement(Float3, "normal"), VertexBufferElement(Float3, "tangent"), VertexBufferElement(Float3, "bitangent"),
+				VertexBufferElement(Float2, "uvs") };
+		}
+
+		const auto position
+			= encoding == VertexEncoding::Quantised ? VertexBufferElement(UShort4, "position", true) : VertexBufferElement(Float3, "position");
+		const auto frame = VertexBufferElement(Short4, "frame", true);
+		const auto uvs = VertexBufferElement(Half2, "uvs");
+		if (colour) {
+			return VertexBufferLayout { position, frame, uvs, VertexBufferElement(UByte4, "colour", true) };
+		}
+		return VertexBufferLayout { position, frame, uvs };
+	}
+
+	std::vector<std::string> VertexFormat::keywords() const
+	{
+		// Quantised positions are read as unorms and dequantised by the object transform, so they share the compact variant.
+		if (encoding == VertexEncoding::Full) {
+			return {};
+		}
+		if (colour) {
+			return { "COMPACT_VERTICES", "VERTEX_COLOUR" };
+		}
+		return { "COMPACT_VERTICES" };
+	}
+
+	static float sign_not_zero(float value) { return value >= 0.0f ? 1.0f : -1.0f; }
+
+	glm::vec2 VertexPacker::encode_octahedral(const glm::vec3& direction)
+	{
+		const auto l1 = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+		if (l1 == 0.0f) {
+			return { 0.0f, 0.0f };
+		}
+
+		const glm::vec2 projected { direction.x / l1, direction.y / l1 };
+		if (direction.z >= 0.0f) {
+			return projected;
+		}
+		// The lower half is folded over the diagonals onto the corners of the square.
+		return { (1.0f - std::abs(projected.y)) * sign_not_zero(projected.x), (1.0f - std::abs(projected.x)) * sign_not_zero(projected.y) };
+	}
+
+	glm::vec3 VertexPacker::decode_octahedral(const glm::vec2& encoded)
+	{
+		glm::vec3 direction { encoded.x, encoded.y, 1.0f - std::abs(encoded.x) - std::abs(encoded.y) };
+		const auto fold = std::max(-direction.z, 0.0f);
+		direction.x -= fold * sign_not_zero(direction.x);
+		direction.y -= fold * sign_not_zero(direction.y);
+		return glm::normalize(direction);
+	}
+
+	static std::int16_t to_snorm(float value) { return static_cast<std::int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * snorm_max)); }
+
+	static float from_snorm(std::int16_t value) { return std::max(static_cast<float>(value) / snorm_max, -1.0f); }
+
+	static std::uint16_t to_unorm(float value) { return static_cast<std::uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * unorm_max)); }
+
+	/// @brief Writes one attribute at the cursor and moves past it.
+	template <typename T> static void write(std::uint8_t*& cursor, const T& value)
+	{
+		std::memcpy(cursor, &value, sizeof(T));
+		cursor += sizeof(T);
+	}
+
+	template <typename T> static T read(const std::uint8_t*& cursor)
+	{
+		T value;
+		std::memcpy(&value, cursor, sizeof(T));
+		cursor += sizeof(T);
+		return value;
+	}
+
+	PackedVertices VertexPacker::pack(std::span<const Vertex> vertices, const MeshBounds& bounds, VertexEncoding encoding)
+	{
+		PackedVertices packed;
+		packed.format.encoding = encoding;
+		if (encoding == VertexEncoding::Full) {
+			packed.data.resize(vertices.size_bytes());
+			std::memcpy(packed.data.data(), vertices.data(), vertices.size_bytes());
+			return packed;
+		}
+
+		if (!vertices.empty()) {
+			const auto& first = vertices.front().colour;
+			packed.format.colour = std::ranges::any_of(vertices, [&first](const Vertex& vertex) { return vertex.colour != first; });
+			packed.constant_colour = packed.format.colour ? packed.constant_colour : first;
+		}
+
+		if (encoding == VertexEncoding::Quantised) {
+			const auto extent = bounds.max - bounds.min;
+			packed.position_origin = bounds.min;
+			packed.position_scale = std::max({ extent.x, extent.y, extent.z });
+			packed.position_scale = packed.position_scale > 0.0f ? packed.position_scale : 1.0f;
+		}
+
+		const auto stride = packed.format.stride();
+		packed.data.resize(vertices.size() * stride);
+		auto* cursor = packed.data.data();
+		for (const auto& vertex : vertices) {
+			if (encoding == VertexEncoding::Quantised) {
+				const auto position = (vertex.position - packed.position_origin) / packed.position_scale;
+				write(cursor, std::array<std::uint16_t, 4> { to_unorm(position.x), to_unorm(position.y), to_unorm(position.z), 0 });
+			} else {
+				write(cursor, vertex.position);
+			}
+
+			const auto normal = encode_octahedral(vertex.normal);
+			const auto tangent = encode_octahedral(vertex.tangent);
+			const bool flipped = glm::dot(glm::cross(vertex.normal, vertex.tangent), vertex.bitangent) < 0.0f;
+			const auto tangent_y = 2 * std::lround(std::clamp(tangent.y, -1.0f, 1.0f) * sign_carrier_max) + (flipped ? 1 : 0);
+			write(cursor,
+				std::array<std::int16_t, 4> { to_snorm(normal.x), to_snorm(normal.y), to_snorm(tangent.x), static_cast<std::int16_t>(tangent_y) });
+
+			write(cursor, glm::packHalf2x16(vertex.uv));
+			if (packed.format.colour) {
+				write(cursor, glm::packUnorm4x8(vertex.colour));
+			}
+		}
+		return packed;
+	}
+
+	Vertex VertexPacker::unpack(const PackedVertices& packed, std::size_t index)
+	{
+		const auto& format = packed.format;
+		const auto stride = format.stride();
+		if (format.encoding == VertexEncoding::Full) {
+			Vertex vertex;
+			std::memcpy(&vertex, packed.data.data() + index * stride, sizeof(Vertex));
+			return vertex;
+		}
+
+		const auto* cursor = packed.data.data() + index * stride;
+		Vertex vertex {};
+		if (format.encoding == VertexEncoding::Quantised) {
+			const auto position = read<std::array<std::uint16_t, 4>>(cursor);
+			const glm::vec3 normalised { position[0] / unorm_max, position[1] / unorm_max, position[2] / unorm_max };
+			vertex.position = packed.position_origin + packed.position_scale * normalised;
+		} else {
+			vertex.position = read<glm::vec3>(cursor);
+		}
+
+		const auto frame = read<std::array<std::int16_t, 4>>(cursor);
+		const auto flipped = (frame[3] & 1) != 0;
+		vertex.normal = decode_octahedral({ from_snorm(frame[0]), from_snorm(frame[1]) });
+		vertex.tangent = decode_octahedral({ from_snorm(frame[2]), static_cast<float>(frame[3] - (frame[3] & 1)) / (2.0f * sign_carrier_max) });
+		vertex.bitangent = (flipped ? -1.0f : 1.0f) * glm::cross(vertex.normal, vertex.tangent);
+
+		vertex.uv = glm::unpackHalf2x16(read<std::uint32_t>(cursor));
+		vertex.colour = format.colour ? glm::unpackUnorm4x8(read<std::uint32_t>(cursor)) : packed.constant_colour;
+		return vertex;
+	}
+
+} // namespace Alabaster
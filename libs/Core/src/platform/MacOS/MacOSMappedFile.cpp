@@ -0,0 +1,50 @@
+#include "av_pch.hpp"
+
+#include "filesystem/MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Alabaster {
+
+	std::optional<MappedFile> MappedFile::open(const std::filesystem::path& path)
+	{
+		const auto descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (descriptor < 0) {
+			return {};
+		}
+
+		struct stat status { };
+		if (::fstat(descriptor, &status) != 0 || !S_ISREG(status.st_mode)) {
+			::close(descriptor);
+			return {};
+		}
+
+		MappedFile file;
+		file.size = static_cast<std::size_t>(status.st_size);
+		if (file.size > 0) {
+			auto* mapping = ::mmap(nullptr, file.size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+			if (mapping == MAP_FAILED) {
+				::close(descriptor);
+				return {};
+			}
+			file.data = static_cast<const std::uint8_t*>(mapping);
+		}
+
+		// The mapping keeps the file alive on its own.
+		::close(descriptor);
+		return file;
+	}
+
+	void MappedFile::unmap()
+	{
+		if (data) {
+			::munmap(const_cast<std::uint8_t*>(data), size);
+		}
+		data = nullptr;
+		size = 0;
+	}
+
+} // namespace Alabaster
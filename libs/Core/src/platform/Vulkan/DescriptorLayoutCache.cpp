@@ -0,0 +1,111 @@
+#include "av_pch.hpp"
+
+#include "graphics/DescriptorLayoutCache.hpp"
+
+#include "core/Common.hpp"
+#include "core/Logger.hpp"
+#include "graphics/GraphicsContext.hpp"
+#include "utilities/Hash.hpp"
+
+#include <vulkan/vulkan.h>
+
+namespace Alabaster {
+
+	DescriptorLayoutCache& DescriptorLayoutCache::the()
+	{
+		static DescriptorLayoutCache cache;
+		return cache;
+	}
+
+	VkDescriptorSetLayout DescriptorLayoutCache::descriptor_set_layout(std::span<const DescriptorBinding> bindings)
+	{
+		const auto key = hash_bindings(bindings);
+
+		std::scoped_lock lock { mutex };
+		if (const auto found = set_layouts.find(key); found != set_layouts.end()) {
+			return found->second;
+		}
+
+		std::vector<VkDescriptorSetLayoutBinding> layout_bindings;
+		layout_bindings.reserve(bindings.size());
+		for (const auto& binding : bindings) {
+			VkDescriptorSetLayoutBinding layout_binding {};
+			layout_binding.binding = binding.binding;
+			layout_binding.descriptorType = static_cast<VkDescriptorType>(binding.type);
+			layout_binding.descriptorCount = binding.count;
+			layout_binding.stageFlags = binding.stages;
+			layout_binding.pImmutableSamplers = nullptr;
+			layout_bindings.push_back(layout_binding);
+		}
+
+		VkDescriptorSetLayoutCreateInfo create_info {};
+		create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		create_info.bindingCount = static_cast<std::uint32_t>(layout_bindings.size());
+		create_info.pBindings = layout_bindings.data();
+
+		VkDescriptorSetLayout layout;
+		vk_check(vkCreateDescriptorSetLayout(GraphicsContext::the().device(), &create_info, nullptr, &layout));
+		set_layouts.try_emplace(key, layout);
+		return layout;
+	}
+
+	std::vector<VkDescriptorSetLayout> DescriptorLayoutCache::descriptor_set_layouts(const ShaderReflection& reflection)
+	{
+		std::vector<VkDescriptorSetLayout> layouts;
+		const auto set_count = reflection.set_count();
+		layouts.reserve(set_count);
+		for (std::uint32_t set = 0; set < set_count; set++) {
+			layouts.push_back(descriptor_set_layout(reflection.set(set)));
+		}
+		return layouts;
+	}
+
+	VkPipelineLayout DescriptorLayoutCache::pipeline_layout(
+		std::span<const VkDescriptorSetLayout> layouts, std::span<const VkPushConstantRange> push_constants)
+	{
+		auto key = Hash::default_seed;
+		for (const auto& layout : layouts) {
+			key = Hash::combine(key, reinterpret_cast<std::uintptr_t>(layout));
+		}
+		for (const auto& range : push_constants) {
+			key = Hash::combine(key, range.offset);
+			key = Hash::combine(key, range.size);
+			key = Hash::combine(key, range.stageFlags);
+		}
+
+		std::scoped_lock lock { mutex };
+		if (const auto found = pipeline_layouts.find(key); found != pipeline_layouts.end()) {
+			return found->second;
+		}
+
+		VkPipelineLayoutCreateInfo create_info {};
+		create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		create_info.setLayoutCount = static_cast<std::uint32_t>(layouts.size());
+		create_info.pSetLayouts = layouts.data();
+		create_info.pushConstantRangeCount = static_cast<std::uint32_t>(push_constants.size());
+		create_info.pPushConstantRanges = push_constants.data();
+
+		VkPipelineLayout layout;
+		vk_check(vkCreatePipelineLayout(GraphicsContext::the().device(), &create_info, nullptr, &layout));
+		pipeline_layouts.try_emplace(key, layout);
+		return layout;
+	}
+
+	void DescriptorLayoutCache::destroy()
+	{
+		std::scoped_lock lock { mutex };
+		const auto& device = GraphicsContext::the().device();
+		for (const auto& [key, layout] : pipeline_layouts) {
+			vkDestroyPipelineLayout(device, layout, nullptr);
+		}
+		for (const auto& [key, layout] : set_layouts) {
+			vkDestroyDescriptorSetLayout(device, layout, nullptr);
+		}
+
+		Log::info("[DescriptorLayoutCache] Destroyed {} descriptor set layouts and {} pipeline layouts.", set_layouts.size(),
+			pipeline_layouts.size());
+		pipeline_layouts.clear();
+		set_layouts.clear();
+	}
+
+} // namespace Alabaster
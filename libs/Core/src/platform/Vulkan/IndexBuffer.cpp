@@ -9,6 +9,7 @@
 #include "graphics/GraphicsContext.hpp"
 #include "graphics/Renderer.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <vulkan/vulkan.h>
 
@@ -16,6 +17,20 @@ namespace Alabaster {
 
 	static constexpr auto debug_name = "IndexBuffer";
 
+	static constexpr std::uint32_t index_size(IndexType type) { return type == IndexType::UInt16 ? sizeof(std::uint16_t) : sizeof(std::uint32_t); }
+
+	std::shared_ptr<IndexBuffer> IndexBuffer::create(std::span<const Index> indices, std::size_t vertex_count)
+	{
+		const auto count = static_cast<std::uint32_t>(indices.size());
+		if (vertex_count >= max_uint16_vertices) {
+			return std::shared_ptr<IndexBuffer>(new IndexBuffer { indices.data(), count });
+		}
+
+		std::vector<std::uint16_t> narrowed(indices.size());
+		std::ranges::transform(indices, narrowed.begin(), [](Index index) { return static_cast<std::uint16_t>(index); });
+		return std::shared_ptr<IndexBuffer>(new IndexBuffer { narrowed.data(), count, IndexType::UInt16 });
+	}
+
 	IndexBuffer::IndexBuffer(std::uint32_t count)
 		: buffer_size(count * sizeof(std::uint32_t))
 		, buffer_count(count)
@@ -32,9 +47,10 @@ namespace Alabaster {
 		memory_allocation = allocator.allocate_buffer(buffer_create_info, Allocator::Usage::CPU_TO_GPU, vulkan_buffer, debug_name);
 	}
 
-	IndexBuffer::IndexBuffer(const void* data, std::uint32_t count)
-		: buffer_size(count * sizeof(std::uint32_t))
+	IndexBuffer::IndexBuffer(const void* data, std::uint32_t count, IndexType index_type)
+		: buffer_size(count * index_size(index_type))
 		, buffer_count(count)
+		, type(index_type)
 	{
 		index_data = Buffer::copy(data, buffer_size);
 		Allocator allocator("IndexBuffer");
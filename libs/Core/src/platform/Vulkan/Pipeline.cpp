@@ -5,18 +5,76 @@
 #include "core/Common.hpp"
 #include "core/Logger.hpp"
 #include "core/exceptions/AlabasterException.hpp"
+#include "graphics/DescriptorLayoutCache.hpp"
 #include "graphics/GraphicsContext.hpp"
+#include "graphics/PipelineCache.hpp"
 #include "graphics/Renderer.hpp"
 #include "graphics/Shader.hpp"
 #include "graphics/VertexBufferLayout.hpp"
+#include "utilities/Hash.hpp"
+#include "utilities/JobSystem.hpp"
 
+#include <bit>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
 #include <vulkan/vulkan.h>
 
 namespace Alabaster {
 
-	static VkFormat datatype_to_vulkan(ShaderDataType type)
+	/// @brief Live pipelines by the hash of their specification, so identical specifications share one VkPipeline.
+	struct PipelineRegistry {
+		std::mutex mutex;
+		std::unordered_map<std::uint64_t, std::weak_ptr<Pipeline>> pipelines;
+		PipelineStatistics statistics;
+	};
+
+	static PipelineRegistry& registry()
+	{
+		static PipelineRegistry pipeline_registry;
+		return pipeline_registry;
+	}
+
+	static std::uint64_t hash_layout(std::uint64_t seed, const VertexBufferLayout& layout)
+	{
+		seed = Hash::combine(seed, layout.get_stride());
+		for (const auto& element : layout) {
+			seed = Hash::combine(seed, static_cast<std::uint64_t>(element.shader_data_type));
+			seed = Hash::combine(seed, element.offset);
+			seed = Hash::combine(seed, element.normalised);
+		}
+		return seed;
+	}
+
+	std::uint64_t hash_specification(const PipelineSpecification& spec)
+	{
+		auto output = Hash::combine(Hash::default_seed, reinterpret_cast<std::uintptr_t>(spec.shader.get()));
+		output = Hash::combine(output, spec.shader_owned_by_pipeline);
+		output = Hash::combine(output, reinterpret_cast<std::uintptr_t>(spec.render_pass));
+		output = Hash::combine(output, spec.wireframe);
+		output = Hash::combine(output, spec.backface_culling);
+		output = Hash::combine(output, static_cast<std::uint64_t>(spec.topology));
+		output = Hash::combine(output, spec.depth_test);
+		output = Hash::combine(output, spec.depth_write);
+		output = hash_layout(output, spec.vertex_layout);
+		output = hash_layout(output, spec.instance_layout);
+		output = Hash::combine(output, spec.ranges.has_value());
+		if (spec.ranges) {
+			for (const auto& range : spec.ranges->get_input_ranges()) {
+				output = Hash::combine(output, range.size);
+				output = Hash::combine(output, static_cast<std::uint64_t>(range.flags));
+			}
+		}
+		for (const auto& layout : spec.descriptor_set_layouts) {
+			output = Hash::combine(output, reinterpret_cast<std::uintptr_t>(layout));
+		}
+		return Hash::combine(output, std::bit_cast<std::uint32_t>(spec.line_width));
+	}
+
+	static VkFormat datatype_to_vulkan(const VertexBufferElement& element)
 	{
-		switch (type) {
+		const auto normalised = element.normalised;
+		switch (element.shader_data_type) {
 		case ShaderDataType::Float:
 			return VK_FORMAT_R32_SFLOAT;
 		case ShaderDataType::Float2:
@@ -33,6 +91,14 @@ namespace Alabaster {
 			return VK_FORMAT_R32G32B32_SINT;
 		case ShaderDataType::Int4:
 			return VK_FORMAT_R32G32B32A32_SINT;
+		case ShaderDataType::Half2:
+			return VK_FORMAT_R16G16_SFLOAT;
+		case ShaderDataType::Short4:
+			return normalised ? VK_FORMAT_R16G16B16A16_SNORM : VK_FORMAT_R16G16B16A16_SINT;
+		case ShaderDataType::UShort4:
+			return normalised ? VK_FORMAT_R16G16B16A16_UNORM : VK_FORMAT_R16G16B16A16_UINT;
+		case ShaderDataType::UByte4:
+			return normalised ? VK_FORMAT_R8G8B8A8_UNORM : VK_FORMAT_R8G8B8A8_UINT;
 		default: {
 			Log::error("Unknown shader data type format.");
 			stop();
@@ -42,7 +108,91 @@ namespace Alabaster {
 		return VK_FORMAT_R32G32B32A32_SFLOAT;
 	}
 
+	/// @brief The rasteriser culls nothing yet, whatever the specification asks for.
+	// FIXME: Allow specifying cull mode.
+	static VkCullModeFlags cull_mode(const PipelineSpecification&) { return VK_CULL_MODE_NONE; }
+
+	std::shared_ptr<Pipeline> Pipeline::create(PipelineSpecification spec)
+	{
+		std::vector<PipelineSpecification> specs;
+		specs.push_back(std::move(spec));
+		return create(std::move(specs)).front();
+	}
+
+	std::vector<std::shared_ptr<Pipeline>> Pipeline::create(std::vector<PipelineSpecification> specs)
+	{
+		using Clock = std::chrono::steady_clock;
+		const auto start = Clock::now();
+		auto& shared = registry();
+
+		std::vector<std::shared_ptr<Pipeline>> output;
+		output.reserve(specs.size());
+		std::vector<std::shared_ptr<Pipeline>> to_build;
+		std::uint32_t reused { 0 };
+		{
+			std::scoped_lock lock { shared.mutex };
+			std::erase_if(shared.pipelines, [](const auto& entry) { return entry.second.expired(); });
+
+			for (auto& spec : specs) {
+				const auto key = hash_specification(spec);
+				if (auto existing = shared.pipelines[key].lock()) {
+					output.push_back(std::move(existing));
+					reused++;
+					continue;
+				}
+
+				auto pipeline = std::shared_ptr<Pipeline>(new Pipeline { std::move(spec) });
+				pipeline->key = key;
+				shared.pipelines[key] = pipeline;
+				output.push_back(pipeline);
+				to_build.push_back(std::move(pipeline));
+			}
+		}
+
+		// Drivers compile pipelines independently, the shared VkPipelineCache is internally synchronised.
+		AssetManager::JobSystem::the().parallel_for(0, to_build.size(), 1, [&to_build](std::size_t index) { to_build[index]->build(); });
+
+		const auto milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		{
+			std::scoped_lock lock { shared.mutex };
+			shared.statistics.created += static_cast<std::uint32_t>(to_build.size());
+			shared.statistics.reused += reused;
+			shared.statistics.last_build_milliseconds = milliseconds;
+			shared.statistics.total_build_milliseconds += milliseconds;
+		}
+		Log::info("[Pipeline] Built {} pipelines and reused {} in {:.2f}ms.", to_build.size(), reused, milliseconds);
+		return output;
+	}
+
+	PipelineStatistics Pipeline::statistics()
+	{
+		auto& shared = registry();
+		std::scoped_lock lock { shared.mutex };
+		return shared.statistics;
+	}
+
 	void Pipeline::invalidate()
+	{
+		if (pipeline) {
+			Renderer::submit_resource_free([device = GraphicsContext::the().device(), retired = std::exchange(pipeline, nullptr)]() {
+				vkDestroyPipeline(device, retired, nullptr);
+			});
+		}
+		build();
+
+		// The specification may have changed since the pipeline was registered.
+		auto& shared = registry();
+		std::scoped_lock lock { shared.mutex };
+		const auto found = shared.pipelines.find(key);
+		key = hash_specification(spec);
+		if (found != shared.pipelines.end() && found->second.lock().get() == this) {
+			auto self = std::move(found->second);
+			shared.pipelines.erase(found);
+			shared.pipelines.insert_or_assign(key, std::move(self));
+		}
+	}
+
+	void Pipeline::build()
 	{
 #ifdef ALABASTER_MACOS
 		spec.line_width = 1.0f;
@@ -51,18 +201,8 @@ namespace Alabaster {
 		const auto& device = GraphicsContext::the().device();
 		const auto& shader = spec.shader;
 
-		VkPipelineLayoutCreateInfo pipeline_layout_create_info = {};
-		pipeline_layout_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-		pipeline_layout_create_info.pNext = nullptr;
-
-		const auto& shader_descriptor_layout = shader->descriptor_set_layouts();
-		if (non_empty(shader_descriptor_layout)) {
-			pipeline_layout_create_info.setLayoutCount = static_cast<std::uint32_t>(shader_descriptor_layout.size());
-			pipeline_layout_create_info.pSetLayouts = shader_descriptor_layout.data();
-		} else {
-			pipeline_layout_create_info.setLayoutCount = static_cast<std::uint32_t>(spec.descriptor_set_layouts.size());
-			pipeline_layout_create_info.pSetLayouts = spec.descriptor_set_layouts.data();
-		}
+		// Layouts given in the specification describe sets shared with other pipelines, e.g. the one a renderer binds for all of its own.
+		const auto& set_layouts = non_empty(spec.descriptor_set_layouts) ? spec.descriptor_set_layouts : shader->descriptor_set_layouts();
 
 		std::vector<VkPushConstantRange> output_ranges;
 		if (spec.ranges) {
@@ -76,11 +216,13 @@ namespace Alabaster {
 				output_ranges.push_back(out);
 				offset += range.size;
 			}
-			pipeline_layout_create_info.pushConstantRangeCount = static_cast<std::uint32_t>(output_ranges.size());
-			pipeline_layout_create_info.pPushConstantRanges = output_ranges.data();
+		} else {
+			for (const auto& block : shader->get_reflection().push_constants) {
+				output_ranges.push_back(VkPushConstantRange { .stageFlags = block.stages, .offset = block.offset, .size = block.size });
+			}
 		}
 
-		vk_check(vkCreatePipelineLayout(device, &pipeline_layout_create_info, nullptr, &pipeline_layout));
+		pipeline_layout = DescriptorLayoutCache::the().pipeline_layout(set_layouts, output_ranges);
 
 		VkGraphicsPipelineCreateInfo pipeline_create_info = {};
 		pipeline_create_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
@@ -99,9 +241,7 @@ namespace Alabaster {
 		rasterisation_state.polygonMode = VK_POLYGON_MODE_FILL;
 
 		rasterisation_state.lineWidth = spec.line_width;
-		// FIXME: Allow specifying cull mode.
-		rasterisation_state.cullMode = spec.backface_culling ? VK_CULL_MODE_BACK_BIT : VK_CULL_MODE_FRONT_BIT;
-		rasterisation_state.cullMode = VK_CULL_MODE_NONE;
+		rasterisation_state.cullMode = cull_mode(spec);
 
 		rasterisation_state.frontFace = VK_FRONT_FACE_CLOCKWISE;
 		rasterisation_state.depthBiasEnable = VK_FALSE;
@@ -191,7 +331,7 @@ namespace Alabaster {
 				auto& attribute = vertex_input_attributes[location];
 				attribute.binding = binding;
 				attribute.location = location;
-				attribute.format = datatype_to_vulkan(element.shader_data_type);
+				attribute.format = datatype_to_vulkan(element);
 				attribute.offset = element.offset;
 				location++;
 			}
@@ -221,19 +361,8 @@ namespace Alabaster {
 		pipeline_create_info.renderPass = spec.render_pass;
 		pipeline_create_info.pDynamicState = &dynamic_state;
 
-		VkPipelineCacheCreateInfo pipeline_cache_info = {};
-		pipeline_cache_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
-		{
-			auto result = vkCreatePipelineCache(device, &pipeline_cache_info, nullptr, &pipeline_cache);
-			if (result != VK_SUCCESS) {
-				throw Alabaster::AlabasterException("Could not create pipeline cache.");
-			}
-		}
-		{
-			auto result = vkCreateGraphicsPipelines(device, pipeline_cache, 1, &pipeline_create_info, nullptr, &pipeline);
-			if (result != VK_SUCCESS) {
-				throw Alabaster::AlabasterException("Could not create pipeline.");
-			}
+		if (vkCreateGraphicsPipelines(device, PipelineCache::the().get(), 1, &pipeline_create_info, nullptr, &pipeline) != VK_SUCCESS) {
+			throw Alabaster::AlabasterException("Could not create pipeline.");
 		}
 		Log::info("[Pipeline] Created pipeline with name {}.", spec.debug_name);
 
@@ -246,13 +375,13 @@ namespace Alabaster {
 	VkPipelineLayout Pipeline::get_vulkan_pipeline_layout() const { return pipeline_layout; }
 	VkPipeline Pipeline::get_vulkan_pipeline() const { return pipeline; }
 	const PipelineSpecification& Pipeline::get_specification() const { return spec; }
+	bool Pipeline::culls_back_faces() const { return (cull_mode(spec) & VK_CULL_MODE_BACK_BIT) != 0; }
 	bool Pipeline::operator!=(const Pipeline& other) const { return pipeline != other.pipeline; }
 	bool Pipeline::operator()(const Pipeline* other) const { return spec.debug_name < other->spec.debug_name; }
 
 	Pipeline::~Pipeline()
 	{
-		vkDestroyPipelineCache(GraphicsContext::the().device(), pipeline_cache, nullptr);
-		vkDestroyPipelineLayout(GraphicsContext::the().device(), pipeline_layout, nullptr);
+		// The layout belongs to the DescriptorLayoutCache, other pipelines may share it.
 		vkDestroyPipeline(GraphicsContext::the().device(), pipeline, nullptr);
 		Log::info("[Pipeline] Destroyed pipeline {} and its dependents.", spec.debug_name);
 	}
@@ -0,0 +1,105 @@
+#include "av_pch.hpp"
+
+#include "graphics/PipelineCache.hpp"
+
+#include "core/Common.hpp"
+#include "core/Logger.hpp"
+#include "filesystem/FileSystem.hpp"
+#include "graphics/GraphicsContext.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Alabaster {
+
+	static constexpr auto cache_filename = "pipelines.bin";
+
+	static bool matches_device(const std::vector<char>& data)
+	{
+		VkPipelineCacheHeaderVersionOne header {};
+		if (data.size() < sizeof(header)) {
+			return false;
+		}
+		std::memcpy(&header, data.data(), sizeof(header));
+
+		VkPhysicalDeviceProperties properties;
+		vkGetPhysicalDeviceProperties(GraphicsContext::the().physical_device(), &properties);
+		return header.headerSize >= sizeof(header) && header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+			&& header.vendorID == properties.vendorID && header.deviceID == properties.deviceID
+			&& std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+	}
+
+	PipelineCache& PipelineCache::the()
+	{
+		static PipelineCache pipeline_cache;
+		return pipeline_cache;
+	}
+
+	PipelineCache::PipelineCache()
+		: path(FileSystem::cache() / cache_filename)
+	{
+		std::vector<char> data;
+		if (std::ifstream stream { path, std::ios::binary | std::ios::ate }) {
+			data.resize(static_cast<std::size_t>(stream.tellg()));
+			stream.seekg(0);
+			stream.read(data.data(), static_cast<std::streamsize>(data.size()));
+			if (!stream || !matches_device(data)) {
+				Log::info("[PipelineCache] Ignoring {}, it was written for another device or driver.", path.string());
+				data.clear();
+			}
+		}
+
+		VkPipelineCacheCreateInfo create_info {};
+		create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		create_info.initialDataSize = data.size();
+		create_info.pInitialData = data.empty() ? nullptr : data.data();
+		vk_check(vkCreatePipelineCache(GraphicsContext::the().device(), &create_info, nullptr, &cache));
+		Log::info("[PipelineCache] Loaded {} bytes from {}.", data.size(), path.string());
+	}
+
+	void PipelineCache::destroy()
+	{
+		if (!cache) {
+			return;
+		}
+
+		const auto& device = GraphicsContext::the().device();
+		std::size_t size { 0 };
+		std::vector<char> data;
+		if (vkGetPipelineCacheData(device, cache, &size, nullptr) == VK_SUCCESS) {
+			data.resize(size);
+			if (vkGetPipelineCacheData(device, cache, &size, data.data()) != VK_SUCCESS) {
+				data.clear();
+			}
+		}
+		vkDestroyPipelineCache(device, cache, nullptr);
+		cache = nullptr;
+
+		if (data.empty()) {
+			return;
+		}
+
+		std::error_code error;
+		std::filesystem::create_directories(path.parent_path(), error);
+		const auto temporary_path = std::filesystem::path { path }.concat(".tmp");
+		{
+			std::ofstream stream(temporary_path, std::ios::binary | std::ios::trunc);
+			if (!stream) {
+				Log::warn("[PipelineCache] Could not write {}.", path.string());
+				return;
+			}
+			stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+		}
+
+		std::filesystem::rename(temporary_path, path, error);
+		if (error) {
+			Log::warn("[PipelineCache] Could not replace {}. Reason: {}", path.string(), error.message());
+			std::filesystem::remove(temporary_path, error);
+			return;
+		}
+		Log::info("[PipelineCache] Wrote {} bytes to {}.", data.size(), path.string());
+	}
+
+} // namespace Alabaster
@@ -5,17 +5,24 @@
 #include "AssetManager.hpp"
 #include "core/Application.hpp"
 #include "core/Window.hpp"
+#include "core/exceptions/AlabasterException.hpp"
 #include "graphics/Camera.hpp"
 #include "graphics/CommandBuffer.hpp"
+#include "graphics/DescriptorLayoutCache.hpp"
+#include "graphics/FrustumCuller.hpp"
 #include "graphics/GraphicsContext.hpp"
 #include "graphics/IndexBuffer.hpp"
 #include "graphics/Mesh.hpp"
+#include "graphics/MeshSimplifier.hpp"
 #include "graphics/Pipeline.hpp"
 #include "graphics/PushConstantRange.hpp"
 #include "graphics/Renderer.hpp"
 #include "graphics/Vertex.hpp"
 #include "graphics/VertexBufferLayout.hpp"
+#include "graphics/VertexPacker.hpp"
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <vulkan/vulkan.h>
 
@@ -56,6 +63,7 @@ namespace Alabaster {
 		static constexpr std::uint32_t max_meshes = 400;
 		static constexpr std::uint32_t max_indices = 6 * max_vertices;
 		std::uint32_t draw_calls { 0 };
+		std::uint32_t meshlets_culled { 0 };
 		std::uint32_t image_count;
 
 		std::uint32_t quad_indices_submitted { 0 };
@@ -73,17 +81,24 @@ namespace Alabaster {
 		std::vector<std::shared_ptr<UniformBuffer>> uniforms;
 
 		std::vector<VkDescriptorSet> descriptor_sets;
+		std::vector<bool> stale_descriptor_sets;
+		std::array<std::shared_ptr<Texture>, 3> bound_textures;
+		ShaderReflection descriptor_interface;
 		VkDescriptorSetLayout descriptor_set_layout;
 		VkDescriptorPool descriptor_pool;
 		std::shared_ptr<Framebuffer> framebuffer;
 
 		std::uint32_t meshes_submitted { 0 };
-		std::array<Mesh*, max_meshes> mesh;
+		std::array<const Mesh*, max_meshes> mesh;
 		std::array<glm::mat4, max_meshes> mesh_transform {};
 		std::array<glm::vec4, max_meshes> mesh_colour;
 		std::array<Pipeline*, max_meshes> mesh_pipeline_submit;
+		std::array<std::uint32_t, max_meshes> mesh_lod {};
+		float lod_scale { 0.0f };
 
 		PC push_constant;
+		/// @brief First index and index count of the runs of meshlets left after culling, reused between meshes.
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> visible_ranges;
 
 		std::unordered_map<std::string_view, std::shared_ptr<Pipeline>> pipelines;
 
@@ -95,6 +110,69 @@ namespace Alabaster {
 
 	static constexpr auto default_model = glm::mat4 { 1.0f };
 
+	static VkIndexType to_vulkan_index_type(IndexType type) { return type == IndexType::UInt16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32; }
+
+	static std::string_view mesh_pipeline_name(const VertexFormat& format)
+	{
+		switch (format.encoding) {
+		case VertexEncoding::Compact:
+			return format.colour ? "mesh_compact_colour"sv : "mesh_compact"sv;
+		case VertexEncoding::Quantised:
+			return format.colour ? "mesh_quantised_colour"sv : "mesh_quantised"sv;
+		default:
+			return "mesh"sv;
+		}
+	}
+
+	/// @brief How far, in pixels, a level of detail may stray from the full mesh before a finer one is drawn.
+	static constexpr float max_lod_screen_error = 1.0f;
+
+	/// @brief Meshes with fewer meshlets are drawn whole, culling them would not save the work it costs.
+	static constexpr std::size_t min_culled_meshlets = 8;
+
+	/// @brief Collects the index ranges of the meshlets inside the frustum, merging neighbours so every run is one draw. Everything is
+	/// tested in model space, the frustum planes are taken from the clip transform (Gribb & Hartmann) and the viewer is moved into the
+	/// mesh, which keeps the normal cone test exact under any transform that does not mirror.
+	/// @param cull_backfaces whether meshlets facing away from the viewer are culled too, only when the pipeline culls back faces
+	/// @return how many meshlets were culled
+	static std::uint32_t cull_meshlets(std::span<const Meshlet> meshlets, const glm::mat4& clip, const glm::vec3& viewer, bool cull_backfaces,
+		std::vector<std::pair<std::uint32_t, std::uint32_t>>& ranges)
+	{
+		const auto frustum = Frustum::of(clip);
+
+		ranges.clear();
+		std::uint32_t culled { 0 };
+		for (const auto& meshlet : meshlets) {
+			if (!frustum.intersects(meshlet.centre, meshlet.radius) || (cull_backfaces && meshlet.is_backfacing(viewer))) {
+				culled++;
+				continue;
+			}
+
+			const auto count = 3 * meshlet.triangle_count;
+			if (!ranges.empty() && ranges.back().first + ranges.back().second == meshlet.first_index) {
+				ranges.back().second += count;
+			} else {
+				ranges.emplace_back(meshlet.first_index, count);
+			}
+		}
+		return culled;
+	}
+
+	/// @brief The default mesh pipeline with the layout and shader variant of the format, created the first time a mesh needs it.
+	static Pipeline* mesh_pipeline(RendererData& data, const VertexFormat& format)
+	{
+		const auto name = mesh_pipeline_name(format);
+		if (const auto found = data.pipelines.find(name); found != data.pipelines.end()) {
+			return found->second.get();
+		}
+
+		auto spec = data.pipelines["mesh"sv]->get_specification();
+		spec.shader = AssetManager::the().shader("mesh_light", format.keywords());
+		spec.debug_name = fmt::format("Mesh Pipeline ({})", name);
+		spec.vertex_layout = format.layout();
+		return data.pipelines.try_emplace(name, Pipeline::create(std::move(spec))).first->second.get();
+	}
+
 	static void reset_data(RendererData& to_reset)
 	{
 		to_reset.quad_indices_submitted = 0;
@@ -106,39 +184,17 @@ namespace Alabaster {
 		to_reset.mesh_pipeline_submit.fill(nullptr);
 		to_reset.mesh_transform.fill({});
 		to_reset.mesh_colour.fill({});
+		to_reset.mesh_lod.fill(0);
 		to_reset.push_constant = {};
 	}
 
 	void Renderer3D::create_descriptor_set_layout()
 	{
-		VkDescriptorSetLayoutBinding ubo_layout_binding {};
-		ubo_layout_binding.binding = 0;
-		ubo_layout_binding.descriptorCount = 1;
-		ubo_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-		ubo_layout_binding.pImmutableSamplers = nullptr;
-		ubo_layout_binding.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
-
-		VkDescriptorSetLayoutBinding array_of_samplers {};
-		array_of_samplers.binding = 1;
-		array_of_samplers.descriptorCount = 32;
-		array_of_samplers.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
-		array_of_samplers.pImmutableSamplers = nullptr;
-		array_of_samplers.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-		VkDescriptorSetLayoutBinding sampler {};
-		sampler.binding = 2;
-		sampler.descriptorCount = 1;
-		sampler.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
-		sampler.pImmutableSamplers = nullptr;
-		sampler.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-		static const std::array bindings = { ubo_layout_binding, array_of_samplers, sampler };
-		VkDescriptorSetLayoutCreateInfo layout_info {};
-		layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-		layout_info.bindingCount = static_cast<std::uint32_t>(bindings.size());
-		layout_info.pBindings = bindings.data();
-
-		vk_check(vkCreateDescriptorSetLayout(GraphicsContext::the().device(), &layout_info, nullptr, &data->descriptor_set_layout));
+		// One set is bound for every pipeline, so its layout covers everything any of the renderer's shaders declare in set 0.
+		for (const auto* shader : { "quad_light", "mesh_light", "line" }) {
+			data->descriptor_interface.merge(AssetManager::the().shader(shader)->get_reflection());
+		}
+		data->descriptor_set_layout = DescriptorLayoutCache::the().descriptor_set_layout(data->descriptor_interface.set(0));
 	}
 
 	void Renderer3D::create_descriptor_pool()
@@ -179,13 +235,25 @@ namespace Alabaster {
 		renderer_data->descriptor_sets.resize(image_count);
 		vk_check(vkAllocateDescriptorSets(GraphicsContext::the().device(), &alloc_info, renderer_data->descriptor_sets.data()));
 
-		const auto& white_texture_info = AssetManager::the().texture("white_texture.png")->get_descriptor_info();
-		const auto& viking_image_info = AssetManager::the().texture("viking_room.png")->get_descriptor_info();
-		const auto& floor_image_info = AssetManager::the().texture("floor.jpg")->get_descriptor_info();
+		renderer_data->bound_textures = { AssetManager::the().texture("white_texture.png"), AssetManager::the().texture("viking_room.png"),
+			AssetManager::the().texture("floor.jpg") };
+
+		renderer_data->stale_descriptor_sets.assign(image_count, false);
+		for (std::uint32_t i = 0; i < image_count; i++) {
+			write_descriptor_set(i);
+		}
+	}
+
+	void Renderer3D::write_descriptor_set(std::uint32_t frame)
+	{
+		const auto& [white_texture, viking_texture, floor_texture] = data->bound_textures;
+		const auto& white_texture_info = white_texture->get_descriptor_info();
+		const auto& viking_image_info = viking_texture->get_descriptor_info();
+		const auto& floor_image_info = floor_texture->get_descriptor_info();
 
 		static constexpr auto texture_array_size = 32;
 
-		static std::array<VkDescriptorImageInfo, texture_array_size> desc_data {};
+		std::array<VkDescriptorImageInfo, texture_array_size> desc_data {};
 		for (uint32_t i = 0; i < texture_array_size; ++i) {
 			desc_data[i].sampler = nullptr;
 			desc_data[i].imageLayout = viking_image_info.imageLayout;
@@ -195,48 +263,47 @@ namespace Alabaster {
 		desc_data[1] = viking_image_info;
 		desc_data[2] = floor_image_info;
 
-		for (std::size_t i = 0; i < image_count; i++) {
-			VkDescriptorBufferInfo buffer_info {};
-			buffer_info.buffer = data->uniforms[i]->get_buffer();
-			buffer_info.offset = 0;
-			buffer_info.range = sizeof(UBO);
-
-			std::array<VkWriteDescriptorSet, 3> descriptor_writes {};
-			auto& ubo = descriptor_writes[0];
-			auto& texture_array = descriptor_writes[1];
-			auto& sampler = descriptor_writes[2];
-
-			ubo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			ubo.dstSet = data->descriptor_sets[i];
-			ubo.dstBinding = 0;
-			ubo.dstArrayElement = 0;
-			ubo.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-			ubo.descriptorCount = 1;
-			ubo.pBufferInfo = &buffer_info;
-
-			texture_array = {};
-			texture_array.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			texture_array.dstBinding = 1;
-			texture_array.dstArrayElement = 0;
-			texture_array.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
-			texture_array.descriptorCount = texture_array_size;
-			texture_array.pBufferInfo = nullptr;
-			texture_array.dstSet = data->descriptor_sets[i];
-			texture_array.pImageInfo = desc_data.data();
-
-			sampler = {};
-			sampler.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			sampler.dstBinding = 2;
-			sampler.dstArrayElement = 0;
-			sampler.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
-			sampler.descriptorCount = 1;
-			sampler.pBufferInfo = nullptr;
-			sampler.dstSet = data->descriptor_sets[i];
-			sampler.pImageInfo = &floor_image_info;
-
-			vkUpdateDescriptorSets(
-				GraphicsContext::the().device(), static_cast<std::uint32_t>(descriptor_writes.size()), descriptor_writes.data(), 0, nullptr);
-		}
+		VkDescriptorBufferInfo buffer_info {};
+		buffer_info.buffer = data->uniforms[frame]->get_buffer();
+		buffer_info.offset = 0;
+		buffer_info.range = sizeof(UBO);
+
+		std::array<VkWriteDescriptorSet, 3> descriptor_writes {};
+		auto& ubo = descriptor_writes[0];
+		auto& texture_array = descriptor_writes[1];
+		auto& sampler = descriptor_writes[2];
+
+		ubo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		ubo.dstSet = data->descriptor_sets[frame];
+		ubo.dstBinding = 0;
+		ubo.dstArrayElement = 0;
+		ubo.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		ubo.descriptorCount = 1;
+		ubo.pBufferInfo = &buffer_info;
+
+		texture_array = {};
+		texture_array.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		texture_array.dstBinding = 1;
+		texture_array.dstArrayElement = 0;
+		texture_array.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+		texture_array.descriptorCount = texture_array_size;
+		texture_array.pBufferInfo = nullptr;
+		texture_array.dstSet = data->descriptor_sets[frame];
+		texture_array.pImageInfo = desc_data.data();
+
+		sampler = {};
+		sampler.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		sampler.dstBinding = 2;
+		sampler.dstArrayElement = 0;
+		sampler.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+		sampler.descriptorCount = 1;
+		sampler.pBufferInfo = nullptr;
+		sampler.dstSet = data->descriptor_sets[frame];
+		sampler.pImageInfo = &floor_image_info;
+
+		vkUpdateDescriptorSets(
+			GraphicsContext::the().device(), static_cast<std::uint32_t>(descriptor_writes.size()), descriptor_writes.data(), 0, nullptr);
+		data->stale_descriptor_sets[frame] = false;
 	}
 
 	Renderer3D::Renderer3D(Camera* cam) noexcept
@@ -274,8 +341,8 @@ namespace Alabaster {
 			.vertex_layout = VertexBufferLayout { VertexBufferElement(ShaderDataType::Float4, "position"),
 				VertexBufferElement(ShaderDataType::Float4, "colour"), VertexBufferElement(ShaderDataType::Float3, "normals"),
 				VertexBufferElement(ShaderDataType::Float2, "uvs"), VertexBufferElement(ShaderDataType::Int, "texture_id") },
-			.ranges = PushConstantRanges { PushConstantRange(PushConstantKind::Both, sizeof(PC)) } };
-		data->pipelines.try_emplace("quad"sv, Pipeline::create(quad_spec));
+			.ranges = PushConstantRanges { PushConstantRange(PushConstantKind::Both, sizeof(PC)) },
+			.descriptor_set_layouts = { data->descriptor_set_layout } };
 
 		data->quad_vertex_buffer = VertexBuffer::create(RendererData::max_vertices * sizeof(QuadVertex));
 		data->line_vertex_buffer = VertexBuffer::create(RendererData::max_vertices * sizeof(LineVertex));
@@ -301,13 +368,10 @@ namespace Alabaster {
 			.debug_name = "Mesh Pipeline",
 			.render_pass = data->framebuffer->get_renderpass(),
 			.topology = Topology::TriangleList,
-			.vertex_layout
-			= VertexBufferLayout { VertexBufferElement(ShaderDataType::Float3, "position"), VertexBufferElement(ShaderDataType::Float4, "colour"),
-				VertexBufferElement(ShaderDataType::Float3, "normal"), VertexBufferElement(ShaderDataType::Float3, "tangent"),
-				VertexBufferElement(ShaderDataType::Float3, "bitangent"), VertexBufferElement(ShaderDataType::Float2, "uvs") },
+			.vertex_layout = VertexFormat {}.layout(),
 			.ranges = PushConstantRanges { PushConstantRange(PushConstantKind::Both, sizeof(PC)) },
+			.descriptor_set_layouts = { data->descriptor_set_layout },
 		};
-		data->pipelines.try_emplace("mesh"sv, Pipeline::create(mesh_spec));
 
 		PipelineSpecification line_spec { .shader = AssetManager::the().shader("line"),
 			.debug_name = "Line Pipeline",
@@ -315,8 +379,17 @@ namespace Alabaster {
 			.topology = Topology::LineList,
 			.vertex_layout
 			= VertexBufferLayout { VertexBufferElement(ShaderDataType::Float4, "position"), VertexBufferElement(ShaderDataType::Float4, "colour") },
+			.descriptor_set_layouts = { data->descriptor_set_layout },
 			.line_width = 5.0f };
-		data->pipelines.try_emplace("line"sv, Pipeline::create(line_spec));
+
+		std::vector<PipelineSpecification> specs;
+		specs.push_back(std::move(quad_spec));
+		specs.push_back(std::move(mesh_spec));
+		specs.push_back(std::move(line_spec));
+		const auto pipelines = Pipeline::create(std::move(specs));
+		data->pipelines.try_emplace("quad"sv, pipelines[0]);
+		data->pipelines.try_emplace("mesh"sv, pipelines[1]);
+		data->pipelines.try_emplace("line"sv, pipelines[2]);
 
 		std::vector<std::uint32_t> line_indices;
 		line_indices.resize(RendererData::max_indices);
@@ -325,13 +398,53 @@ namespace Alabaster {
 		}
 		data->line_index_buffer = IndexBuffer::create(line_indices);
 
-		invalidate_pipelines();
+		shader_reload_listener
+			= AssetManager::the().add_shader_reload_listener([this](const AssetManager::ShaderReload& reload) { rebuild_pipelines(reload); });
+
+		// Sets of frames still in flight cannot be written, so each one is rewritten when its frame comes around again.
+		texture_stream_listener = AssetManager::the().add_texture_stream_listener([this](const std::shared_ptr<Texture>& texture) {
+			if (std::ranges::find(data->bound_textures, texture) != data->bound_textures.end()) {
+				data->stale_descriptor_sets.assign(data->stale_descriptor_sets.size(), true);
+			}
+		});
 	}
 
-	void Renderer3D::invalidate_pipelines()
+	void Renderer3D::rebuild_pipelines(const AssetManager::ShaderReload& reload)
 	{
-		for (const auto& [k, pipe] : data->pipelines) {
-			pipe->invalidate();
+		std::vector<std::shared_ptr<Pipeline>*> stale;
+		std::vector<PipelineSpecification> specs;
+		for (auto& [key, pipeline] : data->pipelines) {
+			if (pipeline->get_specification().shader != reload.previous) {
+				continue;
+			}
+
+			for (const auto& binding : reload.shader->get_reflection().set(0)) {
+				const auto covered = std::ranges::any_of(data->descriptor_interface.set(0), [&binding](const DescriptorBinding& declared) {
+					return declared.binding == binding.binding && declared.type == binding.type && declared.count >= binding.count
+						&& (declared.stages & binding.stages) == binding.stages;
+				});
+				if (!covered) {
+					Log::warn("[Renderer3D] Reloaded shader {} changed binding {} of the renderer's set, restart to pick it up.", reload.name,
+						binding.binding);
+				}
+			}
+
+			auto& spec = specs.emplace_back(pipeline->get_specification());
+			spec.shader = reload.shader;
+			stale.push_back(&pipeline);
+		}
+
+		if (specs.empty()) {
+			return;
+		}
+
+		try {
+			auto rebuilt = Pipeline::create(std::move(specs));
+			for (std::size_t i = 0; i < stale.size(); i++) {
+				Renderer::submit_resource_free([retired = std::exchange(*stale[i], std::move(rebuilt[i]))]() mutable { retired.reset(); });
+			}
+		} catch (const AlabasterException& e) {
+			Log::error("[Renderer3D] Could not rebuild pipelines for shader {}. Reason: {}", reload.name, e.what());
 		}
 	}
 
@@ -339,6 +452,9 @@ namespace Alabaster {
 	{
 		Alabaster::assert_that(!scene_has_begun);
 		scene_has_begun = true;
+		if (const auto frame = Renderer::current_frame(); data->stale_descriptor_sets[frame]) {
+			write_descriptor_set(frame);
+		}
 		reset_data(*data);
 		update_uniform_buffers();
 		data->push_constant = PC();
@@ -348,6 +464,7 @@ namespace Alabaster {
 	{
 		reset_data(*data);
 		data->draw_calls = 0;
+		data->meshlets_culled = 0;
 	}
 
 	void Renderer3D::quad(const glm::vec3& pos, const glm::vec4& colour, const glm::vec3& scale, float rotation, int texture_id)
@@ -426,19 +543,34 @@ namespace Alabaster {
 	void Renderer3D::mesh(
 		const std::shared_ptr<Mesh>& mesh, const glm::mat4& transform, const std::shared_ptr<Pipeline>& pipeline, const glm::vec4& colour)
 	{
-		data->mesh_transform[data->meshes_submitted] = transform;
-		data->mesh_colour[data->meshes_submitted] = colour;
-		data->mesh[data->meshes_submitted] = mesh.get();
-		data->mesh_pipeline_submit[data->meshes_submitted] = pipeline ? pipeline.get() : data->pipelines["mesh"sv].get();
-		data->meshes_submitted++;
+		this->mesh(*mesh, transform, pipeline.get(), colour);
 	}
 
 	void Renderer3D::mesh(const std::shared_ptr<Mesh>& mesh, const glm::mat4& transform, const glm::vec4& colour)
 	{
+		this->mesh(*mesh, transform, nullptr, colour);
+	}
+
+	void Renderer3D::mesh(const Mesh& mesh, const glm::mat4& transform, Pipeline* pipeline, const glm::vec4& colour)
+	{
+		// The error is measured at the point of the bounding sphere closest to the camera, scaled as far as the transform stretches it.
+		const auto lods = mesh.get_lods();
+		std::uint32_t lod { 0 };
+		if (data->lod_scale > 0.0f && lods.size() > 1) {
+			const auto& bounds = mesh.get_bounds();
+			const auto centre = glm::vec3 { transform * glm::vec4 { bounds.centre(), 1.0f } };
+			const auto scale = std::max(
+				{ glm::length(glm::vec3 { transform[0] }), glm::length(glm::vec3 { transform[1] }), glm::length(glm::vec3 { transform[2] }) });
+			const auto radius = scale * bounds.radius;
+			const auto distance = std::max(glm::distance(camera->get_position(), centre) - radius, std::numeric_limits<float>::epsilon());
+			lod = static_cast<std::uint32_t>(MeshSimplifier::select_lod(lods, data->lod_scale * scale / distance, max_lod_screen_error));
+		}
+
+		data->mesh_lod[data->meshes_submitted] = lod;
 		data->mesh_transform[data->meshes_submitted] = transform;
 		data->mesh_colour[data->meshes_submitted] = colour;
-		data->mesh[data->meshes_submitted] = mesh.get();
-		data->mesh_pipeline_submit[data->meshes_submitted] = data->pipelines["mesh"sv].get();
+		data->mesh[data->meshes_submitted] = &mesh;
+		data->mesh_pipeline_submit[data->meshes_submitted] = pipeline ? pipeline : mesh_pipeline(*data, mesh.get_vertex_format());
 		data->meshes_submitted++;
 	}
 
@@ -570,7 +702,7 @@ namespace Alabaster {
 		constexpr VkDeviceSize offsets { 0 };
 		vkCmdBindVertexBuffers(command_buffer.get_buffer(), 0, 1, vbs.data(), &offsets);
 
-		vkCmdBindIndexBuffer(command_buffer.get_buffer(), ib->get_vulkan_buffer(), 0, VK_INDEX_TYPE_UINT32);
+		vkCmdBindIndexBuffer(command_buffer.get_buffer(), ib->get_vulkan_buffer(), 0, to_vulkan_index_type(ib->index_type()));
 
 		if (pipeline->get_vulkan_pipeline_layout()) {
 			vkCmdBindDescriptorSets(
@@ -595,7 +727,7 @@ namespace Alabaster {
 		constexpr VkDeviceSize offsets { 0 };
 		vkCmdBindVertexBuffers(command_buffer.get_buffer(), 0, 1, vbs.data(), &offsets);
 
-		vkCmdBindIndexBuffer(command_buffer.get_buffer(), ib->get_vulkan_buffer(), 0, VK_INDEX_TYPE_UINT32);
+		vkCmdBindIndexBuffer(command_buffer.get_buffer(), ib->get_vulkan_buffer(), 0, to_vulkan_index_type(ib->index_type()));
 
 		if (pipeline->get_vulkan_pipeline_layout()) {
 			vkCmdBindDescriptorSets(
@@ -622,7 +754,8 @@ namespace Alabaster {
 			const auto& mesh_transform = data->mesh_transform[i];
 			const auto& mesh_colour = data->mesh_colour[i];
 
-			data->push_constant.object_transform = mesh_transform;
+			// Quantised positions are dequantised by the vertex transform, a uniform scale the shader's normal matrix normalises away.
+			data->push_constant.object_transform = mesh_transform * mesh->get_vertex_transform();
 			data->push_constant.object_colour = mesh_colour;
 			const auto& pc = data->push_constant;
 			vkCmdPushConstants(command_buffer.get_buffer(), pipeline->get_vulkan_pipeline_layout(),
@@ -637,10 +770,32 @@ namespace Alabaster {
 			constexpr VkDeviceSize offsets { 0 };
 			vkCmdBindVertexBuffers(command_buffer.get_buffer(), 0, 1, vbs.data(), &offsets);
 
-			vkCmdBindIndexBuffer(command_buffer.get_buffer(), *ib, 0, VK_INDEX_TYPE_UINT32);
-
-			vkCmdDrawIndexed(command_buffer.get_buffer(), static_cast<std::uint32_t>(mesh->get_index_count()), 1, 0, 0, 0);
-			data->draw_calls++;
+			vkCmdBindIndexBuffer(command_buffer.get_buffer(), *ib, 0, to_vulkan_index_type(ib.index_type()));
+
+			// Meshlets are ranges of the full mesh, a coarser level is drawn whole.
+			if (const auto lod = data->mesh_lod[i]; lod != 0) {
+				const auto& level = mesh->get_lods()[lod];
+				vkCmdDrawIndexed(command_buffer.get_buffer(), level.index_count, 1, level.first_index, 0, 0);
+				data->draw_calls++;
+				continue;
+			}
+
+			const auto meshlets = mesh->get_meshlets();
+			if (meshlets.size() < min_culled_meshlets) {
+				vkCmdDrawIndexed(command_buffer.get_buffer(), static_cast<std::uint32_t>(mesh->get_index_count()), 1, 0, 0, 0);
+				data->draw_calls++;
+				continue;
+			}
+
+			// A mirroring transform turns the triangles around, their cones no longer say which way they face.
+			const auto cull_backfaces = pipeline->culls_back_faces() && glm::determinant(glm::mat3 { mesh_transform }) > 0.0f;
+			const auto viewer = glm::vec3 { glm::inverse(mesh_transform) * glm::vec4 { camera->get_position(), 1.0f } };
+			data->meshlets_culled
+				+= cull_meshlets(meshlets, camera->get_view_projection() * mesh_transform, viewer, cull_backfaces, data->visible_ranges);
+			for (const auto& [first_index, count] : data->visible_ranges) {
+				vkCmdDrawIndexed(command_buffer.get_buffer(), count, 1, first_index, 0, 0);
+				data->draw_calls++;
+			}
 		}
 	}
 
@@ -660,15 +815,21 @@ namespace Alabaster {
 
 	Renderer3D::~Renderer3D()
 	{
+		AssetManager::the().remove_shader_reload_listener(shader_reload_listener);
+		AssetManager::the().remove_texture_stream_listener(texture_stream_listener);
+
 		const auto& device = GraphicsContext::the().device();
 		vkDestroyDescriptorPool(device, data->descriptor_pool, nullptr);
-		vkDestroyDescriptorSetLayout(device, data->descriptor_set_layout, nullptr);
 
 		delete data;
 	}
 
 	const VkRenderPass& Renderer3D::get_render_pass() const { return data->framebuffer->get_renderpass(); }
 
+	VkDescriptorSetLayout Renderer3D::get_descriptor_set_layout() const { return data->descriptor_set_layout; }
+
 	void Renderer3D::set_camera(const Camera& cam) { *camera = cam; }
 
+	void Renderer3D::set_lod_scale(float pixels_per_unit) { data->lod_scale = pixels_per_unit; }
+
 } // namespace Alabaster
@@ -4,6 +4,7 @@
 
 #include "core/Common.hpp"
 #include "core/exceptions/AlabasterException.hpp"
+#include "graphics/DescriptorLayoutCache.hpp"
 #include "graphics/GraphicsContext.hpp"
 #include "graphics/Renderer.hpp"
 #include "utilities/FileInputOutput.hpp"
@@ -13,29 +14,6 @@
 
 namespace Alabaster {
 
-	auto create_default_bindings()
-	{
-		std::array<VkDescriptorSetLayoutBinding, 3> bindings {};
-		bindings[0].binding = 0;
-		bindings[0].stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
-		bindings[0].pImmutableSamplers = nullptr; // Optional
-		bindings[0].descriptorCount = 1;
-		bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-
-		bindings[1].binding = 1;
-		bindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-		bindings[1].descriptorCount = 32;
-		bindings[1].pImmutableSamplers = nullptr;
-		bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
-
-		bindings[2].binding = 2;
-		bindings[2].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-		bindings[2].descriptorCount = 1;
-		bindings[2].pImmutableSamplers = nullptr;
-		bindings[2].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
-		return bindings;
-	}
-
 	std::pair<std::filesystem::path, std::filesystem::path> to_path(const auto& path)
 	{
 		return { path.string() + ".vert.spv", path.string() + ".frag.spv" };
@@ -62,6 +40,7 @@ namespace Alabaster {
 		: vertex_stage(std::move(s.vertex_stage))
 		, fragment_stage(std::move(s.fragment_stage))
 		, shader_path(s.shader_path)
+		, reflection(std::move(s.reflection))
 		, layouts(s.layouts)
 	{
 	}
@@ -71,10 +50,12 @@ namespace Alabaster {
 	{
 	}
 
-	Shader::Shader(const std::string& path_or_name, std::vector<std::uint32_t> vert_spirv, std::vector<std::uint32_t> frag_spirv)
+	Shader::Shader(const std::string& path_or_name, std::vector<std::uint32_t> vert_spirv, std::vector<std::uint32_t> frag_spirv,
+		ShaderReflection shader_reflection)
 		: vertex_stage(std::make_unique<VkPipelineShaderStageCreateInfo>())
 		, fragment_stage(std::make_unique<VkPipelineShaderStageCreateInfo>())
 		, shader_path(path_or_name)
+		, reflection(std::move(shader_reflection))
 	{
 		const auto vertex_shader_module = create(vert_spirv.data(), vert_spirv.size() * sizeof(std::uint32_t));
 		const auto fragment_shader_module = create(frag_spirv.data(), frag_spirv.size() * sizeof(std::uint32_t));
@@ -96,31 +77,13 @@ namespace Alabaster {
 
 	const std::array<VkPipelineShaderStageCreateInfo, 2> Shader::stages() const { return { *vertex_stage, *fragment_stage }; }
 
-	void Shader::create_layout()
-	{
-		// TODO: This should obviously be generated from the shader compilation.
-		const auto bindings = create_default_bindings();
-
-		VkDescriptorSetLayoutCreateInfo create_info {};
-		create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-		create_info.bindingCount = static_cast<std::uint32_t>(bindings.size());
-		create_info.pBindings = bindings.data();
-
-		layouts.resize(bindings.size());
-		for (std::uint32_t i = 0; i < bindings.size(); i++) {
-			vk_check(vkCreateDescriptorSetLayout(GraphicsContext::the().device(), &create_info, nullptr, &layouts[i]));
-		}
-	}
+	void Shader::create_layout() { layouts = DescriptorLayoutCache::the().descriptor_set_layouts(reflection); }
 
 	void Shader::destroy()
 	{
 		vkDestroyShaderModule(GraphicsContext::the().device(), vertex_stage->module, nullptr);
 		vkDestroyShaderModule(GraphicsContext::the().device(), fragment_stage->module, nullptr);
 
-		for (const auto& layout : layouts) {
-			vkDestroyDescriptorSetLayout(GraphicsContext::the().device(), layout, nullptr);
-		}
-
 		Log::info("[Shader] Shader stages for shader {} deleted.", shader_path.string());
 	}
 
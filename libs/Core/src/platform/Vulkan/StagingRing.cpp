@@ -0,0 +1,54 @@
+#include "av_pch.hpp"
+
+#include "graphics/StagingRing.hpp"
+
+#include "core/Common.hpp"
+#include "graphics/Allocator.hpp"
+
+#include <vulkan/vulkan.h>
+
+namespace Alabaster {
+
+	StagingRing::StagingRing(VkDeviceSize capacity)
+		: size(capacity)
+	{
+		VkBufferCreateInfo buffer_info = {};
+		buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		buffer_info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+		buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		buffer_info.size = size;
+
+		Allocator allocator("StagingRing");
+		allocation = allocator.allocate_buffer(buffer_info, Allocator::Usage::CPU_TO_GPU, buffer, "StagingRing");
+		mapped = allocator.map_memory<std::byte>(allocation);
+	}
+
+	StagingRing::~StagingRing()
+	{
+		if (!allocation)
+			return;
+
+		Allocator allocator("StagingRing");
+		allocator.unmap_memory(allocation);
+		allocator.destroy_buffer(buffer, allocation);
+	}
+
+	std::optional<StagingRing::Region> StagingRing::allocate(VkDeviceSize region_size, VkDeviceSize alignment)
+	{
+		const auto offset = (head + alignment - 1) & ~(alignment - 1);
+		if (offset + region_size > size) {
+			return {};
+		}
+
+		head = offset + region_size;
+		return Region { .buffer = buffer, .offset = offset, .size = region_size, .data = mapped + offset };
+	}
+
+	void StagingRing::flush() const
+	{
+		if (head > 0) {
+			vk_check(vmaFlushAllocation(Allocator::get_vma_allocator(), allocation, 0, head));
+		}
+	}
+
+} // namespace Alabaster
@@ -2,10 +2,12 @@
 
 #include "graphics/Texture.hpp"
 
+#include "graphics/Allocator.hpp"
 #include "graphics/GraphicsContext.hpp"
 #include "platform/Vulkan/ImageUtilities.hpp"
 
 #include <AssetManager.hpp>
+#include <compiler/MipChain.hpp>
 #include <stb_image.h>
 #include <vulkan/vulkan.h>
 
@@ -13,11 +15,13 @@ namespace Alabaster {
 
 	std::shared_ptr<Texture> Texture::from_filename(const std::filesystem::path& path, const TextureProperties& props)
 	{
-		const auto actual_path = FileSystem::texture(path);
-		const auto filename_as_string = actual_path.filename().string();
-		if (const auto& tex = AssetManager::asset<Texture>(filename_as_string))
-			return tex;
-		return std::shared_ptr<Texture>(new Texture { FileSystem::texture(actual_path), props });
+		return AssetManager::the().texture(FileSystem::texture(path), props);
+	}
+
+	std::shared_ptr<Texture> Texture::streamed(
+		const std::filesystem::path& full_path, const std::shared_ptr<Texture>& placeholder, const TextureProperties& props)
+	{
+		return std::shared_ptr<Texture>(new Texture { full_path, *placeholder, props });
 	}
 
 	Texture::Texture(const std::filesystem::path& tex_path, const TextureProperties props)
@@ -39,6 +43,60 @@ namespace Alabaster {
 		invalidate();
 	}
 
+	Texture::Texture(const std::filesystem::path& tex_path, DecodedImage&& decoded, const TextureProperties props)
+		: path(tex_path)
+		, width(decoded.width)
+		, height(decoded.height)
+		, properties(props)
+		, image_data(decoded.pixels)
+		, format(decoded.format)
+	{
+		decoded.pixels = Buffer();
+		if (!image_data) {
+			throw AlabasterException("Could not load image.");
+		}
+
+		ImageSpecification image_spec;
+		image_spec.format = format;
+		image_spec.width = width;
+		image_spec.height = height;
+		image_spec.mips = properties.generate_mips ? Texture::get_mip_level_count() : 1;
+		image_spec.debug_name = properties.debug_name;
+		image = Image::create(image_spec);
+
+		invalidate();
+	}
+
+	Texture::Texture(const std::filesystem::path& tex_path, const ImageHeader& header, const TextureProperties props)
+		: path(tex_path)
+		, width(header.width)
+		, height(header.height)
+		, properties(props)
+		, provided_mips(header.mips)
+		, format(header.format)
+	{
+		ImageSpecification image_spec;
+		image_spec.format = format;
+		image_spec.width = width;
+		image_spec.height = height;
+		image_spec.mips = provided_mips > 0 ? provided_mips : properties.generate_mips ? Texture::get_mip_level_count() : 1;
+		image_spec.debug_name = properties.debug_name;
+		image = Image::create(image_spec);
+
+		create_image_resources();
+	}
+
+	Texture::Texture(const std::filesystem::path& tex_path, const Texture& placeholder, const TextureProperties props)
+		: path(tex_path)
+		, width(placeholder.width)
+		, height(placeholder.height)
+		, properties(props)
+		, image(placeholder.image)
+		, owns_image(false)
+		, format(placeholder.format)
+	{
+	}
+
 	Texture::Texture(ImageFormat input_format, uint32_t w, uint32_t h, const void* data, const TextureProperties props)
 		: width(w)
 		, height(h)
@@ -91,9 +149,139 @@ namespace Alabaster {
 		invalidate();
 	}
 
+	std::shared_ptr<Texture> Texture::from_decoded(const std::filesystem::path& full_path, DecodedImage&& decoded, const TextureProperties& props)
+	{
+		return std::shared_ptr<Texture>(new Texture { full_path, std::move(decoded), props });
+	}
+
+	std::shared_ptr<Texture> Texture::from_staged(const std::filesystem::path& full_path, const ImageHeader& header, const TextureProperties& props)
+	{
+		return std::shared_ptr<Texture>(new Texture { full_path, header, props });
+	}
+
+	std::size_t Texture::ImageHeader::size() const { return Utilities::get_memory_size(format, width, height); }
+
+	Texture::ImageHeader Texture::probe(const std::filesystem::path& full_path)
+	{
+		ImageHeader header;
+		const auto file = FileSystem::read(full_path);
+		if (!file) {
+			return header;
+		}
+
+		const auto* encoded = file->bytes.data();
+		const auto size = static_cast<int>(file->bytes.size());
+		int w;
+		int h;
+		int channels;
+		if (!stbi_info_from_memory(encoded, size, &w, &h, &channels)) {
+			return header;
+		}
+
+		header.width = w;
+		header.height = h;
+		header.format = stbi_is_hdr_from_memory(encoded, size) ? ImageFormat::RGBA32F : ImageFormat::RGBA;
+		return header;
+	}
+
+	bool Texture::decode_into(const std::filesystem::path& full_path, const ImageHeader& header, void* destination)
+	{
+		auto decoded = decode(full_path);
+		if (!decoded) {
+			return false;
+		}
+
+		const auto matches_header = decoded.width == header.width && decoded.height == header.height && decoded.format == header.format;
+		if (matches_header) {
+			std::memcpy(destination, decoded.pixels.data, header.size());
+		}
+
+		decoded.release();
+		return matches_header;
+	}
+
+	void Texture::DecodedImage::release()
+	{
+		stbi_image_free(pixels.data);
+		pixels = Buffer();
+	}
+
+	void Texture::make_resident(Texture& loaded)
+	{
+		Alabaster::assert_that(!owns_image, "Only streamed handles can be made resident.");
+
+		std::swap(image, loaded.image);
+		std::swap(owns_image, loaded.owns_image);
+		width = loaded.width;
+		height = loaded.height;
+		format = loaded.format;
+	}
+
+	std::shared_ptr<Image> Texture::evict(const Texture& placeholder)
+	{
+		Alabaster::assert_that(owns_image, "Only resident textures can be evicted.");
+
+		auto evicted = std::exchange(image, placeholder.image);
+		owns_image = false;
+		width = placeholder.width;
+		height = placeholder.height;
+		format = placeholder.format;
+		return evicted;
+	}
+
+	VkDeviceSize Texture::get_memory_size() const
+	{
+		if (!owns_image || !image || !image->get_info().allocation) {
+			return 0;
+		}
+
+		VmaAllocationInfo allocation_info {};
+		vmaGetAllocationInfo(Allocator::get_vma_allocator(), image->get_info().allocation, &allocation_info);
+		return allocation_info.size;
+	}
+
+	Texture::DecodedImage Texture::decode(const std::filesystem::path& full_path)
+	{
+		const auto file = FileSystem::read(full_path);
+		if (!file) {
+			return DecodedImage {};
+		}
+		return decode(file->bytes);
+	}
+
+	Texture::DecodedImage Texture::decode(std::span<const std::uint8_t> encoded)
+	{
+		DecodedImage decoded;
+		const auto size = static_cast<int>(encoded.size());
+		int w { 0 };
+		int h { 0 };
+		int channels { 0 };
+
+		std::size_t texel_size { 4 };
+		if (stbi_is_hdr_from_memory(encoded.data(), size)) {
+			decoded.pixels.data = (byte*)stbi_loadf_from_memory(encoded.data(), size, &w, &h, &channels, 4);
+			texel_size = 4 * sizeof(float);
+			decoded.format = ImageFormat::RGBA32F;
+		} else {
+			decoded.pixels.data = stbi_load_from_memory(encoded.data(), size, &w, &h, &channels, 4);
+			decoded.format = ImageFormat::RGBA;
+		}
+
+		if (!decoded.pixels.data) {
+			decoded.pixels = Buffer();
+			return decoded;
+		}
+
+		// The dimensions are only written by a successful decode.
+		decoded.pixels.size = static_cast<std::uint32_t>(static_cast<std::size_t>(w) * static_cast<std::size_t>(h) * texel_size);
+		decoded.width = w;
+		decoded.height = h;
+		return decoded;
+	}
+
 	Texture::~Texture()
 	{
-		if (image)
+		if (image && owns_image)
 			image->release();
 
 		image_data.release();
@@ -106,11 +294,11 @@ namespace Alabaster {
 		if (stbi_is_hdr_from_memory(static_cast<const stbi_uc*>(data), static_cast<int>(size))) {
 			image_data.data
 				= (byte*)stbi_loadf_from_memory(static_cast<const stbi_uc*>(data), static_cast<int>(size), &w, &h, &channels, STBI_rgb_alpha);
-			image_data.size = width * height * 4 * sizeof(float);
+			image_data.size = w * h * 4 * sizeof(float);
 			format = ImageFormat::RGBA32F;
 		} else {
 			image_data.data = stbi_load_from_memory(static_cast<const stbi_uc*>(data), static_cast<int>(size), &w, &h, &channels, STBI_rgb_alpha);
-			image_data.size = width * height * 4;
+			image_data.size = w * h * 4;
 			format = ImageFormat::RGBA;
 		}
 
@@ -124,29 +312,11 @@ namespace Alabaster {
 
 	bool Texture::load_image(const std::string& in_path)
 	{
-		if (!IO::is_file(in_path))
+		const auto file = FileSystem::read(in_path);
+		if (!file) {
 			return false;
-		int w;
-		int h;
-		int channels;
-
-		if (stbi_is_hdr(in_path.c_str())) {
-			image_data.data = (byte*)stbi_loadf(path.string().c_str(), &w, &h, &channels, 4);
-			image_data.size = w * h * 4 * sizeof(float);
-			format = ImageFormat::RGBA32F;
-		} else {
-			// stbi_set_flip_vertically_on_load(1);
-			image_data.data = stbi_load(path.string().c_str(), &w, &h, &channels, 4);
-			image_data.size = w * h * 4;
-			format = ImageFormat::RGBA;
 		}
-
-		if (!image_data.data)
-			return false;
-
-		width = w;
-		height = h;
-		return true;
+		return load_image(file->bytes.data(), static_cast<std::uint32_t>(file->bytes.size()));
 	}
 
 	void Texture::resize(const glm::uvec2& size) { resize(size.x, size.y); }
@@ -161,25 +331,29 @@ namespace Alabaster {
 
 	void Texture::invalidate()
 	{
-		const auto& vulkan_device = GraphicsContext::the().device();
-
-		image->release();
-		uint32_t mip_count = properties.generate_mips ? get_mip_level_count() : 1;
-
-		ImageSpecification& image_spec = image->get_specification();
-		image_spec.format = format;
-		image_spec.width = width;
-		image_spec.height = height;
-		image_spec.mips = mip_count;
 		if (!image_data)
-			image_spec.usage = ImageUsage::Storage;
+			image->get_specification().usage = ImageUsage::Storage;
 
-		image->invalidate();
-
-		auto& info = image->get_info();
+		create_image_resources();
 
 		if (image_data) {
-			VkDeviceSize size = image_data.size;
+			// 8 bit images get their mips filtered on the CPU, sRGB correct and alpha aware, and every level goes up in one copy.
+			std::vector<AssetManager::MipLevel> chain;
+			if (format == ImageFormat::RGBA && image->get_specification().mips > 1) {
+				const auto* pixels = static_cast<const std::uint8_t*>(image_data.data);
+				const std::span<const std::uint8_t> base { pixels, Utilities::get_memory_size(format, width, height) };
+				chain = AssetManager::MipChain::generate(base, width, height, {});
+			}
+
+			VkDeviceSize size = chain.empty() ? image_data.size : 0;
+			std::vector<VkDeviceSize> mip_offsets { 0 };
+			if (!chain.empty()) {
+				mip_offsets.clear();
+				for (const auto& level : chain) {
+					mip_offsets.push_back(size);
+					size += level.texels.size();
+				}
+			}
 
 			Allocator allocator("Texture2D - Staging");
 
@@ -193,57 +367,19 @@ namespace Alabaster {
 				= allocator.allocate_buffer(buffer_create_info, Allocator::Usage::CPU_TO_GPU, staging_buffer, "Allocator staging buffer");
 
 			uint8_t* dest_data = allocator.map_memory<uint8_t>(staging_buffer_allocation);
-			memcpy(dest_data, image_data.data, size);
+			if (chain.empty()) {
+				memcpy(dest_data, image_data.data, size);
+			}
+			for (std::size_t mip = 0; mip < chain.size(); mip++) {
+				memcpy(dest_data + mip_offsets[mip], chain[mip].texels.data(), chain[mip].texels.size());
+			}
 			allocator.unmap_memory(staging_buffer_allocation);
 
-			ImmediateCommandBuffer immediate_command_buffer { "Texture Transition" };
+			ImmediateCommandBuffer immediate_command_buffer { "Texture Upload" };
 			immediate_command_buffer.add_destruction_callback(
 				[staging_buffer, staging_buffer_allocation](Allocator& alloc) { alloc.destroy_buffer(staging_buffer, staging_buffer_allocation); });
 
-			VkImageSubresourceRange subresource_range = {};
-			subresource_range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			subresource_range.baseMipLevel = 0;
-			subresource_range.levelCount = 1;
-			subresource_range.layerCount = 1;
-
-			VkImageMemoryBarrier image_memory_barrier {};
-			image_memory_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-			image_memory_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-			image_memory_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-			image_memory_barrier.image = info.image;
-			image_memory_barrier.subresourceRange = subresource_range;
-			image_memory_barrier.srcAccessMask = 0;
-			image_memory_barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-			image_memory_barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-			image_memory_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-
-			vkCmdPipelineBarrier(*immediate_command_buffer, VK_PIPELINE_STAGE_HOST_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1,
-				&image_memory_barrier);
-
-			VkBufferImageCopy buffer_copy_region = {};
-			buffer_copy_region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			buffer_copy_region.imageSubresource.mipLevel = 0;
-			buffer_copy_region.imageSubresource.baseArrayLayer = 0;
-			buffer_copy_region.imageSubresource.layerCount = 1;
-			buffer_copy_region.imageExtent.width = width;
-			buffer_copy_region.imageExtent.height = height;
-			buffer_copy_region.imageExtent.depth = 1;
-			buffer_copy_region.bufferOffset = 0;
-
-			vkCmdCopyBufferToImage(
-				*immediate_command_buffer, staging_buffer, info.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &buffer_copy_region);
-
-			if (mip_count > 1) // Mips to generate
-			{
-				Utilities::insert_image_memory_barrier(*immediate_command_buffer, info.image, VK_ACCESS_TRANSFER_WRITE_BIT,
-					VK_ACCESS_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-					VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, subresource_range);
-			} else {
-				Utilities::insert_image_memory_barrier(*immediate_command_buffer, info.image, VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_SHADER_READ_BIT,
-					VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, image->get_descriptor_info().imageLayout, VK_PIPELINE_STAGE_TRANSFER_BIT,
-					VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, subresource_range);
-			}
-
+			record_upload(*immediate_command_buffer, staging_buffer, 0, mip_offsets);
 		} else {
 			ImmediateCommandBuffer immediate_command_buffer { "Texture Image Layout" };
 
@@ -252,10 +388,42 @@ namespace Alabaster {
 			subresource_range.layerCount = 1;
 			subresource_range.levelCount = get_mip_level_count();
 
-			Utilities::set_image_layout(
-				*immediate_command_buffer, info.image, VK_IMAGE_LAYOUT_UNDEFINED, image->get_descriptor_info().imageLayout, subresource_range);
+			Utilities::set_image_layout(*immediate_command_buffer, image->get_info().image, VK_IMAGE_LAYOUT_UNDEFINED,
+				image->get_descriptor_info().imageLayout, subresource_range);
 		}
 
+		stbi_image_free(image_data.data);
+		image_data = Buffer();
+	}
+
+	void Texture::create_image_resources()
+	{
+		const auto& vulkan_device = GraphicsContext::the().device();
+
+		// A streamed handle shares the placeholder's image, it gets its own before anything is released.
+		if (!owns_image) {
+			ImageSpecification image_spec;
+			image_spec.debug_name = properties.debug_name;
+			image = Image::create(image_spec);
+			owns_image = true;
+		}
+
+		image->release();
+		uint32_t mip_count = provided_mips > 0 ? provided_mips : properties.generate_mips ? get_mip_level_count() : 1;
+
+		ImageSpecification& image_spec = image->get_specification();
+		image_spec.format = format;
+		image_spec.width = width;
+		image_spec.height = height;
+		image_spec.mips = mip_count;
+
+		image->invalidate();
+
+		auto& info = image->get_info();
+
+		// The image comes with a clamping sampler and a default view, replace them with ones that follow the texture properties.
+		vkDestroySampler(vulkan_device, info.sampler, nullptr);
+
 		VkSamplerCreateInfo sampler {};
 		sampler.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
 		sampler.maxAnisotropy = 1.0f;
@@ -277,6 +445,8 @@ namespace Alabaster {
 		vk_check(vkCreateSampler(vulkan_device, &sampler, nullptr, &info.sampler));
 
 		if (!properties.storage) {
+			vkDestroyImageView(vulkan_device, info.view, nullptr);
+
 			VkImageViewCreateInfo view {};
 			view.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
 			view.viewType = VK_IMAGE_VIEW_TYPE_2D;
@@ -289,15 +459,63 @@ namespace Alabaster {
 			view.subresourceRange.levelCount = mip_count;
 			view.image = info.image;
 			vk_check(vkCreateImageView(vulkan_device, &view, nullptr, &info.view));
+		}
+
+		image->update_descriptor();
+	}
+
+	void Texture::record_upload(VkCommandBuffer command_buffer, VkBuffer staging_buffer, VkDeviceSize offset) const
+	{
+		static constexpr std::array<VkDeviceSize, 1> top_mip = { 0 };
+		record_upload(command_buffer, staging_buffer, offset, top_mip);
+	}
 
-			image->update_descriptor();
+	void Texture::record_upload(
+		VkCommandBuffer command_buffer, VkBuffer staging_buffer, VkDeviceSize offset, std::span<const VkDeviceSize> mip_offsets) const
+	{
+		const auto& info = image->get_info();
+		const auto mip_count = image->get_specification().mips;
+		const auto copied_mips = std::min(static_cast<std::uint32_t>(mip_offsets.size()), mip_count);
+		Alabaster::assert_that(copied_mips == mip_count || (copied_mips == 1 && !Utilities::is_block_compressed(format)),
+			"Only uncompressed textures can generate the mips that were not uploaded.");
+
+		VkImageSubresourceRange subresource_range = {};
+		subresource_range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		subresource_range.baseMipLevel = 0;
+		subresource_range.levelCount = copied_mips;
+		subresource_range.layerCount = 1;
+
+		Utilities::insert_image_memory_barrier(command_buffer, info.image, 0, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED,
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_HOST_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, subresource_range);
+
+		std::vector<VkBufferImageCopy> buffer_copy_regions(copied_mips);
+		for (std::uint32_t mip = 0; mip < copied_mips; mip++) {
+			const auto [mip_width, mip_height] = get_mip_size(mip);
+
+			auto& buffer_copy_region = buffer_copy_regions[mip];
+			buffer_copy_region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			buffer_copy_region.imageSubresource.mipLevel = mip;
+			buffer_copy_region.imageSubresource.baseArrayLayer = 0;
+			buffer_copy_region.imageSubresource.layerCount = 1;
+			buffer_copy_region.imageExtent.width = std::max(mip_width, 1u);
+			buffer_copy_region.imageExtent.height = std::max(mip_height, 1u);
+			buffer_copy_region.imageExtent.depth = 1;
+			buffer_copy_region.bufferOffset = offset + mip_offsets[mip];
 		}
 
-		if (image_data && properties.generate_mips && mip_count > 1)
-			generate_mips();
+		vkCmdCopyBufferToImage(command_buffer, staging_buffer, info.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			static_cast<std::uint32_t>(buffer_copy_regions.size()), buffer_copy_regions.data());
 
-		stbi_image_free(image_data.data);
-		image_data = Buffer();
+		if (mip_count > copied_mips) {
+			Utilities::insert_image_memory_barrier(command_buffer, info.image, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+				VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT,
+				VK_PIPELINE_STAGE_TRANSFER_BIT, subresource_range);
+			record_mips(command_buffer);
+		} else {
+			Utilities::insert_image_memory_barrier(command_buffer, info.image, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+				VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, image->get_descriptor_info().imageLayout, VK_PIPELINE_STAGE_TRANSFER_BIT,
+				VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, subresource_range);
+		}
 	}
 
 	Buffer Texture::get_writeable_buffer() { return image_data; }
@@ -323,9 +541,13 @@ namespace Alabaster {
 
 	void Texture::generate_mips()
 	{
-		const auto& info = image->get_info();
-
 		ImmediateCommandBuffer immediate_command_buffer { "Mip Generation" };
+		record_mips(immediate_command_buffer.get_buffer());
+	}
+
+	void Texture::record_mips(VkCommandBuffer command_buffer) const
+	{
+		const auto& info = image->get_info();
 
 		const auto mip_levels = get_mip_level_count();
 		for (uint32_t i = 1; i < mip_levels; i++) {
@@ -335,16 +557,16 @@ namespace Alabaster {
 			image_blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
 			image_blit.srcSubresource.layerCount = 1;
 			image_blit.srcSubresource.mipLevel = i - 1;
-			image_blit.srcOffsets[1].x = int32_t(width >> (i - 1));
-			image_blit.srcOffsets[1].y = int32_t(height >> (i - 1));
+			image_blit.srcOffsets[1].x = std::max(int32_t(width >> (i - 1)), 1);
+			image_blit.srcOffsets[1].y = std::max(int32_t(height >> (i - 1)), 1);
 			image_blit.srcOffsets[1].z = 1;
 
 			// Destination
 			image_blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
 			image_blit.dstSubresource.layerCount = 1;
 			image_blit.dstSubresource.mipLevel = i;
-			image_blit.dstOffsets[1].x = int32_t(width >> i);
-			image_blit.dstOffsets[1].y = int32_t(height >> i);
+			image_blit.dstOffsets[1].x = std::max(int32_t(width >> i), 1);
+			image_blit.dstOffsets[1].y = std::max(int32_t(height >> i), 1);
 			image_blit.dstOffsets[1].z = 1;
 
 			VkImageSubresourceRange mip_sub_range = {};
@@ -354,18 +576,17 @@ namespace Alabaster {
 			mip_sub_range.layerCount = 1;
 
 			// Prepare current mip level as image blit destination
-			Utilities::insert_image_memory_barrier(immediate_command_buffer.get_buffer(), info.image, 0, VK_ACCESS_TRANSFER_WRITE_BIT,
-				VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
-				mip_sub_range);
+			Utilities::insert_image_memory_barrier(command_buffer, info.image, 0, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_UNDEFINED,
+				VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, mip_sub_range);
 
 			// Blit from previous level
-			vkCmdBlitImage(immediate_command_buffer.get_buffer(), info.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, info.image,
-				VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &image_blit, Utilities::vulkan_sampler_filter(properties.sampler_filter));
+			vkCmdBlitImage(command_buffer, info.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, info.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
+				&image_blit, Utilities::vulkan_sampler_filter(properties.sampler_filter));
 
 			// Prepare current mip level as image blit source for next level
-			Utilities::insert_image_memory_barrier(immediate_command_buffer.get_buffer(), info.image, VK_ACCESS_TRANSFER_WRITE_BIT,
-				VK_ACCESS_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-				VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, mip_sub_range);
+			Utilities::insert_image_memory_barrier(command_buffer, info.image, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+				VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT,
+				VK_PIPELINE_STAGE_TRANSFER_BIT, mip_sub_range);
 		}
 
 		// After the loop, all mip layers are in TRANSFER_SRC layout, so transition all to SHADER_READ
@@ -374,8 +595,8 @@ namespace Alabaster {
 		subresource_range.layerCount = 1;
 		subresource_range.levelCount = mip_levels;
 
-		Utilities::insert_image_memory_barrier(immediate_command_buffer.get_buffer(), info.image, VK_ACCESS_TRANSFER_READ_BIT,
-			VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT,
+		Utilities::insert_image_memory_barrier(command_buffer, info.image, VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_SHADER_READ_BIT,
+			VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT,
 			VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, subresource_range);
 	}
 
@@ -28,6 +28,10 @@ namespace Alabaster::Utilities {
 
 	size_t get_memory_size(ImageFormat format, uint32_t width, uint32_t height)
 	{
+		if (is_block_compressed(format)) {
+			return get_image_memory_size(format, width, height);
+		}
+
 		const auto image_size = width * height;
 		switch (format) {
 		case ImageFormat::RED16UI:
@@ -64,6 +68,10 @@ namespace Alabaster::Utilities {
 			return image_size * sizeof(float);
 		case ImageFormat::DEPTH24STENCIL8:
 			return image_size * sizeof(float);
+		case ImageFormat::BC1:
+		case ImageFormat::BC3:
+		case ImageFormat::BC5:
+		case ImageFormat::BC7:
 		case ImageFormat::None:
 			break;
 		}
@@ -185,6 +193,14 @@ namespace Alabaster::Utilities {
 			return VK_FORMAT_R8G8B8_UNORM;
 		case ImageFormat::SRGB:
 			return VK_FORMAT_R8G8B8_SRGB;
+		case ImageFormat::BC1:
+			return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+		case ImageFormat::BC3:
+			return VK_FORMAT_BC3_SRGB_BLOCK;
+		case ImageFormat::BC5:
+			return VK_FORMAT_BC5_UNORM_BLOCK;
+		case ImageFormat::BC7:
+			return VK_FORMAT_BC7_SRGB_BLOCK;
 		case ImageFormat::None:
 			break;
 		}
@@ -352,6 +368,12 @@ namespace Alabaster::Utilities {
 			return 4 * 4;
 		case ImageFormat::B10R11G11UF:
 			return 4;
+		case ImageFormat::BC1:
+			return 8;
+		case ImageFormat::BC3:
+		case ImageFormat::BC5:
+		case ImageFormat::BC7:
+			return 16;
 		default:
 			throw AlabasterException("Test");
 		}
@@ -377,6 +399,10 @@ namespace Alabaster::Utilities {
 		case ImageFormat::RGBA16F:
 		case ImageFormat::RGB:
 		case ImageFormat::SRGB:
+		case ImageFormat::BC1:
+		case ImageFormat::BC3:
+		case ImageFormat::BC5:
+		case ImageFormat::BC7:
 		case ImageFormat::DEPTH24STENCIL8:
 		case ImageFormat::None:
 			return false;
@@ -386,7 +412,18 @@ namespace Alabaster::Utilities {
 
 	uint32_t calculate_mip_count(uint32_t width, uint32_t height) { return (uint32_t)std::floor(std::log2(glm::min(width, height))) + 1; }
 
-	uint32_t get_image_memory_size(ImageFormat format, uint32_t width, uint32_t height) { return width * height * get_image_format_bpp(format); }
+	uint32_t get_image_memory_size(ImageFormat format, uint32_t width, uint32_t height)
+	{
+		if (is_block_compressed(format)) {
+			return ((width + 3) / 4) * ((height + 3) / 4) * get_image_format_bpp(format);
+		}
+		return width * height * get_image_format_bpp(format);
+	}
+
+	bool is_block_compressed(ImageFormat format)
+	{
+		return format == ImageFormat::BC1 || format == ImageFormat::BC3 || format == ImageFormat::BC5 || format == ImageFormat::BC7;
+	}
 
 	bool is_depth_format(ImageFormat format)
 	{
@@ -0,0 +1,60 @@
+#include "av_pch.hpp"
+
+#include "filesystem/MappedFile.hpp"
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+namespace Alabaster {
+
+	std::optional<MappedFile> MappedFile::open(const std::filesystem::path& path)
+	{
+		auto* file_handle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file_handle == INVALID_HANDLE_VALUE) {
+			return {};
+		}
+
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(file_handle, &file_size)) {
+			CloseHandle(file_handle);
+			return {};
+		}
+
+		MappedFile file;
+		file.size = static_cast<std::size_t>(file_size.QuadPart);
+		if (file.size > 0) {
+			auto* mapping = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (!mapping) {
+				CloseHandle(file_handle);
+				return {};
+			}
+
+			auto* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			if (!view) {
+				CloseHandle(mapping);
+				CloseHandle(file_handle);
+				return {};
+			}
+			file.data = static_cast<const std::uint8_t*>(view);
+			file.handle = mapping;
+		}
+
+		// The view keeps the file alive on its own.
+		CloseHandle(file_handle);
+		return file;
+	}
+
+	void MappedFile::unmap()
+	{
+		if (data) {
+			UnmapViewOfFile(data);
+		}
+		if (handle) {
+			CloseHandle(handle);
+		}
+		data = nullptr;
+		size = 0;
+		handle = nullptr;
+	}
+
+} // namespace Alabaster
@@ -0,0 +1,255 @@
+#include "av_pch.hpp"
+
+#include "filesystem/AssetPack.hpp"
+
+#include "core/Logger.hpp"
+#include "utilities/Hash.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace Alabaster {
+
+	static constexpr std::uint32_t pack_magic = 0x4B415041; // "APAK"
+	static constexpr std::uint32_t pack_version = 1;
+
+	struct PackHeader {
+		std::uint32_t magic;
+		std::uint32_t version;
+		std::uint32_t entry_count;
+		std::uint32_t alignment;
+		std::uint64_t strings_offset;
+		std::uint64_t strings_size;
+	};
+
+	struct PackEntry {
+		std::uint64_t path_offset;
+		std::uint32_t path_size;
+		std::uint32_t reserved;
+		std::uint64_t offset;
+		std::uint64_t size;
+		std::uint64_t hash;
+	};
+
+	static_assert(sizeof(PackHeader) == 32 && sizeof(PackEntry) == 40, "The pack layout is persisted, its records must not change size.");
+
+	template <typename T> static void write_pod(std::ofstream& stream, const T& value)
+	{
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template <typename T> static T read_pod(std::span<const std::uint8_t> bytes, std::uint64_t offset)
+	{
+		// The mapping is only guaranteed to be byte aligned at arbitrary offsets.
+		T value;
+		std::memcpy(&value, bytes.data() + offset, sizeof(T));
+		return value;
+	}
+
+	static std::uint64_t align_up(std::uint64_t value, std::uint64_t alignment) { return (value + alignment - 1) & ~(alignment - 1); }
+
+	std::optional<AssetPack> AssetPack::open(const std::filesystem::path& path)
+	{
+		auto mapped = MappedFile::open(path);
+		if (!mapped) {
+			return {};
+		}
+
+		const auto bytes = mapped->bytes();
+		if (bytes.size() < sizeof(PackHeader)) {
+			return {};
+		}
+
+		const auto header = read_pod<PackHeader>(bytes, 0);
+		if (header.magic != pack_magic || header.version != pack_version) {
+			return {};
+		}
+
+		const auto table_end = sizeof(PackHeader) + static_cast<std::uint64_t>(header.entry_count) * sizeof(PackEntry);
+		if (table_end > bytes.size() || header.strings_offset < table_end || header.strings_offset > bytes.size()
+			|| header.strings_size > bytes.size() - header.strings_offset) {
+			return {};
+		}
+
+		AssetPack pack;
+		pack.table.reserve(header.entry_count);
+		for (std::uint32_t i = 0; i < header.entry_count; i++) {
+			const auto packed = read_pod<PackEntry>(bytes, sizeof(PackHeader) + static_cast<std::uint64_t>(i) * sizeof(PackEntry));
+			if (packed.path_offset > header.strings_size || packed.path_size > header.strings_size - packed.path_offset) {
+				return {};
+			}
+			if (packed.offset > bytes.size() || packed.size > bytes.size() - packed.offset) {
+				return {};
+			}
+
+			const auto* path_data = reinterpret_cast<const char*>(bytes.data() + header.strings_offset + packed.path_offset);
+			Entry entry;
+			entry.path = std::string_view { path_data, packed.path_size };
+			entry.bytes = bytes.subspan(packed.offset, packed.size);
+			entry.hash = packed.hash;
+
+			// Lookups binary search the table, so a pack that is not strictly sorted is as good as corrupt.
+			if (!pack.table.empty() && pack.table.back().path >= entry.path) {
+				return {};
+			}
+			pack.table.push_back(entry);
+		}
+
+		pack.file = std::move(*mapped);
+		pack.checked = std::vector<std::atomic<Check>>(pack.table.size());
+		return pack;
+	}
+
+	bool AssetPack::write(const std::filesystem::path& output, const std::filesystem::path& directory)
+	{
+		std::error_code error;
+		std::vector<std::pair<std::string, std::filesystem::path>> files;
+		for (const auto& entry : std::filesystem::recursive_directory_iterator { directory, error }) {
+			if (entry.is_regular_file()) {
+				files.emplace_back(entry.path().lexically_relative(directory).generic_string(), entry.path());
+			}
+		}
+		if (error) {
+			Log::warn("[AssetPack] Could not walk {}. Reason: {}", directory.string(), error.message());
+			return false;
+		}
+		std::ranges::sort(files, {}, &std::pair<std::string, std::filesystem::path>::first);
+
+		std::vector<MappedFile> contents;
+		contents.reserve(files.size());
+		for (const auto& [relative, full_path] : files) {
+			auto mapped = MappedFile::open(full_path);
+			if (!mapped) {
+				Log::warn("[AssetPack] Could not read {}.", full_path.string());
+				return false;
+			}
+			contents.push_back(std::move(*mapped));
+		}
+
+		PackHeader header {};
+		header.magic = pack_magic;
+		header.version = pack_version;
+		header.entry_count = static_cast<std::uint32_t>(files.size());
+		header.alignment = static_cast<std::uint32_t>(blob_alignment);
+		header.strings_offset = sizeof(PackHeader) + files.size() * sizeof(PackEntry);
+
+		std::vector<PackEntry> table(files.size());
+		std::string strings;
+		for (std::size_t i = 0; i < files.size(); i++) {
+			table[i].path_offset = strings.size();
+			table[i].path_size = static_cast<std::uint32_t>(files[i].first.size());
+			strings += files[i].first;
+		}
+		header.strings_size = strings.size();
+
+		auto offset = header.strings_offset + header.strings_size;
+		for (std::size_t i = 0; i < files.size(); i++) {
+			const auto bytes = contents[i].bytes();
+			offset = align_up(offset, blob_alignment);
+			table[i].offset = offset;
+			table[i].size = bytes.size();
+			table[i].hash = Hash::hash_bytes(bytes.data(), bytes.size());
+			offset += bytes.size();
+		}
+
+		const auto thread_hash = std::hash<std::thread::id> {}(std::this_thread::get_id());
+		const auto temporary_path = std::filesystem::path { output }.concat(fmt::format(".{}.tmp", thread_hash));
+		{
+			std::ofstream stream(temporary_path, std::ios::binary | std::ios::trunc);
+			if (!stream) {
+				Log::warn("[AssetPack] Could not open {} for writing.", temporary_path.string());
+				return false;
+			}
+
+			write_pod(stream, header);
+			for (const auto& entry : table) {
+				write_pod(stream, entry);
+			}
+			stream.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+
+			static constexpr std::array<char, blob_alignment> padding {};
+			auto written = header.strings_offset + header.strings_size;
+			for (std::size_t i = 0; i < files.size(); i++) {
+				stream.write(padding.data(), static_cast<std::streamsize>(table[i].offset - written));
+				const auto bytes = contents[i].bytes();
+				stream.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+				written = table[i].offset + table[i].size;
+			}
+			if (!stream) {
+				Log::warn("[AssetPack] Could not write {}.", temporary_path.string());
+				return false;
+			}
+		}
+
+		std::filesystem::rename(temporary_path, output, error);
+		if (error) {
+			std::filesystem::remove(temporary_path, error);
+			return false;
+		}
+		return true;
+	}
+
+	const AssetPack::Entry* AssetPack::lookup(std::string_view path) const
+	{
+		const auto found = std::ranges::lower_bound(table, path, {}, &Entry::path);
+		if (found == table.end() || found->path != path) {
+			return nullptr;
+		}
+		return &*found;
+	}
+
+	std::optional<std::span<const std::uint8_t>> AssetPack::find(std::string_view path) const
+	{
+		const auto* entry = lookup(path);
+		if (!entry) {
+			return {};
+		}
+
+		// Threads racing on the first read both hash the entry and agree on the outcome.
+		auto& check = checked[static_cast<std::size_t>(entry - table.data())];
+		if (check.load(std::memory_order_acquire) == Check::Pending) {
+			const auto intact = verify(*entry);
+			if (!intact) {
+				Log::warn("[AssetPack] {} does not match the hash it was packed with.", entry->path);
+			}
+			check.store(intact ? Check::Intact : Check::Corrupt, std::memory_order_release);
+		}
+		if (check.load(std::memory_order_acquire) == Check::Corrupt) {
+			return {};
+		}
+		return entry->bytes;
+	}
+
+	bool AssetPack::verify_all() const
+	{
+		auto intact = true;
+		for (const auto& entry : table) {
+			intact &= find(entry.path).has_value();
+		}
+		return intact;
+	}
+
+	std::vector<const AssetPack::Entry*> AssetPack::list(std::string_view directory, bool recursive) const
+	{
+		std::string prefix { directory };
+		if (!prefix.empty() && prefix.back() != '/') {
+			prefix += '/';
+		}
+
+		// Everything below a directory shares its prefix, so it is one contiguous run of the sorted table.
+		std::vector<const Entry*> output;
+		for (auto it = std::ranges::lower_bound(table, std::string_view { prefix }, {}, &Entry::path); it != table.end(); ++it) {
+			if (!it->path.starts_with(prefix)) {
+				break;
+			}
+			if (recursive || it->path.find('/', prefix.size()) == std::string_view::npos) {
+				output.push_back(&*it);
+			}
+		}
+		return output;
+	}
+
+	bool AssetPack::verify(const Entry& entry) { return Hash::hash_bytes(entry.bytes.data(), entry.bytes.size()) == entry.hash; }
+
+} // namespace Alabaster
@@ -8,40 +8,20 @@
 
 namespace Alabaster::IO {
 
-	std::string read_file(const std::filesystem::path& filename, OpenMode mode)
+	std::string read_file(const std::filesystem::path& filename, OpenMode)
 	{
-#ifdef ALABASTER_WINDOWS
-		std::ifstream stream(filename, static_cast<int>(mode | OpenMode::AtEnd));
-#else
-		std::ifstream stream(filename, static_cast<std::ios_base::openmode>(mode | OpenMode::AtEnd));
-#endif
-
-		if (!stream) {
-			throw AlabasterException("{}", "Could not open filestream to shader file.");
+		// Files are mapped (or found in a mounted pack) and copied once into the string, which makes every read binary.
+		const auto file = FileSystem::read(filename);
+		if (!file) {
+			throw AlabasterException("Could not open {}.", filename.string());
 		}
 
-		auto size = stream.tellg();
-		verify(size > 0, "Size of file must be greater than zero.");
-
-		std::vector<char> buffer;
-		buffer.resize(size);
-
-		stream.seekg(0);
-
-		stream.read(buffer.data(), size);
-
-		return std::string(buffer.begin(), buffer.end());
+		verify(!file->bytes.empty(), "Size of file must be greater than zero.");
+		return std::string { file->text() };
 	}
 	std::string read_file(std::filesystem::path&& filename, OpenMode mode) { return IO::read_file(filename, mode); }
-	bool exists(const std::filesystem::path& path)
-	{
-		return std::filesystem::exists(path) || std::filesystem::exists(FileSystem::resources() / path);
-	}
-	bool is_file(const std::filesystem::path& path)
-	{
-		const auto regular_file = std::filesystem::is_regular_file(path) || std::filesystem::is_regular_file(FileSystem::resources() / path);
-		return IO::exists(path) && regular_file;
-	}
+	bool exists(const std::filesystem::path& path) { return FileSystem::exists(path) || FileSystem::exists(FileSystem::resources() / path); }
+	bool is_file(const std::filesystem::path& path) { return FileSystem::is_file(path) || FileSystem::is_file(FileSystem::resources() / path); }
 	std::filesystem::path independent_path(const std::string& path)
 	{
 		verify(path.find('/') != std::string::npos);
@@ -0,0 +1,55 @@
+#include "av_pch.hpp"
+
+#include "filesystem/FileStamp.hpp"
+
+#include "filesystem/FileSystem.hpp"
+#include "utilities/Hash.hpp"
+
+namespace Alabaster {
+
+	bool FileStamp::can_reuse_hash(const FileStamp& previous) const
+	{
+		return last_write != 0 && last_write == previous.last_write && size == previous.size;
+	}
+
+	FileStamp FileStamp::stat(const std::filesystem::path& path)
+	{
+		FileStamp output;
+		std::error_code error;
+		output.size = std::filesystem::file_size(path, error);
+		const auto write_time = error ? std::filesystem::file_time_type {} : std::filesystem::last_write_time(path, error);
+		if (error) {
+			// Not a loose file, e.g. one in a mounted pack. Those do not change, but their contents are all we can go by.
+			return {};
+		}
+		if (std::filesystem::file_time_type::clock::now() - write_time > racy_window) {
+			output.last_write = static_cast<std::int64_t>(write_time.time_since_epoch().count());
+		}
+		return output;
+	}
+
+	FileStamp FileStamp::hashed(std::span<const std::uint8_t> contents) const
+	{
+		return {
+			.size = contents.size(),
+			.last_write = size == contents.size() ? last_write : 0,
+			.hash = Hash::hash_bytes(contents.data(), contents.size()),
+		};
+	}
+
+	std::optional<FileStamp> FileStamp::of(const std::filesystem::path& path, const FileStamp* previous)
+	{
+		auto output = stat(path);
+		if (previous && output.can_reuse_hash(*previous)) {
+			output.hash = previous->hash;
+			return output;
+		}
+
+		const auto contents = FileSystem::read(path);
+		if (!contents) {
+			return {};
+		}
+		return output.hashed(contents->bytes);
+	}
+
+} // namespace Alabaster
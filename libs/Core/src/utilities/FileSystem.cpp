@@ -7,6 +7,10 @@
 #include "filesystem/FileSystem.hpp"
 
 #include "core/Logger.hpp"
+#include "filesystem/AssetPack.hpp"
+
+#include <mutex>
+#include <shared_mutex>
 
 namespace Alabaster::FileSystem {
 
@@ -23,6 +27,165 @@ namespace Alabaster::FileSystem {
 	std::filesystem::path scenes() { return root / std::filesystem::path { "scene" }; }
 	std::filesystem::path scripts() { return root / std::filesystem::path { "scripts" }; }
 	std::filesystem::path editor_resources() { return root / std::filesystem::path { "editor" }; }
+	std::filesystem::path cache() { return root / std::filesystem::path { "cache" }; }
+
+	struct Mount {
+		std::filesystem::path directory;
+		std::shared_ptr<const AssetPack> pack;
+	};
+
+	// Mounting happens at start up, lookups come from every loader thread.
+	static std::shared_mutex mount_mutex;
+	static std::vector<Mount> mounts;
+
+	/// @return generic path relative to the resource root, or nothing if the path is not below it
+	static std::optional<std::string> relative_to_root(const std::filesystem::path& path)
+	{
+		// Before the file system is initialised there is no root to be below, and nothing mounted to resolve against.
+		if (root.empty()) {
+			return {};
+		}
+		auto relative = path.lexically_normal().lexically_relative(root.lexically_normal());
+		if (relative.empty() && path.is_absolute() != root.is_absolute()) {
+			relative = std::filesystem::absolute(path).lexically_normal().lexically_relative(std::filesystem::absolute(root).lexically_normal());
+		}
+		if (relative.empty() || *relative.begin() == "..") {
+			return {};
+		}
+		if (relative == ".") {
+			return std::string {};
+		}
+		return relative.generic_string();
+	}
+
+	bool mount(const std::filesystem::path& source)
+	{
+		Mount mount;
+		std::error_code error;
+		if (std::filesystem::is_directory(source, error)) {
+			mount.directory = source;
+		} else if (auto pack = AssetPack::open(source)) {
+			mount.pack = std::make_shared<const AssetPack>(std::move(*pack));
+		} else {
+			Log::warn("[FileSystem] {} is neither a directory nor an asset pack.", source.string());
+			return false;
+		}
+
+		std::unique_lock lock { mount_mutex };
+		Log::info("[FileSystem] Mounted {}{}.", source.string(), mount.pack ? fmt::format(" ({} files)", mount.pack->entries().size()) : "");
+		mounts.push_back(std::move(mount));
+		return true;
+	}
+
+	void unmount_all()
+	{
+		std::unique_lock lock { mount_mutex };
+		mounts.clear();
+	}
+
+	std::optional<FileView> read(const std::filesystem::path& path)
+	{
+		const auto map = [](const std::filesystem::path& file) -> std::optional<FileView> {
+			auto mapped = MappedFile::open(file);
+			if (!mapped) {
+				return {};
+			}
+			auto owner = std::make_shared<const MappedFile>(std::move(*mapped));
+			return FileView { .bytes = owner->bytes(), .owner = owner };
+		};
+
+		if (const auto relative = relative_to_root(path)) {
+			std::shared_lock lock { mount_mutex };
+			for (auto it = mounts.rbegin(); it != mounts.rend(); ++it) {
+				if (!it->pack) {
+					if (auto view = map(it->directory / *relative)) {
+						return view;
+					}
+				} else if (const auto bytes = it->pack->find(*relative)) {
+					return FileView { .bytes = *bytes, .owner = it->pack };
+				}
+			}
+		}
+		return map(path);
+	}
+
+	bool exists(const std::filesystem::path& path)
+	{
+		if (const auto relative = relative_to_root(path)) {
+			std::shared_lock lock { mount_mutex };
+			for (const auto& mount : mounts) {
+				std::error_code error;
+				if (mount.pack ? mount.pack->contains(*relative) : std::filesystem::exists(mount.directory / *relative, error)) {
+					return true;
+				}
+			}
+		}
+		std::error_code error;
+		return std::filesystem::exists(path, error);
+	}
+
+	bool is_file(const std::filesystem::path& path)
+	{
+		if (const auto relative = relative_to_root(path)) {
+			std::shared_lock lock { mount_mutex };
+			for (const auto& mount : mounts) {
+				std::error_code error;
+				if (mount.pack ? mount.pack->contains(*relative) : std::filesystem::is_regular_file(mount.directory / *relative, error)) {
+					return true;
+				}
+			}
+		}
+		std::error_code error;
+		return std::filesystem::is_regular_file(path, error);
+	}
+
+	std::vector<std::filesystem::path> mounted_files(const std::filesystem::path& directory, bool recursive)
+	{
+		const auto relative = relative_to_root(directory);
+		if (!relative) {
+			return {};
+		}
+
+		std::vector<std::filesystem::path> output;
+		std::unordered_set<std::string> seen;
+		const auto add = [&](const std::string& file) {
+			if (seen.insert(file).second) {
+				const auto below = relative->empty() ? std::filesystem::path { file } : std::filesystem::path { file }.lexically_relative(*relative);
+				output.push_back((directory / below).make_preferred());
+			}
+		};
+
+		std::shared_lock lock { mount_mutex };
+		for (auto it = mounts.rbegin(); it != mounts.rend(); ++it) {
+			if (it->pack) {
+				for (const auto* entry : it->pack->list(*relative, recursive)) {
+					add(std::string { entry->path });
+				}
+				continue;
+			}
+
+			std::error_code error;
+			const auto mounted_directory = it->directory / *relative;
+			if (!std::filesystem::is_directory(mounted_directory, error)) {
+				continue;
+			}
+			const auto add_entry = [&](const std::filesystem::directory_entry& entry) {
+				if (entry.is_regular_file()) {
+					add((std::filesystem::path { *relative } / entry.path().lexically_relative(mounted_directory)).generic_string());
+				}
+			};
+			if (recursive) {
+				for (const auto& entry : std::filesystem::recursive_directory_iterator { mounted_directory, error }) {
+					add_entry(entry);
+				}
+			} else {
+				for (const auto& entry : std::filesystem::directory_iterator { mounted_directory, error }) {
+					add_entry(entry);
+				}
+			}
+		}
+		return output;
+	}
 
 	std::vector<std::filesystem::path> find_fonts_with_name(const std::string_view name) { return find_with_name(name, FileSystem::fonts()); }
 	std::vector<std::filesystem::path> find_shaders_with_name(const std::string_view name) { return find_with_name(name, FileSystem::shaders()); }
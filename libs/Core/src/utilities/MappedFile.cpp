@@ -0,0 +1,27 @@
+#include "av_pch.hpp"
+
+#include "filesystem/MappedFile.hpp"
+
+namespace Alabaster {
+
+	MappedFile::~MappedFile() { unmap(); }
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+		: data(std::exchange(other.data, nullptr))
+		, size(std::exchange(other.size, 0))
+		, handle(std::exchange(other.handle, nullptr))
+	{
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other) {
+			unmap();
+			data = std::exchange(other.data, nullptr);
+			size = std::exchange(other.size, 0);
+			handle = std::exchange(other.handle, nullptr);
+		}
+		return *this;
+	}
+
+} // namespace Alabaster
@@ -0,0 +1,123 @@
+#include "graphics/FrustumCuller.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <vector>
+
+using namespace Alabaster;
+
+/// @brief A perspective projection looking down -z from the origin, with depth running from 0 to 1 as in Vulkan.
+static glm::mat4 perspective(float vertical_fov, float aspect, float near_plane, float far_plane)
+{
+	const auto focal = 1.0f / std::tan(0.5f * vertical_fov);
+	return {
+		glm::vec4 { focal / aspect, 0.0f, 0.0f, 0.0f },
+		glm::vec4 { 0.0f, focal, 0.0f, 0.0f },
+		glm::vec4 { 0.0f, 0.0f, far_plane / (near_plane - far_plane), -1.0f },
+		glm::vec4 { 0.0f, 0.0f, far_plane * near_plane / (near_plane - far_plane), 0.0f },
+	};
+}
+
+static float margin_of(const Frustum& frustum, const WorldBounds& bounds)
+{
+	auto margin = std::numeric_limits<float>::max();
+	for (const auto& plane : frustum.planes) {
+		const glm::vec3 normal { plane };
+		const auto reach = std::min(glm::dot(glm::abs(normal), bounds.extent), bounds.radius);
+		margin = std::min(margin, glm::dot(normal, bounds.centre) + plane.w + reach);
+	}
+	return margin;
+}
+
+TEST(FrustumCullerTest, WorldBoundsFollowTheTransform)
+{
+	const MeshBounds cube { .min = glm::vec3 { -1.0f }, .max = glm::vec3 { 1.0f }, .radius = std::sqrt(3.0f) };
+
+	// Scaled by two, turned 45 degrees about z and moved along x.
+	const auto turn = std::numbers::sqrt2_v<float>;
+	const glm::mat4 transform { glm::vec4 { turn, turn, 0.0f, 0.0f }, glm::vec4 { -turn, turn, 0.0f, 0.0f }, glm::vec4 { 0.0f, 0.0f, 2.0f, 0.0f },
+		glm::vec4 { 5.0f, 0.0f, 0.0f, 1.0f } };
+	const auto bounds = WorldBounds::of(cube, transform);
+
+	EXPECT_NEAR(bounds.centre.x, 5.0f, 0.0001f);
+	EXPECT_NEAR(bounds.centre.y, 0.0f, 0.0001f);
+	EXPECT_NEAR(bounds.extent.x, 2.0f * std::numbers::sqrt2_v<float>, 0.0001f);
+	EXPECT_NEAR(bounds.extent.y, 2.0f * std::numbers::sqrt2_v<float>, 0.0001f);
+	EXPECT_NEAR(bounds.extent.z, 2.0f, 0.0001f);
+	EXPECT_NEAR(bounds.radius, 2.0f * std::sqrt(3.0f), 0.0001f);
+}
+
+TEST(FrustumCullerTest, BoxAndSphereBothCull)
+{
+	// The identity clip transform keeps x and y from -1 to 1 and z from 0 to 1.
+	const auto frustum = Frustum::of(glm::mat4 { 1.0f });
+	EXPECT_TRUE(frustum.intersects({ .centre = glm::vec3 { 0.0f }, .extent = glm::vec3 { 0.5f }, .radius = 1.0f }));
+	EXPECT_TRUE(frustum.intersects({ .centre = { 1.5f, 0.0f, 0.0f }, .extent = glm::vec3 { 1.0f }, .radius = 2.0f }));
+	EXPECT_FALSE(frustum.intersects({ .centre = { 3.0f, 0.0f, 0.0f }, .extent = glm::vec3 { 1.0f }, .radius = 2.0f }));
+	EXPECT_TRUE(frustum.intersects(glm::vec3 { 0.0f, 0.0f, 0.5f }, 0.1f));
+	EXPECT_FALSE(frustum.intersects(glm::vec3 { 0.0f, 0.0f, -0.5f }, 0.1f));
+
+	// A thin rod beside the volume, its sphere reaches in but its box does not.
+	const WorldBounds rod { .centre = { 2.5f, 0.0f, 0.0f }, .extent = { 0.1f, 3.0f, 0.1f }, .radius = 3.0f };
+	EXPECT_TRUE(frustum.intersects(rod.centre, rod.radius));
+	EXPECT_FALSE(frustum.intersects(rod));
+
+	// A box turned on its corner, the box around it reaches in but its sphere does not.
+	const WorldBounds turned { .centre = { 2.2f, 2.2f, 0.0f }, .extent = glm::vec3 { 1.5f }, .radius = 1.0f };
+	EXPECT_FALSE(frustum.intersects(turned));
+}
+
+TEST(FrustumCullerTest, VectorsMatchTheScalarTest)
+{
+	const auto view_projection = perspective(std::numbers::pi_v<float> / 3.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+	const auto frustum = Frustum::of(view_projection);
+
+	std::mt19937 generator { 1234 };
+	std::uniform_real_distribution<float> position { -60.0f, 60.0f };
+	std::uniform_real_distribution<float> size { 0.01f, 4.0f };
+
+	// Below and above the parallel threshold, neither a multiple of a vector's width.
+	for (const std::size_t count : { std::size_t { 1003 }, FrustumCuller::parallel_threshold * 3 + 5 }) {
+		SCOPED_TRACE(count);
+		FrustumCuller culler;
+		culler.reserve(count);
+		std::vector<WorldBounds> all_bounds;
+		for (std::size_t i = 0; i < count; i++) {
+			const WorldBounds bounds { .centre = { position(generator), position(generator), -std::abs(position(generator)) },
+				.extent = { size(generator), size(generator), size(generator) },
+				.radius = size(generator) };
+			all_bounds.push_back(bounds);
+			culler.add(bounds);
+		}
+		ASSERT_EQ(culler.size(), count);
+
+		std::vector<std::uint8_t> visible;
+		const auto visible_count = culler.cull(frustum, visible);
+		ASSERT_EQ(visible.size(), count);
+
+		std::size_t expected_count { 0 };
+		std::size_t compared { 0 };
+		for (std::size_t i = 0; i < count; i++) {
+			const auto expected = frustum.intersects(all_bounds[i]);
+			expected_count += expected ? 1 : 0;
+			// Bounds touching a plane may round either way depending on the order the terms are summed in.
+			if (std::abs(margin_of(frustum, all_bounds[i])) < 0.0001f) {
+				continue;
+			}
+			ASSERT_EQ(visible[i] != 0, expected) << i;
+			compared++;
+		}
+		EXPECT_GT(compared, count - 10);
+		EXPECT_NEAR(static_cast<double>(visible_count), static_cast<double>(expected_count), static_cast<double>(count - compared));
+		EXPECT_GT(visible_count, 0);
+		EXPECT_LT(visible_count, count);
+
+		culler.clear();
+		EXPECT_EQ(culler.cull(frustum, visible), 0);
+		EXPECT_TRUE(visible.empty());
+	}
+}
@@ -0,0 +1,211 @@
+#include "filesystem/FileSystem.hpp"
+#include "graphics/MeshFile.hpp"
+#include "utils/TestFiles.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <gtest/gtest.h>
+
+using namespace Alabaster;
+
+// Two triangles sharing an edge, written per corner like an exporter would.
+static constexpr std::string_view quad = "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+										 "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+										 "vn 0 0 1\n"
+										 "f 1/1/1 2/2/1 3/3/1\nf 1/1/1 3/3/1 4/4/1\n";
+
+// The same quad with each triangle carrying its own copies of the shared corners, one of them a rounding error away, and a sliver
+// whose corners all lie within the weld tolerance of the quad's first corner.
+static constexpr std::string_view split_quad = "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 0 0\nv 1 1.000001 0\nv 0 1 0\n"
+											   "v 0.000001 0 0\nv 0 0.000001 0\n"
+											   "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+											   "vn 0 0 1\n"
+											   "f 1/1/1 2/2/1 3/3/1\nf 4/1/1 5/3/1 6/4/1\nf 1/1/1 7/1/1 8/1/1\n";
+
+class MeshFileTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		std::filesystem::remove_all(directory);
+		std::filesystem::create_directories(directory);
+		FileSystem::init_with_cwd(directory);
+		write(source, quad);
+	}
+
+	void TearDown() override { std::filesystem::remove_all(directory); }
+
+	static void write(const std::filesystem::path& path, std::string_view contents)
+	{
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		stream << contents;
+	}
+
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "alabaster_mesh_file";
+	const std::filesystem::path source = directory / "quad.obj";
+	const std::filesystem::path container = directory / "quad.amesh";
+};
+
+TEST_F(MeshFileTest, ImportDeduplicatesVertices)
+{
+	const auto mesh = MeshFile::import_obj(source);
+	ASSERT_TRUE(mesh.has_value());
+	EXPECT_EQ(mesh->vertices.size(), 4);
+	EXPECT_EQ(mesh->indices.size(), 6);
+	EXPECT_EQ(mesh->bounds.min, glm::vec3(0.0f));
+	EXPECT_EQ(mesh->bounds.max, glm::vec3(1.0f, 1.0f, 0.0f));
+	// Every corner of the unit quad is as far from its centre.
+	EXPECT_FLOAT_EQ(mesh->bounds.radius, std::sqrt(0.5f));
+	EXPECT_EQ(mesh->source.size, quad.size());
+}
+
+TEST_F(MeshFileTest, WeldingMergesNearDuplicates)
+{
+	write(source, split_quad);
+
+	const auto separate = MeshFile::import_obj(source);
+	ASSERT_TRUE(separate.has_value());
+	EXPECT_EQ(separate->vertices.size(), 8);
+	EXPECT_EQ(separate->indices.size(), 9);
+
+	const auto welded = MeshFile::import_obj(source, { .weld = true, .weld_tolerance = 0.00001f, .optimise = false });
+	ASSERT_TRUE(welded.has_value());
+	EXPECT_EQ(welded->vertices.size(), 4);
+	ASSERT_EQ(welded->indices.size(), 6);
+	EXPECT_EQ(welded->indices[3], welded->indices[0]);
+	EXPECT_EQ(welded->indices[4], welded->indices[2]);
+}
+
+TEST_F(MeshFileTest, ContainerRoundTrips)
+{
+	const auto mesh = MeshFile::import_obj(source);
+	ASSERT_TRUE(mesh.has_value());
+	ASSERT_TRUE(MeshFile::write(container, *mesh));
+
+	const auto opened = MeshFile::open(container);
+	ASSERT_TRUE(opened.has_value());
+	ASSERT_EQ(opened->vertices().size(), mesh->vertices.size());
+	ASSERT_EQ(opened->indices().size(), mesh->indices.size());
+	EXPECT_TRUE(std::equal(mesh->vertices.begin(), mesh->vertices.end(), opened->vertices().begin()));
+	EXPECT_TRUE(std::equal(mesh->indices.begin(), mesh->indices.end(), opened->indices().begin()));
+	EXPECT_EQ(opened->bounds().max, mesh->bounds.max);
+	EXPECT_EQ(opened->bounds().radius, mesh->bounds.radius);
+	EXPECT_EQ(opened->source().hash, mesh->source.hash);
+	ASSERT_EQ(opened->meshlets().size(), 1);
+	EXPECT_EQ(opened->meshlets().front().triangle_count, mesh->indices.size() / 3);
+	EXPECT_EQ(opened->meshlets().front().radius, mesh->meshlets.front().radius);
+
+	const auto base = reinterpret_cast<std::uintptr_t>(opened->vertices().data()) % MeshFile::data_alignment;
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(opened->indices().data()) % MeshFile::data_alignment, base);
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(opened->meshlets().data()) % MeshFile::data_alignment, base);
+}
+
+TEST_F(MeshFileTest, ContainerFollowsItsSource)
+{
+	TestFiles::age(source);
+	const auto mesh = MeshFile::import_obj(source);
+	ASSERT_TRUE(mesh.has_value());
+	EXPECT_NE(mesh->source.last_write, 0);
+	ASSERT_TRUE(MeshFile::write(container, *mesh));
+
+	const auto opened = MeshFile::open(container);
+	ASSERT_TRUE(opened.has_value());
+	EXPECT_TRUE(opened->is_current(source));
+
+	// Rewriting the same contents only costs a hash, any other contents make the container stale.
+	write(source, quad);
+	EXPECT_TRUE(opened->is_current(source));
+	write(source, std::string { quad } + "f 1/1/1 2/2/1 4/4/1\n");
+	EXPECT_FALSE(opened->is_current(source));
+}
+
+TEST_F(MeshFileTest, RejectsTruncatedContainers)
+{
+	const auto mesh = MeshFile::import_obj(source);
+	ASSERT_TRUE(mesh.has_value());
+	ASSERT_TRUE(MeshFile::write(container, *mesh));
+
+	std::filesystem::resize_file(container, std::filesystem::file_size(container) - sizeof(Index));
+	EXPECT_FALSE(MeshFile::open(container).has_value());
+	write(container, "AMSH");
+	EXPECT_FALSE(MeshFile::open(container).has_value());
+}
+
+TEST_F(MeshFileTest, RejectsMeshletsOutsideTheIndices)
+{
+	const auto mesh = MeshFile::import_obj(source);
+	ASSERT_TRUE(mesh.has_value());
+	ASSERT_TRUE(MeshFile::write(container, *mesh));
+
+	// The meshlet offset follows the counts, offsets, bounds and source stamp in the header, the triangle count follows the first index.
+	std::fstream stream(container, std::ios::binary | std::ios::in | std::ios::out);
+	std::uint64_t meshlet_offset { 0 };
+	stream.seekg(104);
+	stream.read(reinterpret_cast<char*>(&meshlet_offset), sizeof(meshlet_offset));
+	const std::uint32_t triangle_count = 3;
+	stream.seekp(static_cast<std::streamoff>(meshlet_offset + sizeof(std::uint32_t)));
+	stream.write(reinterpret_cast<const char*>(&triangle_count), sizeof(triangle_count));
+	stream.close();
+
+	EXPECT_FALSE(MeshFile::open(container).has_value());
+}
+
+TEST_F(MeshFileTest, RejectsIndicesPastTheVertices)
+{
+	const auto mesh = MeshFile::import_obj(source);
+	ASSERT_TRUE(mesh.has_value());
+	ASSERT_TRUE(MeshFile::write(container, *mesh));
+
+	// The vertex count follows the magic, version and strides in the header, the index offset follows both counts and the vertex offset.
+	std::fstream stream(container, std::ios::binary | std::ios::in | std::ios::out);
+	std::uint64_t vertex_count { 0 };
+	std::uint64_t index_offset { 0 };
+	stream.seekg(16);
+	stream.read(reinterpret_cast<char*>(&vertex_count), sizeof(vertex_count));
+	stream.seekg(40);
+	stream.read(reinterpret_cast<char*>(&index_offset), sizeof(index_offset));
+	const auto index = static_cast<Index>(vertex_count);
+	stream.seekp(static_cast<std::streamoff>(index_offset));
+	stream.write(reinterpret_cast<const char*>(&index), sizeof(index));
+	stream.close();
+
+	EXPECT_FALSE(MeshFile::open(container).has_value());
+}
+
+TEST_F(MeshFileTest, ContainerKeepsLevelsOfDetail)
+{
+	// A gently curved sheet, fine enough for every level of detail to fit in the error bound.
+	static constexpr std::uint32_t side = 48;
+	std::string dome;
+	for (std::uint32_t y = 0; y <= side; y++) {
+		for (std::uint32_t x = 0; x <= side; x++) {
+			const auto u = static_cast<float>(x) / side - 0.5f;
+			const auto v = static_cast<float>(y) / side - 0.5f;
+			dome += "v " + std::to_string(u) + " " + std::to_string(v) + " " + std::to_string(0.2f * (0.5f - u * u - v * v)) + "\n";
+		}
+	}
+	for (std::uint32_t y = 0; y < side; y++) {
+		for (std::uint32_t x = 0; x < side; x++) {
+			const auto corner = std::to_string(y * (side + 1) + x + 1);
+			const auto right = std::to_string(y * (side + 1) + x + 2);
+			const auto up = std::to_string((y + 1) * (side + 1) + x + 1);
+			const auto diagonal = std::to_string((y + 1) * (side + 1) + x + 2);
+			dome += "f " + corner + " " + right + " " + diagonal + "\nf " + corner + " " + diagonal + " " + up + "\n";
+		}
+	}
+	write(source, dome);
+
+	const auto mesh = MeshFile::import_obj(source);
+	ASSERT_TRUE(mesh.has_value());
+	ASSERT_EQ(mesh->lods.size(), 3);
+	EXPECT_EQ(mesh->lods.front().first_index, mesh->indices.size());
+	EXPECT_LT(mesh->lods.back().index_count, mesh->indices.size() / 4);
+	ASSERT_TRUE(MeshFile::write(container, *mesh));
+
+	const auto opened = MeshFile::open(container);
+	ASSERT_TRUE(opened.has_value());
+	ASSERT_EQ(opened->lods().size(), mesh->lods.size());
+	EXPECT_EQ(opened->lods().back().error, mesh->lods.back().error);
+	ASSERT_EQ(opened->indices().size(), mesh->indices.size());
+	ASSERT_EQ(opened->all_indices().size(), mesh->indices.size() + mesh->lod_indices.size());
+	EXPECT_TRUE(std::equal(mesh->lod_indices.begin(), mesh->lod_indices.end(), opened->all_indices().begin() + mesh->indices.size()));
+}
@@ -0,0 +1,196 @@
+#include "filesystem/FileSystem.hpp"
+#include "graphics/MeshOptimiser.hpp"
+#include "utilities/FileInputOutput.hpp"
+#include "utils/TestMeshes.hpp"
+
+#include <algorithm>
+#include <array>
+#include <gtest/gtest.h>
+#include <random>
+#include <tuple>
+
+using namespace Alabaster;
+
+/// @brief Shuffles the triangles, the order an importer without optimisation could produce at worst.
+static void shuffle_triangles(MeshData& mesh)
+{
+	std::vector<std::array<Index, 3>> triangles;
+	for (std::size_t i = 0; i < mesh.indices.size(); i += 3) {
+		triangles.push_back({ mesh.indices[i], mesh.indices[i + 1], mesh.indices[i + 2] });
+	}
+	std::shuffle(triangles.begin(), triangles.end(), std::mt19937 { 1234 });
+	mesh.indices.clear();
+	for (const auto& triangle : triangles) {
+		mesh.indices.insert(mesh.indices.end(), triangle.begin(), triangle.end());
+	}
+}
+
+using Corner = std::tuple<float, float, float, float, float>;
+
+/// @brief The triangles by the contents of their corners, rotated to start at the smallest corner so the winding is kept.
+static std::vector<std::array<Corner, 3>> triangles_of(const MeshData& mesh)
+{
+	std::vector<std::array<Corner, 3>> triangles;
+	for (std::size_t i = 0; i < mesh.indices.size(); i += 3) {
+		std::array<Corner, 3> triangle;
+		for (std::size_t corner = 0; corner < 3; corner++) {
+			const auto& vertex = mesh.vertices[mesh.indices[i + corner]];
+			triangle[corner] = { vertex.position.x, vertex.position.y, vertex.position.z, vertex.uv.x, vertex.uv.y };
+		}
+		std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+		triangles.push_back(triangle);
+	}
+	std::sort(triangles.begin(), triangles.end());
+	return triangles;
+}
+
+TEST(MeshOptimiserTest, VertexCacheOrderBeatsInputOrder)
+{
+	auto mesh = TestMeshes::make_cube_sphere(32);
+	shuffle_triangles(mesh);
+	const auto triangles = triangles_of(mesh);
+	const auto before = MeshOptimiser::analyse_vertex_cache(mesh.indices, mesh.vertices.size());
+
+	const auto clusters = MeshOptimiser::optimise_vertex_cache(mesh.indices, mesh.vertices.size());
+	const auto after = MeshOptimiser::analyse_vertex_cache(mesh.indices, mesh.vertices.size());
+
+	EXPECT_GT(before.acmr, 2.0f);
+	EXPECT_LT(after.acmr, 0.8f);
+	EXPECT_LT(after.atvr, 1.5f);
+	ASSERT_FALSE(clusters.empty());
+	EXPECT_EQ(clusters.front(), 0);
+	EXPECT_TRUE(std::is_sorted(clusters.begin(), clusters.end()));
+	EXPECT_EQ(triangles_of(mesh), triangles);
+}
+
+TEST(MeshOptimiserTest, OverdrawOrderDrawsOuterShellFirst)
+{
+	// An inner shell emitted before the outer one, which hides it from every direction.
+	auto mesh = TestMeshes::make_cube_sphere(8, 0.5f);
+	const auto inner_triangles = mesh.indices.size() / 3;
+	const auto outer = TestMeshes::make_cube_sphere(8, 1.0f);
+	const auto base = static_cast<Index>(mesh.vertices.size());
+	mesh.vertices.insert(mesh.vertices.end(), outer.vertices.begin(), outer.vertices.end());
+	for (const auto index : outer.indices) {
+		mesh.indices.push_back(base + index);
+	}
+	const auto triangles = triangles_of(mesh);
+
+	const auto clusters = MeshOptimiser::optimise_vertex_cache(mesh.indices, mesh.vertices.size());
+	const auto tipsify = MeshOptimiser::analyse_vertex_cache(mesh.indices, mesh.vertices.size());
+
+	// Reordering clusters this small costs more than the default threshold allows, which keeps the Tipsify order.
+	auto bounded = mesh;
+	MeshOptimiser::optimise_overdraw(bounded.indices, bounded.vertices, clusters);
+	EXPECT_LE(MeshOptimiser::analyse_vertex_cache(bounded.indices, bounded.vertices.size()).acmr, tipsify.acmr * MeshOptimiser::overdraw_threshold);
+	EXPECT_EQ(triangles_of(bounded), triangles);
+
+	static constexpr auto threshold = 1.5f;
+	MeshOptimiser::optimise_overdraw(mesh.indices, mesh.vertices, clusters, threshold);
+	EXPECT_LE(MeshOptimiser::analyse_vertex_cache(mesh.indices, mesh.vertices.size()).acmr, tipsify.acmr * threshold);
+	EXPECT_EQ(triangles_of(mesh), triangles);
+
+	// Every outer triangle is drawn before any inner one.
+	const auto outer_triangles = mesh.indices.size() / 3 - inner_triangles;
+	std::size_t outer_drawn { 0 };
+	for (std::size_t i = 0; i < outer_triangles; i++) {
+		outer_drawn += mesh.indices[3 * i] >= base ? 1 : 0;
+	}
+	EXPECT_EQ(outer_drawn, outer_triangles);
+}
+
+TEST(MeshOptimiserTest, MeshletsKeepTheirTrianglesInCacheOrder)
+{
+	auto mesh = TestMeshes::make_cube_sphere(32);
+	MeshOptimiser::optimise(mesh);
+	const auto optimised = MeshOptimiser::analyse_vertex_cache(mesh.indices, mesh.vertices.size());
+	mesh.meshlets = MeshletBuilder::build(mesh.vertices, mesh.indices);
+	const auto split = MeshOptimiser::analyse_vertex_cache(mesh.indices, mesh.vertices.size());
+
+	const auto meshlet_triangles = [&mesh] {
+		std::vector<std::vector<std::array<Corner, 3>>> output;
+		for (const auto& meshlet : mesh.meshlets) {
+			MeshData part;
+			part.vertices = mesh.vertices;
+			part.indices.assign(mesh.indices.begin() + meshlet.first_index, mesh.indices.begin() + meshlet.first_index + 3 * meshlet.triangle_count);
+			output.push_back(triangles_of(part));
+		}
+		return output;
+	};
+	const auto before = meshlet_triangles();
+
+	MeshOptimiser::optimise_meshlets(mesh.indices, mesh.meshlets, mesh.vertices.size());
+	const auto after = MeshOptimiser::analyse_vertex_cache(mesh.indices, mesh.vertices.size());
+
+	EXPECT_GT(split.acmr, optimised.acmr);
+	EXPECT_LT(after.acmr, split.acmr);
+	EXPECT_EQ(meshlet_triangles(), before);
+}
+
+TEST(MeshOptimiserTest, VertexFetchIsLinear)
+{
+	auto mesh = TestMeshes::make_cube_sphere(4);
+	shuffle_triangles(mesh);
+	mesh.vertices.push_back(Vertex {});
+	const auto triangles = triangles_of(mesh);
+
+	MeshOptimiser::optimise_vertex_fetch(mesh.vertices, mesh.indices);
+
+	EXPECT_EQ(mesh.vertices.size(), 6 * 5 * 5);
+	Index next { 0 };
+	for (const auto index : mesh.indices) {
+		ASSERT_LE(index, next);
+		next = std::max<Index>(next, index + 1);
+	}
+	EXPECT_EQ(triangles_of(mesh), triangles);
+}
+
+TEST(MeshOptimiserTest, OptimiseReportsBothOrders)
+{
+	auto cube = TestMeshes::make_cube_sphere(1);
+	const auto cube_report = MeshOptimiser::optimise(cube);
+	EXPECT_FLOAT_EQ(cube_report.after.acmr, 2.0f);
+	EXPECT_FLOAT_EQ(cube_report.after.atvr, 1.0f);
+
+	auto sphere = TestMeshes::make_cube_sphere(16);
+	shuffle_triangles(sphere);
+	const auto triangles = triangles_of(sphere);
+	const auto report = MeshOptimiser::optimise(sphere);
+	EXPECT_LT(report.after.acmr, report.before.acmr);
+	EXPECT_LT(report.after.atvr, report.before.atvr);
+	EXPECT_EQ(triangles_of(sphere), triangles);
+}
+
+TEST(MeshOptimiserTest, BundledModelsImprove)
+{
+	std::optional<std::filesystem::path> root;
+	try {
+		root = IO::get_resource_root();
+	} catch (const std::exception&) {
+	}
+	if (!root) {
+		GTEST_SKIP() << "The bundled models are not checked out.";
+	}
+
+	FileSystem::init_with_cwd(*root);
+	std::size_t optimised { 0 };
+	for (const auto* name : { "sphere.obj", "sphere_subdivided.obj", "cube.obj", "viking_room.obj" }) {
+		const auto path = FileSystem::model(name);
+		if (!std::filesystem::exists(path)) {
+			continue;
+		}
+
+		SCOPED_TRACE(name);
+		auto mesh = MeshFile::import_obj(path, { .optimise = false });
+		ASSERT_TRUE(mesh.has_value());
+		const auto triangles = triangles_of(*mesh);
+		const auto report = MeshOptimiser::optimise(*mesh);
+		EXPECT_LE(report.after.acmr, report.before.acmr);
+		EXPECT_GE(report.after.atvr, 1.0f);
+		EXPECT_EQ(triangles_of(*mesh), triangles);
+		optimised++;
+	}
+	if (optimised == 0) {
+		GTEST_SKIP() << "The bundled models are not checked out.";
+	}
+}
@@ -0,0 +1,120 @@
+#include "graphics/MeshFile.hpp"
+#include "graphics/MeshSimplifier.hpp"
+#include "utils/TestMeshes.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+
+using namespace Alabaster;
+
+static float area_of(const std::vector<Vertex>& vertices, std::span<const Index> indices)
+{
+	float area { 0.0f };
+	for (std::size_t i = 0; i < indices.size(); i += 3) {
+		const auto& a = vertices[indices[i]].position;
+		const auto& b = vertices[indices[i + 1]].position;
+		const auto& c = vertices[indices[i + 2]].position;
+		area += 0.5f * glm::length(glm::cross(b - a, c - a));
+	}
+	return area;
+}
+
+/// @brief Every triangle of a sphere centred on the origin faces outwards, none was turned over by a collapse.
+static void expect_outward(const std::vector<Vertex>& vertices, std::span<const Index> indices)
+{
+	for (std::size_t i = 0; i < indices.size(); i += 3) {
+		const auto& a = vertices[indices[i]].position;
+		const auto& b = vertices[indices[i + 1]].position;
+		const auto& c = vertices[indices[i + 2]].position;
+		ASSERT_GT(glm::dot(glm::cross(b - a, c - a), a + b + c), 0.0f);
+	}
+}
+
+TEST(MeshSimplifierTest, FlatGridSimplifiesWithoutError)
+{
+	const auto grid = TestMeshes::make_grid(32);
+	const auto simplified = MeshSimplifier::simplify(grid.vertices, grid.indices, grid.indices.size() / 10, 0.0001f);
+
+	// The border is kept, the interior of a plane collapses for free.
+	EXPECT_LE(simplified.indices.size(), grid.indices.size() / 4);
+	EXPECT_NEAR(simplified.error, 0.0f, 0.0001f);
+	EXPECT_NEAR(area_of(grid.vertices, simplified.indices), area_of(grid.vertices, grid.indices), 0.01f);
+	for (std::size_t i = 0; i < simplified.indices.size(); i += 3) {
+		const auto& a = grid.vertices[simplified.indices[i]].position;
+		const auto& b = grid.vertices[simplified.indices[i + 1]].position;
+		const auto& c = grid.vertices[simplified.indices[i + 2]].position;
+		EXPECT_GT(glm::cross(b - a, c - a).z, 0.0f);
+	}
+}
+
+TEST(MeshSimplifierTest, ChainReachesItsRatios)
+{
+	const auto sphere = TestMeshes::make_sphere(64, 128);
+	const std::array ratios { 0.5f, 0.25f, 0.125f };
+	std::vector<Index> lod_indices;
+	const auto lods = MeshSimplifier::build_lods(sphere.vertices, sphere.indices, ratios, 0.05f, lod_indices);
+	ASSERT_EQ(lods.size(), ratios.size());
+
+	const auto triangles = static_cast<float>(sphere.indices.size() / 3);
+	auto expected_first = static_cast<std::uint32_t>(sphere.indices.size());
+	for (std::size_t level = 0; level < lods.size(); level++) {
+		SCOPED_TRACE(level);
+		const auto& lod = lods[level];
+		EXPECT_EQ(lod.first_index, expected_first);
+		expected_first += lod.index_count;
+		EXPECT_LE(static_cast<float>(lod.index_count / 3), ratios[level] * triangles);
+		EXPECT_GT(static_cast<float>(lod.index_count / 3), 0.9f * ratios[level] * triangles);
+		EXPECT_LE(lod.error, 0.05f);
+		if (level > 0) {
+			EXPECT_GE(lod.error, lods[level - 1].error);
+		}
+
+		const auto range = std::span { lod_indices }.subspan(lod.first_index - sphere.indices.size(), lod.index_count);
+		expect_outward(sphere.vertices, range);
+		EXPECT_TRUE(std::ranges::all_of(range, [&sphere](Index index) { return index < sphere.vertices.size(); }));
+	}
+	EXPECT_EQ(expected_first, sphere.indices.size() + lod_indices.size());
+}
+
+TEST(MeshSimplifierTest, ErrorBoundStopsTheChain)
+{
+	const auto sphere = TestMeshes::make_sphere(32, 64);
+	const auto loose = MeshSimplifier::simplify(sphere.vertices, sphere.indices, 0, 1.0f);
+	const auto tight = MeshSimplifier::simplify(sphere.vertices, sphere.indices, 0, 0.01f);
+	EXPECT_LE(tight.error, 0.01f);
+	EXPECT_GT(loose.error, 0.01f);
+	EXPECT_GT(tight.indices.size(), loose.indices.size());
+
+	std::vector<Index> lod_indices;
+	const std::array ratios { 0.5f, 0.25f, 0.125f };
+	const auto lods = MeshSimplifier::build_lods(sphere.vertices, sphere.indices, ratios, 0.0f, lod_indices);
+	EXPECT_TRUE(lods.empty());
+	EXPECT_TRUE(lod_indices.empty());
+}
+
+TEST(MeshSimplifierTest, SeamsAndBordersStay)
+{
+	// Two quads side by side whose shared edge is a uv seam, every vertex is on the border or the seam.
+	MeshData mesh;
+	for (const auto& [x, y, u] : { std::array { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 1.0f }, { 1.0f, 1.0f, 1.0f }, { 0.0f, 1.0f, 0.0f },
+			 { 1.0f, 0.0f, 0.0f }, { 2.0f, 0.0f, 1.0f }, { 2.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, 0.0f } }) {
+		Vertex vertex {};
+		vertex.position = { x, y, 0.0f };
+		vertex.uv = { u, y };
+		mesh.vertices.push_back(vertex);
+	}
+	mesh.indices = { 0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7 };
+
+	const auto simplified = MeshSimplifier::simplify(mesh.vertices, mesh.indices, 0, 1.0f);
+	EXPECT_EQ(simplified.indices, mesh.indices);
+}
+
+TEST(MeshSimplifierTest, SelectsTheCoarsestLevelWithinTheScreenError)
+{
+	const std::array<MeshLod, 4> lods { { { 0, 300, 0.0f }, { 300, 150, 0.01f }, { 450, 75, 0.04f }, { 525, 36, 0.2f } } };
+	EXPECT_EQ(MeshSimplifier::select_lod(lods, 1000.0f, 1.0f), 0);
+	EXPECT_EQ(MeshSimplifier::select_lod(lods, 100.0f, 1.0f), 1);
+	EXPECT_EQ(MeshSimplifier::select_lod(lods, 20.0f, 1.0f), 2);
+	EXPECT_EQ(MeshSimplifier::select_lod(lods, 1.0f, 1.0f), 3);
+	EXPECT_EQ(MeshSimplifier::select_lod(std::span { lods }.first(1), 0.0f, 1.0f), 0);
+}
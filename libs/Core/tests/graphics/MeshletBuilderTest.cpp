@@ -0,0 +1,161 @@
+#include "filesystem/FileSystem.hpp"
+#include "graphics/MeshFile.hpp"
+#include "graphics/MeshletBuilder.hpp"
+#include "utilities/FileInputOutput.hpp"
+#include "utils/TestMeshes.hpp"
+
+#include <algorithm>
+#include <array>
+#include <gtest/gtest.h>
+
+using namespace Alabaster;
+
+using Triangle = std::array<Index, 3>;
+
+static std::vector<Triangle> sorted_triangles(std::span<const Index> indices)
+{
+	std::vector<Triangle> triangles;
+	for (std::size_t i = 0; i < indices.size(); i += 3) {
+		Triangle triangle { indices[i], indices[i + 1], indices[i + 2] };
+		std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+		triangles.push_back(triangle);
+	}
+	std::sort(triangles.begin(), triangles.end());
+	return triangles;
+}
+
+/// @brief Every triangle lands in exactly one meshlet, the meshlets stay within the limits and their spheres hold their vertices.
+static void expect_valid(const MeshData& mesh, const std::vector<Index>& original, const std::vector<Meshlet>& meshlets)
+{
+	EXPECT_EQ(sorted_triangles(mesh.indices), sorted_triangles(original));
+
+	std::uint32_t next_index { 0 };
+	for (const auto& meshlet : meshlets) {
+		ASSERT_EQ(meshlet.first_index, next_index);
+		ASSERT_GT(meshlet.triangle_count, 0);
+		EXPECT_LE(meshlet.triangle_count, MeshletBuilder::max_triangles);
+		EXPECT_LE(meshlet.vertex_count, MeshletBuilder::max_vertices);
+		next_index += 3 * meshlet.triangle_count;
+
+		const auto range = std::span { mesh.indices }.subspan(meshlet.first_index, 3 * meshlet.triangle_count);
+		std::vector<Index> unique { range.begin(), range.end() };
+		std::sort(unique.begin(), unique.end());
+		unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+		EXPECT_EQ(unique.size(), meshlet.vertex_count);
+		for (const auto index : unique) {
+			EXPECT_LE(glm::length(mesh.vertices[index].position - meshlet.centre), meshlet.radius + 0.00001f);
+		}
+	}
+	EXPECT_EQ(next_index, mesh.indices.size());
+}
+
+TEST(MeshletBuilderTest, GridFillsMeshlets)
+{
+	auto grid = TestMeshes::make_grid(64);
+	const auto original = grid.indices;
+	const auto meshlets = MeshletBuilder::build(grid.vertices, grid.indices);
+	expect_valid(grid, original, meshlets);
+
+	const auto statistics = MeshletBuilder::analyse(meshlets);
+	EXPECT_GT(statistics.triangles_per_meshlet, 90.0f);
+	EXPECT_GT(statistics.vertices_per_meshlet, 60.0f);
+
+	// A flat meshlet has a degenerate cone, it is culled from anywhere behind its plane and clear of its bounding sphere.
+	EXPECT_NEAR(statistics.average_cone_cutoff, 0.0f, 0.0001f);
+	EXPECT_FLOAT_EQ(statistics.cullable_ratio, 1.0f);
+	for (const auto& meshlet : meshlets) {
+		const glm::vec3 offset { 0.0f, 0.0f, meshlet.radius + 1.0f };
+		EXPECT_TRUE(meshlet.is_backfacing(meshlet.centre - offset));
+		EXPECT_FALSE(meshlet.is_backfacing(meshlet.centre + offset));
+	}
+}
+
+TEST(MeshletBuilderTest, SphereConesAreTightAndConservative)
+{
+	auto sphere = TestMeshes::make_sphere(48, 96);
+	const auto original = sphere.indices;
+	const auto meshlets = MeshletBuilder::build(sphere.vertices, sphere.indices);
+	expect_valid(sphere, original, meshlets);
+
+	const auto statistics = MeshletBuilder::analyse(meshlets);
+	EXPECT_GT(statistics.triangles_per_meshlet, 80.0f);
+	EXPECT_LT(statistics.average_cone_cutoff, 0.5f);
+	EXPECT_GT(statistics.cullable_ratio, 0.9f);
+
+	// A viewer far along +x sees the -x half of the sphere from behind, most of those meshlets are culled and none that is culled
+	// has a triangle facing the viewer.
+	const glm::vec3 viewer { 10.0f, 0.0f, 0.0f };
+	std::size_t culled { 0 };
+	for (const auto& meshlet : meshlets) {
+		if (!meshlet.is_backfacing(viewer)) {
+			continue;
+		}
+		culled++;
+		for (std::uint32_t i = meshlet.first_index; i < meshlet.first_index + 3 * meshlet.triangle_count; i += 3) {
+			const auto& a = sphere.vertices[sphere.indices[i]].position;
+			const auto& b = sphere.vertices[sphere.indices[i + 1]].position;
+			const auto& c = sphere.vertices[sphere.indices[i + 2]].position;
+			EXPECT_GE(glm::dot(glm::cross(b - a, c - a), a - viewer), 0.0f);
+		}
+	}
+	EXPECT_GT(culled, meshlets.size() / 4);
+}
+
+TEST(MeshletBuilderTest, DisconnectedTrianglesShareMeshlets)
+{
+	MeshData mesh;
+	for (std::uint32_t i = 0; i < 200; i++) {
+		const auto x = static_cast<float>(i);
+		for (const auto& position : { glm::vec3 { x, 0, 0 }, glm::vec3 { x + 0.5f, 0, 0 }, glm::vec3 { x, 0.5f, 0 } }) {
+			Vertex vertex {};
+			vertex.position = position;
+			mesh.vertices.push_back(vertex);
+		}
+		mesh.indices.insert(mesh.indices.end(), { 3 * i, 3 * i + 1, 3 * i + 2 });
+	}
+	const auto original = mesh.indices;
+	const auto meshlets = MeshletBuilder::build(mesh.vertices, mesh.indices);
+	expect_valid(mesh, original, meshlets);
+	// 21 triangles of 3 unique vertices fit in 64.
+	EXPECT_EQ(meshlets.size(), 10);
+}
+
+TEST(MeshletBuilderTest, EmptyMeshHasNoMeshlets)
+{
+	std::vector<Index> indices;
+	EXPECT_TRUE(MeshletBuilder::build({}, indices).empty());
+	EXPECT_FLOAT_EQ(MeshletBuilder::analyse({}).triangles_per_meshlet, 0.0f);
+}
+
+TEST(MeshletBuilderTest, BundledModelsAreSplit)
+{
+	std::optional<std::filesystem::path> root;
+	try {
+		root = IO::get_resource_root();
+	} catch (const std::exception&) {
+	}
+	if (!root) {
+		GTEST_SKIP() << "The bundled models are not checked out.";
+	}
+
+	FileSystem::init_with_cwd(*root);
+	std::size_t split { 0 };
+	for (const auto* name : { "sphere.obj", "sphere_subdivided.obj", "cube.obj", "viking_room.obj" }) {
+		const auto path = FileSystem::model(name);
+		if (!std::filesystem::exists(path)) {
+			continue;
+		}
+
+		SCOPED_TRACE(name);
+		auto mesh = MeshFile::import_obj(path);
+		ASSERT_TRUE(mesh.has_value());
+		auto indices = mesh->indices;
+		const auto meshlets = MeshletBuilder::build(mesh->vertices, indices);
+		EXPECT_EQ(sorted_triangles(indices), sorted_triangles(mesh->indices));
+		EXPECT_EQ(mesh->meshlets.size(), meshlets.size());
+		split++;
+	}
+	if (split == 0) {
+		GTEST_SKIP() << "The bundled models are not checked out.";
+	}
+}
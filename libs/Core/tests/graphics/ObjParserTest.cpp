@@ -0,0 +1,156 @@
+#include "filesystem/FileSystem.hpp"
+#include "graphics/ObjParser.hpp"
+#include "utilities/FileInputOutput.hpp"
+
+#include <array>
+#include <cmath>
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <tiny_obj_loader.h>
+
+using namespace Alabaster;
+
+// Every index form, relative indices, quads split either way, comments, groups and carriage returns.
+static constexpr std::string_view features = "# exported\r\n"
+											 "mtllib model.mtl\r\n"
+											 "o quad\r\n"
+											 "v 0 0 0\r\nv 1 0 0\r\nv 1 1 0\r\nv 0 1 0\r\n"
+											 "vt 0 0\nvt 1 0\nvt 1 1\nvt +0.0 1e0\n"
+											 "vn 0 0 1\n"
+											 "usemtl surface\n"
+											 "s off\n"
+											 "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+											 "g wedge\n"
+											 "v 0 0 -4 0.5 0.5 0.5\nv 1 0 -4\n\tv 2 0.25 -4\nv 4 3 -4\n"
+											 "f -4 -3 -2 -1\n"
+											 "f 5//1 6//1 7//1\n"
+											 "f -4/-4 -3/-3 -2/-2\n"
+											 "l 1 2\n";
+
+static void expect_near(const std::vector<float>& expected, const std::vector<float>& actual)
+{
+	ASSERT_EQ(expected.size(), actual.size());
+	for (std::size_t i = 0; i < expected.size(); i++) {
+		// tinyobj rounds through its own decimal parser, which can differ from a correctly rounded float in the last place.
+		EXPECT_NEAR(expected[i], actual[i], 0.000001f * std::max(1.0f, std::abs(expected[i]))) << "component " << i;
+	}
+}
+
+static void expect_matches_tinyobj(std::string_view text, const ObjModel& model)
+{
+	tinyobj::ObjReader reader;
+	ASSERT_TRUE(reader.ParseFromString(std::string { text }, "", tinyobj::ObjReaderConfig {}));
+
+	const auto& attrib = reader.GetAttrib();
+	expect_near(attrib.vertices, model.positions);
+	expect_near(attrib.normals, model.normals);
+	expect_near(attrib.texcoords, model.texcoords);
+
+	std::vector<ObjIndex> indices;
+	for (const auto& shape : reader.GetShapes()) {
+		for (const auto& index : shape.mesh.indices) {
+			indices.push_back({ index.vertex_index, index.normal_index, index.texcoord_index });
+		}
+	}
+	ASSERT_EQ(indices.size(), model.indices.size());
+	for (std::size_t i = 0; i < indices.size(); i++) {
+		EXPECT_EQ(indices[i], model.indices[i]) << "corner " << i;
+	}
+}
+
+/// @brief A grid of quads, with every other row referencing its corners relative to the end.
+static std::string write_grid(std::uint32_t side)
+{
+	std::string text;
+	for (std::uint32_t y = 0; y <= side; y++) {
+		for (std::uint32_t x = 0; x <= side; x++) {
+			text += fmt::format("v {} {} {}\nvt {} {}\n", x, y * 1.5f, (x * y) % 7 * 0.1f, x / float(side), y / float(side));
+		}
+	}
+	text += "vn 0 0 1\n";
+
+	const auto count = (side + 1) * (side + 1);
+	for (std::uint32_t y = 0; y < side; y++) {
+		for (std::uint32_t x = 0; x < side; x++) {
+			const auto corner = y * (side + 1) + x + 1;
+			const std::array<std::uint32_t, 4> corners { corner, corner + 1, corner + side + 2, corner + side + 1 };
+			text += "f";
+			for (const auto index : corners) {
+				const auto relative = y % 2 == 1 ? static_cast<std::int64_t>(index) - count - 1 : static_cast<std::int64_t>(index);
+				text += fmt::format(" {0}/{0}/1", relative);
+			}
+			text += "\n";
+		}
+	}
+	return text;
+}
+
+TEST(ObjParserTest, FeaturesMatchTinyobj)
+{
+	const auto model = ObjParser::parse(features);
+	ASSERT_TRUE(model.has_value());
+	EXPECT_EQ(model->indices.size(), 18);
+	expect_matches_tinyobj(features, *model);
+}
+
+TEST(ObjParserTest, ChunksMatchTinyobj)
+{
+	const auto text = write_grid(24);
+	const auto whole = ObjParser::parse(text);
+	ASSERT_TRUE(whole.has_value());
+	expect_matches_tinyobj(text, *whole);
+
+	// Chunks of a few lines each, so relative indices and quads reach into positions parsed by other jobs.
+	const auto chunked = ObjParser::parse(text, 64);
+	ASSERT_TRUE(chunked.has_value());
+	EXPECT_EQ(chunked->positions, whole->positions);
+	EXPECT_EQ(chunked->texcoords, whole->texcoords);
+	EXPECT_EQ(chunked->indices, whole->indices);
+}
+
+TEST(ObjParserTest, LargerPolygonsAreFanned)
+{
+	const auto model = ObjParser::parse("v 0 0 0\nv 1 0 0\nv 2 1 0\nv 1 2 0\nv 0 1 0\nf 1 2 3 4 5\n");
+	ASSERT_TRUE(model.has_value());
+	ASSERT_EQ(model->indices.size(), 9);
+	EXPECT_EQ(model->indices[3], (ObjIndex { .position = 0 }));
+	EXPECT_EQ(model->indices[4], (ObjIndex { .position = 2 }));
+	EXPECT_EQ(model->indices[5], (ObjIndex { .position = 3 }));
+}
+
+TEST(ObjParserTest, RejectsInvalidInput)
+{
+	EXPECT_FALSE(ObjParser::parse("v 0 0 0\nv 1 0 0\nv 1 1 0\nf 0 1 2\n").has_value());
+	EXPECT_FALSE(ObjParser::parse("v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 4\n").has_value());
+	EXPECT_FALSE(ObjParser::parse("v 0 0 0\nv 1 0 0\nv 1 1 0\nf -4 -2 -1\n").has_value());
+	EXPECT_FALSE(ObjParser::parse("v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1/1 2/1 3/1\n").has_value());
+	EXPECT_FALSE(ObjParser::parse("v 0 zero 0\n").has_value());
+	EXPECT_FALSE(ObjParser::parse("v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1,2,3\n").has_value());
+}
+
+TEST(ObjParserTest, BundledModelsMatchTinyobj)
+{
+	std::optional<std::filesystem::path> root;
+	try {
+		root = IO::get_resource_root();
+	} catch (const std::exception&) {
+	}
+	if (!root || !std::filesystem::is_directory(*root / "models")) {
+		GTEST_SKIP() << "The bundled models are not checked out.";
+	}
+
+	FileSystem::init_with_cwd(*root);
+	for (const auto& entry : std::filesystem::directory_iterator { FileSystem::models() }) {
+		if (entry.path().extension() != ".obj") {
+			continue;
+		}
+
+		SCOPED_TRACE(entry.path().filename().string());
+		const auto file = FileSystem::read(entry.path());
+		ASSERT_TRUE(file.has_value());
+		const auto model = ObjParser::parse(file->text(), 1 << 16);
+		ASSERT_TRUE(model.has_value());
+		expect_matches_tinyobj(file->text(), *model);
+	}
+}
@@ -0,0 +1,63 @@
+#include "graphics/ShaderReflection.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace Alabaster;
+
+static constexpr VkShaderStageFlags vertex_stage = 0x00000001;
+static constexpr VkShaderStageFlags fragment_stage = 0x00000010;
+
+TEST(ShaderReflectionTest, MergeCombinesStagesOfSharedBindings)
+{
+	ShaderReflection vertex { .bindings = { { .set = 0, .binding = 0, .type = DescriptorType::UniformBuffer, .count = 1, .stages = vertex_stage } },
+		.push_constants = { { .offset = 0, .size = 64, .stages = vertex_stage } } };
+	const ShaderReflection fragment {
+		.bindings = { { .set = 0, .binding = 1, .type = DescriptorType::SampledImage, .count = 32, .stages = fragment_stage },
+			{ .set = 0, .binding = 0, .type = DescriptorType::UniformBuffer, .count = 1, .stages = fragment_stage } },
+		.push_constants = { { .offset = 0, .size = 64, .stages = fragment_stage } },
+	};
+
+	vertex.merge(fragment);
+
+	ASSERT_EQ(vertex.bindings.size(), 2);
+	EXPECT_EQ(vertex.bindings[0].binding, 0);
+	EXPECT_EQ(vertex.bindings[0].stages, vertex_stage | fragment_stage);
+	EXPECT_EQ(vertex.bindings[1].binding, 1);
+	EXPECT_EQ(vertex.bindings[1].count, 32);
+	ASSERT_EQ(vertex.push_constants.size(), 1);
+	EXPECT_EQ(vertex.push_constants[0].stages, vertex_stage | fragment_stage);
+}
+
+TEST(ShaderReflectionTest, SetReturnsBindingsOfOneSet)
+{
+	ShaderReflection reflection;
+	reflection.merge({ .bindings = { { .set = 2, .binding = 0, .type = DescriptorType::StorageBuffer, .count = 1, .stages = vertex_stage },
+						   { .set = 0, .binding = 3, .type = DescriptorType::Sampler, .count = 1, .stages = fragment_stage },
+						   { .set = 0, .binding = 1, .type = DescriptorType::UniformBuffer, .count = 1, .stages = vertex_stage } },
+		.push_constants = {} });
+
+	EXPECT_EQ(reflection.set_count(), 3);
+	ASSERT_EQ(reflection.set(0).size(), 2);
+	EXPECT_EQ(reflection.set(0)[0].binding, 1);
+	EXPECT_EQ(reflection.set(0)[1].binding, 3);
+	EXPECT_TRUE(reflection.set(1).empty());
+	EXPECT_EQ(reflection.set(2).size(), 1);
+	EXPECT_EQ(ShaderReflection {}.set_count(), 0);
+}
+
+TEST(ShaderReflectionTest, HashIgnoresSetIndexButNotInterface)
+{
+	const DescriptorBinding uniform { .set = 0, .binding = 0, .type = DescriptorType::UniformBuffer, .count = 1, .stages = vertex_stage };
+	auto same_in_other_set = uniform;
+	same_in_other_set.set = 1;
+	auto other_stage = uniform;
+	other_stage.stages = fragment_stage;
+	auto other_type = uniform;
+	other_type.type = DescriptorType::StorageBuffer;
+
+	const auto hash = hash_bindings({ &uniform, 1 });
+	EXPECT_EQ(hash, hash_bindings({ &same_in_other_set, 1 }));
+	EXPECT_NE(hash, hash_bindings({ &other_stage, 1 }));
+	EXPECT_NE(hash, hash_bindings({ &other_type, 1 }));
+	EXPECT_NE(hash, hash_bindings({}));
+}
@@ -0,0 +1,139 @@
+#include "graphics/VertexPacker.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <numbers>
+#include <vector>
+
+using namespace Alabaster;
+
+/// @brief Directions spread over the sphere, including the poles and the folded edges of the octahedron.
+static std::vector<glm::vec3> directions()
+{
+	std::vector<glm::vec3> output { { 0, 0, 1 }, { 0, 0, -1 }, { 1, 0, 0 }, { 0, -1, 0 }, { 1, 1, 0 }, { -1, 0, -1 } };
+	static constexpr std::uint32_t rings = 32;
+	for (std::uint32_t ring = 1; ring < rings; ring++) {
+		const auto polar = std::numbers::pi_v<float> * static_cast<float>(ring) / rings;
+		for (std::uint32_t segment = 0; segment < 2 * rings; segment++) {
+			const auto azimuth = std::numbers::pi_v<float> * static_cast<float>(segment) / rings;
+			output.emplace_back(std::sin(polar) * std::cos(azimuth), std::sin(polar) * std::sin(azimuth), std::cos(polar));
+		}
+	}
+	for (auto& direction : output) {
+		direction = glm::normalize(direction);
+	}
+	return output;
+}
+
+static std::vector<Vertex> make_vertices()
+{
+	std::vector<Vertex> vertices;
+	const auto all = directions();
+	for (std::size_t i = 0; i < all.size(); i++) {
+		const auto& normal = all[i];
+		const auto helper = std::abs(normal.z) < 0.9f ? glm::vec3 { 0, 0, 1 } : glm::vec3 { 1, 0, 0 };
+		const auto tangent = glm::normalize(glm::cross(helper, normal));
+		const auto handedness = i % 2 == 0 ? 1.0f : -1.0f;
+
+		Vertex vertex {};
+		vertex.position = glm::vec3 { 4.0f, -2.0f, 1.0f } + 3.0f * normal;
+		vertex.colour = { 1.0f, 1.0f, 1.0f, 1.0f };
+		vertex.normal = normal;
+		vertex.tangent = tangent;
+		vertex.bitangent = handedness * glm::cross(normal, tangent);
+		vertex.uv = { static_cast<float>(i % 17) / 16.0f, 1.0f - static_cast<float>(i % 5) * 0.3f };
+		vertices.push_back(vertex);
+	}
+	return vertices;
+}
+
+static void expect_near(const glm::vec3& expected, const glm::vec3& actual, float tolerance)
+{
+	EXPECT_NEAR(expected.x, actual.x, tolerance);
+	EXPECT_NEAR(expected.y, actual.y, tolerance);
+	EXPECT_NEAR(expected.z, actual.z, tolerance);
+}
+
+TEST(VertexPackerTest, OctahedralRoundTrips)
+{
+	for (const auto& direction : directions()) {
+		const auto encoded = VertexPacker::encode_octahedral(direction);
+		EXPECT_LE(std::max(std::abs(encoded.x), std::abs(encoded.y)), 1.0f);
+		expect_near(direction, VertexPacker::decode_octahedral(encoded), 0.00001f);
+	}
+}
+
+TEST(VertexPackerTest, LayoutsMatchTheirStrides)
+{
+	EXPECT_EQ(VertexFormat {}.stride(), sizeof(Vertex));
+	EXPECT_EQ((VertexFormat { .encoding = VertexEncoding::Compact, .colour = false }.stride()), 24);
+	EXPECT_EQ((VertexFormat { .encoding = VertexEncoding::Compact, .colour = true }.stride()), 28);
+	EXPECT_EQ((VertexFormat { .encoding = VertexEncoding::Quantised, .colour = false }.stride()), 20);
+	EXPECT_EQ((VertexFormat { .encoding = VertexEncoding::Quantised, .colour = true }.stride()), 24);
+
+	EXPECT_TRUE(VertexFormat {}.keywords().empty());
+	EXPECT_EQ((VertexFormat { .encoding = VertexEncoding::Quantised, .colour = false }.keywords()), std::vector<std::string> { "COMPACT_VERTICES" });
+}
+
+TEST(VertexPackerTest, CompactRoundTrips)
+{
+	const auto vertices = make_vertices();
+	const auto packed = VertexPacker::pack(vertices, MeshBounds::of(vertices), VertexEncoding::Compact);
+	ASSERT_EQ(packed.vertex_count(), vertices.size());
+	EXPECT_FALSE(packed.format.colour);
+	EXPECT_EQ(packed.constant_colour, vertices.front().colour);
+
+	for (std::size_t i = 0; i < vertices.size(); i++) {
+		SCOPED_TRACE(i);
+		const auto& expected = vertices[i];
+		const auto vertex = VertexPacker::unpack(packed, i);
+		EXPECT_EQ(vertex.position, expected.position);
+		expect_near(expected.normal, vertex.normal, 0.0002f);
+		expect_near(expected.tangent, vertex.tangent, 0.0004f);
+		expect_near(expected.bitangent, vertex.bitangent, 0.001f);
+		EXPECT_NEAR(expected.uv.x, vertex.uv.x, 0.0005f);
+		EXPECT_NEAR(expected.uv.y, vertex.uv.y, 0.0005f);
+		EXPECT_EQ(vertex.colour, expected.colour);
+	}
+}
+
+TEST(VertexPackerTest, QuantisedPositionsStayWithinAStep)
+{
+	const auto vertices = make_vertices();
+	const auto bounds = MeshBounds::of(vertices);
+	const auto packed = VertexPacker::pack(vertices, bounds, VertexEncoding::Quantised);
+	EXPECT_EQ(packed.position_origin, bounds.min);
+	EXPECT_FLOAT_EQ(packed.position_scale, 6.0f);
+
+	const auto step = packed.position_scale / 65535.0f;
+	for (std::size_t i = 0; i < vertices.size(); i++) {
+		SCOPED_TRACE(i);
+		expect_near(vertices[i].position, VertexPacker::unpack(packed, i).position, step);
+	}
+}
+
+TEST(VertexPackerTest, VaryingColourIsKept)
+{
+	auto vertices = make_vertices();
+	vertices[3].colour = { 1.0f, 0.0f, 0.2f, 1.0f };
+	const auto packed = VertexPacker::pack(vertices, MeshBounds::of(vertices), VertexEncoding::Compact);
+	ASSERT_TRUE(packed.format.colour);
+	EXPECT_EQ(packed.data.size(), vertices.size() * 28);
+
+	const auto vertex = VertexPacker::unpack(packed, 3);
+	EXPECT_FLOAT_EQ(vertex.colour.x, 1.0f);
+	EXPECT_NEAR(vertex.colour.z, 0.2f, 0.5f / 255.0f);
+	EXPECT_EQ(VertexPacker::unpack(packed, 4).colour, vertices[4].colour);
+}
+
+TEST(VertexPackerTest, FullKeepsVerticesAsTheyAre)
+{
+	const auto vertices = make_vertices();
+	const auto packed = VertexPacker::pack(vertices, MeshBounds::of(vertices), VertexEncoding::Full);
+	ASSERT_EQ(packed.data.size(), vertices.size() * sizeof(Vertex));
+	EXPECT_TRUE(packed.format.colour);
+	const auto vertex = VertexPacker::unpack(packed, 7);
+	EXPECT_EQ(vertex.normal, vertices[7].normal);
+	EXPECT_EQ(vertex.bitangent, vertices[7].bitangent);
+}
@@ -0,0 +1,141 @@
+#include "filesystem/AssetPack.hpp"
+#include "filesystem/FileSystem.hpp"
+
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+
+using Alabaster::AssetPack;
+namespace FileSystem = Alabaster::FileSystem;
+
+class AssetPackTest : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		directory = std::filesystem::temp_directory_path() / "alabaster_asset_pack_test";
+		std::filesystem::remove_all(directory);
+		std::filesystem::create_directories(directory / "resources" / "shaders");
+		std::filesystem::create_directories(directory / "resources" / "textures" / "nested");
+
+		write("resources/shaders/mesh.vert", "void main() {}");
+		write("resources/shaders/mesh.frag", "void main() { colour = vec4(1); }");
+		write("resources/textures/wood.png", std::string(1000, 'w'));
+		write("resources/textures/nested/stone.png", "stone");
+
+		pack_path = directory / "resources.apak";
+		ASSERT_TRUE(AssetPack::write(pack_path, directory / "resources"));
+	}
+
+	void TearDown() override
+	{
+		FileSystem::unmount_all();
+		std::filesystem::remove_all(directory);
+	}
+
+	void write(const std::string& relative, const std::string& contents) const
+	{
+		std::ofstream stream(directory / relative, std::ios::binary);
+		stream << contents;
+	}
+
+	std::filesystem::path directory;
+	std::filesystem::path pack_path;
+};
+
+TEST_F(AssetPackTest, TableOfContentsIsSortedAndAligned)
+{
+	const auto pack = AssetPack::open(pack_path);
+	ASSERT_TRUE(pack.has_value());
+	ASSERT_EQ(pack->entries().size(), 4);
+
+	const auto* base = pack->entries().front().bytes.data();
+	for (std::size_t i = 0; i < pack->entries().size(); i++) {
+		const auto& entry = pack->entries()[i];
+		if (i > 0) {
+			EXPECT_LT(pack->entries()[i - 1].path, entry.path);
+		}
+		EXPECT_EQ((entry.bytes.data() - base) % AssetPack::blob_alignment, 0);
+		EXPECT_TRUE(AssetPack::verify(entry)) << entry.path;
+	}
+}
+
+TEST_F(AssetPackTest, FindsFilesByRelativePath)
+{
+	const auto pack = AssetPack::open(pack_path);
+	ASSERT_TRUE(pack.has_value());
+
+	const auto fragment = pack->find("shaders/mesh.frag");
+	ASSERT_TRUE(fragment.has_value());
+	EXPECT_EQ(std::string(reinterpret_cast<const char*>(fragment->data()), fragment->size()), "void main() { colour = vec4(1); }");
+	EXPECT_EQ(pack->find("textures/wood.png")->size(), 1000);
+	EXPECT_FALSE(pack->contains("textures/missing.png"));
+	EXPECT_FALSE(pack->contains("shaders"));
+
+	EXPECT_EQ(pack->list("textures", false).size(), 1);
+	EXPECT_EQ(pack->list("textures", true).size(), 2);
+	EXPECT_EQ(pack->list("", true).size(), 4);
+}
+
+TEST_F(AssetPackTest, RejectsTruncatedPacks)
+{
+	const auto truncated = directory / "truncated.apak";
+	std::filesystem::copy_file(pack_path, truncated);
+	std::filesystem::resize_file(truncated, 100);
+	EXPECT_FALSE(AssetPack::open(truncated).has_value());
+	EXPECT_FALSE(AssetPack::open(directory / "resources" / "shaders" / "mesh.vert").has_value());
+}
+
+TEST_F(AssetPackTest, RejectsCorruptPacks)
+{
+	const auto patched = [this](const std::string& name, std::streamoff offset, const std::string& bytes) {
+		const auto copy = directory / name;
+		std::filesystem::copy_file(pack_path, copy);
+		std::fstream stream(copy, std::ios::binary | std::ios::in | std::ios::out);
+		stream.seekp(offset);
+		stream.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+		return copy;
+	};
+
+	// The strings offset sits after the magic, version, entry count and alignment, here pointing far past the end of the file.
+	EXPECT_FALSE(AssetPack::open(patched("offset.apak", 16, std::string(8, '\xff'))).has_value());
+
+	// One byte of a file's contents changed, the table of contents is still intact. Only reading that file finds out.
+	std::ifstream stream(pack_path, std::ios::binary);
+	const std::string contents { std::istreambuf_iterator<char> { stream }, {} };
+	const auto wood = contents.find(std::string(1000, 'w'));
+	ASSERT_NE(wood, std::string::npos);
+	const auto corrupt = AssetPack::open(patched("contents.apak", static_cast<std::streamoff>(wood), "x"));
+	ASSERT_TRUE(corrupt.has_value());
+	EXPECT_TRUE(corrupt->contains("textures/wood.png"));
+	EXPECT_FALSE(corrupt->find("textures/wood.png").has_value());
+	EXPECT_TRUE(corrupt->find("shaders/mesh.frag").has_value());
+	EXPECT_FALSE(corrupt->verify_all());
+	EXPECT_TRUE(AssetPack::open(pack_path)->verify_all());
+}
+
+TEST_F(AssetPackTest, MountedPacksResolveBeforeLooseFiles)
+{
+	FileSystem::init_with_cwd(directory / "resources");
+	write("resources/shaders/mesh.vert", "changed on disk");
+	ASSERT_TRUE(FileSystem::mount(pack_path));
+
+	// Loose files are gone as far as the packed assets are concerned, the pack is all that is read.
+	std::filesystem::remove_all(directory / "resources" / "textures");
+	const auto wood = FileSystem::read(FileSystem::texture("wood.png"));
+	ASSERT_TRUE(wood.has_value());
+	EXPECT_EQ(wood->bytes.size(), 1000);
+	EXPECT_TRUE(FileSystem::is_file(FileSystem::texture("nested/stone.png")));
+	EXPECT_EQ(FileSystem::read(FileSystem::shader("mesh.vert"))->text(), "void main() {}");
+
+	const auto textures = FileSystem::in_directory<std::filesystem::path>(FileSystem::textures(), { ".png" }, true);
+	ASSERT_EQ(textures.size(), 1);
+	EXPECT_EQ(textures.front(), FileSystem::texture("wood.png").make_preferred());
+
+	write("resources/shaders/mesh.geom", "void main() {}");
+	const auto shaders = FileSystem::in_directory<std::string>(FileSystem::shaders(), { "*" }, true);
+	EXPECT_EQ(shaders.size(), 3);
+
+	FileSystem::unmount_all();
+	EXPECT_EQ(FileSystem::read(FileSystem::shader("mesh.vert"))->text(), "changed on disk");
+	EXPECT_FALSE(FileSystem::exists(FileSystem::texture("wood.png")));
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+
+namespace TestFiles {
+
+	/// @brief Moves the modification time out of the window in which it cannot be trusted.
+	inline void age(const std::filesystem::path& path)
+	{
+		std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now() - std::chrono::hours(1));
+	}
+
+} // namespace TestFiles
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "graphics/MeshFile.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+namespace TestMeshes {
+
+	/// @brief A flat grid of quads in the xy plane, facing +z.
+	inline Alabaster::MeshData make_grid(std::uint32_t side)
+	{
+		Alabaster::MeshData mesh;
+		for (std::uint32_t y = 0; y <= side; y++) {
+			for (std::uint32_t x = 0; x <= side; x++) {
+				Alabaster::Vertex vertex {};
+				vertex.position = { static_cast<float>(x), static_cast<float>(y), 0.0f };
+				mesh.vertices.push_back(vertex);
+			}
+		}
+		for (std::uint32_t y = 0; y < side; y++) {
+			for (std::uint32_t x = 0; x < side; x++) {
+				const auto corner = y * (side + 1) + x;
+				mesh.indices.insert(mesh.indices.end(), { corner, corner + 1, corner + side + 2, corner, corner + side + 2, corner + side + 1 });
+			}
+		}
+		return mesh;
+	}
+
+	/// @brief A latitude and longitude sphere with outward facing triangles. The poles and the first meridian repeat their positions
+	/// the way a textured sphere does.
+	inline Alabaster::MeshData make_sphere(std::uint32_t rings, std::uint32_t segments)
+	{
+		Alabaster::MeshData mesh;
+		for (std::uint32_t ring = 0; ring <= rings; ring++) {
+			const auto polar = std::numbers::pi_v<float> * static_cast<float>(ring) / static_cast<float>(rings);
+			for (std::uint32_t segment = 0; segment <= segments; segment++) {
+				const auto azimuth = 2.0f * std::numbers::pi_v<float> * static_cast<float>(segment) / static_cast<float>(segments);
+				Alabaster::Vertex vertex {};
+				vertex.position = { std::sin(polar) * std::cos(azimuth), std::sin(polar) * std::sin(azimuth), std::cos(polar) };
+				if (ring == 0 || ring == rings) {
+					vertex.position = { 0.0f, 0.0f, std::cos(polar) };
+				} else if (segment == segments) {
+					vertex.position = mesh.vertices[ring * (segments + 1)].position;
+				}
+				mesh.vertices.push_back(vertex);
+			}
+		}
+		for (std::uint32_t ring = 0; ring < rings; ring++) {
+			for (std::uint32_t segment = 0; segment < segments; segment++) {
+				const auto corner = ring * (segments + 1) + segment;
+				const auto below = corner + segments + 1;
+				if (ring != 0) {
+					mesh.indices.insert(mesh.indices.end(), { corner, below, corner + 1 });
+				}
+				if (ring + 1 != rings) {
+					mesh.indices.insert(mesh.indices.end(), { corner + 1, below, below + 1 });
+				}
+			}
+		}
+		return mesh;
+	}
+
+	/// @brief A cube with every face subdivided into a grid and pushed out onto a sphere. Faces do not share vertices, like the seams
+	/// of an exported sphere. The same sphere the mesh benchmarks write as an OBJ.
+	inline Alabaster::MeshData make_cube_sphere(std::uint32_t subdivisions, float radius = 1.0f)
+	{
+		static const std::array<std::array<glm::vec3, 3>, 6> faces { {
+			{ glm::vec3 { 1, 0, 0 }, glm::vec3 { 0, 0, -1 }, glm::vec3 { 0, 1, 0 } },
+			{ glm::vec3 { -1, 0, 0 }, glm::vec3 { 0, 0, 1 }, glm::vec3 { 0, 1, 0 } },
+			{ glm::vec3 { 0, 1, 0 }, glm::vec3 { 1, 0, 0 }, glm::vec3 { 0, 0, -1 } },
+			{ glm::vec3 { 0, -1, 0 }, glm::vec3 { 1, 0, 0 }, glm::vec3 { 0, 0, 1 } },
+			{ glm::vec3 { 0, 0, 1 }, glm::vec3 { 1, 0, 0 }, glm::vec3 { 0, 1, 0 } },
+			{ glm::vec3 { 0, 0, -1 }, glm::vec3 { -1, 0, 0 }, glm::vec3 { 0, 1, 0 } },
+		} };
+
+		Alabaster::MeshData mesh;
+		const auto side = subdivisions + 1;
+		for (const auto& [normal, right, up] : faces) {
+			const auto base = static_cast<Alabaster::Index>(mesh.vertices.size());
+			for (std::uint32_t y = 0; y < side; y++) {
+				for (std::uint32_t x = 0; x < side; x++) {
+					const auto u = static_cast<float>(x) / static_cast<float>(subdivisions);
+					const auto v = static_cast<float>(y) / static_cast<float>(subdivisions);
+					Alabaster::Vertex vertex {};
+					vertex.position = radius * glm::normalize(normal + (2.0f * u - 1.0f) * right + (2.0f * v - 1.0f) * up);
+					vertex.uv = { u, v };
+					mesh.vertices.push_back(vertex);
+				}
+			}
+			for (std::uint32_t y = 0; y < subdivisions; y++) {
+				for (std::uint32_t x = 0; x < subdivisions; x++) {
+					const auto corner = base + y * side + x;
+					mesh.indices.insert(mesh.indices.end(), { corner, corner + 1, corner + side + 1, corner, corner + side + 1, corner + side });
+				}
+			}
+		}
+		return mesh;
+	}
+
+} // namespace TestMeshes
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <CoreForward.hpp>
+#include <cache/AssetHandle.hpp>
+#include <graphics/FrustumCuller.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/norm.hpp>
@@ -114,16 +116,35 @@ namespace SceneSystem::Component {
 	template <> inline constexpr std::string_view component_name<Component::Transform> = "transform";
 
 	struct Mesh {
-		std::shared_ptr<Alabaster::Mesh> mesh;
+		AssetManager::MeshHandle mesh {};
 
 		Mesh() = default;
-		explicit Mesh(const std::shared_ptr<Alabaster::Mesh>& mesh);
+		explicit Mesh(AssetManager::MeshHandle mesh);
 		~Mesh() = default;
 
-		inline bool valid() const { return mesh != nullptr; }
+		inline bool valid() const { return mesh.valid(); }
 	};
 	template <> inline constexpr std::string_view component_name<Component::Mesh> = "mesh";
 
+	/// @brief The world space bounds of an entity's mesh. Added and culled by the scene every frame, but only recomputed once the mesh
+	/// or the transform changed.
+	struct Bounds {
+		Alabaster::WorldBounds world {};
+		/// @brief The handle's generation tells a mesh apart from one loaded into its slot later, where an address could be reused.
+		AssetManager::MeshHandle mesh {};
+		glm::vec3 position { 0 };
+		glm::quat rotation { 0, 0, 0, 0 };
+		glm::vec3 scale { 0 };
+		/// @brief Whether the last culling pass found the bounds in view.
+		bool visible { true };
+
+		bool is_current(AssetManager::MeshHandle current_mesh, const Transform& transform) const
+		{
+			return mesh == current_mesh && position == transform.position && rotation == transform.rotation && scale == transform.scale;
+		}
+	};
+	template <> inline constexpr std::string_view component_name<Component::Bounds> = "bounds";
+
 	struct Pipeline {
 		std::shared_ptr<Alabaster::Pipeline> pipeline = nullptr;
 
@@ -146,10 +167,10 @@ namespace SceneSystem::Component {
 
 	struct Texture {
 		glm::vec4 colour { 1.0f };
-		const std::shared_ptr<Alabaster::Texture> texture { nullptr };
+		AssetManager::TextureHandle texture {};
 
 		template <typename T>
-		explicit Texture(const T& col, const std::shared_ptr<Alabaster::Texture>& tex = nullptr)
+		explicit Texture(const T& col, AssetManager::TextureHandle tex = {})
 			: colour(col)
 			, texture(tex)
 		{
@@ -259,7 +280,7 @@ namespace SceneSystem::Component {
 	}
 
 	template <typename T>
-	concept IsComponent = Detail::IsAnyOf<T, Mesh, Transform, ID, Tag, Texture, BasicGeometry, Pipeline, Camera, Light, PointLight,
+	concept IsComponent = Detail::IsAnyOf<T, Mesh, Bounds, Transform, ID, Tag, Texture, BasicGeometry, Pipeline, Camera, Light, PointLight,
 		SphereIntersectible, QuadIntersectible, Behaviour, ScriptBehaviour>;
 
 	template <typename T>
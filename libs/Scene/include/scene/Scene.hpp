@@ -4,6 +4,7 @@
 #include "component/Component.hpp"
 #include "graphics/Camera.hpp"
 #include "graphics/CommandBuffer.hpp"
+#include "graphics/FrustumCuller.hpp"
 #include "graphics/Renderer3D.hpp"
 
 #include <entt/entt.hpp>
@@ -11,6 +12,7 @@
 
 namespace AssetManager {
 	class FileWatcher;
+	struct ShaderReload;
 }
 
 namespace Scripting {
@@ -43,6 +45,8 @@ namespace SceneSystem {
 
 		void draw_entities_in_scene();
 		void update_intersectibles();
+		/// @brief Tests the bounds of every entity with a mesh against the camera's frustum, only those in view are drawn.
+		void cull_entities();
 
 		void delete_entity(const std::string& tag);
 		void delete_entity(const uuids::uuid& uuid);
@@ -67,6 +71,8 @@ namespace SceneSystem {
 		[[nodiscard]] const std::shared_ptr<Alabaster::Image>& final_image() const;
 		void update_selected_entity() const;
 
+		[[nodiscard]] const Alabaster::CullingStatistics& get_culling_statistics() const { return culling_statistics; }
+
 		[[nodiscard]] const auto& get_camera() const { return scene_camera; }
 		auto& get_camera() { return scene_camera; }
 
@@ -80,6 +86,7 @@ namespace SceneSystem {
 		void pick_entity(const glm::vec3& ray_world);
 		void pick_mouse();
 		void build_scene();
+		void rebuild_pipelines(const AssetManager::ShaderReload& reload);
 
 		entt::registry registry;
 
@@ -102,6 +109,13 @@ namespace SceneSystem {
 		std::unique_ptr<Alabaster::Framebuffer> framebuffer;
 		std::unique_ptr<Alabaster::Renderer3D> scene_renderer;
 
+		std::optional<std::uint32_t> shader_reload_listener;
+
+		Alabaster::FrustumCuller culler;
+		std::vector<Component::Bounds*> culled_bounds;
+		std::vector<std::uint8_t> visibility;
+		Alabaster::CullingStatistics culling_statistics;
+
 		friend Entity;
 	};
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "cache/ResourceCache.hpp"
 #include "component/Component.hpp"
 #include "entity/Entity.hpp"
 #include "graphics/Mesh.hpp"
@@ -54,7 +55,9 @@ namespace SceneSystem {
 		void operator()(Entity& entity, auto& out)
 		{
 			auto mesh_object = json::object();
-			mesh_object["asset_path"] = entity.get_component<Component::Mesh>().mesh->get_asset_path().string();
+			if (const auto* mesh = AssetManager::the().get(entity.get_component<Component::Mesh>().mesh)) {
+				mesh_object["asset_path"] = mesh->get_asset_path().string();
+			}
 
 			out[Component::component_name<Component::Mesh>] = mesh_object;
 		};
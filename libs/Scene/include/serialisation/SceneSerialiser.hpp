@@ -1,7 +1,8 @@
 #pragma once
 
-#include <future>
 #include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
 #include <vector>
 
 namespace SceneSystem {
@@ -29,7 +30,8 @@ namespace SceneSystem {
 		Scene& scene;
 		bool has_written { false };
 		nlohmann::json output_json {};
-		std::vector<std::future<nlohmann::json>> futures;
+		std::vector<nlohmann::json> serialised_entities;
+		std::optional<std::string> serialisation_error;
 		std::string time_stamp;
 	};
 
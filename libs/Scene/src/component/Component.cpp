@@ -24,7 +24,7 @@ namespace SceneSystem {
 		return glm::translate(glm::mat4(1.0f), position) * glm::mat4(rotation) * glm::scale(glm::mat4(1.0f), scale);
 	}
 
-	Component::Mesh::Mesh(const std::shared_ptr<Alabaster::Mesh>& in_mesh)
+	Component::Mesh::Mesh(AssetManager::MeshHandle in_mesh)
 		: mesh(in_mesh)
 	{
 	}
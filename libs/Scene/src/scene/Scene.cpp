@@ -12,6 +12,7 @@
 #include <Alabaster.hpp>
 #include <GLFW/glfw3.h>
 #include <Scripting.hpp>
+#include <chrono>
 #include <glm/gtc/type_ptr.hpp>
 #include <imgui/imgui.h>
 
@@ -48,6 +49,9 @@ namespace SceneSystem {
 		engine->set_scene(this);
 		engine->register_file_watcher(watcher);
 
+		shader_reload_listener
+			= AssetManager::the().add_shader_reload_listener([this](const AssetManager::ShaderReload& reload) { rebuild_pipelines(reload); });
+
 		Alabaster::FramebufferSpecification fbs;
 		fbs.width = w;
 		fbs.height = h;
@@ -59,6 +63,43 @@ namespace SceneSystem {
 		framebuffer = std::make_unique<Alabaster::Framebuffer>(fbs);
 	}
 
+	void Scene::rebuild_pipelines(const AssetManager::ShaderReload& reload)
+	{
+		// Entities commonly share a pipeline, rebuild each one once and keep them shared.
+		std::unordered_map<Alabaster::Pipeline*, std::size_t> stale;
+		std::vector<Alabaster::PipelineSpecification> specs;
+
+		const auto pipeline_view = registry.view<Component::Pipeline>();
+		pipeline_view.each([&reload, &stale, &specs](Component::Pipeline& component) {
+			if (!component.pipeline || component.pipeline->get_specification().shader != reload.previous) {
+				return;
+			}
+
+			if (stale.try_emplace(component.pipeline.get(), specs.size()).second) {
+				specs.emplace_back(component.pipeline->get_specification()).shader = reload.shader;
+			}
+		});
+
+		if (specs.empty()) {
+			return;
+		}
+
+		std::vector<std::shared_ptr<Alabaster::Pipeline>> rebuilt;
+		try {
+			rebuilt = Alabaster::Pipeline::create(std::move(specs));
+		} catch (const Alabaster::AlabasterException& e) {
+			Alabaster::Log::error("[Scene] Could not rebuild pipelines for shader {}. Reason: {}", reload.name, e.what());
+			return;
+		}
+
+		pipeline_view.each([&stale, &rebuilt](Component::Pipeline& component) {
+			if (const auto found = stale.find(component.pipeline.get()); found != stale.end()) {
+				Alabaster::Renderer::submit_resource_free([retired = component.pipeline]() mutable { retired.reset(); });
+				component.pipeline = rebuilt[found->second];
+			}
+		});
+	}
+
 	void Scene::step()
 	{
 		// TODO: We should step
@@ -198,33 +239,99 @@ namespace SceneSystem {
 		});
 	}
 
+	void Scene::cull_entities()
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		// Bounds are added outside the view over them, adding to a storage while iterating it is not safe.
+		const auto without_bounds = registry.view<const Component::Transform, const Component::Mesh>(entt::exclude<Component::Bounds>);
+		const std::vector<entt::entity> added { without_bounds.begin(), without_bounds.end() };
+		registry.insert<Component::Bounds>(added.begin(), added.end());
+
+		const auto& assets = AssetManager::the();
+		culler.clear();
+		culled_bounds.clear();
+		const auto bounds_view = registry.view<const Component::Transform, const Component::Mesh, Component::Bounds>();
+		bounds_view.each([this, &assets](const auto& transform, const auto& mesh, auto& bounds) {
+			const auto* model = assets.get(mesh.mesh);
+			if (!model) {
+				bounds.visible = false;
+				return;
+			}
+
+			if (!bounds.is_current(mesh.mesh, transform)) {
+				bounds.world = Alabaster::WorldBounds::of(model->get_bounds(), transform.to_matrix());
+				bounds.mesh = mesh.mesh;
+				bounds.position = transform.position;
+				bounds.rotation = transform.rotation;
+				bounds.scale = transform.scale;
+			}
+			culler.add(bounds.world);
+			culled_bounds.push_back(&bounds);
+		});
+
+		const auto frustum = Alabaster::Frustum::of(scene_camera->get_view_projection());
+		const auto visible = culler.cull(frustum, visibility);
+		for (std::size_t i = 0; i < culled_bounds.size(); i++) {
+			culled_bounds[i]->visible = visibility[i] != 0;
+		}
+
+		culling_statistics = {
+			.visible = static_cast<std::uint32_t>(visible),
+			.culled = static_cast<std::uint32_t>(culled_bounds.size() - visible),
+			.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(),
+		};
+	}
+
 	void Scene::draw_entities_in_scene()
 	{
 		axes(scene_renderer, glm::vec3 { -2.5, -0.1, 2.5 }, 5.0f);
-
-		const auto mesh_view = registry.view<Component::Transform, const Component::Mesh, const Component::Texture, const Component::Pipeline>(
-			entt::exclude<Component::Light>);
-		mesh_view.each([&renderer = scene_renderer](const auto& transform, const auto& mesh, const auto& texture, const auto& pipeline) {
-			if (mesh.valid()) {
-				renderer->mesh(mesh.mesh, transform.to_matrix(), pipeline.pipeline, texture.colour);
+		cull_entities();
+
+		// Levels of detail are picked by the pixels their error covers in the viewport, before the viewport is sized everything is
+		// drawn at full detail.
+		const auto pixels_per_unit = 0.5f * viewport_size.y / std::tan(0.5f * scene_camera->get_vertical_fov());
+		scene_renderer->set_lod_scale(pixels_per_unit);
+
+		// Meshes are resolved through their handles, iterating the views never touches a reference count.
+		const auto& assets = AssetManager::the();
+		const auto mesh_view = registry.view<Component::Transform, const Component::Mesh, const Component::Bounds, const Component::Texture,
+			const Component::Pipeline>(entt::exclude<Component::Light>);
+		mesh_view.each([&renderer = scene_renderer, &assets](
+						   const auto& transform, const auto& mesh, const auto& bounds, const auto& texture, const auto& pipeline) {
+			if (!bounds.visible) {
+				return;
+			}
+			if (const auto* model = assets.get(mesh.mesh)) {
+				renderer->mesh(*model, transform.to_matrix(), pipeline.pipeline.get(), texture.colour);
 			}
 		});
 
-		const auto light_view = registry.view<const Component::Transform, const Component::Light, Component::Texture, const Component::Mesh>(
-			entt::exclude<Component::PointLight>);
-		light_view.each([&renderer = scene_renderer](const auto& transform, const auto& light, auto& texture, const auto& mesh) {
+		// Lights may carry a pipeline of their own, e.g. an unlit one, and fall back to the renderer's otherwise.
+		const auto pipeline_of = [this](entt::entity entity) -> Alabaster::Pipeline* {
+			const auto* component = registry.try_get<Component::Pipeline>(entity);
+			return component ? component->pipeline.get() : nullptr;
+		};
+
+		// Lights out of view still light the scene, only their meshes are culled.
+		const auto light_view = registry.view<const Component::Transform, const Component::Light, Component::Texture, const Component::Mesh,
+			const Component::Bounds>(entt::exclude<Component::PointLight>);
+		light_view.each([&renderer = scene_renderer, &assets, &pipeline_of](const auto entity, const auto& transform, const auto& light,
+							auto& texture, const auto& mesh, const auto& bounds) {
 			texture.colour = light.ambience;
-			if (mesh.valid()) {
-				renderer->mesh(mesh.mesh, transform.to_matrix(), nullptr, texture.colour);
+			if (const auto* model = assets.get(mesh.mesh); model && bounds.visible) {
+				renderer->mesh(*model, transform.to_matrix(), pipeline_of(entity), texture.colour);
 			}
 			renderer->set_light_data(transform.position, texture.colour, light.ambience);
 		});
 
-		const auto point_light_view = registry.view<const Component::Transform, const Component::PointLight, const Component::Mesh>();
-		point_light_view.each([&renderer = scene_renderer](const auto& transform, const auto& light, const auto& mesh) {
+		const auto point_light_view
+			= registry.view<const Component::Transform, const Component::PointLight, const Component::Mesh, const Component::Bounds>();
+		point_light_view.each([&renderer = scene_renderer, &assets, &pipeline_of](
+								  const auto entity, const auto& transform, const auto& light, const auto& mesh, const auto& bounds) {
 			renderer->submit_point_light_data({ glm::vec4(transform.position, 1.0), light.ambience });
-			if (mesh.valid()) {
-				renderer->mesh(mesh.mesh, transform.to_matrix(), nullptr, light.ambience);
+			if (const auto* model = assets.get(mesh.mesh); model && bounds.visible) {
+				renderer->mesh(*model, transform.to_matrix(), pipeline_of(entity), light.ambience);
 			}
 		});
 		scene_renderer->commit_point_light_data();
@@ -281,6 +388,10 @@ namespace SceneSystem {
 
 	Scene::~Scene()
 	{
+		if (shader_reload_listener) {
+			AssetManager::the().remove_shader_reload_listener(*shader_reload_listener);
+		}
+
 		auto scripts = registry.view<Component::Behaviour>();
 		scripts.each([](Component::Behaviour& behaviour) {
 			if (!behaviour.is_valid())
@@ -4,7 +4,6 @@
 
 #include "component/Component.hpp"
 #include "core/Logger.hpp"
-#include "core/Utilities.hpp"
 #include "entity/Entity.hpp"
 #include "filesystem/FileSystem.hpp"
 #include "scene/Scene.hpp"
@@ -16,6 +15,8 @@
 
 namespace SceneSystem {
 
+	static constexpr std::size_t entities_per_job = 16;
+
 	SceneSerialiser::SceneSerialiser(Scene& input_scene) noexcept
 		: scene(input_scene)
 	{
@@ -51,7 +52,6 @@ namespace SceneSystem {
 
 	void SceneSerialiser::serialise_to_json()
 	{
-		using json = nlohmann::json;
 		auto& registry = scene.get_registry();
 
 		time_stamp = Alabaster::Time::formatted_time();
@@ -69,41 +69,29 @@ namespace SceneSystem {
 			Alabaster::Log::info("We could not create these entities..");
 		}
 
-		AssetManager::ThreadPool pool { 16 };
-		auto all_serialised_entities = json::array();
-		using namespace Alabaster::Utilities;
-		for (auto chunked = split_into(entities, 16); auto& chunk : chunked) {
-			futures.emplace_back(pool.push([chunk = std::move(chunk)](int) mutable {
-				auto serialised_entities = json::array();
-				for (auto& entity : chunk) {
-					serialised_entities.push_back(serialise_entity(entity));
-				}
-				return serialised_entities;
-			}));
+		serialised_entities.resize(entities.size());
+		try {
+			AssetManager::JobSystem::the().parallel_for(0, entities.size(), entities_per_job,
+				[&entities, &serialised = serialised_entities](std::size_t index) { serialised[index] = serialise_entity(entities[index]); });
+		} catch (const std::exception& error) {
+			serialisation_error = error.what();
 		}
-
-		pool.stop(true);
 	}
 
 	void SceneSerialiser::write_to_dir() noexcept
 	{
 		has_written = true;
 
-		json entities_array = json::array();
-		try {
-			for (auto& entity_array_future : futures) {
-				for (auto array = entity_array_future.get(); const auto& entity_array : array) {
-					entities_array.push_back(entity_array);
-				}
-			}
-		} catch (const std::future_error& error) {
-			Alabaster::Log::error("Could not serialise scene because the thread pool threw. Will not write file. More info: {}", error.what());
-			return;
-		} catch (const std::exception& error) {
-			Alabaster::Log::error("Could not serialise scene because {}. Will not write file.", error.what());
+		if (serialisation_error) {
+			Alabaster::Log::error("Could not serialise scene because {}. Will not write file.", *serialisation_error);
 			return;
 		}
 
+		auto entities_array = nlohmann::json::array();
+		for (auto& entity : serialised_entities) {
+			entities_array.push_back(std::move(entity));
+		}
+
 		output_json["entities"] = entities_array;
 
 		try {